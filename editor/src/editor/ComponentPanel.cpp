@@ -167,7 +167,7 @@ namespace editor {
 	class ComponentPanel::AnimationComponentNode : public ComponentPanel::ComponentNode<AnimationComponent>
 	{
 	private:	// Functions
-		std::array<char, NodeData::kMaxLength> mName = {};
+		std::array<char, 64> mName = {};
 
 	public:		// Functions
 		AnimationComponentNode(ComponentPanel& panel) : ComponentNode(panel) {};
@@ -185,7 +185,7 @@ namespace editor {
 				auto [animation] = query.getComponents<AnimationComponent>(entity);
 				auto node = animation->getRootNode();
 				if (node) {
-					ImGui::Text("%s (0x%p)", node->getData().name.data(), static_cast<void*>(node));
+					ImGui::Text("%s (0x%p)", node->getData().name.c_str(), static_cast<void*>(node));
 				}
 				else {
 					ImGui::Text("No node setted");
@@ -369,11 +369,11 @@ namespace editor {
 					}
 					if (ImGui::Button(("Build probe" + getIdPrefix() + "LightProbeComponentNode::BuildProbe").c_str())) {
 						auto irradianceMapRef = TextureUtils::convoluteCubeMap(*environmentTexture, mIrradianceMapSize);
-						lightProbe->irradianceMap = getEditor().getScene()->repository.insert(std::make_shared<TextureRef>(irradianceMapRef));
+						lightProbe->irradianceMap = getEditor().getScene()->repository.insert(Repository::makeShared<TextureRef>(irradianceMapRef));
 						setRepoName<TextureRef>(lightProbe->irradianceMap, (mEnvironmentTextureName + "IrradianceMap").c_str());
 
 						auto prefilterMapRef = TextureUtils::prefilterCubeMap(*environmentTexture, mPrefilterMapSize);
-						lightProbe->prefilterMap = getEditor().getScene()->repository.insert(std::make_shared<TextureRef>(prefilterMapRef));
+						lightProbe->prefilterMap = getEditor().getScene()->repository.insert(Repository::makeShared<TextureRef>(prefilterMapRef));
 						setRepoName<TextureRef>(lightProbe->prefilterMap, (mEnvironmentTextureName + "PrefilterMap").c_str());
 					}
 					if (!environmentTexture) {
@@ -904,8 +904,9 @@ namespace editor {
 		}
 		void drawTriMesh(TriangleMeshCollider& triMesh)
 		{
-			ImGui::Text("Number of vertices: %lu", triMesh.getNumVertices());
-			ImGui::Text("Number of indices: %lu", triMesh.getNumIndices());
+			const auto& triangleMesh = triMesh.getMesh();
+			ImGui::Text("Number of vertices: %lu", triangleMesh? triangleMesh->getNumVertices() : 0);
+			ImGui::Text("Number of indices: %lu", triangleMesh? triangleMesh->getNumIndices() : 0);
 
 			if (ImGui::TreeNode("Create from graphics mesh")) {
 				auto mesh = getEditor().getScene()->repository.findByName<MeshRef>(mMeshName.c_str());
@@ -917,10 +918,10 @@ namespace editor {
 				std::string name1 = "Build Triangle Mesh" + getIdPrefix() + "RigidBodyComponentNode::BuildTriangleMesh";
 				if (ImGui::Button(name1.c_str())) {
 					auto rawMesh = MeshLoader::createRawMesh(*mesh);
-					triMesh.setMesh(
+					triMesh.setMesh(std::make_shared<TriangleMesh>(
 						rawMesh.positions.data(), rawMesh.positions.size(),
 						rawMesh.indices.data(), rawMesh.indices.size()
-					);
+					));
 				}
 				ImGui::TreePop();
 			}
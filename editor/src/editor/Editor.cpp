@@ -145,7 +145,7 @@ namespace editor {
 			vTransforms->orientation = glm::quat(glm::vec3(glm::radians(-30.0f), glm::radians(110.0f), 0.0f));
 
 			auto scriptComponent = query.emplaceComponent<se::app::ScriptComponent>(mViewportEntity);
-			auto scriptSPtr = std::make_shared<ViewportControl>();
+			auto scriptSPtr = se::app::Repository::makeShared<ViewportControl>();
 			auto script = mRepository->insert<se::app::Script>(std::move(scriptSPtr), "viewportControl");
 			scriptComponent->setScript(script);
 
@@ -165,7 +165,7 @@ namespace editor {
 			auto& context = mExternalTools->graphicsEngine->getContext();
 			auto mesh = query.emplaceComponent<se::app::MeshComponent>(mGridEntity);
 			auto gridRawMesh = se::app::MeshLoader::createGridMesh("grid", 50, 100.0f);
-			auto gridMeshRef = std::make_shared<se::app::MeshRef>(se::app::MeshLoader::createGraphicsMesh(context, gridRawMesh));
+			auto gridMeshRef = se::app::Repository::makeShared<se::app::MeshRef>(se::app::MeshLoader::createGraphicsMesh(context, gridRawMesh));
 			auto gridMesh = mRepository->insert(std::move(gridMeshRef), "gridMesh");
 			std::size_t gridIndex = mesh->add(false, gridMesh, se::graphics::PrimitiveType::Line);
 
@@ -175,11 +175,11 @@ namespace editor {
 				SOMBRA_ERROR_LOG << result.description();
 				return;
 			}
-			auto program3DResource = mRepository->insert(std::make_shared<se::app::ProgramRef>(program3DRef), "program3D")
+			auto program3DResource = mRepository->insert(se::app::Repository::makeShared<se::app::ProgramRef>(program3DRef), "program3D")
 				.setPath("res/shaders/vertex3D.glsl||res/shaders/fragment3D.glsl");
 
 			auto renderer = dynamic_cast<se::graphics::Renderer*>(mExternalTools->graphicsEngine->getRenderGraph().getNode("forwardRendererMesh"));
-			auto stepGrid = mRepository->insert(std::make_shared<se::app::RenderableShaderStep>(*renderer), "stepGrid");
+			auto stepGrid = mRepository->insert(se::app::Repository::makeShared<se::app::RenderableShaderStep>(*renderer), "stepGrid");
 			stepGrid->addResource(program3DResource)
 				.addBindable(context.create<se::graphics::SetOperation>(se::graphics::Operation::Culling, false))
 				.addBindable(context.create<se::graphics::SetOperation>(se::graphics::Operation::DepthTest, true))
@@ -187,7 +187,7 @@ namespace editor {
 					context.create<se::graphics::UniformVariableValue<glm::vec4>>("uColor", glm::vec4(0.5f, 0.5f, 0.5f, 1.0f))
 						.qedit([=](auto& q, auto& uniform) { uniform.load(*q.getTBindable(program3DRef)); })
 				);
-			auto shaderGrid = mRepository->insert(std::make_shared<se::app::RenderableShader>(*mEventManager), "shaderGrid");
+			auto shaderGrid = mRepository->insert(se::app::Repository::makeShared<se::app::RenderableShader>(*mEventManager), "shaderGrid");
 			shaderGrid->addStep(stepGrid);
 			mesh->addRenderableShader(gridIndex, shaderGrid);
 		});
@@ -0,0 +1,75 @@
+#include <limits>
+#include <imgui.h>
+#include <se/utils/MemoryTracker.h>
+#include "MemoryPanel.h"
+#include "Editor.h"
+
+using namespace se::utils;
+
+namespace editor {
+
+	bool MemoryPanel::render()
+	{
+		bool open = true;
+		if (!ImGui::Begin(("Memory Panel##MemoryPanel" + std::to_string(mPanelId)).c_str(), &open)) {
+			ImGui::End();
+			return open;
+		}
+
+		MemoryTracker& tracker = MemoryTracker::getInstance();
+		ImGui::Text("Frame %zu", tracker.getFrameCount());
+
+		if (ImGui::SmallButton(("Reset peaks##MemoryPanel" + std::to_string(mPanelId) + "::ResetPeaks").c_str())) {
+			tracker.resetHighWaterMarks();
+		}
+
+		ImGuiTableFlags tableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg;
+		if (ImGui::BeginTable(("##MemoryPanel" + std::to_string(mPanelId) + "::Table").c_str(), 6, tableFlags)) {
+			ImGui::TableSetupColumn("Tag");
+			ImGui::TableSetupColumn("Current (KiB)");
+			ImGui::TableSetupColumn("Peak (KiB)");
+			ImGui::TableSetupColumn("Budget (KiB)");
+			ImGui::TableSetupColumn("Live allocs");
+			ImGui::TableSetupColumn("Allocs/frame");
+			ImGui::TableHeadersRow();
+
+			auto addRow = [](const char* name, const MemoryStats& stats, bool overBudget) {
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(name);
+				ImGui::TableNextColumn();
+				if (overBudget) {
+					ImGui::TextColored(ImVec4(1.0f, 0.25f, 0.25f, 1.0f), "%.2f", stats.currentBytes / 1024.0f);
+				}
+				else {
+					ImGui::Text("%.2f", stats.currentBytes / 1024.0f);
+				}
+				ImGui::TableNextColumn();
+				ImGui::Text("%.2f", stats.highWaterMark / 1024.0f);
+				ImGui::TableNextColumn();
+				if (stats.budget == std::numeric_limits<std::size_t>::max()) {
+					ImGui::TextUnformatted("-");
+				}
+				else {
+					ImGui::Text("%.2f", stats.budget / 1024.0f);
+				}
+				ImGui::TableNextColumn();
+				ImGui::Text("%zu", stats.liveAllocations);
+				ImGui::TableNextColumn();
+				ImGui::Text("%zu", stats.frameAllocations);
+			};
+
+			for (int i = 0; i < static_cast<int>(MemoryTag::Count); ++i) {
+				MemoryTag tag = static_cast<MemoryTag>(i);
+				addRow(MemoryTracker::getTagName(tag), tracker.getStats(tag), tracker.isOverBudget(tag));
+			}
+			addRow("Total", tracker.getTotalStats(), false);
+
+			ImGui::EndTable();
+		}
+
+		ImGui::End();
+		return open;
+	}
+
+}
@@ -0,0 +1,29 @@
+#ifndef MEMORY_PANEL_H
+#define MEMORY_PANEL_H
+
+#include "IEditorPanel.h"
+
+namespace editor {
+
+	class Editor;
+
+
+	/**
+	 * Class MemoryPanel, it's the Editor panel used for viewing the memory
+	 * tracked by the MemoryTracker for each subsystem of the engine
+	 */
+	class MemoryPanel : public IEditorPanel
+	{
+	public:		// Functions
+		/** Creates a new MemoryPanel
+		 *
+		 * @param	editor a reference to the Editor that holds the Panel */
+		MemoryPanel(Editor& editor) : IEditorPanel(editor) {};
+
+		/** @copydoc IEditorPanel::render() */
+		virtual bool render() override;
+	};
+
+}
+
+#endif		// MEMORY_PANEL_H
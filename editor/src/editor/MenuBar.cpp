@@ -9,6 +9,7 @@
 #include "ComponentPanel.h"
 #include "RepositoryPanel.h"
 #include "SceneNodesPanel.h"
+#include "MemoryPanel.h"
 #include "Gizmo.h"
 
 using namespace se::app;
@@ -61,6 +62,9 @@ namespace editor {
 				if (ImGui::MenuItem("Gizmo", "")) {
 					mEditor.addPanel(new Gizmo(mEditor));
 				}
+				if (ImGui::MenuItem("Memory", "")) {
+					mEditor.addPanel(new MemoryPanel(mEditor));
+				}
 				ImGui::EndMenu();
 			}
 			if (ImGui::BeginMenu("Help")) {
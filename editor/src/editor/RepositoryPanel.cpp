@@ -370,7 +370,7 @@ namespace editor {
 			ImGui::SameLine();
 
 			if (confirmButton(validName)) {
-				auto lSource = std::make_shared<LightSource>(getEditor().getEventManager(), LightSource::Type::Directional);
+				auto lSource = Repository::makeShared<LightSource>(getEditor().getEventManager(), LightSource::Type::Directional);
 				setRepoName(
 					repository.insert(std::move(lSource)).setFakeUser(),
 					mNameBuffer.data()
@@ -421,7 +421,7 @@ namespace editor {
 				return Result(false, "Error reading the audio file \"" + std::string(path) + "\"");
 			}
 
-			auto dataSourceSPtr = std::make_shared<DataSource>(std::move(dSource));
+			auto dataSourceSPtr = Repository::makeShared<DataSource>(std::move(dSource));
 			setRepoName(
 				repository.insert(std::move(dataSourceSPtr)).setPath(path).setFakeUser(),
 				mNameBuffer.data()
@@ -456,7 +456,7 @@ namespace editor {
 				if (!gravity) {
 					force.setFakeUser(false);
 
-					gravity = std::make_shared<Gravity>();
+					gravity = Repository::makeShared<Gravity>();
 					auto force2 = repository.insert<Force>(gravity)
 						.setFakeUser(true)
 						.setName(force.getName())
@@ -471,7 +471,7 @@ namespace editor {
 				if (!punctual) {
 					force.setFakeUser(false);
 
-					punctual = std::make_shared<PunctualForce>();
+					punctual = Repository::makeShared<PunctualForce>();
 					auto force2 = repository.insert<Force>(punctual)
 						.setFakeUser(true)
 						.setName(force.getName())
@@ -486,7 +486,7 @@ namespace editor {
 				if (!directional) {
 					force.setFakeUser(false);
 
-					directional = std::make_shared<DirectionalForce>();
+					directional = Repository::makeShared<DirectionalForce>();
 					auto force2 = repository.insert<Force>(directional)
 						.setFakeUser(true)
 						.setName(force.getName())
@@ -514,7 +514,7 @@ namespace editor {
 			}
 			ImGui::SameLine();
 			if (confirmButton(validName)) {
-				auto force = repository.insert<Force>(std::make_shared<Gravity>(), mNameBuffer.data());
+				auto force = repository.insert<Force>(Repository::makeShared<Gravity>(), mNameBuffer.data());
 				force.setFakeUser();
 				mNameBuffer.fill(0);
 				ret = true;
@@ -632,7 +632,7 @@ namespace editor {
 				);
 				if (result) {
 					setRepoName(
-						repository.insert(std::make_shared<ProgramRef>(program))
+						repository.insert(Repository::makeShared<ProgramRef>(program))
 							.setPath((mPathVertex + "|" + mPathGeometry + "|" + mPathFragment).c_str())
 							.setFakeUser(),
 						mNameBuffer.data()
@@ -738,7 +738,7 @@ namespace editor {
 			}
 			ImGui::SameLine();
 			if (confirmButton(validName && isRendererSelected)) {
-				auto step = repository.insert<RenderableShaderStep>(std::make_shared<RenderableShaderStep>(*renderers[mRendererSelected]), mNameBuffer.data());
+				auto step = repository.insert<RenderableShaderStep>(Repository::makeShared<RenderableShaderStep>(*renderers[mRendererSelected]), mNameBuffer.data());
 				step.setFakeUser();
 				mNameBuffer.fill(0);
 				ret = true;
@@ -1632,7 +1632,7 @@ namespace editor {
 			}
 			ImGui::SameLine();
 			if (confirmButton(validName)) {
-				auto rShaderSPtr = std::make_shared<RenderableShader>(getEditor().getEventManager());
+				auto rShaderSPtr = Repository::makeShared<RenderableShader>(getEditor().getEventManager());
 				setRepoName(
 					repository.insert(std::move(rShaderSPtr)).setFakeUser(),
 					mNameBuffer.data()
@@ -1760,7 +1760,7 @@ namespace editor {
 				if (ImGui::Button(("Generate" + getIdPrefix() + "TextureNode::equirectangularToCubeMap").c_str())) {
 					auto cubeMapRef = TextureUtils::equirectangularToCubeMap(*texture, mCubeMapSize);
 					setRepoName(
-						repository.insert(std::make_shared<TextureRef>(cubeMapRef)).setFakeUser(true),
+						repository.insert(Repository::makeShared<TextureRef>(cubeMapRef)).setFakeUser(true),
 						(std::string(texture.getName()) + "CubeMap").c_str()
 					);
 				}
@@ -1773,7 +1773,7 @@ namespace editor {
 				if (ImGui::Button(("Generate" + getIdPrefix() + "TextureNode::equirectangularToCubeMap").c_str())) {
 					auto normalMapRef = TextureUtils::heightmapToNormalMapLocal(*texture, mNormalMapWidth, mNormalMapHeight);
 					setRepoName(
-						repository.insert(std::make_shared<TextureRef>(normalMapRef)).setFakeUser(true),
+						repository.insert(Repository::makeShared<TextureRef>(normalMapRef)).setFakeUser(true),
 						(std::string(texture.getName()) + "NormalMap").c_str()
 					);
 				}
@@ -1835,7 +1835,7 @@ namespace editor {
 			}
 
 			setRepoName(
-				repository.insert(std::make_shared<TextureRef>(textureRef)).setPath(path),
+				repository.insert(Repository::makeShared<TextureRef>(textureRef)).setPath(path),
 				mNameBuffer.data()
 			);
 
@@ -1904,7 +1904,7 @@ namespace editor {
 			ImGui::SameLine();
 			if (confirmButton(validName)) {
 				setRepoName(
-					repository.insert(std::make_shared<ParticleEmitter>()).setFakeUser(),
+					repository.insert(Repository::makeShared<ParticleEmitter>()).setFakeUser(),
 					mNameBuffer.data()
 				);
 				mNameBuffer.fill(0);
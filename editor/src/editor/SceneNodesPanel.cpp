@@ -1,3 +1,4 @@
+#include <cstring>
 #include <imgui.h>
 #include <imgui_internal.h>
 #include <glm/gtc/type_ptr.hpp>
@@ -28,7 +29,7 @@ namespace editor {
 			// Options for adding root child nodes
 			if (ImGui::BeginPopupContextItem()) {
 				mSelectedNode = root->end();
-				mWorkingData = se::animation::NodeData();
+				setWorkingData(se::animation::NodeData());
 
 				mAdd |= ImGui::MenuItem("Add");
 				ImGui::EndPopup();
@@ -48,10 +49,14 @@ namespace editor {
 
 				ImGui::Separator();
 				ImGui::Text("Node selected: 0x%p", static_cast<void*>(&(*mSelectedNode)));
-				ImGui::InputText(
+				std::array<char, kMaxNameSize> nameBuffer = {};
+				std::strncpy(nameBuffer.data(), animationData.name.c_str(), nameBuffer.size() - 1);
+				if (ImGui::InputText(
 					("Name##SceneNodesPanel" + std::to_string(mPanelId) + "::name").c_str(),
-					animationData.name.data(), animationData.name.size()
-				);
+					nameBuffer.data(), nameBuffer.size(), ImGuiInputTextFlags_EnterReturnsTrue
+				)) {
+					animationData.name = se::utils::NameId(nameBuffer.data());
+				}
 				ImGui::Text("Local transforms:");
 				updated |= ImGui::DragFloat3("Position", glm::value_ptr(animationData.localTransforms.position), 0.005f, -FLT_MAX, FLT_MAX, "%.3f", 1.0f);
 				updated |= drawOrientation("Orientation", animationData.localTransforms.orientation, mOrientationType);
@@ -94,10 +99,11 @@ namespace editor {
 			if (ImGui::BeginPopup(("SceneNodesPanel" + std::to_string(mPanelId) + "::addPopup").c_str())) {
 				ImGui::InputText(
 					("Name##SceneNodesPanel" + std::to_string(mPanelId) + "::add").c_str(),
-					mWorkingData.name.data(), mWorkingData.name.size()
+					mNameBuffer.data(), mNameBuffer.size()
 				);
 				if (ImGui::Button(("Add##SceneNodesPanel" + std::to_string(mPanelId) + "::Add").c_str())) {
 					mAdd = false;
+					mWorkingData.name = se::utils::NameId(mNameBuffer.data());
 					fixWorkingDataName();
 					se::animation::AnimationNode::const_iterator<se::utils::Traversal::BFS> selectedNode = mSelectedNode;
 					root->insert(selectedNode, std::make_unique<se::animation::AnimationNode>(mWorkingData));
@@ -122,7 +128,7 @@ namespace editor {
 				if (!mRoot) {
 					ImGui::InputText(
 						("Name##SceneNodesPanel" + std::to_string(mPanelId) + "::changeParent").c_str(),
-						mWorkingData.name.data(), mWorkingData.name.size()
+						mNameBuffer.data(), mNameBuffer.size()
 					);
 				}
 				ImGui::Checkbox(("Update descendants" + std::to_string(mPanelId) + "::updateDescendants").c_str(), &mDescendants);
@@ -133,15 +139,16 @@ namespace editor {
 					bool change = true;
 					auto it = root->cend();
 					if (!mRoot) {
+						se::utils::NameId parentName(mNameBuffer.data());
 						it = std::find_if(root->cbegin(), root->cend(), [&](const se::animation::AnimationNode& node) {
-							return std::strcmp(node.getData().name.data(), mWorkingData.name.data()) == 0;
+							return node.getData().name == parentName;
 						});
 						change = (it != root->cend())
 							&& (it != se::animation::AnimationNode::const_iterator<se::utils::Traversal::BFS>(mSelectedNode));
 					}
 					if (change) {
 						mSelectedNode = root->move(mSelectedNode, it, mDescendants);
-						mWorkingData = mSelectedNode->getData();
+						setWorkingData(mSelectedNode->getData());
 					}
 
 					ImGui::CloseCurrentPopup();
@@ -166,16 +173,16 @@ namespace editor {
 		ImGuiTreeNodeFlags nodeFlags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick | ImGuiTreeNodeFlags_SpanAvailWidth
 			| ((itNode == mSelectedNode)? ImGuiTreeNodeFlags_Selected : ImGuiTreeNodeFlags_None)
 			| (!itNode->getChild()? ImGuiTreeNodeFlags_Leaf : ImGuiTreeNodeFlags_None);
-		bool nodeOpen = ImGui::TreeNodeEx(&(*itNode), nodeFlags, "%s", itNode->getData().name.data());
+		bool nodeOpen = ImGui::TreeNodeEx(&(*itNode), nodeFlags, "%s", itNode->getData().name.c_str());
 
 		// Select the node with the left and right mouse buttons
 		if (ImGui::IsItemClicked()) {
 			mSelectedNode = itNode;
-			mWorkingData = itNode->getData();
+			setWorkingData(itNode->getData());
 		}
 		if (ImGui::BeginPopupContextItem()) {
 			mSelectedNode = itNode;
-			mWorkingData = itNode->getData();
+			setWorkingData(itNode->getData());
 
 			mAdd |= ImGui::MenuItem("Add");
 			mRemove |= ImGui::MenuItem("Remove");
@@ -196,28 +203,30 @@ namespace editor {
 	}
 
 
+	void SceneNodesPanel::setWorkingData(const se::animation::NodeData& nodeData)
+	{
+		mWorkingData = nodeData;
+		mNameBuffer = {};
+		std::strncpy(mNameBuffer.data(), mWorkingData.name.c_str(), mNameBuffer.size() - 1);
+	}
+
+
 	void SceneNodesPanel::fixWorkingDataName()
 	{
 		se::animation::AnimationNode& root = mEditor.getScene()->rootNode;
-		std::string name = mWorkingData.name.data();
+		se::utils::NameId name = mWorkingData.name;
 
 		for (std::size_t i = 0; true; ++i) {
 			if (std::none_of(root.cbegin(), root.cend(), [&](const se::animation::AnimationNode& node) {
-				return node.getData().name.data() == name;
+				return node.getData().name == name;
 			})) {
 				break;
 			}
 
-			name = mWorkingData.name.data();
-			std::string number = "." + std::to_string(i);
-			std::size_t nameSize = mWorkingData.name.size() - number.size();
-			if (name.size() > nameSize) {
-				name = name.substr(0, nameSize);
-			}
-			name += number;
+			name = se::utils::NameId(mWorkingData.name.str() + "." + std::to_string(i));
 		}
 
-		std::copy(name.begin(), name.end(), mWorkingData.name.begin());
+		mWorkingData.name = name;
 	}
 
 }
@@ -1,6 +1,7 @@
 #ifndef SCENE_NODES_PANEL_H
 #define SCENE_NODES_PANEL_H
 
+#include <array>
 #include <se/animation/AnimationNode.h>
 #include "IEditorPanel.h"
 
@@ -16,6 +17,9 @@ namespace editor {
 		using NodeIterator =
 			se::animation::AnimationNode::iterator<se::utils::Traversal::BFS>;
 
+		/** The maximum size of the node names that can be written */
+		static constexpr std::size_t kMaxNameSize = 256;
+
 	private:	// Attributes
 		/** The selected node */
 		NodeIterator mSelectedNode;
@@ -26,6 +30,10 @@ namespace editor {
 		/** The NodeData where the user input will be stored */
 		se::animation::NodeData mWorkingData;
 
+		/** The buffer where the user input of the @see mWorkingData name
+		 * will be stored */
+		std::array<char, kMaxNameSize> mNameBuffer = {};
+
 		/** The operations to execute */
 		bool mRemove = false, mAdd = false, mRemoveHierarchy = false,
 			mChangeParent = false;
@@ -50,6 +58,12 @@ namespace editor {
 		 * @param	itNode an iterator to the node to draw */
 		void drawNode(NodeIterator itNode);
 
+		/** Sets the given NodeData as the @see mWorkingData, copying its
+		 * name to @see mNameBuffer
+		 *
+		 * @param	nodeData the new NodeData */
+		void setWorkingData(const se::animation::NodeData& nodeData);
+
 		/** Checks if the current @see mWorkingData name isn't already used.
 		 * If it's already used it will add a number to it */
 		void fixWorkingDataName();
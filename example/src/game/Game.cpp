@@ -116,7 +116,7 @@ namespace game {
 
 		try {
 			// Font load
-			auto arialSPtr = std::make_shared<se::graphics::Font>();
+			auto arialSPtr = se::app::Repository::makeShared<se::graphics::Font>();
 			std::vector<char> characterSet(128);
 			std::iota(characterSet.begin(), characterSet.end(), '\0');
 			if (!se::app::FontReader::read(mExternalTools->graphicsEngine->getContext(), "res/fonts/arial.ttf", characterSet, { 48, 48 }, { 1280, 720 }, *arialSPtr)) {
@@ -316,7 +316,7 @@ namespace game {
 						logo1->width, logo1->height
 					);
 				});
-			logoTexture = mGame.getRepository().insert(std::make_shared<se::app::TextureRef>(texRef), "logo");
+			logoTexture = mGame.getRepository().insert(se::app::Repository::makeShared<se::app::TextureRef>(texRef), "logo");
 			logoTexture.setFakeUser();
 
 			texRef = graphicsEngine->getContext().create<se::graphics::Texture>(se::graphics::TextureTarget::Texture2D)
@@ -326,7 +326,7 @@ namespace game {
 						reticle1->width, reticle1->height
 					);
 				});
-			reticleTexture = mGame.getRepository().insert(std::make_shared<se::app::TextureRef>(texRef), "reticle");
+			reticleTexture = mGame.getRepository().insert(se::app::Repository::makeShared<se::app::TextureRef>(texRef), "reticle");
 			reticleTexture.setFakeUser();
 
 			chessTexture = mScene->repository.findByName<se::app::TextureRef>("chessTexture");
@@ -341,13 +341,13 @@ namespace game {
 						);
 				});
 			texRef = se::app::TextureUtils::equirectangularToCubeMap(texRef, 512);
-			skyTexture = mScene->repository.insert(std::make_shared<se::app::TextureRef>(texRef), "skyTexture");
+			skyTexture = mScene->repository.insert(se::app::Repository::makeShared<se::app::TextureRef>(texRef), "skyTexture");
 
 			// Meshes
 			se::app::RawMesh cubeRawMesh = se::app::MeshLoader::createBoxMesh("Cube", glm::vec3(1.0f));
 			cubeRawMesh.normals = se::app::MeshLoader::calculateNormals(cubeRawMesh.positions, cubeRawMesh.indices);
 			cubeRawMesh.tangents = se::app::MeshLoader::calculateTangents(cubeRawMesh.positions, cubeRawMesh.texCoords, cubeRawMesh.indices);
-			cubeMesh = mScene->repository.insert(std::make_shared<se::app::MeshRef>(se::app::MeshLoader::createGraphicsMesh(graphicsEngine->getContext(), cubeRawMesh)), "cube");
+			cubeMesh = mScene->repository.insert(se::app::Repository::makeShared<se::app::MeshRef>(se::app::MeshLoader::createGraphicsMesh(graphicsEngine->getContext(), cubeRawMesh)), "cube");
 
 			se::app::RawMesh planeRawMesh("Plane");
 			planeRawMesh.positions = { {-0.5f,-0.5f, 0.0f}, { 0.5f,-0.5f, 0.0f}, {-0.5f, 0.5f, 0.0f}, { 0.5f, 0.5f, 0.0f} };
@@ -355,7 +355,7 @@ namespace game {
 			planeRawMesh.indices = { 0, 1, 2, 1, 3, 2, };
 			planeRawMesh.normals = se::app::MeshLoader::calculateNormals(planeRawMesh.positions, planeRawMesh.indices);
 			planeRawMesh.tangents = se::app::MeshLoader::calculateTangents(planeRawMesh.positions, planeRawMesh.texCoords, planeRawMesh.indices);
-			planeMesh = mScene->repository.insert(std::make_shared<se::app::MeshRef>(se::app::MeshLoader::createGraphicsMesh(graphicsEngine->getContext(), planeRawMesh)), "plane");
+			planeMesh = mScene->repository.insert(se::app::Repository::makeShared<se::app::MeshRef>(se::app::MeshLoader::createGraphicsMesh(graphicsEngine->getContext(), planeRawMesh)), "plane");
 
 			// Programs
 			programShadow = mScene->repository.findByName<se::app::ProgramRef>("programShadow");
@@ -367,7 +367,7 @@ namespace game {
 			if (!result) {
 				throw std::runtime_error("programSky error: " + std::string(result.description()));
 			}
-			programSky = mScene->repository.insert(std::make_shared<se::app::ProgramRef>(programSkyRef), "programSky");
+			programSky = mScene->repository.insert(se::app::Repository::makeShared<se::app::ProgramRef>(programSkyRef), "programSky");
 
 			// Techniques
 			technique2D = mGame.getRepository().findByName<se::graphics::Technique>("technique2D");
@@ -379,7 +379,7 @@ namespace game {
 			stepShadow = mScene->repository.findByName<se::app::RenderableShaderStep>("stepShadow");
 
 			skyTexture->edit([](auto& texture) { texture.setTextureUnit(0); });
-			auto stepSky = mScene->repository.insert(std::make_shared<se::app::RenderableShaderStep>(*forwardRendererMesh), "stepSky");
+			auto stepSky = mScene->repository.insert(se::app::Repository::makeShared<se::app::RenderableShaderStep>(*forwardRendererMesh), "stepSky");
 			stepSky->addResource(programSky)
 				.addResource(skyTexture)
 				.addBindable(graphicsEngine->getContext().create<se::graphics::SetOperation>(se::graphics::Operation::DepthTest, true))
@@ -389,10 +389,10 @@ namespace game {
 						.qedit([pRef = *programSky](auto& q, auto& uniform) { uniform.load(*q.getTBindable(pRef)); })
 				);
 
-			shaderSky = mScene->repository.insert(std::make_shared<se::app::RenderableShader>(mGame.getEventManager()), "shaderSky");
+			shaderSky = mScene->repository.insert(se::app::Repository::makeShared<se::app::RenderableShader>(mGame.getEventManager()), "shaderSky");
 			shaderSky->addStep(stepSky);
 
-			auto stepPlane = mScene->repository.insert(std::make_shared<se::app::RenderableShaderStep>(*gBufferRendererMesh), "stepPlane");
+			auto stepPlane = mScene->repository.insert(se::app::Repository::makeShared<se::app::RenderableShaderStep>(*gBufferRendererMesh), "stepPlane");
 			se::app::ShaderLoader::addMaterialBindables(
 				stepPlane,
 				se::app::Material{
@@ -402,11 +402,11 @@ namespace game {
 				programGBufMaterial
 			);
 
-			shaderPlane = mScene->repository.insert(std::make_shared<se::app::RenderableShader>(mGame.getEventManager()), "shaderPlane");
+			shaderPlane = mScene->repository.insert(se::app::Repository::makeShared<se::app::RenderableShader>(mGame.getEventManager()), "shaderPlane");
 			shaderPlane->addStep(stepShadow)
 				.addStep(stepPlane);
 
-			auto stepRandom = mScene->repository.insert(std::make_shared<se::app::RenderableShaderStep>(*gBufferRendererMesh), "stepRandom");
+			auto stepRandom = mScene->repository.insert(se::app::Repository::makeShared<se::app::RenderableShaderStep>(*gBufferRendererMesh), "stepRandom");
 			se::app::ShaderLoader::addMaterialBindables(
 				stepRandom,
 				se::app::Material{
@@ -416,7 +416,7 @@ namespace game {
 				programGBufMaterial
 			);
 
-			shaderRandom = mScene->repository.insert(std::make_shared<se::app::RenderableShader>(mGame.getEventManager()), "shaderRandom");
+			shaderRandom = mScene->repository.insert(se::app::Repository::makeShared<se::app::RenderableShader>(mGame.getEventManager()), "shaderRandom");
 			shaderRandom->addStep(stepShadow)
 				.addStep(stepRandom);
 
@@ -431,7 +431,7 @@ namespace game {
 				.setFakeUser();
 
 			// Lights
-			spotLight = mScene->repository.insert(std::make_shared<se::app::LightSource>(mGame.getEventManager(), se::app::LightSource::Type::Spot), "spotLight");
+			spotLight = mScene->repository.insert(se::app::Repository::makeShared<se::app::LightSource>(mGame.getEventManager(), se::app::LightSource::Type::Spot), "spotLight");
 
 			// Forces
 			gravity = mScene->repository.findByName<se::physics::Force>("gravity");
@@ -454,7 +454,7 @@ namespace game {
 			mGame.getExternalTools().graphicsEngine->addRenderable(mPickText);
 
 			// Scripts
-			auto playerControllerSPtr = std::make_shared<PlayerController>(*this, *mPickText);
+			auto playerControllerSPtr = se::app::Repository::makeShared<PlayerController>(*this, *mPickText);
 			playerController = mScene->repository.insert<se::app::Script>(std::move(playerControllerSPtr), "playerController");
 		}
 		catch (std::exception& e) {
@@ -599,7 +599,7 @@ namespace game {
 				rbComponent.get().setCollider(std::move(collider));
 				query.addComponent(cube, std::move(rbComponent));
 
-				auto stepCube = mScene->repository.insert(std::make_shared<se::app::RenderableShaderStep>(*gBufferRendererMesh), ("stepCube" + std::to_string(i)).c_str());
+				auto stepCube = mScene->repository.insert(se::app::Repository::makeShared<se::app::RenderableShaderStep>(*gBufferRendererMesh), ("stepCube" + std::to_string(i)).c_str());
 				se::app::ShaderLoader::addMaterialBindables(
 					stepCube,
 					se::app::Material{
@@ -609,7 +609,7 @@ namespace game {
 					programGBufMaterial
 				);
 
-				auto shaderCube = mScene->repository.insert(std::make_shared<se::app::RenderableShader>(mGame.getEventManager()), ("shaderCube" + std::to_string(i)).c_str());
+				auto shaderCube = mScene->repository.insert(se::app::Repository::makeShared<se::app::RenderableShader>(mGame.getEventManager()), ("shaderCube" + std::to_string(i)).c_str());
 				shaderCube->addStep(stepShadow)
 					.addStep(stepCube);
 
@@ -650,7 +650,7 @@ namespace game {
 				transforms.position = glm::vec3(0.0f, 2.0f, 75.0f) + displacement;
 				query.addComponent(tubeSlice, std::move(transforms));
 
-				auto stepSlice = mScene->repository.insert(std::make_shared<se::app::RenderableShaderStep>(*gBufferRendererMesh), ("step" + name).c_str());
+				auto stepSlice = mScene->repository.insert(se::app::Repository::makeShared<se::app::RenderableShaderStep>(*gBufferRendererMesh), ("step" + name).c_str());
 				se::app::ShaderLoader::addMaterialBindables(
 					stepSlice,
 					se::app::Material{
@@ -663,12 +663,12 @@ namespace game {
 					programGBufMaterial
 				);
 
-				auto shaderSlice = mScene->repository.insert(std::make_shared<se::app::RenderableShader>(mGame.getEventManager()), ("shader" + name).c_str());
+				auto shaderSlice = mScene->repository.insert(se::app::Repository::makeShared<se::app::RenderableShader>(mGame.getEventManager()), ("shader" + name).c_str());
 				shaderSlice->addStep(stepShadow)
 					.addStep(stepSlice);
 
 				auto tmpRawMesh = se::app::MeshLoader::createRawMesh(heMesh, normals).first;
-				auto sliceMesh = mScene->repository.insert(std::make_shared<se::app::MeshRef>(se::app::MeshLoader::createGraphicsMesh(graphicsEngine->getContext(), tmpRawMesh)), ("mesh" + name).c_str());
+				auto sliceMesh = mScene->repository.insert(se::app::Repository::makeShared<se::app::MeshRef>(se::app::MeshLoader::createGraphicsMesh(graphicsEngine->getContext(), tmpRawMesh)), ("mesh" + name).c_str());
 				auto mesh = query.emplaceComponent<se::app::MeshComponent>(tubeSlice);
 				auto rIndex = mesh->add(false, sliceMesh);
 				mesh->addRenderableShader(rIndex, std::move(shaderSlice));
@@ -52,10 +52,10 @@ namespace game {
 		rawMesh2.normals = se::app::MeshLoader::calculateNormals(rawMesh2.positions, rawMesh2.indices);
 		rawMesh2.tangents = se::app::MeshLoader::calculateTangents(rawMesh2.positions, rawMesh2.texCoords, rawMesh2.indices);
 
-		mTetrahedronMesh = scene->repository.insert(std::make_shared<se::app::MeshRef>(se::app::MeshLoader::createGraphicsMesh(graphicsEngine->getContext(), rawMesh2)), "tetrahedronMesh");
+		mTetrahedronMesh = scene->repository.insert(se::app::Repository::makeShared<se::app::MeshRef>(se::app::MeshLoader::createGraphicsMesh(graphicsEngine->getContext(), rawMesh2)), "tetrahedronMesh");
 
 		auto programGBufMaterial = scene->repository.findByName<se::app::ProgramRef>("programGBufMaterial");
-		auto stepYellow = scene->repository.insert(std::make_shared<se::app::RenderableShaderStep>(*gBufferRenderer), "stepYellow");
+		auto stepYellow = scene->repository.insert(se::app::Repository::makeShared<se::app::RenderableShaderStep>(*gBufferRenderer), "stepYellow");
 
 		se::app::ShaderLoader::addMaterialBindables(
 			stepYellow,
@@ -66,7 +66,7 @@ namespace game {
 			programGBufMaterial
 		);
 
-		mShaderYellow = scene->repository.insert(std::make_shared<se::app::RenderableShader>(mLevel.getGame().getEventManager()), "shaderYellow");
+		mShaderYellow = scene->repository.insert(se::app::Repository::makeShared<se::app::RenderableShader>(mLevel.getGame().getEventManager()), "shaderYellow");
 		mShaderYellow->addStep(stepYellow);
 
 		mLightYellow = scene->repository.emplace<se::app::LightSource>(mLevel.getGame().getEventManager(), se::app::LightSource::Type::Point)
@@ -0,0 +1,135 @@
+#include <string>
+#include <iostream>
+#include <se/app/Application.h>
+#include <se/app/io/SceneGenerator.h>
+#include <se/app/io/SceneSerializer.h>
+#include <se/physics/RigidBodyWorld.h>
+
+using namespace se::app;
+
+/**
+ * Class SceneGenApp, it's the headless Application used for generating the
+ * stress Scenes
+ */
+class SceneGenApp : public Application
+{
+public:		// Functions
+	/** Creates a new SceneGenApp
+	 *
+	 * @param	maxEntities the maximum number of Entities */
+	SceneGenApp(std::size_t maxEntities) :
+		Application(se::physics::WorldProperties{}, 0.016f, HeadlessConfig{ maxEntities }) {};
+
+	/** @return	true if the Application was created succesfully, false
+	 *			otherwise */
+	bool good() const { return mState != AppState::Error; };
+};
+
+
+static void printUsage(const char* program)
+{
+	std::cout << "Usage: " << program << " --out <file> [options]\n"
+		<< "Options:\n"
+		<< "  --entities <n>        total number of entities, split with the default proportions (default 1000)\n"
+		<< "  --seed <n>            seed of the random values (default 0)\n"
+		<< "  --world-size <n>      length of the sides of the generated area\n"
+		<< "  --convex <n>          number of dynamic bodies with convex colliders\n"
+		<< "  --mesh-bodies <n>     number of static bodies with triangle mesh colliders\n"
+		<< "  --terrains <n>        number of static bodies with terrain colliders\n"
+		<< "  --characters <n>      number of skinned animated characters\n"
+		<< "  --bones <n>           number of bones of each character (default 16)\n"
+		<< "  --particles <n>       number of particle emitters\n"
+		<< "  --lights <n>          number of lights\n"
+		<< "  --static-meshes <n>   number of entities with only a mesh\n";
+}
+
+
+int main(int argc, char** argv)
+{
+	std::string outPath;
+	std::size_t numEntities = 1000;
+	unsigned int seed = 0;
+
+	// The per kind counts override the ones calculated from --entities, so
+	// they are parsed in a second pass
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		bool hasValue = (i + 1 < argc);
+		if ((arg == "--entities") && hasValue) {
+			numEntities = std::stoul(argv[++i]);
+		}
+		else if ((arg == "--seed") && hasValue) {
+			seed = static_cast<unsigned int>(std::stoul(argv[++i]));
+		}
+		else if ((arg == "--out") && hasValue) {
+			outPath = argv[++i];
+		}
+	}
+
+	SceneGenerator::Config config = SceneGenerator::createConfig(numEntities, seed);
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		bool hasValue = (i + 1 < argc);
+		if ((arg == "--entities") || (arg == "--seed") || (arg == "--out")) {
+			++i;
+		}
+		else if ((arg == "--world-size") && hasValue) {
+			config.worldSize = std::stof(argv[++i]);
+		}
+		else if ((arg == "--convex") && hasValue) {
+			config.numConvexBodies = std::stoul(argv[++i]);
+		}
+		else if ((arg == "--mesh-bodies") && hasValue) {
+			config.numMeshBodies = std::stoul(argv[++i]);
+		}
+		else if ((arg == "--terrains") && hasValue) {
+			config.numTerrains = std::stoul(argv[++i]);
+		}
+		else if ((arg == "--characters") && hasValue) {
+			config.numCharacters = std::stoul(argv[++i]);
+		}
+		else if ((arg == "--bones") && hasValue) {
+			config.numBonesPerCharacter = std::stoul(argv[++i]);
+		}
+		else if ((arg == "--particles") && hasValue) {
+			config.numParticleEmitters = std::stoul(argv[++i]);
+		}
+		else if ((arg == "--lights") && hasValue) {
+			config.numLights = std::stoul(argv[++i]);
+		}
+		else if ((arg == "--static-meshes") && hasValue) {
+			config.numStaticMeshes = std::stoul(argv[++i]);
+		}
+		else {
+			printUsage(argv[0]);
+			return (arg == "--help")? 0 : 1;
+		}
+	}
+
+	if (outPath.empty()) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	std::size_t totalEntities = config.numConvexBodies + config.numMeshBodies + config.numTerrains
+		+ config.numCharacters + config.numParticleEmitters + config.numLights + config.numStaticMeshes;
+	SceneGenApp application(totalEntities);
+	if (!application.good()) {
+		std::cerr << "Failed to create the Application" << std::endl;
+		return 1;
+	}
+
+	Scene scene("stress" + std::to_string(seed), application);
+	if (auto result = SceneGenerator::generate(config, scene); !result) {
+		std::cerr << "Failed to generate the Scene: " << result.description() << std::endl;
+		return 1;
+	}
+
+	if (auto result = SceneSerializer::serialize(outPath, scene); !result) {
+		std::cerr << "Failed to serialize the Scene: " << result.description() << std::endl;
+		return 1;
+	}
+
+	std::cout << "Scene with " << scene.entities.size() << " Entities written to " << outPath << std::endl;
+	return 0;
+}
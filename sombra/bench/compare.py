@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+"""Compares the results of two SombraBench runs.
+
+Usage:
+    compare.py <baseline.json> <current.json> [--threshold 0.1] [--metric median_ns]
+               [--allow-missing]
+
+Both files must have been generated with "SombraBench --out <file>". A
+benchmark is flagged as a regression when its time per iteration grows more
+than the given threshold (relative to the baseline). The benchmarks of the
+baseline that are missing from the current results are also flagged, unless
+--allow-missing is given (e.g. for runs with --filter). The script exits with
+a non-zero status if any regression or missing benchmark was found, so it can be
+used in CI.
+
+bench/baseline.json holds a reference run of all the SombraBench benchmarks.
+The timings depend on the machine, so a baseline generated on the same machine
+should be used for the comparisons.
+"""
+
+import sys
+import json
+import argparse
+
+
+def load_results(path):
+    with open(path) as f:
+        data = json.load(f)
+    return { b["name"]: b for b in data.get("benchmarks", []) }
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compares two SombraBench JSON results")
+    parser.add_argument("baseline", help="the JSON file with the baseline results")
+    parser.add_argument("current", help="the JSON file with the current results")
+    parser.add_argument("--threshold", type=float, default=0.1,
+        help="maximum relative slowdown allowed (default 0.1 = 10%%)")
+    parser.add_argument("--metric", default="median_ns",
+        choices=[ "mean_ns", "median_ns", "min_ns" ],
+        help="the statistic to compare (default median_ns)")
+    parser.add_argument("--allow-missing", action="store_true",
+        help="don't flag the baseline benchmarks missing from the current results")
+    args = parser.parse_args()
+
+    baseline = load_results(args.baseline)
+    current = load_results(args.current)
+
+    regressions = []
+    missing = []
+    print("%-48s %14s %14s %9s" % ("Benchmark", "Baseline (ns)", "Current (ns)", "Change"))
+    for name in sorted(set(baseline) | set(current)):
+        if name not in current:
+            flag = ""
+            if not args.allow_missing:
+                flag = "  MISSING"
+                missing.append(name)
+            print("%-48s %14.1f %14s %9s%s" % (name, baseline[name][args.metric], "missing", "", flag))
+            continue
+        if name not in baseline:
+            print("%-48s %14s %14.1f %9s" % (name, "new", current[name][args.metric], ""))
+            continue
+
+        old = baseline[name][args.metric]
+        new = current[name][args.metric]
+        change = (new - old) / old if old > 0.0 else 0.0
+
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions.append(name)
+        elif change < -args.threshold:
+            flag = "  improvement"
+
+        print("%-48s %14.1f %14.1f %+8.1f%%%s" % (name, old, new, 100.0 * change, flag))
+
+    if regressions:
+        print("\n%d benchmark(s) regressed more than %.1f%%:" % (len(regressions), 100.0 * args.threshold))
+        for name in regressions:
+            print("  " + name)
+    if missing:
+        print("\n%d benchmark(s) of the baseline are missing from the current results:" % len(missing))
+        for name in missing:
+            print("  " + name)
+
+    return 1 if (regressions or missing) else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
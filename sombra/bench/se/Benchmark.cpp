@@ -0,0 +1,89 @@
+#include <cmath>
+#include <numeric>
+#include <algorithm>
+#include "Benchmark.h"
+
+namespace se::bench {
+
+	BenchmarkRunner& BenchmarkRunner::getInstance()
+	{
+		static BenchmarkRunner instance;
+		return instance;
+	}
+
+
+	bool BenchmarkRunner::add(const char* name, const BenchmarkFunction& function)
+	{
+		mBenchmarks.push_back({ name, function });
+		return true;
+	}
+
+
+	BenchmarkResult BenchmarkRunner::run(
+		const Benchmark& benchmark,
+		double minTime, std::size_t repetitions
+	) {
+		static constexpr std::size_t kMaxIterations = 1000000000;
+		const std::chrono::duration<double> minDuration(minTime);
+
+		// Find the number of iterations needed for reaching the minimum time
+		std::size_t iterations = 1;
+		while (true) {
+			State state(iterations);
+			benchmark.function(state);
+
+			std::chrono::duration<double> elapsed = state.getElapsed();
+			if ((elapsed >= minDuration) || (iterations >= kMaxIterations)) {
+				break;
+			}
+
+			double multiplier = (elapsed.count() > 0.0)? 1.4 * minDuration / elapsed : 10.0;
+			multiplier = std::clamp(multiplier, 2.0, 10.0);
+			iterations = std::min(
+				static_cast<std::size_t>(std::ceil(iterations * multiplier)),
+				kMaxIterations
+			);
+		}
+
+		// Measure the repetitions
+		BenchmarkResult result;
+		result.name = benchmark.name;
+		result.iterations = iterations;
+		result.repetitions = std::max(repetitions, std::size_t(1));
+
+		std::vector<double> nsPerIteration;
+		std::size_t totalItems = 0;
+		double totalSeconds = 0.0;
+		for (std::size_t i = 0; i < result.repetitions; ++i) {
+			State state(iterations);
+			benchmark.function(state);
+
+			double ns = static_cast<double>(state.getElapsed().count());
+			nsPerIteration.push_back(ns / iterations);
+			totalItems += state.getItemsProcessed();
+			totalSeconds += ns * 1.0e-9;
+			result.counters = state.getCounters();
+		}
+
+		std::vector<double> sorted = nsPerIteration;
+		std::sort(sorted.begin(), sorted.end());
+		std::size_t n = sorted.size();
+
+		result.meanNs = std::accumulate(sorted.begin(), sorted.end(), 0.0) / n;
+		result.medianNs = (n % 2 == 0)? 0.5 * (sorted[n / 2 - 1] + sorted[n / 2]) : sorted[n / 2];
+		result.minNs = sorted.front();
+
+		double variance = 0.0;
+		for (double value : sorted) {
+			variance += (value - result.meanNs) * (value - result.meanNs);
+		}
+		result.stddevNs = (n > 1)? std::sqrt(variance / (n - 1)) : 0.0;
+
+		if ((totalItems > 0) && (totalSeconds > 0.0)) {
+			result.itemsPerSecond = totalItems / totalSeconds;
+		}
+
+		return result;
+	}
+
+}
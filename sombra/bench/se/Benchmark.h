@@ -0,0 +1,221 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <map>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <functional>
+
+namespace se::bench {
+
+	/**
+	 * Class State, it's used by the benchmark functions for controlling the
+	 * number of iterations to run and the measured time
+	 */
+	class State
+	{
+	private:	// Nested types
+		using Clock = std::chrono::steady_clock;
+
+	private:	// Attributes
+		/** The number of iterations that the benchmark must run */
+		std::size_t mMaxIterations;
+
+		/** The number of iterations already started */
+		std::size_t mIterations;
+
+		/** If the timer is running or not */
+		bool mRunning;
+
+		/** The time point where the timer was started */
+		Clock::time_point mStart;
+
+		/** The time measured */
+		std::chrono::nanoseconds mElapsed;
+
+		/** The number of items processed by the benchmark in all its
+		 * iterations, it's used for calculating the throughput */
+		std::size_t mItemsProcessed;
+
+		/** The user counters of the benchmark */
+		std::map<std::string, double> mCounters;
+
+	public:		// Functions
+		/** Creates a new State
+		 *
+		 * @param	maxIterations the number of iterations to run */
+		State(std::size_t maxIterations) :
+			mMaxIterations(maxIterations), mIterations(0), mRunning(false),
+			mElapsed(0), mItemsProcessed(0) {};
+
+		/** Checks if the benchmark must run another iteration. The timer is
+		 * started with the first call and stopped with the last one, so the
+		 * code outside the loop isn't measured
+		 *
+		 * @return	true if there are iterations left, false otherwise */
+		bool keepRunning()
+		{
+			if (mIterations == 0) {
+				resumeTiming();
+			}
+
+			if (mIterations < mMaxIterations) {
+				++mIterations;
+				return true;
+			}
+
+			pauseTiming();
+			return false;
+		};
+
+		/** Stops the timer, it's used for excluding the setup code inside the
+		 * benchmark loop from the measurements */
+		void pauseTiming()
+		{
+			if (mRunning) {
+				mElapsed += Clock::now() - mStart;
+				mRunning = false;
+			}
+		};
+
+		/** Resumes the timer stopped with @see pauseTiming */
+		void resumeTiming()
+		{
+			if (!mRunning) {
+				mStart = Clock::now();
+				mRunning = true;
+			}
+		};
+
+		/** @return	the number of iterations that the benchmark must run */
+		std::size_t getMaxIterations() const { return mMaxIterations; };
+
+		/** @return	the time measured */
+		std::chrono::nanoseconds getElapsed() const { return mElapsed; };
+
+		/** Sets the number of items processed in all the iterations
+		 *
+		 * @param	itemsProcessed the number of items processed */
+		void setItemsProcessed(std::size_t itemsProcessed)
+		{ mItemsProcessed = itemsProcessed; };
+
+		/** @return	the number of items processed in all the iterations */
+		std::size_t getItemsProcessed() const { return mItemsProcessed; };
+
+		/** Sets the value of an user counter
+		 *
+		 * @param	name the name of the counter
+		 * @param	value the new value of the counter */
+		void setCounter(const std::string& name, double value)
+		{ mCounters[name] = value; };
+
+		/** @return	the user counters of the benchmark */
+		const std::map<std::string, double>& getCounters() const
+		{ return mCounters; };
+	};
+
+
+	/** The function signature of all the benchmarks */
+	using BenchmarkFunction = std::function<void(State&)>;
+
+
+	/**
+	 * Struct Benchmark, it holds a benchmark that can be run by the
+	 * BenchmarkRunner
+	 */
+	struct Benchmark
+	{
+		/** The name of the Benchmark */
+		std::string name;
+
+		/** The function to measure */
+		BenchmarkFunction function;
+	};
+
+
+	/**
+	 * Struct BenchmarkResult, holds the measurements of a Benchmark
+	 */
+	struct BenchmarkResult
+	{
+		/** The name of the Benchmark */
+		std::string name;
+
+		/** The number of iterations of each repetition */
+		std::size_t iterations = 0;
+
+		/** The number of times that the Benchmark was run */
+		std::size_t repetitions = 0;
+
+		/** The statistics of the nanoseconds elapsed per iteration */
+		double meanNs = 0.0, medianNs = 0.0, minNs = 0.0, stddevNs = 0.0;
+
+		/** The number of items processed per second, 0 if the Benchmark
+		 * didn't report its items */
+		double itemsPerSecond = 0.0;
+
+		/** The user counters of the last repetition */
+		std::map<std::string, double> counters;
+	};
+
+
+	/**
+	 * Class BenchmarkRunner, it holds all the registered Benchmarks and is
+	 * used for running them
+	 */
+	class BenchmarkRunner
+	{
+	private:	// Attributes
+		/** The registered Benchmarks */
+		std::vector<Benchmark> mBenchmarks;
+
+	public:		// Functions
+		/** @return	the only instance of the BenchmarkRunner */
+		static BenchmarkRunner& getInstance();
+
+		/** Registers the given Benchmark
+		 *
+		 * @param	name the name of the Benchmark
+		 * @param	function the function to measure
+		 * @return	true, it's used for registering the Benchmarks on static
+		 *			initialization */
+		bool add(const char* name, const BenchmarkFunction& function);
+
+		/** @return	the registered Benchmarks */
+		const std::vector<Benchmark>& getBenchmarks() const
+		{ return mBenchmarks; };
+
+		/** Runs the given Benchmark. The number of iterations is increased
+		 * until a single run lasts at least the given minimum time, then the
+		 * Benchmark is run the given number of repetitions with that number
+		 * of iterations
+		 *
+		 * @param	benchmark the Benchmark to run
+		 * @param	minTime the minimum time in seconds of each repetition
+		 * @param	repetitions the number of repetitions
+		 * @return	the measurements of the Benchmark */
+		static BenchmarkResult run(
+			const Benchmark& benchmark,
+			double minTime, std::size_t repetitions
+		);
+	private:
+		/** Creates a new BenchmarkRunner */
+		BenchmarkRunner() = default;
+	};
+
+}
+
+
+#define SOMBRA_BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define SOMBRA_BENCHMARK_CONCAT(a, b) SOMBRA_BENCHMARK_CONCAT_IMPL(a, b)
+
+/** Defines and registers a new benchmark function with the given name. The
+ * function body must follow the macro and receives a State named state */
+#define SOMBRA_BENCHMARK(name)												\
+	static void name(se::bench::State& state);								\
+	static const bool SOMBRA_BENCHMARK_CONCAT(sRegistered, name) =			\
+		se::bench::BenchmarkRunner::getInstance().add(#name, name);			\
+	static void name(se::bench::State& state)
+
+#endif		// BENCHMARK_H
@@ -0,0 +1,84 @@
+#include <random>
+#include <se/animation/AnimationEngine.h>
+#include <se/animation/LinearAnimations.h>
+#include <se/animation/TransformationAnimator.h>
+#include "se/Benchmark.h"
+
+using namespace se::animation;
+static constexpr float kDeltaTime = 1.0f / 60.0f;
+static constexpr std::size_t kNumKeyFrames = 16;
+
+
+/** Measures the update of a set of skeletons, each one with a chain of
+ * bones animated with a translation and a rotation animation */
+SOMBRA_BENCHMARK(AnimationEngine_skeletons)
+{
+	static constexpr std::size_t kNumSkeletons = 64;
+	static constexpr std::size_t kNumBones = 32;
+
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+	std::vector<std::unique_ptr<AnimationNode>> skeletons;
+	std::vector<std::unique_ptr<IAnimator>> animators;
+	AnimationEngine animationEngine;
+
+	for (std::size_t i = 0; i < kNumSkeletons; ++i) {
+		auto& root = skeletons.emplace_back(std::make_unique<AnimationNode>());
+		auto parentIt = root->cend();
+		for (std::size_t j = 0; j < kNumBones; ++j) {
+			auto nodeIt = root->emplace(parentIt);
+			nodeIt->getData().localTransforms.position = glm::vec3(0.0f, 1.0f, 0.0f);
+
+			auto translations = std::make_shared<AnimationVec3Linear>();
+			auto rotations = std::make_shared<AnimationQuatLinear>();
+			for (std::size_t k = 0; k < kNumKeyFrames; ++k) {
+				float time = static_cast<float>(k) / 4.0f;
+				translations->addKeyFrame({ { dist(generator), dist(generator), dist(generator) }, time });
+				rotations->addKeyFrame({ glm::normalize(glm::quat(dist(generator), dist(generator), dist(generator), dist(generator))), time });
+			}
+
+			auto translationAnimator = std::make_unique<Vec3Animator>(translations);
+			translationAnimator->addNode(TransformationAnimator::TransformationType::Translation, *nodeIt);
+			auto rotationAnimator = std::make_unique<QuatAnimator>(rotations);
+			rotationAnimator->addNode(TransformationAnimator::TransformationType::Rotation, *nodeIt);
+
+			animationEngine.addAnimator(animators.emplace_back(std::move(translationAnimator)).get());
+			animationEngine.addAnimator(animators.emplace_back(std::move(rotationAnimator)).get());
+
+			parentIt = nodeIt;
+		}
+	}
+
+	while (state.keepRunning()) {
+		animationEngine.update(kDeltaTime);
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumSkeletons * kNumBones);
+	state.setCounter("animators", static_cast<double>(animators.size()));
+}
+
+
+/** Measures the interpolation of the keyframes of a single animation */
+SOMBRA_BENCHMARK(AnimationEngine_interpolateVec3Linear)
+{
+	static constexpr std::size_t kNumSamples = 1024;
+
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+	AnimationVec3Linear animation;
+	for (std::size_t k = 0; k < kNumKeyFrames; ++k) {
+		animation.addKeyFrame({ { dist(generator), dist(generator), dist(generator) }, static_cast<float>(k) });
+	}
+
+	glm::vec3 sum(0.0f);
+	while (state.keepRunning()) {
+		for (std::size_t i = 0; i < kNumSamples; ++i) {
+			sum += animation.interpolate(kNumKeyFrames * static_cast<float>(i) / kNumSamples);
+		}
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumSamples);
+	state.setCounter("checksum", sum.x + sum.y + sum.z);
+}
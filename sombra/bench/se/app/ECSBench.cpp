@@ -0,0 +1,110 @@
+#include <se/app/ECS.h>
+#include "se/Benchmark.h"
+
+using namespace se::app;
+static constexpr std::size_t kNumEntities = 10000;
+
+struct Position { float x = 0.0f, y = 0.0f, z = 0.0f; };
+struct Velocity { float x = 1.0f, y = 2.0f, z = 3.0f; };
+struct Health { int value = 100; };
+
+
+static void populate(EntityDatabase& db, std::size_t numEntities)
+{
+	db.executeQuery([&](EntityDatabase::Query& query) {
+		for (std::size_t i = 0; i < numEntities; ++i) {
+			Entity entity = query.addEntity();
+			query.emplaceComponent<Position>(entity);
+			query.emplaceComponent<Velocity>(entity);
+			if (i % 2 == 0) {
+				query.emplaceComponent<Health>(entity);
+			}
+		}
+	});
+}
+
+
+static void createDatabase(std::unique_ptr<EntityDatabase>& db)
+{
+	db = std::make_unique<EntityDatabase>(kNumEntities);
+	db->addComponentTable<Position>(kNumEntities);
+	db->addComponentTable<Velocity>(kNumEntities);
+	db->addComponentTable<Health>(kNumEntities);
+}
+
+
+SOMBRA_BENCHMARK(EntityDatabase_createEntities)
+{
+	std::unique_ptr<EntityDatabase> db;
+	while (state.keepRunning()) {
+		state.pauseTiming();
+		createDatabase(db);
+		state.resumeTiming();
+
+		populate(*db, kNumEntities);
+
+		state.pauseTiming();
+		db = nullptr;
+		state.resumeTiming();
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumEntities);
+}
+
+
+SOMBRA_BENCHMARK(EntityDatabase_iterateEntityComponents)
+{
+	std::unique_ptr<EntityDatabase> db;
+	createDatabase(db);
+	populate(*db, kNumEntities);
+
+	while (state.keepRunning()) {
+		db->executeQuery([&](EntityDatabase::Query& query) {
+			query.iterateEntityComponents<Position, Velocity>([](Entity, Position* p, Velocity* v) {
+				p->x += 0.016f * v->x;
+				p->y += 0.016f * v->y;
+				p->z += 0.016f * v->z;
+			});
+		});
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumEntities);
+}
+
+
+SOMBRA_BENCHMARK(EntityDatabase_iterateComponents)
+{
+	std::unique_ptr<EntityDatabase> db;
+	createDatabase(db);
+	populate(*db, kNumEntities);
+
+	while (state.keepRunning()) {
+		db->executeQuery([&](EntityDatabase::Query& query) {
+			query.iterateComponents<Health>([](Health& health) { --health.value; });
+		});
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumEntities / 2);
+}
+
+
+SOMBRA_BENCHMARK(EntityDatabase_removeEntities)
+{
+	std::unique_ptr<EntityDatabase> db;
+	while (state.keepRunning()) {
+		state.pauseTiming();
+		createDatabase(db);
+		populate(*db, kNumEntities);
+		state.resumeTiming();
+
+		db->executeQuery([&](EntityDatabase::Query& query) {
+			query.clearEntities();
+		});
+
+		state.pauseTiming();
+		db = nullptr;
+		state.resumeTiming();
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumEntities);
+}
@@ -0,0 +1,61 @@
+#include <cstdio>
+#include <memory>
+#include <se/app/Application.h>
+#include <se/app/io/SceneGenerator.h>
+#include <se/app/io/SceneSerializer.h>
+#include "se/Benchmark.h"
+
+using namespace se::app;
+static constexpr std::size_t kNumEntities = 1000;
+static constexpr unsigned int kSeed = 42;
+static constexpr char kScenePath[] = "SceneSerializerBench.json";
+
+
+static void removeSceneFiles()
+{
+	std::remove(kScenePath);
+	std::remove((std::string(kScenePath) + ".dat").c_str());
+}
+
+
+/** Measures the serialization of a generated Scene without graphics data */
+SOMBRA_BENCHMARK(SceneSerializer_serialize)
+{
+	Application application({}, 0.016f, HeadlessConfig{ 2 * kNumEntities });
+	Scene scene("serialize", application);
+	SceneGenerator::generate(SceneGenerator::createConfig(kNumEntities, kSeed), scene);
+
+	while (state.keepRunning()) {
+		SceneSerializer::serialize(kScenePath, scene);
+	}
+	removeSceneFiles();
+
+	state.setItemsProcessed(state.getMaxIterations() * scene.entities.size());
+}
+
+
+/** Measures the deserialization of a generated Scene without graphics data */
+SOMBRA_BENCHMARK(SceneSerializer_deserialize)
+{
+	Application application({}, 0.016f, HeadlessConfig{ 2 * kNumEntities });
+	{
+		Scene scene("generated", application);
+		SceneGenerator::generate(SceneGenerator::createConfig(kNumEntities, kSeed), scene);
+		SceneSerializer::serialize(kScenePath, scene);
+	}
+
+	std::size_t numEntities = 0;
+	while (state.keepRunning()) {
+		auto scene = std::make_unique<Scene>("deserialize", application);
+		SceneSerializer::deserialize(kScenePath, *scene);
+
+		// The Entities are removed when the Scene is destroyed
+		state.pauseTiming();
+		numEntities = scene->entities.size();
+		scene.reset();
+		state.resumeTiming();
+	}
+	removeSceneFiles();
+
+	state.setItemsProcessed(state.getMaxIterations() * numEntities);
+}
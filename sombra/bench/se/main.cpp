@@ -0,0 +1,104 @@
+#include <cstdio>
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include "Benchmark.h"
+
+using namespace se::bench;
+
+static void printUsage(const char* program)
+{
+	std::cout << "Usage: " << program << " [options]\n"
+		<< "Options:\n"
+		<< "  --filter <text>       only run the benchmarks whose name contains the text\n"
+		<< "  --out <file>          write the results as JSON to the given file\n"
+		<< "  --min-time <seconds>  minimum time of each repetition (default 0.1)\n"
+		<< "  --repetitions <n>     number of repetitions of each benchmark (default 5)\n"
+		<< "  --list                list the benchmarks without running them\n";
+}
+
+
+int main(int argc, char** argv)
+{
+	std::string filter, outPath;
+	double minTime = 0.1;
+	std::size_t repetitions = 5;
+	bool list = false;
+
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		bool hasValue = (i + 1 < argc);
+		if ((arg == "--filter") && hasValue) {
+			filter = argv[++i];
+		}
+		else if ((arg == "--out") && hasValue) {
+			outPath = argv[++i];
+		}
+		else if ((arg == "--min-time") && hasValue) {
+			minTime = std::stod(argv[++i]);
+		}
+		else if ((arg == "--repetitions") && hasValue) {
+			repetitions = std::stoul(argv[++i]);
+		}
+		else if (arg == "--list") {
+			list = true;
+		}
+		else {
+			printUsage(argv[0]);
+			return (arg == "--help")? 0 : 1;
+		}
+	}
+
+	nlohmann::json jsonBenchmarks = nlohmann::json::array();
+	if (!list) {
+		std::printf("%-48s %14s %14s %14s %12s\n", "Benchmark", "Median (ns)", "Min (ns)", "Stddev (ns)", "Iterations");
+	}
+
+	for (const Benchmark& benchmark : BenchmarkRunner::getInstance().getBenchmarks()) {
+		if (benchmark.name.find(filter) == std::string::npos) {
+			continue;
+		}
+		if (list) {
+			std::cout << benchmark.name << std::endl;
+			continue;
+		}
+
+		BenchmarkResult result = BenchmarkRunner::run(benchmark, minTime, repetitions);
+		std::printf(
+			"%-48s %14.1f %14.1f %14.1f %12zu\n", result.name.c_str(),
+			result.medianNs, result.minNs, result.stddevNs, result.iterations
+		);
+
+		nlohmann::json jsonResult = {
+			{ "name", result.name },
+			{ "iterations", result.iterations },
+			{ "repetitions", result.repetitions },
+			{ "mean_ns", result.meanNs },
+			{ "median_ns", result.medianNs },
+			{ "min_ns", result.minNs },
+			{ "stddev_ns", result.stddevNs },
+			{ "counters", result.counters }
+		};
+		if (result.itemsPerSecond > 0.0) {
+			jsonResult["items_per_second"] = result.itemsPerSecond;
+		}
+		jsonBenchmarks.push_back(jsonResult);
+	}
+
+	if (!outPath.empty()) {
+		std::ofstream outFile(outPath);
+		if (!outFile.good()) {
+			std::cerr << "Can't open the output file " << outPath << std::endl;
+			return 1;
+		}
+
+		nlohmann::json jsonOutput = {
+			{ "min_time", minTime },
+			{ "benchmarks", jsonBenchmarks }
+		};
+		outFile << jsonOutput.dump(4) << std::endl;
+	}
+
+	return 0;
+}
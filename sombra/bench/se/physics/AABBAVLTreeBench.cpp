@@ -0,0 +1,116 @@
+#include <random>
+#include "se/physics/collision/AABBAVLTree.h"
+#include "se/Benchmark.h"
+
+using namespace se::physics;
+static constexpr std::size_t kNumAABBs = 4096;
+static constexpr float kWorldSize = 200.0f;
+static constexpr float kEpsilon = 0.0001f;
+
+
+static std::vector<AABB> createAABBs(std::size_t numAABBs)
+{
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> positionDist(-0.5f * kWorldSize, 0.5f * kWorldSize);
+	std::uniform_real_distribution<float> sizeDist(0.25f, 2.0f);
+
+	std::vector<AABB> ret(numAABBs);
+	for (AABB& aabb : ret) {
+		glm::vec3 position(positionDist(generator), positionDist(generator), positionDist(generator));
+		glm::vec3 halfSize(sizeDist(generator), sizeDist(generator), sizeDist(generator));
+		aabb = { position - halfSize, position + halfSize };
+	}
+
+	return ret;
+}
+
+
+SOMBRA_BENCHMARK(AABBAVLTree_build)
+{
+	std::vector<AABB> aabbs = createAABBs(kNumAABBs);
+
+	while (state.keepRunning()) {
+		AABBAVLTree<std::size_t> tree;
+		for (std::size_t i = 0; i < aabbs.size(); ++i) {
+			tree.addNode(aabbs[i], i);
+		}
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumAABBs);
+}
+
+
+SOMBRA_BENCHMARK(AABBAVLTree_removeAddNodes)
+{
+	std::vector<AABB> aabbs = createAABBs(kNumAABBs);
+	std::vector<std::size_t> nodeIds;
+
+	AABBAVLTree<std::size_t> tree;
+	for (std::size_t i = 0; i < aabbs.size(); ++i) {
+		nodeIds.push_back(tree.addNode(aabbs[i], i));
+	}
+
+	// Move every AABB a little bit as the CoarseCollisionDetector does
+	const glm::vec3 displacement(0.1f);
+	while (state.keepRunning()) {
+		for (std::size_t i = 0; i < aabbs.size(); ++i) {
+			aabbs[i].minimum += displacement;
+			aabbs[i].maximum += displacement;
+			tree.removeNode(nodeIds[i]);
+			nodeIds[i] = tree.addNode(aabbs[i], i);
+		}
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumAABBs);
+}
+
+
+SOMBRA_BENCHMARK(AABBAVLTree_calculateAllOverlaps)
+{
+	std::vector<AABB> aabbs = createAABBs(kNumAABBs);
+
+	AABBAVLTree<std::size_t> tree;
+	for (std::size_t i = 0; i < aabbs.size(); ++i) {
+		tree.addNode(aabbs[i], i);
+	}
+
+	std::size_t numOverlaps = 0;
+	while (state.keepRunning()) {
+		numOverlaps = 0;
+		tree.calculateAllOverlaps(kEpsilon, [&](std::size_t, std::size_t) { ++numOverlaps; });
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumAABBs);
+	state.setCounter("overlaps", static_cast<double>(numOverlaps));
+}
+
+
+SOMBRA_BENCHMARK(AABBAVLTree_calculateIntersectionsWith)
+{
+	static constexpr std::size_t kNumRays = 256;
+	std::vector<AABB> aabbs = createAABBs(kNumAABBs);
+
+	AABBAVLTree<std::size_t> tree;
+	for (std::size_t i = 0; i < aabbs.size(); ++i) {
+		tree.addNode(aabbs[i], i);
+	}
+
+	std::mt19937 generator(7);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::vector<Ray> rays;
+	for (std::size_t i = 0; i < kNumRays; ++i) {
+		glm::vec3 direction(dist(generator), dist(generator), dist(generator));
+		rays.emplace_back(glm::vec3(0.0f), glm::normalize(direction + glm::vec3(0.001f)));
+	}
+
+	std::size_t numHits = 0;
+	while (state.keepRunning()) {
+		numHits = 0;
+		for (const Ray& ray : rays) {
+			tree.calculateIntersectionsWith(ray, kEpsilon, [&](std::size_t) { ++numHits; });
+		}
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumRays);
+	state.setCounter("hits", static_cast<double>(numHits));
+}
@@ -0,0 +1,134 @@
+#include <cmath>
+#include <random>
+#include <glm/gtc/matrix_transform.hpp>
+#include <se/physics/collision/BoundingSphere.h>
+#include <se/physics/collision/CoarseCollisionDetector.h>
+#include <se/utils/ThreadPool.h>
+#include "se/Benchmark.h"
+
+using namespace se::physics;
+static constexpr std::size_t kNumBodies = 10000;
+static constexpr float kWorldSize = 200.0f;
+static constexpr float kEpsilon = 0.0001f;
+static constexpr float kDeltaTime = 1.0f / 60.0f;
+
+
+/** Moves the first numMovingBodies of kNumBodies spheres bouncing inside the
+ * world bounds and measures the update of the CoarseCollisionDetector and
+ * its pair cache */
+static void moveBodies(
+	se::bench::State& state, float aabbMargin, float displacementMultiplier, std::size_t rebuildInterval,
+	std::size_t numMovingBodies = kNumBodies, std::size_t numThreads = 1
+) {
+	se::utils::ThreadPool threadPool(numThreads);
+
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> positionDist(-0.5f * kWorldSize, 0.5f * kWorldSize);
+	std::uniform_real_distribution<float> velocityDist(-5.0f, 5.0f);
+
+	CoarseCollisionDetector ccd(kEpsilon, aabbMargin, displacementMultiplier, rebuildInterval);
+	std::vector<std::unique_ptr<BoundingSphere>> spheres;
+	std::vector<glm::vec3> positions, velocities;
+	spheres.reserve(kNumBodies);
+	for (std::size_t i = 0; i < kNumBodies; ++i) {
+		positions.emplace_back(positionDist(generator), positionDist(generator), positionDist(generator));
+		velocities.emplace_back(velocityDist(generator), velocityDist(generator), velocityDist(generator));
+
+		auto& sphere = spheres.emplace_back(std::make_unique<BoundingSphere>(0.5f));
+		sphere->setTransforms(glm::translate(glm::mat4(1.0f), positions.back()));
+		ccd.add(sphere.get());
+	}
+
+	std::size_t numPairs = 0;
+	while (state.keepRunning()) {
+		state.pauseTiming();
+		for (std::size_t i = 0; i < numMovingBodies; ++i) {
+			positions[i] += kDeltaTime * velocities[i];
+			for (int j = 0; j < 3; ++j) {
+				if (std::abs(positions[i][j]) > 0.5f * kWorldSize) {
+					velocities[i][j] = -velocities[i][j];
+				}
+			}
+			spheres[i]->setTransforms(glm::translate(glm::mat4(1.0f), positions[i]));
+		}
+		state.resumeTiming();
+
+		ccd.update(&threadPool, numThreads);
+
+		numPairs = 0;
+		for (const auto& pair : ccd.getPairs()) {
+			if (pair.state != CoarseCollisionDetector::PairState::End) {
+				++numPairs;
+			}
+		}
+
+		state.pauseTiming();
+		for (auto& sphere : spheres) {
+			sphere->resetUpdatedState();
+		}
+		state.resumeTiming();
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumBodies);
+	state.setCounter("pairs", static_cast<double>(numPairs));
+}
+
+
+/** Without margins every moving Collider is reinserted in every update */
+SOMBRA_BENCHMARK(CoarseCollisionDetector_moveTightAABBs)
+{
+	moveBodies(state, 0.0f, 0.0f, 0);
+}
+
+
+SOMBRA_BENCHMARK(CoarseCollisionDetector_moveFatAABBs)
+{
+	moveBodies(state, 0.1f, 2.0f, 0);
+}
+
+
+SOMBRA_BENCHMARK(CoarseCollisionDetector_moveFatAABBsRebuild)
+{
+	moveBodies(state, 0.1f, 2.0f, 60);
+}
+
+
+SOMBRA_BENCHMARK(CoarseCollisionDetector_moveFatAABBsParallel)
+{
+	moveBodies(state, 0.1f, 2.0f, 0, kNumBodies, 8);
+}
+
+
+/** Only 1% of the bodies move, so most of the pairs persist */
+SOMBRA_BENCHMARK(CoarseCollisionDetector_moveFewBodies)
+{
+	moveBodies(state, 0.1f, 2.0f, 0, kNumBodies / 100);
+}
+
+
+/** Measures the full AABB Tree traversal that the pair cache replaces */
+SOMBRA_BENCHMARK(CoarseCollisionDetector_calculateCollisions)
+{
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> positionDist(-0.5f * kWorldSize, 0.5f * kWorldSize);
+
+	CoarseCollisionDetector ccd(kEpsilon);
+	std::vector<std::unique_ptr<BoundingSphere>> spheres;
+	spheres.reserve(kNumBodies);
+	for (std::size_t i = 0; i < kNumBodies; ++i) {
+		glm::vec3 position(positionDist(generator), positionDist(generator), positionDist(generator));
+		auto& sphere = spheres.emplace_back(std::make_unique<BoundingSphere>(0.5f));
+		sphere->setTransforms(glm::translate(glm::mat4(1.0f), position));
+		ccd.add(sphere.get());
+	}
+	ccd.update();
+
+	std::size_t numPairs = 0;
+	while (state.keepRunning()) {
+		numPairs = 0;
+		ccd.calculateCollisions([&](Collider*, Collider*) { ++numPairs; });
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumBodies);
+	state.setCounter("pairs", static_cast<double>(numPairs));
+}
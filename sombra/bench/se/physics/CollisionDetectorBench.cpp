@@ -0,0 +1,145 @@
+#include <random>
+#include <se/physics/RigidBody.h>
+#include <se/physics/RigidBodyWorld.h>
+#include <se/physics/collision/BoundingSphere.h>
+#include "se/Benchmark.h"
+
+using namespace se::physics;
+static constexpr std::size_t kNumBodies = 2000;
+static constexpr std::size_t kNumRays = 256;
+static constexpr float kWorldSize = 200.0f;
+
+
+/** Holds a RigidBodyWorld with kNumBodies static spheres and kNumRays rays
+ * cast from the center of the world */
+struct RayCastScene
+{
+	RigidBodyWorld world;
+	std::vector<std::unique_ptr<RigidBody>> rigidBodies;
+	std::vector<Ray> rays;
+
+	RayCastScene(std::size_t numThreads) : world(createProperties(numThreads))
+	{
+		std::mt19937 generator(42);
+		std::uniform_real_distribution<float> positionDist(-0.5f * kWorldSize, 0.5f * kWorldSize);
+		std::uniform_real_distribution<float> directionDist(-1.0f, 1.0f);
+
+		for (std::size_t i = 0; i < kNumBodies; ++i) {
+			RigidBodyState state;
+			state.position = glm::vec3(positionDist(generator), positionDist(generator), positionDist(generator));
+
+			rigidBodies.push_back(std::make_unique<RigidBody>(
+				RigidBodyProperties(), state, std::make_unique<BoundingSphere>(2.0f)
+			));
+			world.addRigidBody(rigidBodies.back().get());
+		}
+		world.update(0.016f);
+
+		for (std::size_t i = 0; i < kNumRays; ++i) {
+			glm::vec3 direction(directionDist(generator), directionDist(generator), directionDist(generator));
+			rays.emplace_back(glm::vec3(0.0f), glm::normalize(direction + glm::vec3(0.001f)));
+		}
+	};
+
+	static WorldProperties createProperties(std::size_t numThreads)
+	{
+		WorldProperties properties;
+		properties.numThreads = numThreads;
+		return properties;
+	};
+};
+
+
+SOMBRA_BENCHMARK(CollisionDetector_rayCastFirst)
+{
+	RayCastScene scene(1);
+
+	std::size_t numHits = 0;
+	while (state.keepRunning()) {
+		numHits = 0;
+		for (const Ray& ray : scene.rays) {
+			numHits += scene.world.getCollisionDetector().rayCastFirst(ray).first? 1 : 0;
+		}
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumRays);
+	state.setCounter("hits", static_cast<double>(numHits));
+}
+
+
+static void rayCastBatch(se::bench::State& state, std::size_t numThreads)
+{
+	RayCastScene scene(numThreads);
+	std::vector<CollisionDetector::RayCastResult> results(kNumRays);
+
+	std::size_t numHits = 0;
+	while (state.keepRunning()) {
+		scene.world.getCollisionDetector().rayCastBatch(scene.rays.data(), scene.rays.size(), results.data());
+
+		numHits = 0;
+		for (const auto& result : results) {
+			numHits += result.first? 1 : 0;
+		}
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumRays);
+	state.setCounter("hits", static_cast<double>(numHits));
+}
+
+
+SOMBRA_BENCHMARK(CollisionDetector_rayCastBatch1Thread)
+{
+	rayCastBatch(state, 1);
+}
+
+
+SOMBRA_BENCHMARK(CollisionDetector_rayCastBatch4Threads)
+{
+	rayCastBatch(state, 4);
+}
+
+
+SOMBRA_BENCHMARK(CollisionDetector_shapeCastBatch)
+{
+	RayCastScene scene(1);
+
+	BoundingSphere sphere(0.5f);
+	std::vector<CollisionDetector::ShapeCast> shapeCasts;
+	for (const Ray& ray : scene.rays) {
+		shapeCasts.push_back({ &sphere, ray.direction });
+	}
+	std::vector<CollisionDetector::RayCastResult> results(kNumRays);
+
+	std::size_t numHits = 0;
+	while (state.keepRunning()) {
+		scene.world.getCollisionDetector().shapeCastBatch(shapeCasts.data(), shapeCasts.size(), results.data());
+
+		numHits = 0;
+		for (const auto& result : results) {
+			numHits += result.first? 1 : 0;
+		}
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumRays);
+	state.setCounter("hits", static_cast<double>(numHits));
+}
+
+
+SOMBRA_BENCHMARK(CollisionDetector_overlapSphere)
+{
+	RayCastScene scene(1);
+	std::vector<Collider*> results(kNumBodies);
+
+	std::size_t numOverlaps = 0;
+	while (state.keepRunning()) {
+		numOverlaps = 0;
+		for (const Ray& ray : scene.rays) {
+			numOverlaps += scene.world.getCollisionDetector().overlapSphere(
+				0.25f * kWorldSize * ray.direction, 10.0f, results.data(), results.size()
+			);
+		}
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumRays);
+	state.setCounter("overlaps", static_cast<double>(numOverlaps));
+}
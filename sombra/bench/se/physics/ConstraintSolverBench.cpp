@@ -0,0 +1,207 @@
+#include <se/physics/RigidBody.h>
+#include <se/physics/RigidBodyWorld.h>
+#include <se/physics/forces/DirectionalForce.h>
+#include <se/physics/collision/BoundingBox.h>
+#include <se/physics/constraints/DistanceConstraint.h>
+#include "se/Benchmark.h"
+
+using namespace se::physics;
+static constexpr float kDeltaTime = 1.0f / 60.0f;
+static constexpr float kGravity = 9.8f;
+static constexpr std::size_t kNumWarmUpSteps = 30;
+
+
+static RigidBodyProperties createBoxProperties(float mass, const glm::vec3& lengths)
+{
+	glm::vec3 l2 = lengths * lengths;
+	glm::mat3 inertiaTensor(0.0f);
+	inertiaTensor[0][0] = mass * (l2.y + l2.z) / 12.0f;
+	inertiaTensor[1][1] = mass * (l2.x + l2.z) / 12.0f;
+	inertiaTensor[2][2] = mass * (l2.x + l2.y) / 12.0f;
+
+	RigidBodyProperties properties(mass, inertiaTensor);
+	properties.frictionCoefficient = 0.5f;
+	properties.sleepMotion = 0.0f;
+	return properties;
+}
+
+
+/** Measures the updates of a scene with stacks of boxes, most of the time
+ * is spent in the collision detection and the resolution of the contact
+ * constraints */
+SOMBRA_BENCHMARK(ConstraintSolver_boxStacks)
+{
+	static constexpr std::size_t kStacksPerSide = 4;
+	static constexpr std::size_t kStackHeight = 8;
+	const glm::vec3 boxLengths(1.0f);
+	const float boxMass = 1.0f;
+
+	auto gravity = std::make_shared<DirectionalForce>(glm::vec3(0.0f, -kGravity * boxMass, 0.0f));
+
+	RigidBodyState groundState;
+	groundState.position = glm::vec3(0.0f, -0.5f, 0.0f);
+	RigidBody ground(RigidBodyProperties(), groundState, std::make_unique<BoundingBox>(glm::vec3(100.0f, 1.0f, 100.0f)));
+
+	std::vector<RigidBody> boxes;
+	boxes.reserve(kStacksPerSide * kStacksPerSide * kStackHeight);
+	for (std::size_t x = 0; x < kStacksPerSide; ++x) {
+		for (std::size_t z = 0; z < kStacksPerSide; ++z) {
+			for (std::size_t y = 0; y < kStackHeight; ++y) {
+				RigidBodyState boxState;
+				boxState.position = glm::vec3(3.0f * x, 0.5f + 1.01f * y, 3.0f * z);
+				auto& box = boxes.emplace_back(createBoxProperties(boxMass, boxLengths), boxState, std::make_unique<BoundingBox>(boxLengths));
+				box.addForce(gravity);
+			}
+		}
+	}
+
+	WorldProperties worldProperties;
+	worldProperties.maxCollidingRBs = 4 * boxes.size();
+	worldProperties.maxConstraintIterations = 10;
+	RigidBodyWorld world(worldProperties);
+	world.addRigidBody(&ground);
+	for (RigidBody& box : boxes) {
+		world.addRigidBody(&box);
+	}
+
+	for (std::size_t i = 0; i < kNumWarmUpSteps; ++i) {
+		world.update(kDeltaTime);
+	}
+
+	while (state.keepRunning()) {
+		world.update(kDeltaTime);
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * boxes.size());
+	state.setCounter("bodies", static_cast<double>(boxes.size()));
+}
+
+
+/** Measures the resolution of the DistanceConstraints of a set of chains
+ * of RigidBodies without Colliders */
+SOMBRA_BENCHMARK(ConstraintSolver_distanceChains)
+{
+	static constexpr std::size_t kNumChains = 16;
+	static constexpr std::size_t kChainLength = 32;
+	const float linkMass = 1.0f;
+
+	auto gravity = std::make_shared<DirectionalForce>(glm::vec3(0.0f, -kGravity * linkMass, 0.0f));
+
+	std::vector<RigidBody> links;
+	std::vector<DistanceConstraint> constraints;
+	links.reserve(kNumChains * kChainLength);
+	constraints.reserve(kNumChains * (kChainLength - 1));
+
+	for (std::size_t i = 0; i < kNumChains; ++i) {
+		RigidBodyState anchorState;
+		anchorState.position = glm::vec3(2.0f * i, 0.0f, 0.0f);
+		links.emplace_back(RigidBodyProperties(), anchorState);
+
+		for (std::size_t j = 1; j < kChainLength; ++j) {
+			RigidBodyState linkState;
+			linkState.position = glm::vec3(2.0f * i + 0.5f * j, -0.5f * j, 0.0f);
+			auto& link = links.emplace_back(createBoxProperties(linkMass, glm::vec3(0.5f)), linkState);
+			link.addForce(gravity);
+
+			constraints.emplace_back(std::array<RigidBody*, 2>{ &links[links.size() - 2], &link });
+		}
+	}
+
+	WorldProperties worldProperties;
+	worldProperties.maxConstraintIterations = 10;
+	RigidBodyWorld world(worldProperties);
+	for (RigidBody& link : links) {
+		world.addRigidBody(&link);
+	}
+	for (DistanceConstraint& constraint : constraints) {
+		world.getConstraintManager().addConstraint(&constraint);
+	}
+
+	for (std::size_t i = 0; i < kNumWarmUpSteps; ++i) {
+		world.update(kDeltaTime);
+	}
+
+	while (state.keepRunning()) {
+		world.update(kDeltaTime);
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * constraints.size());
+	state.setCounter("constraints", static_cast<double>(constraints.size()));
+}
+
+
+/** Measures the resolution of a single large ConstraintIsland made of a grid
+ * of RigidBodies linked by DistanceConstraints and hanging from static
+ * anchors */
+static void distanceGrid(se::bench::State& state, std::size_t minParallelSolverConstraints, std::size_t numThreads)
+{
+	static constexpr std::size_t kGridSize = 32;
+	const float nodeMass = 1.0f;
+
+	auto gravity = std::make_shared<DirectionalForce>(glm::vec3(0.0f, -kGravity * nodeMass, 0.0f));
+
+	std::vector<RigidBody> nodes;
+	std::vector<DistanceConstraint> constraints;
+	nodes.reserve(kGridSize * (kGridSize + 1));
+	constraints.reserve(2 * kGridSize * kGridSize);
+
+	for (std::size_t x = 0; x < kGridSize; ++x) {
+		RigidBodyState anchorState;
+		anchorState.position = glm::vec3(0.5f * x, 0.0f, 0.0f);
+		nodes.emplace_back(RigidBodyProperties(), anchorState);
+	}
+	for (std::size_t y = 1; y <= kGridSize; ++y) {
+		for (std::size_t x = 0; x < kGridSize; ++x) {
+			RigidBodyState nodeState;
+			nodeState.position = glm::vec3(0.5f * x, -0.5f * y, 0.0f);
+			auto& node = nodes.emplace_back(createBoxProperties(nodeMass, glm::vec3(0.25f)), nodeState);
+			node.addForce(gravity);
+
+			constraints.emplace_back(std::array<RigidBody*, 2>{ &nodes[nodes.size() - 1 - kGridSize], &node });
+			if (x > 0) {
+				constraints.emplace_back(std::array<RigidBody*, 2>{ &nodes[nodes.size() - 2], &node });
+			}
+		}
+	}
+
+	WorldProperties worldProperties;
+	worldProperties.maxConstraintIterations = 10;
+	worldProperties.minParallelSolverConstraints = minParallelSolverConstraints;
+	worldProperties.numThreads = numThreads;
+	RigidBodyWorld world(worldProperties);
+	for (RigidBody& node : nodes) {
+		world.addRigidBody(&node);
+	}
+	for (DistanceConstraint& constraint : constraints) {
+		world.getConstraintManager().addConstraint(&constraint);
+	}
+
+	for (std::size_t i = 0; i < kNumWarmUpSteps; ++i) {
+		world.update(kDeltaTime);
+	}
+
+	while (state.keepRunning()) {
+		world.update(kDeltaTime);
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * constraints.size());
+	state.setCounter("constraints", static_cast<double>(constraints.size()));
+}
+
+
+SOMBRA_BENCHMARK(ConstraintSolver_distanceGridSerial)
+{
+	distanceGrid(state, 0, 1);
+}
+
+
+SOMBRA_BENCHMARK(ConstraintSolver_distanceGridParallel1Thread)
+{
+	distanceGrid(state, 1, 1);
+}
+
+
+SOMBRA_BENCHMARK(ConstraintSolver_distanceGridParallel4Threads)
+{
+	distanceGrid(state, 1, 4);
+}
@@ -0,0 +1,140 @@
+#include <random>
+#include <vector>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <se/physics/collision/QuickHull.h>
+#include <se/physics/collision/HalfEdgeMeshExt.h>
+#include <se/physics/collision/ConvexPolyhedron.h>
+#include "se/Benchmark.h"
+
+using namespace se::physics;
+static constexpr std::size_t kNumDirections = 64;
+
+
+/** Creates a ConvexPolyhedron with the convex hull of random points in an
+ * ellipsoid surface, so all the points are vertices of the hull */
+static ConvexPolyhedron createHull(std::size_t numVertices)
+{
+	std::mt19937 generator(42);
+	std::normal_distribution<float> distribution;
+
+	HalfEdgeMesh points;
+	for (std::size_t i = 0; i < numVertices; ++i) {
+		glm::vec3 direction(distribution(generator), distribution(generator), distribution(generator));
+		addVertex(points, glm::vec3(2.0f, 1.0f, 0.5f) * glm::normalize(direction));
+	}
+
+	QuickHull qh(0.0001f);
+	qh.calculate(points);
+
+	ConvexPolyhedron ret(qh.getMesh());
+	ret.setTransforms(
+		glm::translate(glm::mat4(1.0f), glm::vec3(5.0f, -1.0f, -10.0f))
+		* glm::mat4_cast(glm::normalize(glm::quat(0.9f, 0.1f, 0.3f, 0.2f)))
+	);
+	return ret;
+}
+
+
+static std::vector<glm::vec3> createDirections()
+{
+	std::mt19937 generator(7);
+	std::normal_distribution<float> distribution;
+
+	std::vector<glm::vec3> ret;
+	for (std::size_t i = 0; i < kNumDirections; ++i) {
+		ret.push_back(glm::normalize(glm::vec3(distribution(generator), distribution(generator), distribution(generator))));
+	}
+	return ret;
+}
+
+
+/** Measures the hill climbing over the HalfEdgeMesh that the support
+ * function used before */
+static void furthestVertex(se::bench::State& state, std::size_t numVertices)
+{
+	HalfEdgeMesh mesh = createHull(numVertices).getLocalMesh();
+	std::vector<glm::vec3> directions = createDirections();
+
+	int iVertex = 0;
+	while (state.keepRunning()) {
+		for (const glm::vec3& direction : directions) {
+			iVertex += getFurthestVertexInDirection(mesh, direction);
+		}
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumDirections);
+	state.setCounter("vertices", static_cast<double>(mesh.vertices.size()));
+	state.setCounter("checksum", static_cast<double>(iVertex));
+}
+
+
+static void furthestPoint(se::bench::State& state, std::size_t numVertices)
+{
+	ConvexPolyhedron hull = createHull(numVertices);
+	std::vector<glm::vec3> directions = createDirections();
+
+	glm::vec3 pointWorld, pointLocal, sum(0.0f);
+	while (state.keepRunning()) {
+		for (const glm::vec3& direction : directions) {
+			hull.getFurthestPointInDirection(direction, pointWorld, pointLocal);
+			sum += pointWorld;
+		}
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumDirections);
+	state.setCounter("vertices", static_cast<double>(hull.getLocalMesh().vertices.size()));
+	state.setCounter("checksum", static_cast<double>(sum.x));
+}
+
+
+static void furthestPointsBatch(se::bench::State& state, std::size_t numVertices)
+{
+	ConvexPolyhedron hull = createHull(numVertices);
+	std::vector<glm::vec3> directions = createDirections();
+
+	std::vector<glm::vec3> pointsWorld(kNumDirections), pointsLocal(kNumDirections);
+	while (state.keepRunning()) {
+		hull.getFurthestPointsInDirections(directions.data(), kNumDirections, pointsWorld.data(), pointsLocal.data());
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumDirections);
+	state.setCounter("vertices", static_cast<double>(hull.getLocalMesh().vertices.size()));
+	state.setCounter("checksum", static_cast<double>(pointsWorld[0].x));
+}
+
+
+SOMBRA_BENCHMARK(ConvexPolyhedron_hillClimbing64)
+{
+	furthestVertex(state, 64);
+}
+
+
+SOMBRA_BENCHMARK(ConvexPolyhedron_hillClimbing256)
+{
+	furthestVertex(state, 256);
+}
+
+
+SOMBRA_BENCHMARK(ConvexPolyhedron_furthestPoint64)
+{
+	furthestPoint(state, 64);
+}
+
+
+SOMBRA_BENCHMARK(ConvexPolyhedron_furthestPoint256)
+{
+	furthestPoint(state, 256);
+}
+
+
+SOMBRA_BENCHMARK(ConvexPolyhedron_furthestPointsBatch64)
+{
+	furthestPointsBatch(state, 64);
+}
+
+
+SOMBRA_BENCHMARK(ConvexPolyhedron_furthestPointsBatch256)
+{
+	furthestPointsBatch(state, 256);
+}
@@ -0,0 +1,100 @@
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <se/physics/collision/Manifold.h>
+#include <se/physics/collision/Capsule.h>
+#include <se/physics/collision/BoundingBox.h>
+#include <se/physics/collision/BoundingSphere.h>
+#include <se/physics/collision/FineCollisionDetector.h>
+#include "se/Benchmark.h"
+
+using namespace se::physics;
+static constexpr float kCoarseEpsilon		= 0.0001f;
+static constexpr float kMinFDifference		= 0.00001f;
+static constexpr std::size_t kMaxIterations	= 100;
+static constexpr float kContactPrecision	= 0.0000001f;
+static constexpr float kContactSeparation	= 0.00001f;
+static constexpr float kRaycastPrecision	= 0.0000001f;
+
+
+static FineCollisionDetector createDetector()
+{
+	return FineCollisionDetector(
+		kCoarseEpsilon,
+		kMinFDifference, kMaxIterations,
+		kContactPrecision, kContactSeparation,
+		kRaycastPrecision
+	);
+}
+
+
+static glm::mat4 createTransforms(const glm::vec3& position, const glm::quat& orientation)
+{
+	return glm::translate(glm::mat4(1.0f), position) * glm::mat4_cast(orientation);
+}
+
+
+/** Measures a Manifold solved with the given Colliders */
+static void collide(se::bench::State& state, const Collider& collider1, const Collider& collider2)
+{
+	FineCollisionDetector fineCollisionDetector = createDetector();
+
+	std::size_t numContacts = 0;
+	while (state.keepRunning()) {
+		Manifold manifold(&collider1, &collider2);
+		fineCollisionDetector.collide(manifold);
+		numContacts = manifold.contacts.size();
+	}
+
+	state.setItemsProcessed(state.getMaxIterations());
+	state.setCounter("contacts", static_cast<double>(numContacts));
+}
+
+
+/** The same configuration than GJKEPA_boxBoxSeparated */
+SOMBRA_BENCHMARK(FineCollisionDetector_boxBoxSeparated)
+{
+	BoundingBox bb1(glm::vec3(1.0f)), bb2(glm::vec3(1.0f, 2.0f, 0.5f));
+	bb1.setTransforms(createTransforms(glm::vec3(0.0f), glm::quat(1.0f, glm::vec3(0.0f))));
+	bb2.setTransforms(createTransforms(glm::vec3(1.2f, 0.9f, 0.1f), glm::normalize(glm::quat(0.9f, 0.1f, 0.3f, 0.2f))));
+	collide(state, bb1, bb2);
+}
+
+
+/** The same configuration than GJKEPA_boxBoxPenetrating */
+SOMBRA_BENCHMARK(FineCollisionDetector_boxBoxPenetrating)
+{
+	BoundingBox bb1(glm::vec3(1.0f)), bb2(glm::vec3(1.0f, 2.0f, 0.5f));
+	bb1.setTransforms(createTransforms(glm::vec3(0.0f), glm::quat(1.0f, glm::vec3(0.0f))));
+	bb2.setTransforms(createTransforms(glm::vec3(0.6f, 0.5f, 0.1f), glm::normalize(glm::quat(0.9f, 0.1f, 0.3f, 0.2f))));
+	collide(state, bb1, bb2);
+}
+
+
+/** A box resting on another one, the clipped faces generate 4 Contacts */
+SOMBRA_BENCHMARK(FineCollisionDetector_boxBoxResting)
+{
+	BoundingBox bb1(glm::vec3(1.0f)), bb2(glm::vec3(1.0f));
+	bb1.setTransforms(createTransforms(glm::vec3(0.0f), glm::quat(1.0f, glm::vec3(0.0f))));
+	bb2.setTransforms(createTransforms(glm::vec3(0.1f, 0.99f, -0.2f), glm::quat(1.0f, glm::vec3(0.0f))));
+	collide(state, bb1, bb2);
+}
+
+
+SOMBRA_BENCHMARK(FineCollisionDetector_capsuleSpherePenetrating)
+{
+	Capsule c1(0.5f, 2.0f);
+	BoundingSphere bs1(1.0f);
+	c1.setTransforms(createTransforms(glm::vec3(0.0f), glm::normalize(glm::quat(0.8f, 0.0f, 0.6f, 0.0f))));
+	bs1.setTransforms(createTransforms(glm::vec3(0.3f, 1.2f, -0.2f), glm::quat(1.0f, glm::vec3(0.0f))));
+	collide(state, c1, bs1);
+}
+
+
+SOMBRA_BENCHMARK(FineCollisionDetector_capsuleBoxPenetrating)
+{
+	Capsule c1(0.5f, 2.0f);
+	BoundingBox bb1(glm::vec3(1.0f, 2.0f, 0.5f));
+	c1.setTransforms(createTransforms(glm::vec3(0.0f), glm::normalize(glm::quat(0.8f, 0.0f, 0.6f, 0.0f))));
+	bb1.setTransforms(createTransforms(glm::vec3(0.6f, 0.5f, 0.1f), glm::normalize(glm::quat(0.9f, 0.1f, 0.3f, 0.2f))));
+	collide(state, c1, bb1);
+}
@@ -0,0 +1,117 @@
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <se/physics/collision/Manifold.h>
+#include <se/physics/collision/BoundingBox.h>
+#include <se/physics/collision/FineCollisionDetector.h>
+#include "se/Benchmark.h"
+
+using namespace se::physics;
+static constexpr float kCoarseEpsilon		= 0.0001f;
+static constexpr float kMinFDifference		= 0.00001f;
+static constexpr std::size_t kMaxIterations	= 100;
+static constexpr float kContactPrecision	= 0.0000001f;
+static constexpr float kContactSeparation	= 0.00001f;
+static constexpr float kRaycastPrecision	= 0.0000001f;
+
+
+static FineCollisionDetector createDetector()
+{
+	return FineCollisionDetector(
+		kCoarseEpsilon,
+		kMinFDifference, kMaxIterations,
+		kContactPrecision, kContactSeparation,
+		kRaycastPrecision
+	);
+}
+
+
+/** BoundingBoxes are solved analytically, so the benchmarks use
+ * ConvexPolyhedrons with the same shape */
+static ConvexPolyhedron createBox(const glm::vec3& lengths)
+{
+	return ConvexPolyhedron(BoundingBox(lengths).getLocalMesh());
+}
+
+
+static glm::mat4 createTransforms(const glm::vec3& position, const glm::quat& orientation)
+{
+	return glm::translate(glm::mat4(1.0f), position) * glm::mat4_cast(orientation);
+}
+
+
+/** Measures the GJK algorithm without EPA, the Colliders don't intersect */
+SOMBRA_BENCHMARK(GJKEPA_boxBoxSeparated)
+{
+	FineCollisionDetector fineCollisionDetector = createDetector();
+
+	ConvexPolyhedron bb1 = createBox(glm::vec3(1.0f)), bb2 = createBox(glm::vec3(1.0f, 2.0f, 0.5f));
+	bb1.setTransforms(createTransforms(glm::vec3(0.0f), glm::quat(1.0f, glm::vec3(0.0f))));
+	bb2.setTransforms(createTransforms(glm::vec3(1.2f, 0.9f, 0.1f), glm::normalize(glm::quat(0.9f, 0.1f, 0.3f, 0.2f))));
+
+	while (state.keepRunning()) {
+		Manifold manifold(&bb1, &bb2);
+		fineCollisionDetector.collide(manifold);
+	}
+
+	state.setItemsProcessed(state.getMaxIterations());
+}
+
+
+/** Measures the GJK and EPA algorithms with penetrating boxes */
+SOMBRA_BENCHMARK(GJKEPA_boxBoxPenetrating)
+{
+	FineCollisionDetector fineCollisionDetector = createDetector();
+
+	ConvexPolyhedron bb1 = createBox(glm::vec3(1.0f)), bb2 = createBox(glm::vec3(1.0f, 2.0f, 0.5f));
+	bb1.setTransforms(createTransforms(glm::vec3(0.0f), glm::quat(1.0f, glm::vec3(0.0f))));
+	bb2.setTransforms(createTransforms(glm::vec3(0.6f, 0.5f, 0.1f), glm::normalize(glm::quat(0.9f, 0.1f, 0.3f, 0.2f))));
+
+	std::size_t numContacts = 0;
+	while (state.keepRunning()) {
+		Manifold manifold(&bb1, &bb2);
+		fineCollisionDetector.collide(manifold);
+		numContacts = manifold.contacts.size();
+	}
+
+	state.setItemsProcessed(state.getMaxIterations());
+	state.setCounter("contacts", static_cast<double>(numContacts));
+}
+
+
+/** Measures the update of the contacts of a persistent Manifold */
+SOMBRA_BENCHMARK(GJKEPA_boxBoxPersistentManifold)
+{
+	FineCollisionDetector fineCollisionDetector = createDetector();
+
+	ConvexPolyhedron bb1 = createBox(glm::vec3(1.0f)), bb2 = createBox(glm::vec3(1.0f, 2.0f, 0.5f));
+	bb1.setTransforms(createTransforms(glm::vec3(0.0f), glm::quat(1.0f, glm::vec3(0.0f))));
+	bb2.setTransforms(createTransforms(glm::vec3(0.6f, 0.5f, 0.1f), glm::normalize(glm::quat(0.9f, 0.1f, 0.3f, 0.2f))));
+
+	Manifold manifold(&bb1, &bb2);
+	while (state.keepRunning()) {
+		fineCollisionDetector.collide(manifold);
+	}
+
+	state.setItemsProcessed(state.getMaxIterations());
+}
+
+
+
+/** Measures the GJK algorithm warm started with the separating axis of the
+ * previous updates of a persistent Manifold */
+SOMBRA_BENCHMARK(GJKEPA_boxBoxSeparatedWarmStarted)
+{
+	FineCollisionDetector fineCollisionDetector = createDetector();
+
+	ConvexPolyhedron bb1 = createBox(glm::vec3(1.0f)), bb2 = createBox(glm::vec3(1.0f, 2.0f, 0.5f));
+	bb1.setTransforms(createTransforms(glm::vec3(0.0f), glm::quat(1.0f, glm::vec3(0.0f))));
+	bb2.setTransforms(createTransforms(glm::vec3(1.2f, 0.9f, 0.1f), glm::normalize(glm::quat(0.9f, 0.1f, 0.3f, 0.2f))));
+
+	Manifold manifold(&bb1, &bb2);
+	while (state.keepRunning()) {
+		fineCollisionDetector.collide(manifold);
+	}
+
+	state.setItemsProcessed(state.getMaxIterations());
+}
+
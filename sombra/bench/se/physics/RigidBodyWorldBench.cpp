@@ -0,0 +1,62 @@
+#include <random>
+#include <se/physics/RigidBody.h>
+#include <se/physics/RigidBodyWorld.h>
+#include <se/physics/forces/Gravity.h>
+#include <se/physics/forces/PunctualForce.h>
+#include "se/Benchmark.h"
+
+using namespace se::physics;
+static constexpr std::size_t kNumBodies = 4096;
+static constexpr float kWorldSize = 200.0f;
+static constexpr float kDeltaTime = 1.0f / 60.0f;
+
+
+/** Updates a RigidBodyWorld with kNumBodies dynamic RigidBodies without
+ * Colliders, so only their integration is measured */
+static void integrateBodies(se::bench::State& state, std::size_t numThreads)
+{
+	WorldProperties properties;
+	properties.worldAABB = { glm::vec3(-kWorldSize), glm::vec3(kWorldSize) };
+	properties.numThreads = numThreads;
+	RigidBodyWorld world(properties);
+
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+	auto gravity = std::make_shared<Gravity>();
+
+	std::vector<std::unique_ptr<RigidBody>> rigidBodies;
+	rigidBodies.reserve(kNumBodies);
+	for (std::size_t i = 0; i < kNumBodies; ++i) {
+		RigidBodyProperties rbProperties(1.0f, glm::mat3(0.4f));
+		rbProperties.linearDrag = 0.01f;
+		rbProperties.angularDrag = 0.01f;
+		rbProperties.sleepMotion = 0.0f;
+
+		RigidBodyState rbState;
+		rbState.position = 0.5f * kWorldSize * glm::vec3(distribution(generator), distribution(generator), distribution(generator));
+		rbState.angularVelocity = glm::vec3(distribution(generator), distribution(generator), distribution(generator));
+
+		auto& rb = rigidBodies.emplace_back(std::make_unique<RigidBody>(rbProperties, rbState));
+		rb->addForce(gravity);
+		rb->addForce(std::make_shared<PunctualForce>(glm::vec3(0.0f, 0.0f, 1.0f), rbState.position + glm::vec3(0.5f, 0.0f, 0.0f)));
+		world.addRigidBody(rb.get());
+	}
+
+	while (state.keepRunning()) {
+		world.update(kDeltaTime);
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumBodies * properties.numSubsteps);
+}
+
+
+SOMBRA_BENCHMARK(RigidBodyWorld_integrate1Thread)
+{
+	integrateBodies(state, 1);
+}
+
+
+SOMBRA_BENCHMARK(RigidBodyWorld_integrate4Threads)
+{
+	integrateBodies(state, 4);
+}
@@ -0,0 +1,130 @@
+#include <random>
+#include "se/physics/collision/AABBAVLTree.h"
+#include "se/physics/collision/StaticAABBTree.h"
+#include "se/Benchmark.h"
+
+using namespace se::physics;
+static constexpr std::size_t kNumAABBs = 4096;
+static constexpr std::size_t kNumQueries = 256;
+static constexpr float kWorldSize = 200.0f;
+static constexpr float kEpsilon = 0.0001f;
+
+
+/** The same AABBs than the AABBAVLTree benchmarks */
+static std::vector<AABB> createAABBs(std::size_t numAABBs)
+{
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> positionDist(-0.5f * kWorldSize, 0.5f * kWorldSize);
+	std::uniform_real_distribution<float> sizeDist(0.25f, 2.0f);
+
+	std::vector<AABB> ret(numAABBs);
+	for (AABB& aabb : ret) {
+		glm::vec3 position(positionDist(generator), positionDist(generator), positionDist(generator));
+		glm::vec3 halfSize(sizeDist(generator), sizeDist(generator), sizeDist(generator));
+		aabb = { position - halfSize, position + halfSize };
+	}
+
+	return ret;
+}
+
+
+/** The same rays than AABBAVLTree_calculateIntersectionsWith */
+static std::vector<Ray> createRays()
+{
+	std::mt19937 generator(7);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::vector<Ray> ret;
+	for (std::size_t i = 0; i < kNumQueries; ++i) {
+		glm::vec3 direction(dist(generator), dist(generator), dist(generator));
+		ret.emplace_back(glm::vec3(0.0f), glm::normalize(direction + glm::vec3(0.001f)));
+	}
+
+	return ret;
+}
+
+
+SOMBRA_BENCHMARK(StaticAABBTree_build)
+{
+	std::vector<AABB> aabbs = createAABBs(kNumAABBs);
+
+	std::size_t numNodes = 0;
+	while (state.keepRunning()) {
+		StaticAABBTree tree;
+		tree.build(aabbs.data(), aabbs.size());
+		numNodes = tree.getNodes().size();
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumAABBs);
+	state.setCounter("nodes", static_cast<double>(numNodes));
+}
+
+
+/** Measures the AABBAVLTree with the same queries than
+ * StaticAABBTree_calculateOverlapsWith */
+SOMBRA_BENCHMARK(AABBAVLTree_calculateOverlapsWith)
+{
+	std::vector<AABB> aabbs = createAABBs(kNumAABBs);
+	std::vector<AABB> queries = createAABBs(kNumQueries);
+
+	AABBAVLTree<std::size_t> tree;
+	for (std::size_t i = 0; i < aabbs.size(); ++i) {
+		tree.addNode(aabbs[i], i);
+	}
+
+	std::size_t numOverlaps = 0;
+	while (state.keepRunning()) {
+		numOverlaps = 0;
+		for (const AABB& query : queries) {
+			tree.calculateOverlapsWith(query, kEpsilon, [&](std::size_t) { ++numOverlaps; });
+		}
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumQueries);
+	state.setCounter("overlaps", static_cast<double>(numOverlaps));
+}
+
+
+SOMBRA_BENCHMARK(StaticAABBTree_calculateOverlapsWith)
+{
+	std::vector<AABB> aabbs = createAABBs(kNumAABBs);
+	std::vector<AABB> queries = createAABBs(kNumQueries);
+
+	StaticAABBTree tree;
+	tree.build(aabbs.data(), aabbs.size());
+
+	std::size_t numOverlaps = 0;
+	while (state.keepRunning()) {
+		numOverlaps = 0;
+		for (const AABB& query : queries) {
+			tree.calculateOverlapsWith(query, kEpsilon, [&](std::uint32_t i) {
+				numOverlaps += overlaps(aabbs[i], query, kEpsilon)? 1 : 0;
+			});
+		}
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumQueries);
+	state.setCounter("overlaps", static_cast<double>(numOverlaps));
+}
+
+
+SOMBRA_BENCHMARK(StaticAABBTree_calculateIntersectionsWith)
+{
+	std::vector<AABB> aabbs = createAABBs(kNumAABBs);
+	std::vector<Ray> rays = createRays();
+
+	StaticAABBTree tree;
+	tree.build(aabbs.data(), aabbs.size());
+
+	std::size_t numHits = 0;
+	while (state.keepRunning()) {
+		numHits = 0;
+		for (const Ray& ray : rays) {
+			tree.calculateIntersectionsWith(ray, kEpsilon, [&](std::uint32_t i) {
+				numHits += intersects(aabbs[i], ray, kEpsilon)? 1 : 0;
+			});
+		}
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumQueries);
+	state.setCounter("hits", static_cast<double>(numHits));
+}
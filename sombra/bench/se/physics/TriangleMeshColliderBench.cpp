@@ -0,0 +1,75 @@
+#include <cmath>
+#include <vector>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <se/physics/collision/TriangleMeshCollider.h>
+#include "se/Benchmark.h"
+
+using namespace se::physics;
+static constexpr std::size_t kGridSize = 64;
+
+
+/** Creates a TriangleMeshCollider with a wavy grid of
+ * 2 * (kGridSize - 1)^2 triangles */
+static TriangleMeshCollider createGrid()
+{
+	std::vector<glm::vec3> vertices;
+	for (std::size_t z = 0; z < kGridSize; ++z) {
+		for (std::size_t x = 0; x < kGridSize; ++x) {
+			float y = 0.5f * std::sin(0.3f * x) * std::cos(0.2f * z);
+			vertices.emplace_back(static_cast<float>(x), y, static_cast<float>(z));
+		}
+	}
+
+	std::vector<std::uint32_t> indices;
+	for (std::size_t z = 0; z + 1 < kGridSize; ++z) {
+		for (std::size_t x = 0; x + 1 < kGridSize; ++x) {
+			auto i0 = static_cast<std::uint32_t>(z * kGridSize + x), i1 = i0 + 1;
+			auto i2 = static_cast<std::uint32_t>(i0 + kGridSize), i3 = i2 + 1;
+			indices.insert(indices.end(), { i0, i2, i1, i1, i2, i3 });
+		}
+	}
+
+	return TriangleMeshCollider(std::make_shared<TriangleMesh>(vertices.data(), vertices.size(), indices.data(), indices.size()));
+}
+
+
+/** Measures copying a TriangleMeshCollider, like cloning an Entity does */
+SOMBRA_BENCHMARK(TriangleMeshCollider_clone)
+{
+	TriangleMeshCollider mesh = createGrid();
+
+	std::size_t numTriangles = 0;
+	while (state.keepRunning()) {
+		auto clone = mesh.clone();
+		numTriangles = static_cast<TriangleMeshCollider&>(*clone).getMesh()->getNumTriangles();
+	}
+
+	state.setItemsProcessed(state.getMaxIterations());
+	state.setCounter("triangles", static_cast<double>(numTriangles));
+}
+
+
+/** Measures moving the mesh and querying a small AABB over it, like a
+ * moving platform does each frame */
+SOMBRA_BENCHMARK(TriangleMeshCollider_moveAndOverlap)
+{
+	TriangleMeshCollider mesh = createGrid();
+	const AABB query = { glm::vec3(10.0f, -1.0f, 10.0f), glm::vec3(11.0f, 1.0f, 11.0f) };
+
+	std::size_t numParts = 0;
+	float offset = 0.0f;
+	while (state.keepRunning()) {
+		offset = (offset > 1.0f)? 0.0f : offset + 0.01f;
+		mesh.setTransforms(
+			glm::translate(glm::mat4(1.0f), glm::vec3(offset, 0.0f, 0.0f))
+			* glm::mat4_cast(glm::angleAxis(0.1f * offset, glm::vec3(0.0f, 1.0f, 0.0f)))
+		);
+
+		numParts = 0;
+		mesh.processOverlapingParts(query, 0.0001f, [&](const ConvexCollider&) { ++numParts; });
+	}
+
+	state.setItemsProcessed(state.getMaxIterations());
+	state.setCounter("parts", static_cast<double>(numParts));
+}
@@ -0,0 +1,66 @@
+#include <atomic>
+#include <se/utils/TaskSet.h>
+#include "se/Benchmark.h"
+
+using namespace se::utils;
+static constexpr int kMaxTasks = 4096;
+static constexpr int kNumThreads = 4;
+static constexpr int kNumTasks = 1024;
+
+SOMBRA_BENCHMARK(TaskManager_independentTasks)
+{
+	TaskManager taskManager(kMaxTasks, kNumThreads);
+	std::atomic_int counter = 0;
+
+	while (state.keepRunning()) {
+		TaskSet taskSet(taskManager);
+		for (int i = 0; i < kNumTasks; ++i) {
+			taskSet.createTask([&]() { ++counter; });
+		}
+		taskSet.submitAndWait();
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumTasks);
+}
+
+
+SOMBRA_BENCHMARK(TaskManager_taskChain)
+{
+	TaskManager taskManager(kMaxTasks, kNumThreads);
+	std::atomic_int counter = 0;
+
+	while (state.keepRunning()) {
+		TaskSet taskSet(taskManager);
+		TaskId previous = taskSet.createTask([&]() { ++counter; });
+		for (int i = 1; i < kNumTasks; ++i) {
+			TaskId current = taskSet.createTask([&]() { ++counter; });
+			taskSet.depends(current, previous);
+			previous = current;
+		}
+		taskSet.submitAndWait();
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumTasks);
+}
+
+
+SOMBRA_BENCHMARK(TaskManager_nestedSubTaskSets)
+{
+	static constexpr int kNumSubSets = 32;
+	TaskManager taskManager(kMaxTasks, kNumThreads);
+	std::atomic_int counter = 0;
+
+	while (state.keepRunning()) {
+		TaskSet taskSet(taskManager);
+		for (int i = 0; i < kNumSubSets; ++i) {
+			taskSet.createSubTaskSet([&](SubTaskSet& subSet) {
+				for (int j = 0; j < kNumTasks / kNumSubSets; ++j) {
+					subSet.createTask([&]() { ++counter; });
+				}
+			});
+		}
+		taskSet.submitAndWait();
+	}
+
+	state.setItemsProcessed(state.getMaxIterations() * kNumTasks);
+}
@@ -1,10 +1,10 @@
 #ifndef ANIMATION_NODE_H
 #define ANIMATION_NODE_H
 
-#include <array>
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include "../utils/TreeNode.h"
+#include "../utils/StringInterner.h"
 
 namespace se::animation {
 
@@ -38,11 +38,9 @@ namespace se::animation {
 	 */
 	struct NodeData
 	{
-		/** The maximum name length allowed */
-		static constexpr std::size_t kMaxLength = 256;
-
-		/** The name of the Node */
-		std::array<char, kMaxLength> name = {};
+		/** The name of the Node, it's used for searching the Nodes animated
+		 * by the SkeletonAnimators and the joints of the Skins */
+		utils::NameId name;
 
 		/** The node transforms in relation to its parent */
 		NodeTransforms localTransforms;
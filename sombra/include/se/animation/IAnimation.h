@@ -2,6 +2,7 @@
 #define I_ANIMATION_H
 
 #include <vector>
+#include "../utils/MemoryTracker.h"
 
 namespace se::animation {
 
@@ -42,17 +43,21 @@ namespace se::animation {
 	public:		// Nested types
 		using KeyFrame = U;
 		using KeyFramePair = std::pair<KeyFrame, KeyFrame>;
+		using KeyFrameVector = std::vector<
+			KeyFrame, utils::TrackedAllocator<KeyFrame, utils::MemoryTag::Animation>
+		>;
 
 	protected:	// Attributes
-		/** The KeyFrames raw data sorted by their timePoint */
-		std::vector<KeyFrame> mKeyFrames;
+		/** The KeyFrames raw data sorted by their timePoint, its memory is
+		 * tracked with the MemoryTag::Animation tag */
+		KeyFrameVector mKeyFrames;
 
 	public:		// Functions
 		/** Class destructor */
 		virtual ~Animation() = default;
 
 		/** @return	the KeyFrames of the Animation */
-		const std::vector<KeyFrame>& getKeyFrames() const;
+		const KeyFrameVector& getKeyFrames() const;
 
 		/** Adds a new KeyFrame to the Animation
 		 *
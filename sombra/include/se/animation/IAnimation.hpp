@@ -6,7 +6,7 @@
 namespace se::animation {
 
 	template <typename T, typename U>
-	const std::vector<typename Animation<T, U>::KeyFrame>& Animation<T, U>::getKeyFrames() const
+	const typename Animation<T, U>::KeyFrameVector& Animation<T, U>::getKeyFrames() const
 	{
 		return mKeyFrames;
 	}
@@ -17,7 +17,7 @@ namespace se::animation {
 
 		struct NodeAnimator
 		{
-			std::array<char, NodeData::kMaxLength> nodeName;
+			utils::NameId nodeName;
 			TransformationAnimator::TransformationType type;
 			TransformationAnimatorUPtr animator;
 		};
@@ -28,7 +28,8 @@ namespace se::animation {
 		float mLoopTime;
 
 		/** Maps the names of the AnimationNodes to transform with the
-		 * IAnimators that will animate them */
+		 * IAnimators that will animate them. They are sorted by the id of
+		 * their names for faster searchs */
 		std::vector<NodeAnimator> mNAnimators;
 
 		/** All the root AnimationNodes of the hierarchies to animate */
@@ -80,6 +81,19 @@ namespace se::animation {
 			const char* nodeName,
 			TransformationAnimator::TransformationType type,
 			TransformationAnimatorUPtr animator
+		) { addAnimator(utils::NameId(nodeName), type, std::move(animator)); };
+
+		/** Adds the given TransformationAnimator to the SkeletonAnimator
+		 *
+		 * @param	nodeName the name id of the AnimationNodes that will be
+		 *			affected by the animator
+		 * @param	type the TransformationType to apply to the AnimationNode
+		 *			with the given TransformationAnimator
+		 * @param	animator a pointer to the TransformationAnimator to add */
+		void addAnimator(
+			const utils::NameId& nodeName,
+			TransformationAnimator::TransformationType type,
+			TransformationAnimatorUPtr animator
 		);
 
 		/** Iterates through all the TransformationAnimators added to the
@@ -99,6 +113,17 @@ namespace se::animation {
 		void removeAnimator(
 			const char* nodeName,
 			TransformationAnimator::TransformationType type
+		) { removeAnimator(utils::NameId(nodeName), type); };
+
+		/** Removes the given TransformationAnimator to the SkeletonAnimator
+		 *
+		 * @param	nodeName the name id of the AnimationNodes affected by the
+		 *			animator to remove
+		 * @param	type the TransformationType that TransformationAnimator to
+		 *			remove is applying to the AnimationNodes */
+		void removeAnimator(
+			const utils::NameId& nodeName,
+			TransformationAnimator::TransformationType type
 		);
 
 		/** Adds the given node hierarchy to the SkeletonAnimator, so the nodes
@@ -121,23 +146,23 @@ namespace se::animation {
 		 * @param	rootNode the root AnimationNode of the skeleton to remove */
 		void removeNodeHierarchy(AnimationNode& rootNode);
 	private:
-		/** Compares the name of the animator and the given one
+		/** Compares the name id of the animator and the given one
 		 *
 		 * @param	lhs the NodeAnimator to compare
-		 * @param	rhs the name to compare
+		 * @param	rhs the name id to compare
 		 * @return	true if the NodeAnimator is less than the name,
 		 *			false otherwise */
 		static
-		bool compareLessLo(const NodeAnimator& lhs, const char* rhs);
+		bool compareLessLo(const NodeAnimator& lhs, const utils::NameId& rhs);
 
-		/** Compares the given name and the animator one
+		/** Compares the given name id and the animator one
 		 *
-		 * @param	lhs the name to compare
+		 * @param	lhs the name id to compare
 		 * @param	rhs the NodeAnimator to compare
 		 * @return	true if the name is less than the NodeAnimator,
 		 *			false otherwise */
 		static
-		bool compareLessUp(const char* lhs, const NodeAnimator& rhs);
+		bool compareLessUp(const utils::NameId& lhs, const NodeAnimator& rhs);
 	};
 
 
@@ -146,7 +171,7 @@ namespace se::animation {
 	{
 		for (const NodeAnimator& nAnimator : mNAnimators) {
 			callback(
-				nAnimator.nodeName.data(), nAnimator.type,
+				nAnimator.nodeName.c_str(), nAnimator.type,
 				nAnimator.animator.get()
 			);
 		}
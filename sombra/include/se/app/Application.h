@@ -1,6 +1,7 @@
 #ifndef APPLICATION_H
 #define APPLICATION_H
 
+#include <cassert>
 #include <glm/glm.hpp>
 #include "events/EventManager.h"
 #include "../window/WindowManager.h"
@@ -19,10 +20,35 @@ namespace se::app {
 	class Repository;
 
 
+	/**
+	 * Struct HeadlessConfig, holds the configuration of the Applications
+	 * created without window, graphics and audio
+	 */
+	struct HeadlessConfig
+	{
+		/** The maximum number of Entities of the Application */
+		std::size_t maxEntities = 1024;
+
+		/** If the updates must be executed one after another without waiting
+		 * for the wall clock. Useful for simulation farms and benchmarks */
+		bool runAsFastAsPossible = false;
+
+		/** The number of updates after which the Application will stop, 0
+		 * for running until @see Application::stop is called */
+		std::size_t maxUpdates = 0;
+	};
+
+
 	/**
 	 * Class Application, it's the class that every App must inherit from
 	 * to get access to all the SOMBRA managers and systems and to be updated
 	 * at a constant rate.
+	 *
+	 * An Application can also be created in headless mode, without window,
+	 * GraphicsEngine and AudioEngine. In this mode the ExternalTools for
+	 * them are nullptr and only the Systems that don't need them (Scripts,
+	 * Animation and Physics) are created. The Components of the other
+	 * Systems can still be added to the Entities but they won't be updated.
 	 */
 	class Application : public IEventListener
 	{
@@ -57,6 +83,13 @@ namespace se::app {
 		/** The minimum elapsed time between updates in seconds */
 		const float mUpdateTime;
 
+		/** If the Application was created without window, graphics and
+		 * audio */
+		const bool mHeadless;
+
+		/** The configuration of the headless mode */
+		const HeadlessConfig mHeadlessConfig;
+
 		/** The variable used for stopping the main loop */
 		bool mStopRunning;
 
@@ -109,6 +142,19 @@ namespace se::app {
 			float updateTime
 		);
 
+		/** Creates a new headless Application, without window, graphics and
+		 * audio
+		 *
+		 * @param	physicsWorldProperties the configuration with which the
+		 *			RigidBodyWorld is going to be created
+		 * @param	updateTime the elapsed time between updates in seconds
+		 * @param	headlessConfig the configuration of the headless mode */
+		Application(
+			const physics::WorldProperties& physicsWorldProperties,
+			float updateTime,
+			const HeadlessConfig& headlessConfig = {}
+		);
+
 		/** Class destructor */
 		virtual ~Application();
 
@@ -127,8 +173,18 @@ namespace se::app {
 		/** @return	a reference to the Repository of the Application */
 		Repository& getRepository() { return *mRepository; };
 
-		/** @return	a reference to the GUIManager of the Application */
-		GUIManager& getGUIManager() { return *mGUIManager; };
+		/** @return	a reference to the GUIManager of the Application
+		 * @note	the GUIManager isn't available in headless mode, check
+		 *			@see isHeadless first */
+		GUIManager& getGUIManager()
+		{
+			assert(mGUIManager && "The GUIManager isn't available in headless mode");
+			return *mGUIManager;
+		};
+
+		/** @return	true if the Application was created without window,
+		 *			graphics and audio, false otherwise */
+		bool isHeadless() const { return mHeadless; };
 
 		/** @copydoc IEventListener::notify(const IEvent&) */
 		virtual bool notify(const IEvent&) override { return false; };
@@ -141,6 +197,20 @@ namespace se::app {
 		/** Function used for stopping the Application */
 		void stop();
 	protected:
+		/** Creates the Application managers and Systems
+		 *
+		 * @param	windowConfig a pointer to the configuration of the window,
+		 *			nullptr in headless mode
+		 * @param	physicsWorldProperties the configuration with which the
+		 *			RigidBodyWorld is going to be created
+		 * @param	audioDeviceId the id of the audio device to use
+		 * @param	maxEntities the maximum number of Entities */
+		void init(
+			const window::WindowData* windowConfig,
+			const physics::WorldProperties& physicsWorldProperties,
+			std::size_t audioDeviceId, std::size_t maxEntities
+		);
+
 		/** Runs the Application
 		 *
 		 * @return	true if the Application exited succesfully, false
@@ -3,6 +3,7 @@
 
 #include <cassert>
 #include <unordered_map>
+#include "../utils/MemoryTracker.h"
 
 namespace se::app {
 
@@ -110,6 +111,11 @@ namespace se::app {
 	template <typename T>
 	class EntityDatabase::ComponentTable : public ITComponentTable<T>
 	{
+	private:	// Nested types
+		/** The allocator used for the Components, its memory is tracked with
+		 * the MemoryTag::ECS tag */
+		using Allocator = utils::TrackedAllocator<T, utils::MemoryTag::ECS>;
+
 	private:	// Attributes
 		/** The Components added to the ComponentTable */
 		T* mComponents;
@@ -141,12 +147,23 @@ namespace se::app {
 			mComponents(nullptr),
 			mMaxComponents(maxComponents), mNumComponents(0)
 		{
-			mComponents = std::allocator<T>().allocate(mMaxComponents);
+			mComponents = Allocator().allocate(mMaxComponents);
 			mComponentFlags.resize(2 * mMaxComponents, false);
 			mEntityComponentMap.reserve(mMaxComponents);
 			mComponentEntityMap.reserve(mMaxComponents);
 		};
 
+		/** Class destructor */
+		virtual ~ComponentTable()
+		{
+			for (std::size_t i = 0; i < mMaxComponents; ++i) {
+				if (mComponentFlags[2 * i]) {
+					mComponents[i].~T();
+				}
+			}
+			Allocator().deallocate(mComponents, mMaxComponents);
+		};
+
 		/** @copydoc IComponentTable::getMaxComponents() */
 		virtual std::size_t getMaxComponents() const override
 		{ return mMaxComponents; };
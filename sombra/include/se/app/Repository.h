@@ -6,9 +6,23 @@
 #include <string>
 #include <functional>
 #include "../utils/PackedVector.h"
+#include "../utils/MemoryTracker.h"
 
 namespace se::app {
 
+	/**
+	 * Struct RepositoryMemoryTag, it holds the MemoryTag used for tracking the
+	 * memory of the Resources of type @tparam T created with
+	 * @see Repository::makeShared. It can be specialized for the Resource
+	 * types that should be counted in other subsystems
+	 */
+	template <typename T>
+	struct RepositoryMemoryTag
+	{
+		static constexpr utils::MemoryTag value = utils::MemoryTag::Repository;
+	};
+
+
 	/**
 	 * Class Repository, it provides a single point for storing and accessing
 	 * to all the Elements of the given types. Resources are automatically
@@ -19,7 +33,7 @@ namespace se::app {
 	public:		// Nested types
 		template <typename T> class ResourceRef;
 		template <typename T> using CloneCallback =
-			std::function<std::unique_ptr<T>(const T&)>;
+			std::function<std::shared_ptr<T>(const T&)>;
 	private:
 		template <typename T> struct Resource;
 		struct IRepoTable;
@@ -47,6 +61,15 @@ namespace se::app {
 		Repository& operator=(const Repository& other) = default;
 		Repository& operator=(Repository&& other) = default;
 
+		/** Creates a new Resource of type @tparam T that can be added to the
+		 * Repository. Its memory is tracked with the MemoryTag of
+		 * @see RepositoryMemoryTag
+		 *
+		 * @param	args the arguments used for creating the Resource
+		 * @return	a shared_ptr to the new Resource */
+		template <typename T, typename... Args>
+		static std::shared_ptr<T> makeShared(Args&&... args);
+
 		/** Initializes the Repository so it can hold elements of @tparam T type
 		 *
 		 * @param	cloneCB the function used for clonying the elements
@@ -2,7 +2,11 @@
 #define REPOSITORY_HPP
 
 #include <mutex>
+#include <algorithm>
+#include <unordered_map>
 #include "../utils/MathUtils.h"
+#include "../utils/MemoryTracker.h"
+#include "../utils/StringInterner.h"
 
 namespace se::app {
 
@@ -16,7 +20,7 @@ namespace se::app {
 		std::shared_ptr<T> resource;
 
 		/** The name of the Resource */
-		std::string name;
+		utils::NameId name;
 
 		/** The index of the linked Scene file where the Resource is stored,
 		 * If it's negative then the Resource is located in the same
@@ -52,14 +56,59 @@ namespace se::app {
 	template <typename T>
 	struct Repository::RepoTable : public Repository::IRepoTable
 	{
-		/** All the data stored in the RepoTable */
-		utils::PackedVector<Resource<T>> data;
+		/** All the data stored in the RepoTable, its memory is tracked with
+		 * the MemoryTag::Repository tag */
+		utils::PackedVector<
+			Resource<T>,
+			utils::TrackedAllocator<Resource<T>, utils::MemoryTag::Repository>
+		> data;
+
+		/** Maps the names of the Resources with their indices in
+		 * @see data. The Resources without name aren't added */
+		std::unordered_multimap<utils::NameId, std::size_t, utils::NameId::Hash>
+			nameIndices;
 
 		/** The function used for clonying a Resource */
 		CloneCallback<T> cloneCallback;
 
 		/** The mutex used for protecting the Repository */
 		mutable std::recursive_mutex mutex;
+
+		/** Sets the name of the given Resource
+		 *
+		 * @param	index the index of the Resource in @see data
+		 * @param	name the new name of the Resource */
+		void setName(std::size_t index, const utils::NameId& name)
+		{
+			removeNameIndex(index);
+			data[index].name = name;
+			if (!name.empty()) {
+				nameIndices.emplace(name, index);
+			}
+		};
+
+		/** Removes the given Resource
+		 *
+		 * @param	index the index of the Resource in @see data */
+		void erase(std::size_t index)
+		{
+			removeNameIndex(index);
+			data.erase( data.begin().setIndex(index) );
+		};
+
+		/** Removes the given Resource from @see nameIndices
+		 *
+		 * @param	index the index of the Resource in @see data */
+		void removeNameIndex(std::size_t index)
+		{
+			auto [itBegin, itEnd] = nameIndices.equal_range(data[index].name);
+			for (auto it = itBegin; it != itEnd; ++it) {
+				if (it->second == index) {
+					nameIndices.erase(it);
+					break;
+				}
+			}
+		};
 	};
 
 
@@ -159,15 +208,31 @@ namespace se::app {
 	template <typename T>
 	void Repository::clear()
 	{
-		getRepoTable<T>().data.clear();
+		auto& table = getRepoTable<T>();
+		std::scoped_lock lock(table.mutex);
+		table.nameIndices.clear();
+		table.data.clear();
+	}
+
+
+	template <typename T, typename... Args>
+	std::shared_ptr<T> Repository::makeShared(Args&&... args)
+	{
+		using Allocator = utils::TrackedAllocator<T, RepositoryMemoryTag<T>::value>;
+		return std::allocate_shared<T>(Allocator(), std::forward<Args>(args)...);
 	}
 
 
 	template <typename T, typename... Args>
 	Repository::ResourceRef<T> Repository::emplace(Args&&... args)
 	{
-		auto it = getRepoTable<T>().data.emplace();
-		it->resource = std::make_shared<T>(std::forward<Args>(args)...);
+		auto resource = makeShared<T>(std::forward<Args>(args)...);
+
+		auto& table = getRepoTable<T>();
+		std::scoped_lock lock(table.mutex);
+
+		auto it = table.data.emplace();
+		it->resource = std::move(resource);
 
 		return ResourceRef<T>(this, it.getIndex());
 	}
@@ -176,9 +241,12 @@ namespace se::app {
 	template <typename T>
 	Repository::ResourceRef<T> Repository::insert(const std::shared_ptr<T>& value, const char* name)
 	{
-		auto it = getRepoTable<T>().data.emplace();
+		auto& table = getRepoTable<T>();
+		std::scoped_lock lock(table.mutex);
+
+		auto it = table.data.emplace();
 		it->resource = value;
-		it->name = name;
+		table.setName(it.getIndex(), utils::NameId(name));
 
 		return ResourceRef<T>(this, it.getIndex());
 	}
@@ -193,7 +261,7 @@ namespace se::app {
 		if (table.cloneCallback) {
 			auto value = table.cloneCallback(*resource);
 			if (value) {
-				ret = insert<T>(std::move(value));
+				ret = insert<T>(value);
 				ret.setName( resource.getName() );
 				ret.setPath( resource.getPath() );
 				if (resource.isLinked()) {
@@ -226,9 +294,23 @@ namespace se::app {
 	template <typename T>
 	Repository::ResourceRef<T> Repository::findByName(const char* name) const
 	{
-		return find<T>([&](const ResourceRef<T>& ref) {
-			return ref.getName() == name;
+		utils::NameId nameId;
+		if (!utils::NameId::find(name, nameId) || nameId.empty()) {
+			return ResourceRef<T>();
+		}
+
+		const auto& table = getRepoTable<T>();
+
+		std::scoped_lock lock(table.mutex);
+		auto [itBegin, itEnd] = table.nameIndices.equal_range(nameId);
+		auto itFirst = std::min_element(itBegin, itEnd, [](const auto& lhs, const auto& rhs) {
+			return lhs.second < rhs.second;
 		});
+		if (itFirst != itEnd) {
+			return ResourceRef<T>(const_cast<Repository*>(this), itFirst->second);
+		}
+
+		return ResourceRef<T>();
 	}
 
 
@@ -267,7 +349,7 @@ namespace se::app {
 	{
 		auto& table = getRepoTable<T>();
 		std::scoped_lock lock(table.mutex);
-		return table.data[index].name;
+		return table.data[index].name.str();
 	}
 
 
@@ -276,7 +358,7 @@ namespace se::app {
 	{
 		auto& table = getRepoTable<T>();
 		std::scoped_lock lock(table.mutex);
-		table.data[index].name = name;
+		table.setName(index, utils::NameId(name));
 	}
 
 
@@ -356,7 +438,7 @@ namespace se::app {
 		else {
 			table.data[index].userCount = (table.data[index].userCount << 1) >> 1;
 			if (table.data[index].userCount == 0) {
-				table.data.erase( table.data.begin().setIndex(index) );
+				table.erase(index);
 			}
 		}
 	}
@@ -368,7 +450,7 @@ namespace se::app {
 		auto& table = getRepoTable<T>();
 		std::scoped_lock lock(table.mutex);
 		if (--table.data[index].userCount == 0) {
-			table.data.erase( table.data.begin().setIndex(index) );
+			table.erase(index);
 		}
 	}
 
@@ -2,9 +2,50 @@
 #define IMAGE_H
 
 #include <memory>
+#include "../../utils/MemoryTracker.h"
 
 namespace se::app {
 
+	/**
+	 * Struct ImageDeleter, it releases the pixels allocated with
+	 * @see allocatePixels
+	 */
+	template <typename T>
+	struct ImageDeleter
+	{
+		/** The number of elements allocated */
+		std::size_t length = 0;
+
+		/** Releases the given pixels
+		 *
+		 * @param	pixels a pointer to the pixels to release */
+		void operator()(T* pixels) const
+		{
+			utils::TrackedAllocator<T, utils::MemoryTag::Texture>()
+				.deallocate(pixels, length);
+		};
+	};
+
+
+	/** The pointer to the pixel data of an Image */
+	template <typename T>
+	using ImagePixelsUPtr = std::unique_ptr<T[], ImageDeleter<T>>;
+
+
+	/** Allocates memory for the pixels of an Image, its memory is tracked
+	 * with the MemoryTag::Texture tag
+	 *
+	 * @param	length the number of elements to allocate
+	 * @return	a pointer to the new pixels */
+	template <typename T>
+	ImagePixelsUPtr<T> allocatePixels(std::size_t length)
+	{
+		T* pixels = utils::TrackedAllocator<T, utils::MemoryTag::Texture>()
+			.allocate(length);
+		return ImagePixelsUPtr<T>(pixels, ImageDeleter<T>{ length });
+	}
+
+
 	/**
 	 * Struct Class, it holds the data of an image in memory.
 	 */
@@ -12,7 +53,7 @@ namespace se::app {
 	struct Image
 	{
 		/** The pixel data of the image */
-		std::unique_ptr<T[]> pixels;
+		ImagePixelsUPtr<T> pixels;
 
 		/** The width of the image in pixels */
 		std::size_t width = 0;
@@ -33,7 +74,7 @@ namespace se::app {
 		std::size_t length = static_cast<std::size_t>(source.channels);
 		length *= source.width * source.height;
 
-		ret.pixels = std::unique_ptr<T[]>(new T[length]);
+		ret.pixels = allocatePixels<T>(length);
 		ret.width = source.width;
 		ret.height = source.height;
 		ret.channels = source.channels;
@@ -4,9 +4,18 @@
 #include <vector>
 #include <string>
 #include <glm/glm.hpp>
+#include "../../utils/MemoryTracker.h"
 
 namespace se::app {
 
+	/** The vectors used for storing the RawMesh data, their memory is
+	 * tracked with the MemoryTag::Mesh tag */
+	template <typename T>
+	using MeshVector = std::vector<
+		T, utils::TrackedAllocator<T, utils::MemoryTag::Mesh>
+	>;
+
+
 	/** The attribute indices of the VAO of a Mesh */
 	struct MeshAttributes
 	{
@@ -30,14 +39,14 @@ namespace se::app {
 	public:
 		std::string name;
 
-		std::vector<glm::vec3> positions;
-		std::vector<glm::vec3> normals;
-		std::vector<glm::vec3> tangents;
-		std::vector<glm::vec2> texCoords;
-		std::vector<glm::u16vec4> jointIndices;
-		std::vector<glm::vec4> jointWeights;
+		MeshVector<glm::vec3> positions;
+		MeshVector<glm::vec3> normals;
+		MeshVector<glm::vec3> tangents;
+		MeshVector<glm::vec2> texCoords;
+		MeshVector<glm::u16vec4> jointIndices;
+		MeshVector<glm::vec4> jointWeights;
 
-		std::vector<unsigned short> indices;
+		MeshVector<unsigned short> indices;
 
 		RawMesh(const std::string& name = "") : name(name) {};
 	};
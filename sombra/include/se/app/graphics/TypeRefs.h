@@ -7,6 +7,7 @@
 #include "../../graphics/3D/Mesh.h"
 #include "../../graphics/3D/Particles.h"
 #include "../../graphics/Context.h"
+#include "../Repository.h"
 
 namespace se::app {
 
@@ -23,6 +24,20 @@ namespace se::app {
 		graphics::UniformVariableValueVector<T>
 	>;
 
+
+	template <>
+	struct RepositoryMemoryTag<MeshRef>
+	{
+		static constexpr utils::MemoryTag value = utils::MemoryTag::Mesh;
+	};
+
+
+	template <>
+	struct RepositoryMemoryTag<TextureRef>
+	{
+		static constexpr utils::MemoryTag value = utils::MemoryTag::Texture;
+	};
+
 }
 
 #endif		// TYPE_REFS_H
@@ -127,9 +127,9 @@ namespace se::app {
 		 * @param	faceIndices a vector with indices of the vertices that
 		 *			compose the triangle faces of a Mesh
 		 * @return	a vector with the normals of the vertices */
-		static std::vector<glm::vec3> calculateNormals(
-			const std::vector<glm::vec3>& positions,
-			const std::vector<unsigned short>& faceIndices
+		static MeshVector<glm::vec3> calculateNormals(
+			const MeshVector<glm::vec3>& positions,
+			const MeshVector<unsigned short>& faceIndices
 		);
 
 		/** Calculates the Tangents of the given vertices
@@ -140,10 +140,10 @@ namespace se::app {
 		 * @param	faceIndices a vector with indices of the vertices that
 		 *			compose the triangle faces of a Mesh
 		 * @return	a vector with the tangents of the vertices */
-		static std::vector<glm::vec3> calculateTangents(
-			const std::vector<glm::vec3>& positions,
-			const std::vector<glm::vec2>& texCoords,
-			const std::vector<unsigned short>& faceIndices
+		static MeshVector<glm::vec3> calculateTangents(
+			const MeshVector<glm::vec3>& positions,
+			const MeshVector<glm::vec2>& texCoords,
+			const MeshVector<unsigned short>& faceIndices
 		);
 
 		/** Calculate the heights from the given data in the range [-0.5, 0.5]
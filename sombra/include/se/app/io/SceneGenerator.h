@@ -0,0 +1,90 @@
+#ifndef SCENE_GENERATOR_H
+#define SCENE_GENERATOR_H
+
+#include "../Scene.h"
+#include "../graphics/RenderableShader.h"
+#include "Result.h"
+
+namespace se::app {
+
+	/**
+	 * Class SceneGenerator, it's used for populating Scenes with procedural
+	 * Entities for load testing. The generation is deterministic, the same
+	 * Config always creates the same Scene on every platform.
+	 *
+	 * @note	the Components that need graphics resources (MeshComponents
+	 *			and ParticleSystemComponents) are only added if the
+	 *			Application has a GraphicsEngine. The terrains only have
+	 *			a RigidBodyComponent with a TerrainCollider
+	 */
+	class SceneGenerator
+	{
+	public:		// Nested types
+		using RenderableShaderResource =
+			Repository::ResourceRef<RenderableShader>;
+
+		/** Struct Config, holds the number of Entities of each kind to
+		 * generate */
+		struct Config
+		{
+			/** The seed used for generating the random values */
+			unsigned int seed = 0;
+
+			/** The length of the sides of the area where the Entities are
+			 * going to be placed */
+			float worldSize = 200.0f;
+
+			/** The number of dynamic RigidBodies with convex Colliders */
+			std::size_t numConvexBodies = 0;
+
+			/** The number of static RigidBodies with TriangleMeshColliders */
+			std::size_t numMeshBodies = 0;
+
+			/** The number of static RigidBodies with TerrainColliders */
+			std::size_t numTerrains = 0;
+
+			/** The number of vertices in each side of the terrains */
+			std::size_t terrainResolution = 32;
+
+			/** The number of animated characters with a SkinComponent */
+			std::size_t numCharacters = 0;
+
+			/** The number of bones of each character */
+			std::size_t numBonesPerCharacter = 16;
+
+			/** The number of ParticleSystemComponents */
+			std::size_t numParticleEmitters = 0;
+
+			/** The number of LightComponents */
+			std::size_t numLights = 0;
+
+			/** The number of Entities with only a MeshComponent */
+			std::size_t numStaticMeshes = 0;
+
+			/** The shader added to all the generated Meshes, Terrains and
+			 * ParticleSystems. If it isn't set they won't be drawn */
+			RenderableShaderResource shader = {};
+		};
+
+	public:		// Functions
+		/** Creates a Config for generating a Scene with the given number of
+		 * Entities with the default proportions of each kind of Entity
+		 *
+		 * @param	numEntities the total number of Entities to generate
+		 * @param	seed the seed used for generating the random values
+		 * @return	the new Config */
+		static Config createConfig(std::size_t numEntities, unsigned int seed);
+
+		/** Populates the given Scene with the Entities described by the
+		 * given Config
+		 *
+		 * @param	config the Config with the Entities to generate
+		 * @param	output the Scene where the Entities and their resources
+		 *			will be stored
+		 * @return	a Result object with the result of the generation */
+		static Result generate(const Config& config, Scene& output);
+	};
+
+}
+
+#endif		// SCENE_GENERATOR_H
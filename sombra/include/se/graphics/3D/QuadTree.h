@@ -5,6 +5,7 @@
 #include <memory>
 #include <glm/glm.hpp>
 #include "../../utils/PackedVector.h"
+#include "../../utils/MemoryTracker.h"
 
 namespace se::graphics {
 
@@ -45,6 +46,12 @@ namespace se::graphics {
 			std::array<int, 4> neighboursLods = { -1, -1, -1, -1 };
 		};
 
+		/** The container of the Nodes, its memory is tracked with the
+		 * MemoryTag::Graphics tag */
+		using NodeVector = utils::PackedVector<
+			Node, utils::TrackedAllocator<Node, utils::MemoryTag::Graphics>
+		>;
+
 		/** Each of the directions of a Node */
 		enum class Direction : int
 		{ Bottom = 0, Top, Left, Right, NumDirections };
@@ -62,7 +69,7 @@ namespace se::graphics {
 		std::vector<float> mLodDistances;
 
 		/** All the nodes of the QuadTree */
-		utils::PackedVector<Node> mNodes;
+		NodeVector mNodes;
 
 	public:		// Functions
 		/** Creates a new QuadTree
@@ -94,7 +101,7 @@ namespace se::graphics {
 		void setLodDistances(const std::vector<float>& lodDistances);
 
 		/** @return	the root Node of the QuadTree */
-		const utils::PackedVector<Node>& getNodes() const { return mNodes; };
+		const NodeVector& getNodes() const { return mNodes; };
 
 		/** Updates the QuadTree nodes depending on the distance to the
 		 * highestLodLocation and the level of details
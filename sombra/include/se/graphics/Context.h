@@ -6,6 +6,7 @@
 #include <memory>
 #include <functional>
 #include "se/utils/PackedVector.h"
+#include "se/utils/MemoryTracker.h"
 #include "core/Bindable.h"
 
 namespace se::graphics {
@@ -42,8 +43,12 @@ namespace se::graphics {
 		/** The number of Bindable types */
 		static uint32_t sBindableTypeCount;
 
-		/** All the bindables of the Context */
-		utils::PackedVector<BindableResource> mBindables;
+		/** All the bindables of the Context, its memory is tracked with the
+		 * MemoryTag::Graphics tag */
+		utils::PackedVector<
+			BindableResource,
+			utils::TrackedAllocator<BindableResource, utils::MemoryTag::Graphics>
+		> mBindables;
 
 		/** The Command Queue (FIFO) used for interacting with the Graphics API
 		 * or @see mBindables */
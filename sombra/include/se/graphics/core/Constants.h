@@ -208,6 +208,56 @@ namespace se::graphics {
 	}
 
 
+	/** Returns the number of bytes used by each texel of the given
+	 * ColorFormat
+	 *
+	 * @param	format the ColorFormat to check
+	 * @param	type the type of each component, it's only used with the
+	 *			unsized ColorFormats
+	 * @return	the size of a texel in bytes */
+	constexpr std::size_t toTexelSize(ColorFormat format, TypeId type)
+	{
+		switch (format) {
+			case ColorFormat::Stencil8:
+			case ColorFormat::R8:
+				return 1;
+			case ColorFormat::Depth16:
+			case ColorFormat::R16ui:
+			case ColorFormat::R16f:
+			case ColorFormat::RG8:
+				return 2;
+			case ColorFormat::RGB8:
+				return 3;
+			case ColorFormat::Depth24:
+			case ColorFormat::Depth32:
+			case ColorFormat::Depth24Stencil8:
+			case ColorFormat::R32ui:
+			case ColorFormat::R32f:
+			case ColorFormat::RG16ui:
+			case ColorFormat::RG16f:
+			case ColorFormat::RGBA8:
+				return 4;
+			case ColorFormat::RGB16ui:
+			case ColorFormat::RGB16f:
+				return 6;
+			case ColorFormat::Depth32Stencil8:
+			case ColorFormat::RG32ui:
+			case ColorFormat::RG32f:
+			case ColorFormat::RGBA16ui:
+			case ColorFormat::RGBA16f:
+				return 8;
+			case ColorFormat::RGB32ui:
+			case ColorFormat::RGB32f:
+				return 12;
+			case ColorFormat::RGBA32ui:
+			case ColorFormat::RGBA32f:
+				return 16;
+			default:
+				return toNumberOfComponents(format) * toTypeSize(type);
+		}
+	}
+
+
 	/** Defines the interpolation method used for mipmapping if enabled */
 	enum class TextureFilter
 	{
@@ -25,6 +25,10 @@ namespace se::graphics {
 		/** The number of indices of the buffer */
 		std::size_t mIndexCount;
 
+		/** The number of bytes allocated for the buffer, they are reported
+		 * to the MemoryTracker with the MemoryTag::Mesh tag */
+		std::size_t mSize;
+
 	public:		// Functions
 		/** Creates a new IndexBuffer */
 		IndexBuffer();
@@ -35,6 +35,11 @@ namespace se::graphics {
 		/** If the texture has multiple mipmap levels or not */
 		bool mHasMipMaps;
 
+		/** The number of bytes of the first mipmap level of the texture,
+		 * they are reported to the MemoryTracker with the
+		 * MemoryTag::Texture tag */
+		std::size_t mImageSize;
+
 	public:		// Functions
 		/** Creates a new Texture
 		 *
@@ -231,6 +236,15 @@ namespace se::graphics {
 
 		/** Unbinds the Texture */
 		virtual void unbind() const override;
+	private:
+		/** Updates the number of bytes of the Texture, reporting the changes
+		 * to the MemoryTracker
+		 *
+		 * @param	imageSize the new number of bytes of the first mipmap
+		 *			level
+		 * @param	hasMipMaps if the Texture has multiple mipmap levels or
+		 *			not */
+		void updateMemory(std::size_t imageSize, bool hasMipMaps);
 	};
 
 }
@@ -19,6 +19,10 @@ namespace se::graphics {
 		/** The id of the Buffer Array */
 		unsigned int mBufferId;
 
+		/** The number of bytes allocated for the buffer, they are reported
+		 * to the MemoryTracker with the MemoryTag::Mesh tag */
+		std::size_t mSize;
+
 	public:		// Functions
 		/** Creates a new VertexBuffer */
 		VertexBuffer();
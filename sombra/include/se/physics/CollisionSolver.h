@@ -1,7 +1,8 @@
 #ifndef COLLISION_SOLVER_H
 #define COLLISION_SOLVER_H
 
-#include <unordered_map>
+#include <array>
+#include <vector>
 #include "constraints/NormalConstraint.h"
 #include "constraints/FrictionConstraint.h"
 #include "collision/CollisionDetector.h"
@@ -14,41 +15,67 @@ namespace se::physics {
 	/**
 	 * Class CollisionSolver, it's ICollisionListener used for creating and
 	 * removing Constraints used for solving the Collisions between the
-	 * RigidBodies
+	 * RigidBodies. The Constraints of each Contact are kept while the Contact
+	 * persists, so their lambda values are used as the initial ones of the
+	 * next updates (warm starting).
+	 *
+	 * The Constraints are pooled in flat arrays indexed by the Manifold
+	 * index and the Contact position inside it, so they are updated in
+	 * place, and the changes are sent to the ConstraintManager all at once
+	 * in the next update.
 	 */
 	class CollisionSolver : public ICollisionListener
 	{
 	private:	// Nested types
-		/** Holds the indices of all the Constraints per Contact */
-		struct ContactConstraintIndices
+		/** Holds the state of the Constraints of a Contact of a Manifold */
+		struct ContactSlot
 		{
-			std::size_t iNormalConstraint;
-			std::size_t iFrictionConstraints[2];
+			/** The identifier of the Contact */
+			std::uint32_t contactId = 0;
+
+			/** If the Contact is used by the Manifold or not */
+			bool active = false;
+
+			/** If the Constraints are added to the ConstraintManager */
+			bool registered = false;
+
+			/** If the Contact was added to @see mDirtyContactSlots */
+			bool dirty = false;
 		};
 
-		using ManifoldConstraintIndices = utils::FixedVector<
-			ContactConstraintIndices, Manifold::kMaxContacts
-		>;
+		using ColliderPair = std::array<const Collider*, 2>;
 
 	private:	// Attributes
 		/** A reference to the RigidBodyWorld that holds the RigidBodies */
 		RigidBodyWorld& mParentWorld;
 
-		/** Maps each Manifold with the indices of the Constraints generated
-		 * as a consecuence of the collisions */
-		std::unordered_map<
-			const Manifold*, ManifoldConstraintIndices
-		> mManifoldConstraintIndicesMap;
-
-		/** The NormalConstraints of all the Contacts */
-		utils::PackedVector<NormalConstraint> mContactNormalConstraints;
-
-		/** The FrictionConstraints of all the Contacts */
-		utils::PackedVector<FrictionConstraint> mContactFrictionConstraints;
-
-		/** The mutex used for protecting @see mManifoldConstraintIndicesMap,
-		 * @see mContactNormalConstraints and
-		 * @see mContactFrictionConstraints */
+		/** The Colliders of the Manifold of each Manifold index, nullptr
+		 * if it isn't used */
+		std::vector<ColliderPair> mManifoldColliders;
+
+		/** The state of each Contact, stored as
+		 * [manifold index * Manifold::kMaxContacts + Contact position] */
+		std::vector<ContactSlot> mContactSlots;
+
+		/** The NormalConstraint of each Contact, with the same layout than
+		 * @see mContactSlots */
+		std::vector<
+			NormalConstraint,
+			utils::TrackedAllocator<NormalConstraint, utils::MemoryTag::Physics>
+		> mContactNormalConstraints;
+
+		/** The two FrictionConstraints of each Contact, with the same layout
+		 * than @see mContactSlots */
+		std::vector<
+			std::array<FrictionConstraint, 2>,
+			utils::TrackedAllocator<std::array<FrictionConstraint, 2>, utils::MemoryTag::Physics>
+		> mContactFrictionConstraints;
+
+		/** The indices of the Contacts that were added or removed since the
+		 * last update */
+		std::vector<std::size_t> mDirtyContactSlots;
+
+		/** The mutex used for protecting all the Contact data */
 		mutable std::mutex mMutex;
 
 	public:		// Functions
@@ -61,8 +88,10 @@ namespace se::physics {
 		/** Class destructor */
 		~CollisionSolver();
 
-		/** @copydoc ICollisionListener::onCollision(const Manifold&) */
-		virtual void onCollision(const Manifold& manidold) override;
+		/** @copydoc ICollisionListener::onCollision(const Manifold&, std::size_t) */
+		virtual void onCollision(
+			const Manifold& manifold, std::size_t manifoldIndex
+		) override;
 
 		/** Removes all the Manifolds and Collision Constraints that references
 		 * the given RigidBody
@@ -70,7 +99,15 @@ namespace se::physics {
 		 * @param	rigidBody a pointer to the RigidBody to remove */
 		void removeRigidBody(const RigidBody* rigidBody);
 
-		/** Solves the Constraints between the RigidBodies of the entities
+		/** Removes all the Collision Constraints of the Manifolds that
+		 * references the given Collider
+		 *
+		 * @param	collider a pointer to the Collider to remove, it's only
+		 *			compared so it can be already destroyed */
+		void removeCollider(const Collider* collider);
+
+		/** Adds and removes the Constraints of the Contacts changed since the
+		 * last update to the ConstraintManager and updates them
 		 *
 		 * @param	deltaTime the elapsed time since the last update in
 		 *			seconds */
@@ -79,13 +116,28 @@ namespace se::physics {
 		/** Adds contact constraints to the CollisionSolver for resolving the
 		 * collision detected in the given contact Manifold
 		 *
-		 * @param	manifold the contact Manifold */
-		void handleIntersectingManifold(const Manifold& manifold);
+		 * @param	manifold the contact Manifold
+		 * @param	manifoldIndex the index of the Manifold */
+		void handleIntersectingManifold(
+			const Manifold& manifold, std::size_t manifoldIndex
+		);
 
 		/** Removes all the Manifold contact constraints from the CollisionSolver
 		 *
-		 * @param	manifold the contact Manifold */
-		void handleDisjointManifold(const Manifold& manifold);
+		 * @param	manifoldIndex the index of the Manifold */
+		void handleDisjointManifold(std::size_t manifoldIndex);
+
+		/** Marks the Constraints of a Contact as added or removed, so the
+		 * change is sent to the ConstraintManager in the next update
+		 *
+		 * @param	iContactSlot the index of the Contact
+		 * @param	active if the Contact must be added (true) or removed
+		 *			(false) */
+		void setContactActive(std::size_t iContactSlot, bool active);
+
+		/** Sends the Constraints of the Contacts changed since the last
+		 * update to the ConstraintManager */
+		void flushContactChanges();
 	};
 
 }
@@ -59,6 +59,12 @@ namespace se::physics {
 		 * put to Sleeping state (only used with dynamic RigidBodies) */
 		float sleepMotion = 0.001f;
 
+		/** If the RigidBody must use continuous collision detection or not
+		 * (only used with dynamic RigidBodies with a ConvexCollider). It
+		 * prevents fast RigidBodies from passing through thin Colliders, at
+		 * the cost of a shape cast in each update where they move fast */
+		bool continuousCollisionDetection = false;
+
 		/** Unused property, it can be used by the client program to store
 		 * stuff */
 		void* userData = nullptr;
@@ -133,6 +139,7 @@ namespace se::physics {
 	public:		// Nested types
 		friend class RigidBodyDynamics;
 		friend class ConstraintIsland;
+		friend class RigidBodyStateStore;
 		using ForceSPtr = std::shared_ptr<Force>;
 		using ColliderUPtr = std::unique_ptr<Collider>;
 
@@ -2,6 +2,8 @@
 #define RIGID_BODY_WORLD_H
 
 #include <mutex>
+#include <memory>
+#include <functional>
 #include "../utils/ThreadPool.h"
 #include "collision/CollisionDetector.h"
 #include "constraints/ConstraintManager.h"
@@ -43,6 +45,11 @@ namespace se::physics {
 		 * used for checking if a contact is the same than another one */
 		float contactSeparation = 0.00001f;
 
+		/** The maximum distance between the local coordinates of a Contact
+		 * and the ones of a Contact of the previous update for treating them
+		 * as the same Contact, so its solved values are reused */
+		float contactMatchDistance = 0.02f;
+
 		/** The precision of the calculated ray casts */
 		float raycastPrecision = 0.0000001f;
 
@@ -62,6 +69,12 @@ namespace se::physics {
 		/** The gravity acceleration value of all the FrictionConstraints */
 		float frictionGravityAcceleration = 9.8f;
 
+		/** The minimum displacement of a RigidBody with continuous collision
+		 * detection in an update, relative to the smallest size of its
+		 * Collider AABB, needed for checking if it passed through any other
+		 * Collider */
+		float continuousCollisionThreshold = 0.25f;
+
 		/** The number of substeps executed per update */
 		std::size_t numSubsteps = 4;
 
@@ -69,17 +82,52 @@ namespace se::physics {
 		 * should run for solving the Constraints */
 		std::size_t maxConstraintIterations = 1;
 
+		/** The factor applied to the lambda values of the contact Constraints
+		 * calculated in the last substep before using them as the initial
+		 * ones of the Gauss-Seidel algorithm, 0 for disabling the warm
+		 * starting. The lambda values also hold the penetration corrections,
+		 * so using them fully makes the stacked RigidBodies topple */
+		float warmStartingFactor = 0.85f;
+
+		/** The minimum number of Constraints of a ConstraintIsland for
+		 * solving it with the parallel graph colored solver, 0 for never
+		 * using it */
+		std::size_t minParallelSolverConstraints = 256;
+
 		/** The number of threads to use */
 		std::size_t numThreads = 8;
+
+		/** The distance added in every direction to the AABBs of the
+		 * Colliders during the coarse collision detection step, so they
+		 * don't need to be updated in every movement */
+		float coarseCollisionAABBMargin = 0.1f;
+
+		/** The multiplier of the displacement of the Colliders in each update
+		 * used for enlarging their coarse collision AABBs in the direction
+		 * of their movement */
+		float coarseCollisionDisplacementMultiplier = 2.0f;
+
+		/** The number of updates between each full rebuild of the coarse
+		 * collision AABB Tree, 0 for never rebuilding it */
+		std::size_t coarseCollisionRebuildInterval = 0;
 	};
 
 
+	class RigidBodyStateStore;
+
+
 	/**
 	 * Class RigidBodyWorld, it holds all the properties, RigidBodies and
 	 * Constraints of a simulation
 	 */
 	class RigidBodyWorld
 	{
+	public:		// Nested types
+		/** The minimum number of RigidBodies updated by each thread */
+		static constexpr std::size_t kMinRigidBodiesPerThread = 64;
+	private:
+		using BatchCallback = std::function<void(std::size_t, std::size_t)>;
+
 	private:	// Attributes
 		/** All the properties of the RigidBodyWorld */
 		const WorldProperties mProperties;
@@ -105,6 +153,13 @@ namespace se::physics {
 		/** The pointers to the Colliders of each RigidBody */
 		std::vector<Collider*> mRigidBodiesColliders;
 
+		/** The RigidBodies integrated in the current substep */
+		std::vector<RigidBody*> mActiveRigidBodies;
+
+		/** The states of @see mActiveRigidBodies in Structure of Arrays
+		 * layout, used for integrating them in parallel */
+		std::unique_ptr<RigidBodyStateStore> mStateStore;
+
 		/** The mutex used for protecting @see mRigidBodies and
 		 * @see mRigidBodiesColliders */
 		std::mutex mMutex;
@@ -153,6 +208,30 @@ namespace se::physics {
 		 * @param	deltaTime the elapsed time since the last simulation of
 		 *			the RigidBodies in seconds */
 		void update(float deltaTime);
+	private:
+		/** Splits the given number of elements between the threads of the
+		 * ThreadPool and processes them with the given callback. The first
+		 * chunk is processed by the calling thread
+		 *
+		 * @param	numElements the number of elements to process
+		 * @param	callback the function used for processing the elements,
+		 *			its parameters are the index of the first element and the
+		 *			index after the last one */
+		void processBatch(std::size_t numElements, const BatchCallback& callback);
+
+		/** Checks if the given RigidBody passed through any other Collider
+		 * in the current update. In that case the RigidBody is moved back to
+		 * the time of impact and its velocity towards the hit Collider is
+		 * removed, so the collision is resolved in the next updates
+		 *
+		 * @param	rigidBody the RigidBody with continuous collision
+		 *			detection to check
+		 * @param	initialPosition the position of the RigidBody at the
+		 *			start of the update, its Collider must be still located
+		 *			there */
+		void processContinuousCollision(
+			RigidBody& rigidBody, const glm::vec3& initialPosition
+		);
 	};
 
 }
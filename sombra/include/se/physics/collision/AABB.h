@@ -55,6 +55,14 @@ namespace se::physics {
 	bool isInside(const AABB& aabb, const glm::vec3& point, float epsilon);
 
 
+	/** Checks if the second AABB is completely inside the first one
+	 *
+	 * @param	aabb1 the AABB that should contain the other one
+	 * @param	aabb2 the AABB to test
+	 * @return	true if aabb2 is inside aabb1, false otherwise */
+	bool contains(const AABB& aabb1, const AABB& aabb2);
+
+
 	/** Creates a new AABB by computing the AABB of the transformed initial AABB
 	 *
 	 * @param	aabb the initial AABB
@@ -33,6 +33,10 @@ namespace se::physics {
 		/** @copydoc Collider::clone() */
 		virtual std::unique_ptr<Collider> clone() const override
 		{ return std::make_unique<BoundingBox>(*this); };
+
+		/** @copydoc Collider::getType() */
+		virtual ColliderType getType() const override
+		{ return ColliderType::BoundingBox; };
 	private:
 		/** Calculates the HalfEdgeMesh of the BoundingBox from its lenghts in
 		 * each axis
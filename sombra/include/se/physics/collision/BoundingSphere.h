@@ -42,6 +42,10 @@ namespace se::physics {
 		virtual std::unique_ptr<Collider> clone() const override
 		{ return std::make_unique<BoundingSphere>(*this); };
 
+		/** @copydoc Collider::getType() */
+		virtual ColliderType getType() const override
+		{ return ColliderType::BoundingSphere; };
+
 		/** @copydoc Collider::setTransforms() */
 		void setTransforms(const glm::mat4& transforms) override;
 
@@ -51,6 +51,10 @@ namespace se::physics {
 		virtual std::unique_ptr<Collider> clone() const override
 		{ return std::make_unique<Capsule>(*this); };
 
+		/** @copydoc Collider::getType() */
+		virtual ColliderType getType() const override
+		{ return ColliderType::Capsule; };
+
 		/** @copydoc Collider::setTransforms() */
 		void setTransforms(const glm::mat4& transforms) override;
 
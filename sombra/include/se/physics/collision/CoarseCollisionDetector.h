@@ -2,9 +2,13 @@
 #define COARSE_COLLISION_DETECTOR_H
 
 #include <memory>
+#include <vector>
 #include <functional>
 #include "../../utils/PackedVector.h"
-#include "Ray.h"
+#include "../../utils/MemoryTracker.h"
+#include "AABB.h"
+
+namespace se::utils { class ThreadPool; }
 
 namespace se::physics {
 
@@ -14,37 +18,135 @@ namespace se::physics {
 
 	/**
 	 * Class CoarseCollisionDetector, it's used to detect which colliders are
-	 * intersecting by their AABBs using an AABB Tree
+	 * intersecting by their AABBs using an AABB Tree. The Tree stores
+	 * enlarged ("fat") AABBs of the Colliders, so the Colliders that move
+	 * only need to be reinserted when their AABB leaves the fat one.
+	 *
+	 * The intersecting Colliders are also stored in a persistent pair cache
+	 * that is updated incrementally, only the Colliders that have moved
+	 * search for new intersections in the AABB Tree. These searches can be
+	 * done in parallel, the result is always the same than the serial one
 	 */
 	class CoarseCollisionDetector
 	{
 	public:		// Nested types
 		using CollisionCallback = std::function<void(Collider*, Collider*)>;
 		using ColliderCallback = std::function<void(Collider*)>;
+
+		/** The states of the pairs of the pair cache */
+		enum class PairState
+		{
+			Begin,		///< The AABBs started to intersect in the last update
+			Persist,	///< The AABBs were already intersecting
+			End			///< The AABBs stopped intersecting in the last update
+		};
+
+		/** Holds a pair of Colliders whose AABBs are intersecting */
+		struct ColliderPair
+		{
+			/** The value of @see userData when it isn't set */
+			static constexpr std::size_t kNoUserData =
+				static_cast<std::size_t>(-1);
+
+			/** The indices of the Colliders in the CoarseCollisionDetector,
+			 * the first one is always smaller than the second one. The pairs
+			 * are sorted by them */
+			std::size_t colliderIndices[2];
+
+			/** The Colliders of the pair, in the same order than
+			 * @see colliderIndices */
+			Collider* colliders[2];
+
+			/** The state of the pair */
+			PairState state;
+
+			/** Data of the user of the CoarseCollisionDetector, it's kept
+			 * until the pair is removed */
+			std::size_t userData = kNoUserData;
+		};
 	private:
 		/** Holds cached data of a Collider */
 		struct ColliderData
 		{
 			Collider* collider;
 			std::size_t nodeId;
+			AABB aabb;				///< The AABB at the last update
+			bool moved = true;		///< If it must search for new pairs
 		};
 
 	public:	// Attributes
+		/** The maximum ratio between the area of the AABB stored in the AABB
+		 * Tree and the area of the fat AABB of a Collider before the first
+		 * one is shrunk */
+		static constexpr float kMaxFatAreaRatio = 4.0f;
+
+		/** The minimum number of moved Colliders that each thread must
+		 * process when searching for new pairs in parallel */
+		static constexpr std::size_t kMinMovedCollidersPerThread = 128;
+
 		/** The epsilon value used for the comparisons */
 		float mEpsilon;
 
+		/** The distance added in every direction to the AABBs of the
+		 * Colliders stored in the AABB Tree */
+		float mAABBMargin;
+
+		/** The multiplier of the displacement of the Colliders since the
+		 * last update used for enlarging their AABBs in the direction of
+		 * their movement */
+		float mDisplacementMultiplier;
+
+		/** The number of updates between each full rebuild of the AABB Tree,
+		 * 0 for never rebuilding it */
+		std::size_t mRebuildInterval;
+
+		/** The number of updates since the last rebuild of the AABB Tree */
+		std::size_t mUpdatesSinceRebuild;
+
 		/** The Colliders to check if they collide between each other */
-		utils::PackedVector<ColliderData> mColliders;
+		utils::PackedVector<
+			ColliderData,
+			utils::TrackedAllocator<ColliderData, utils::MemoryTag::Physics>
+		> mColliders;
 
 		/** The AABB Tree used for the coarse collision detection, the user
 		 * data is an index to a Collider in @see mColliders */
 		std::unique_ptr<AABBAVLTree<std::size_t>> mAABBTree;
 
+		/** The pairs of Colliders whose AABBs are intersecting, sorted by
+		 * their Collider indices */
+		std::vector<ColliderPair> mPairs;
+
+		/** The indices of the Colliders that have moved in the current
+		 * update */
+		std::vector<std::size_t> mMovedColliders;
+
+		/** The pairs found in the current update by the Colliders that have
+		 * moved */
+		std::vector<ColliderPair> mNewPairs;
+
+		/** The pairs found by each thread in the current update */
+		std::vector<std::vector<ColliderPair>> mThreadPairs;
+
+		/** The vector used for merging @see mPairs with @see mNewPairs */
+		std::vector<ColliderPair> mMergedPairs;
+
 	public:	// Functions
 		/** Creates a new CoarseCollisionDetector
 		 *
-		 * @param	epsilon the Epsilon value used for the tests */
-		CoarseCollisionDetector(float epsilon);
+		 * @param	epsilon the Epsilon value used for the tests
+		 * @param	aabbMargin the distance added in every direction to the
+		 *			AABBs of the Colliders stored in the AABB Tree
+		 * @param	displacementMultiplier the multiplier of the displacement
+		 *			of the Colliders used for enlarging their AABBs in the
+		 *			direction of their movement
+		 * @param	rebuildInterval the number of updates between each full
+		 *			rebuild of the AABB Tree, 0 for never rebuilding it */
+		CoarseCollisionDetector(
+			float epsilon, float aabbMargin = 0.1f,
+			float displacementMultiplier = 2.0f,
+			std::size_t rebuildInterval = 0
+		);
 
 		/** Class destructor */
 		~CoarseCollisionDetector();
@@ -68,13 +170,37 @@ namespace se::physics {
 		void remove(Collider* collider);
 
 		/** Updates the Detector with the movement of the Colliders, this must
-		 * be called at every clock tick */
-		void update();
+		 * be called at every clock tick. It also updates the pair cache, the
+		 * pairs that ended in the previous update are removed from it
+		 *
+		 * @param	threadPool the ThreadPool used for searching the new
+		 *			pairs in parallel, nullptr for searching them in the
+		 *			calling thread
+		 * @param	numThreads the maximum number of tasks to submit to the
+		 *			ThreadPool */
+		void update(
+			utils::ThreadPool* threadPool = nullptr,
+			std::size_t numThreads = 1
+		);
+
+		/** @return	the pairs of Colliders whose AABBs were intersecting or
+		 *			stopped intersecting in the last update, sorted by their
+		 *			Collider indices */
+		std::vector<ColliderPair>& getPairs() { return mPairs; };
 
-		/** Calculates all the Colliders that are currently intersecting
+		/** @return	the pairs of Colliders whose AABBs were intersecting or
+		 *			stopped intersecting in the last update, sorted by their
+		 *			Collider indices */
+		const std::vector<ColliderPair>& getPairs() const
+		{ return mPairs; };
+
+		/** Calculates all the Colliders whose AABBs are currently
+		 * intersecting by traversing the whole AABB Tree
 		 *
 		 * @param	callback the function that must be called for
-		 *			every pair of Colliders intersecting */
+		 *			every pair of Colliders intersecting
+		 * @note	the pair cache should be used instead
+		 * @see		getPairs */
 		void calculateCollisions(const CollisionCallback& callback) const;
 
 		/** Calculates all the Colliders that are currently intersecting with
@@ -86,6 +212,44 @@ namespace se::physics {
 		void calculateIntersections(
 			const Ray& ray, const ColliderCallback& callback
 		) const;
+
+		/** Calculates all the Colliders whose AABBs are currently
+		 * overlapping with the given AABB
+		 *
+		 * @param	aabb the AABB to test
+		 * @param	callback the function that must be called for each
+		 *			of the Colliders overlapping with the AABB */
+		void calculateOverlaps(
+			const AABB& aabb, const ColliderCallback& callback
+		) const;
+	private:
+		/** Calculates the enlarged AABB to store in the AABB Tree
+		 *
+		 * @param	aabb the AABB of the Collider
+		 * @param	displacement the displacement of the Collider since the
+		 *			last update
+		 * @return	the fat AABB */
+		AABB calculateFatAABB(
+			const AABB& aabb, const glm::vec3& displacement
+		) const;
+
+		/** Updates the pair cache with the Colliders that have moved
+		 *
+		 * @param	threadPool the ThreadPool used for searching the new
+		 *			pairs, it can be nullptr
+		 * @param	numThreads the maximum number of tasks to submit to the
+		 *			ThreadPool */
+		void updatePairs(utils::ThreadPool* threadPool, std::size_t numThreads);
+
+		/** Searches the new pairs of a range of the moved Colliders
+		 *
+		 * @param	iStart the index of the first moved Collider to process
+		 * @param	iEnd the index after the last moved Collider to process
+		 * @param	output the vector where the new pairs will be appended */
+		void findNewPairs(
+			std::size_t iStart, std::size_t iEnd,
+			std::vector<ColliderPair>& output
+		) const;
 	};
 
 }
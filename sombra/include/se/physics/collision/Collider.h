@@ -11,6 +11,19 @@ namespace se::physics {
 	class RigidBody;
 
 
+	/** The types of Colliders used for selecting the algorithms that
+	 * calculate the collisions between them */
+	enum class ColliderType : int
+	{
+		BoundingSphere = 0,	///< A BoundingSphere
+		Capsule,			///< A Capsule
+		BoundingBox,		///< A BoundingBox
+		Convex,				///< Any other ConvexCollider
+		Concave,			///< Any ConcaveCollider
+		Count				///< The number of ColliderTypes
+	};
+
+
 	/**
 	 * Class Collider, a Collider is used to store the basic data of an object
 	 * that can collide with other Colliders
@@ -75,6 +88,9 @@ namespace se::physics {
 		/** @return	the layers of the Collider */
 		std::bitset<kMaxLayers> getLayers() const { return mLayers; };
 
+		/** @return	the ColliderType of the Collider */
+		virtual ColliderType getType() const = 0;
+
 		/** Updates the scale, translation and orientation of the Collider
 		 * with the data of the given transformations matrix
 		 *
@@ -3,14 +3,18 @@
 
 #include <map>
 #include <mutex>
+#include <limits>
+#include <unordered_map>
 #include "CoarseCollisionDetector.h"
 #include "FineCollisionDetector.h"
 #include "../../utils/MathUtils.h"
 #include "../../utils/PackedVector.h"
+#include "../../utils/MemoryTracker.h"
 
 namespace se::physics {
 
 	class RigidBodyWorld;
+	class QuerySnapshot;
 
 
 	/**
@@ -25,8 +29,14 @@ namespace se::physics {
 
 		/** Function called per collision Manifold updated
 		 *
-		 * @param	manifold the Manifold updated */
-		virtual void onCollision(const Manifold& manidold) = 0;
+		 * @param	manifold the Manifold updated
+		 * @param	manifoldIndex the index of the Manifold in the
+		 *			CollisionDetector. It doesn't change while the Manifold
+		 *			exists, and it's always lower than
+		 *			WorldProperties::maxCollidingRBs */
+		virtual void onCollision(
+			const Manifold& manifold, std::size_t manifoldIndex
+		) = 0;
 	};
 
 
@@ -44,11 +54,40 @@ namespace se::physics {
 	{
 	public:		// Nested types
 		using RayCastCallback = std::function<void(Collider*, const RayHit&)>;
+		using LayerMask = std::bitset<Collider::kMaxLayers>;
+		using RayCastResult = std::pair<Collider*, RayHit>;
+
+		/** Holds the input of a shape cast */
+		struct ShapeCast
+		{
+			/** The shape to move, located at its initial position */
+			const ConvexCollider* shape;
+
+			/** The normalized direction in which the shape is moved */
+			glm::vec3 direction;
+		};
+
+		/** The minimum number of queries processed by each thread in the
+		 * batched queries */
+		static constexpr std::size_t kMinQueriesPerThread = 16;
 	private:
-		using ColliderPair = std::pair<const Collider*, const Collider*>;
+		using BatchCallback = std::function<void(std::size_t, std::size_t)>;
+		using CastCallback = std::function<
+			std::pair<bool, RayHit>(const Collider&, float)
+		>;
+
+		using ColliderPair = CoarseCollisionDetector::ColliderPair;
 		using ManifoldUPtr = std::unique_ptr<Manifold>;
 		using ManifoldCallback = std::function<void(const Manifold&)>;
 
+		/** Holds a new Manifold and the index of the pair of the
+		 * CoarseCollisionDetector of its Colliders */
+		struct NewManifold
+		{
+			std::size_t pairIndex;
+			Manifold manifold;
+		};
+
 	private:	// Attributes
 		/** A reference to the RigidBodyWorld that holds the RigidBodies */
 		RigidBodyWorld& mParentWorld;
@@ -62,25 +101,36 @@ namespace se::physics {
 		 * it to generate all the contact data */
 		FineCollisionDetector mFineCollisionDetector;
 
-		/** The Colliders that are colliding in the coarse collision detection
-		 * step */
-		std::vector<ColliderPair> mCoarseCollidersColliding;
-
-		/** All the Manifolds that the CollisionDetector can hold */
-		utils::PackedVector<Manifold> mManifolds;
+		/** The indices of the pairs of the CoarseCollisionDetector that must
+		 * be checked in the fine collision detection step */
+		std::vector<std::size_t> mCoarsePairIndices;
 
-		/** Maps a pair of Colliders with the index of the Manifold of their
-		 * collision */
-		std::unordered_map<ColliderPair, std::size_t, utils::PairHash>
-			mCollidersManifoldMap;
+		/** All the Manifolds that the CollisionDetector can hold. The index
+		 * of the Manifold of each pair of Colliders is stored as the user
+		 * data of their CoarseCollisionDetector pair */
+		utils::PackedVector<
+			Manifold, utils::TrackedAllocator<Manifold, utils::MemoryTag::Physics>
+		> mManifolds;
 
 		/** The listeners added to the CollisionDetector */
 		std::vector<ICollisionListener*> mListeners;
 
+		/** The copies of the Colliders used by the last QuerySnapshot. The
+		 * copies of the Colliders updated since then are removed, so only
+		 * them are copied again by @see updateQuerySnapshot */
+		std::unordered_map<
+			const Collider*, std::shared_ptr<const Collider>
+		> mColliderCopies;
+
 		/** The mutex used for protecting @see mCoarseCollisionDetector,
-		 * @see mManifolds, @see mCollidersManifoldMap and @see mListeners */
+		 * @see mManifolds, @see mListeners and @see mColliderCopies */
 		std::mutex mMutex;
 
+		/** The snapshot of the Colliders used by the scene queries. It's
+		 * replaced atomically, so the queries don't need to lock
+		 * @see mMutex */
+		std::shared_ptr<const QuerySnapshot> mQuerySnapshot;
+
 	public:		// Functions
 		/** Creates a new CollisionDetector
 		 *
@@ -92,6 +142,11 @@ namespace se::physics {
 		 * the RigidBodies */
 		void update();
 
+		/** Replaces the snapshot of the Colliders used by the scene queries
+		 * with one of their current state. It's called by the RigidBodyWorld
+		 * at the end of each update, once the Colliders have been moved */
+		void updateQuerySnapshot();
+
 		/** Adds the given Collider to the CollisionDetection so it will check
 		 * if it collides or intersects
 		 *
@@ -130,6 +185,153 @@ namespace se::physics {
 		 *			if it didn't intersect anything, and a RayCast object with
 		 *			the result of the RayCast */
 		std::pair<Collider*, RayHit> rayCastFirst(const Ray& ray);
+
+		/** Calculates the first intersection of each of the given rays in
+		 * parallel. Unlike @see rayCastFirst it doesn't lock the
+		 * CollisionDetector, the rays are tested against the snapshot of the
+		 * Colliders taken at the end of the last RigidBodyWorld update, so
+		 * it can be called from multiple threads at the same time, even
+		 * during a RigidBodyWorld update. The Colliders added since then
+		 * won't be tested, and the changes made to the other ones won't be
+		 * seen until the next update
+		 *
+		 * @param	rays a pointer to the rays to test
+		 * @param	numRays the number of rays
+		 * @param	results a pointer to the array where the result of each
+		 *			ray will be stored, with the same format than
+		 *			@see rayCastFirst. It must have space for numRays
+		 *			results
+		 * @param	maxDistance the maximum distance along the direction of
+		 *			the rays of the intersections
+		 * @param	layers only the Colliders with any of this layers will
+		 *			be tested
+		 * @note	the returned Colliders are the ones added to the
+		 *			CollisionDetector, so they must be checked before using
+		 *			them if they can be destroyed from other threads. It
+		 *			mustn't be called from a task of the ThreadPool of the
+		 *			RigidBodyWorld */
+		void rayCastBatch(
+			const Ray* rays, std::size_t numRays, RayCastResult* results,
+			float maxDistance = std::numeric_limits<float>::max(),
+			const LayerMask& layers = LayerMask().set()
+		) const;
+
+		/** Calculates the first Collider hit by the given shape when it's
+		 * moved in the given direction. Like @see rayCastBatch it doesn't
+		 * lock the CollisionDetector, and it has the same restrictions
+		 *
+		 * @param	shape the shape to move, located at its initial position.
+		 *			It can be a BoundingSphere, Capsule, BoundingBox,
+		 *			ConvexPolyhedron or any other ConvexCollider. If it's
+		 *			added to the CollisionDetector it will be ignored
+		 * @param	direction the normalized direction of the movement
+		 * @param	maxDistance the maximum displacement of the shape
+		 * @param	layers only the Colliders with any of this layers will
+		 *			be tested
+		 * @return	a pair with a pointer to the hit Collider, nullptr if it
+		 *			didn't hit anything, and a RayHit object with the
+		 *			displacement of the shape until the time of impact as
+		 *			its distance, and the contact point and normal on the
+		 *			surface of the hit Collider. The normal is zero if the
+		 *			shape was already intersecting the Collider */
+		RayCastResult shapeCastFirst(
+			const ConvexCollider& shape, const glm::vec3& direction,
+			float maxDistance = std::numeric_limits<float>::max(),
+			const LayerMask& layers = LayerMask().set()
+		) const;
+
+		/** Calculates @see shapeCastFirst for each of the given shape casts
+		 * in parallel
+		 *
+		 * @param	shapeCasts a pointer to the shape casts to test
+		 * @param	numShapeCasts the number of shape casts
+		 * @param	results a pointer to the array where the result of each
+		 *			shape cast will be stored. It must have space for
+		 *			numShapeCasts results
+		 * @param	maxDistance the maximum displacement of the shapes
+		 * @param	layers only the Colliders with any of this layers will
+		 *			be tested */
+		void shapeCastBatch(
+			const ShapeCast* shapeCasts, std::size_t numShapeCasts,
+			RayCastResult* results,
+			float maxDistance = std::numeric_limits<float>::max(),
+			const LayerMask& layers = LayerMask().set()
+		) const;
+
+		/** Calculates the Colliders that overlap with the given AABB. Like
+		 * @see rayCastBatch it doesn't lock the CollisionDetector, and it
+		 * has the same restrictions
+		 *
+		 * @param	aabb the AABB to test
+		 * @param	results a pointer to the array where the overlapping
+		 *			Colliders will be stored
+		 * @param	maxResults the maximum number of Colliders that can be
+		 *			stored in results, the remaining ones are discarded
+		 * @param	layers only the Colliders with any of this layers will
+		 *			be tested
+		 * @return	the number of Colliders stored in results */
+		std::size_t overlapAABB(
+			const AABB& aabb, Collider** results, std::size_t maxResults,
+			const LayerMask& layers = LayerMask().set()
+		) const;
+
+		/** Calculates the Colliders that overlap with the given sphere. Like
+		 * @see rayCastBatch it doesn't lock the CollisionDetector, and it
+		 * has the same restrictions
+		 *
+		 * @param	center the center of the sphere in world space
+		 * @param	radius the radius of the sphere
+		 * @param	results a pointer to the array where the overlapping
+		 *			Colliders will be stored
+		 * @param	maxResults the maximum number of Colliders that can be
+		 *			stored in results, the remaining ones are discarded
+		 * @param	layers only the Colliders with any of this layers will
+		 *			be tested
+		 * @return	the number of Colliders stored in results */
+		std::size_t overlapSphere(
+			const glm::vec3& center, float radius,
+			Collider** results, std::size_t maxResults,
+			const LayerMask& layers = LayerMask().set()
+		) const;
+
+		/** Calculates the Colliders that overlap with the given convex
+		 * shape. Like @see rayCastBatch it doesn't lock the
+		 * CollisionDetector, and it has the same restrictions
+		 *
+		 * @param	shape the shape to test, located at its world position.
+		 *			If it's added to the CollisionDetector it will be
+		 *			ignored
+		 * @param	results a pointer to the array where the overlapping
+		 *			Colliders will be stored
+		 * @param	maxResults the maximum number of Colliders that can be
+		 *			stored in results, the remaining ones are discarded
+		 * @param	layers only the Colliders with any of this layers will
+		 *			be tested
+		 * @return	the number of Colliders stored in results */
+		std::size_t overlapShape(
+			const ConvexCollider& shape,
+			Collider** results, std::size_t maxResults,
+			const LayerMask& layers = LayerMask().set()
+		) const;
+
+		/** Calculates the first Collider hit by the given Collider when it's
+		 * moved with the given displacement. It's used for the continuous
+		 * collision detection of the fast RigidBodies, so unlike
+		 * @see shapeCastFirst it uses the current state of the
+		 * CollisionDetector: the candidates are the Colliders whose AABBs
+		 * overlap the AABB of the Collider swept along the displacement
+		 *
+		 * @param	collider the Collider to move, located at its initial
+		 *			position. It must be added to the CollisionDetector
+		 * @param	displacement the movement of the Collider
+		 * @return	a pair with a pointer to the hit Collider, nullptr if it
+		 *			didn't hit anything, and a RayHit with the same format
+		 *			than the @see shapeCastFirst one. The Colliders that were
+		 *			already intersecting the given one are skipped, since their
+		 *			Contacts are resolved by the collision detection step */
+		RayCastResult calculateTimeOfImpact(
+			const ConvexCollider& collider, const glm::vec3& displacement
+		);
 	private:
 		/** Broad/Coarse collision detection step */
 		void broadCollisionDetection();
@@ -140,12 +342,49 @@ namespace se::physics {
 		/** Executes the narrow/Fine collision detection step for a single
 		 * Collider pair
 		 *
-		 * @param	pair the pair to detect its collisions
+		 * @param	pairIndex the index of the CoarseCollisionDetector pair
+		 *			to detect its collisions
 		 * @param	newManifolds a vector where the new Manifolds will be
 		 *			inserted */
 		void singleNarrowCollision(
-			const ColliderPair& pair, std::vector<Manifold>& newManifolds
+			std::size_t pairIndex, std::vector<NewManifold>& newManifolds
 		);
+
+		/** Splits the given queries between the calling thread and the
+		 * ThreadPool of the RigidBodyWorld, and waits until all of them
+		 * are processed
+		 *
+		 * @param	numQueries the number of queries
+		 * @param	callback the function used for processing the queries,
+		 *			its parameters are the index of the first query and the
+		 *			index after the last one */
+		void processBatch(
+			std::size_t numQueries, const BatchCallback& callback
+		) const;
+
+		/** Calculates the first intersection of an AABB centered at the
+		 * origin of the given ray with the Colliders of the given
+		 * QuerySnapshot when it's moved in the ray direction
+		 *
+		 * @param	snapshot the QuerySnapshot to test
+		 * @param	ray the ray to test
+		 * @param	halfExtents the half size of the AABB, zero for testing
+		 *			only the ray
+		 * @param	maxDistance the maximum distance of the intersection
+		 * @param	layers the layers of the Colliders to test
+		 * @param	ignoredCollider a pointer to a Collider that won't be
+		 *			tested, it can be nullptr
+		 * @param	castCollider the function used for calculating the
+		 *			exact intersection with the copy of each candidate
+		 *			Collider with the current maximum distance
+		 * @return	the result of the cast, with the same format than
+		 *			@see rayCastFirst */
+		RayCastResult castClosest(
+			const QuerySnapshot& snapshot, const Ray& ray,
+			const glm::vec3& halfExtents, float maxDistance,
+			const LayerMask& layers, const Collider* ignoredCollider,
+			const CastCallback& castCollider
+		) const;
 	};
 
 }
@@ -31,6 +31,10 @@ namespace se::physics {
 		ConcaveCollider& operator=(const ConcaveCollider& other) = default;
 		ConcaveCollider& operator=(ConcaveCollider&& other) = default;
 
+		/** @copydoc Collider::getType() */
+		virtual ColliderType getType() const override
+		{ return ColliderType::Concave; };
+
 		/** Calls the given callback for each of the overlaping convex parts of
 		 * the ConcaveCollider with the given AABB
 		 *
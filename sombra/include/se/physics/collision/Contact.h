@@ -1,6 +1,7 @@
 #ifndef CONTACT_H
 #define CONTACT_H
 
+#include <cstdint>
 #include <glm/glm.hpp>
 
 namespace se::physics {
@@ -27,10 +28,16 @@ namespace se::physics {
 		 * Collider in local space */
 		glm::vec3 localPosition[2];
 
+		/** The identifier of the Contact inside its Manifold. It's kept while
+		 * the Contact persists between updates, so the data calculated from
+		 * the Contact can be reused */
+		std::uint32_t id;
+
 		/** Creates a new Contact */
 		Contact() : penetration(0.0f), normal(0.0f),
 			worldPosition{ glm::vec3(0.0f), glm::vec3(0.0f) },
-			localPosition{ glm::vec3(0.0f), glm::vec3(0.0f) } {};
+			localPosition{ glm::vec3(0.0f), glm::vec3(0.0f) },
+			id(0) {};
 	};
 
 }
@@ -23,6 +23,10 @@ namespace se::physics {
 		ConvexCollider& operator=(const ConvexCollider& other) = default;
 		ConvexCollider& operator=(ConvexCollider&& other) = default;
 
+		/** @copydoc Collider::getType() */
+		virtual ColliderType getType() const override
+		{ return ColliderType::Convex; };
+
 		/** Calculates the coordinates of the ConvexCollider's furthest point
 		 * in the given direction
 		 *
@@ -38,6 +42,28 @@ namespace se::physics {
 			const glm::vec3& direction,
 			glm::vec3& pointWorld, glm::vec3& pointLocal
 		) const = 0;
+
+		/** Calculates the coordinates of the ConvexCollider's furthest points
+		 * in each of the given directions
+		 *
+		 * @param	directions a pointer to the directions towards we want to
+		 *			get the furthest points
+		 * @param	numDirections the number of directions
+		 * @param	pointsWorld a pointer to the array where we are going to
+		 *			store the coordinates in world space of the furthest
+		 *			points
+		 * @param	pointsLocal a pointer to the array where we are going to
+		 *			store the coordinates in local space of the furthest
+		 *			points */
+		virtual void getFurthestPointsInDirections(
+			const glm::vec3* directions, std::size_t numDirections,
+			glm::vec3* pointsWorld, glm::vec3* pointsLocal
+		) const
+		{
+			for (std::size_t i = 0; i < numDirections; ++i) {
+				getFurthestPointInDirection(directions[i], pointsWorld[i], pointsLocal[i]);
+			}
+		};
 	};
 
 }
@@ -1,6 +1,7 @@
 #ifndef CONVEX_POLYHEDRON_H
 #define CONVEX_POLYHEDRON_H
 
+#include <vector>
 #include "HalfEdgeMesh.h"
 #include "ConvexCollider.h"
 
@@ -8,7 +9,9 @@ namespace se::physics {
 
 	/**
 	 * Class ConvexPolyhedron, it's a ConvexCollider whose vertices form a
-	 * convex shape
+	 * convex shape. The world coordinates of its vertices are also stored in
+	 * Structure of Arrays layout for evaluating the support function with
+	 * SIMD instructions
 	 */
 	class ConvexPolyhedron : public ConvexCollider
 	{
@@ -22,6 +25,20 @@ namespace se::physics {
 		/** The transformation matrix of the ConvexPolyhedron */
 		glm::mat4 mTransformsMatrix;
 
+		/** The indices of the HEVertices stored in the coordinate arrays. The
+		 * arrays are padded with the first HEVertex up to a multiple of the
+		 * SIMD width */
+		std::vector<int> mVertexIndices;
+
+		/** The x coordinates of the HEVertices in world space */
+		std::vector<float> mVertexXs;
+
+		/** The y coordinates of the HEVertices in world space */
+		std::vector<float> mVertexYs;
+
+		/** The z coordinates of the HEVertices in world space */
+		std::vector<float> mVertexZs;
+
 	public:		// Functions
 		/** Creates a new ConvexPolyhedron located at the origin of coordinates
 		 *
@@ -67,6 +84,12 @@ namespace se::physics {
 			const glm::vec3& direction,
 			glm::vec3& pointWorld, glm::vec3& pointLocal
 		) const override;
+
+		/** @copydoc ConvexCollider::getFurthestPointsInDirections() */
+		void getFurthestPointsInDirections(
+			const glm::vec3* directions, std::size_t numDirections,
+			glm::vec3* pointsWorld, glm::vec3* pointsLocal
+		) const override;
 	};
 
 }
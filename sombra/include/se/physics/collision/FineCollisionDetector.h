@@ -1,8 +1,10 @@
 #ifndef FINE_COLLISION_DETECTOR_H
 #define FINE_COLLISION_DETECTOR_H
 
+#include <array>
 #include <memory>
 #include <vector>
+#include "Collider.h"
 #include "Manifold.h"
 #include "Ray.h"
 
@@ -13,15 +15,37 @@ namespace se::physics {
 	class GJKCollisionDetector;
 	class EPACollisionDetector;
 	class GJKRayCaster;
+	class AnalyticCollisionDetector;
 
 
 	/**
 	 * Class FineCollisionDetector, is the class that calculates the contact
-	 * data generated from the intersection (collision) of volumes (Colliders)
+	 * data generated from the intersection (collision) of volumes (Colliders).
+	 * The algorithm used for each pair of Colliders is selected from their
+	 * ColliderTypes, the BoundingSphere, Capsule and BoundingBox pairs are
+	 * solved analytically and the remaining ones with GJK and EPA.
 	 */
 	class FineCollisionDetector
 	{
+	private:	// Nested types
+		/** The number of ColliderTypes */
+		static constexpr std::size_t kNumColliderTypes =
+			static_cast<std::size_t>(ColliderType::Count);
+
+		/** The functions used for calculating the collision between two
+		 * Colliders of specific ColliderTypes */
+		using CollideFunction =
+			bool (FineCollisionDetector::*)(const Collider&, const Collider&, Manifold&);
+
+		/** The CollideFunctions of every pair of ColliderTypes */
+		using CollideFunctionTable =
+			std::array<std::array<CollideFunction, kNumColliderTypes>, kNumColliderTypes>;
+
 	private:	// Attributes
+		/** The CollideFunction to use indexed by the ColliderTypes of the
+		 * first and second Colliders */
+		static const CollideFunctionTable kCollideFunctions;
+
 		/** The class that implements the GJK algorithm for detecting if two
 		 * ConvexColliders are intersecting */
 		std::unique_ptr<GJKCollisionDetector> mGJKCollisionDetector;
@@ -34,6 +58,10 @@ namespace se::physics {
 		 * the intersections between ConvexColliders and rays */
 		std::unique_ptr<GJKRayCaster> mGJKRayCaster;
 
+		/** The class that calculates the Contacts between the Colliders with
+		 * simple shapes */
+		std::unique_ptr<AnalyticCollisionDetector> mAnalyticCollisionDetector;
+
 		/** The precision of the AABB tests */
 		const float mCoarseEpsilon;
 
@@ -42,6 +70,11 @@ namespace se::physics {
 		 * other one */
 		const float mContactSeparation2;
 
+		/** The square of the maximum distance between the local coordinates
+		 * of a new Contact and an old one for keeping the identifier of the
+		 * old one */
+		const float mContactMatchDistance2;
+
 	public:		// Functions
 		/** Creates a new FineCollisionDetector
 		 *
@@ -55,12 +88,15 @@ namespace se::physics {
 		 * @param	contactSeparation the minimum distance between the
 		 *			coordinates of two Contacts used for checking if a contact
 		 *			is the same than another one
-		 * @param	raycastPrecision the precision of the calculated RayCasts */
+		 * @param	raycastPrecision the precision of the calculated RayCasts
+		 * @param	contactMatchDistance the maximum distance between the
+		 *			local coordinates of two Contacts calculated in different
+		 *			updates for treating them as the same Contact */
 		FineCollisionDetector(
 			float coarseEpsilon,
 			float minFDifference, std::size_t maxIterations,
 			float contactPrecision, float contactSeparation,
-			float raycastPrecision
+			float raycastPrecision, float contactMatchDistance = 0.02f
 		);
 
 		/** Class destructor */
@@ -86,8 +122,78 @@ namespace se::physics {
 		 *			on the Collider will be stored if the ray intersects */
 		std::pair<bool, RayHit> intersects(
 			const Ray& ray, const Collider& collider
-		);
+		) const;
+
+		/** Checks if the given shape intersects with the given Collider when
+		 * it's moved in the given direction
+		 *
+		 * @param	shape the ConvexCollider to move, located at its initial
+		 *			position
+		 * @param	direction the direction in which the shape is moved
+		 * @param	maxDistance the maximum displacement along the direction
+		 *			of the shape, only used with ConcaveColliders
+		 * @param	collider the Collider to check for an intersection
+		 * @return	a pair with a boolean that tells if the shape intersects,
+		 *			and a RayCast object where the result of the shape cast
+		 *			will be stored if the shape intersects. Its distance is
+		 *			the displacement along the direction until the impact,
+		 *			and its contact point and normal are located on the
+		 *			surface of the Collider */
+		std::pair<bool, RayHit> intersects(
+			const ConvexCollider& shape, const glm::vec3& direction,
+			float maxDistance, const Collider& collider
+		) const;
+
+		/** Checks if the given shape overlaps with the given Collider. Unlike
+		 * @see collide it doesn't calculate any Contact data
+		 *
+		 * @param	shape the ConvexCollider to test
+		 * @param	collider the Collider to check for an overlap
+		 * @return	true if the shape and the Collider are overlapping, false
+		 *			otherwise */
+		bool overlaps(
+			const ConvexCollider& shape, const Collider& collider
+		) const;
 	private:
+		/** CollideFunction for two ConvexColliders */
+		bool dispatchConvexConvex(
+			const Collider& collider1, const Collider& collider2,
+			Manifold& manifold
+		);
+
+		/** CollideFunction for a ConvexCollider and a ConcaveCollider */
+		bool dispatchConvexConcave(
+			const Collider& collider1, const Collider& collider2,
+			Manifold& manifold
+		);
+
+		/** CollideFunction for a ConcaveCollider and a ConvexCollider */
+		bool dispatchConcaveConvex(
+			const Collider& collider1, const Collider& collider2,
+			Manifold& manifold
+		);
+
+		/** CollideFunction for two ConcaveColliders */
+		bool dispatchConcaveConcave(
+			const Collider& collider1, const Collider& collider2,
+			Manifold& manifold
+		);
+
+		/** CollideFunction for the Colliders solved by the
+		 * AnalyticCollisionDetector. The Contacts of the Manifold are
+		 * replaced with the new ones
+		 *
+		 * @tparam	T1 the type of the first Collider of the function F
+		 * @tparam	T2 the type of the second Collider of the function F
+		 * @tparam	F the AnalyticCollisionDetector function to call
+		 * @tparam	kSwap if the Colliders of the Manifold are in the reverse
+		 *			order than the ones of the function F */
+		template <typename T1, typename T2, auto F, bool kSwap>
+		bool dispatchAnalytic(
+			const Collider& collider1, const Collider& collider2,
+			Manifold& manifold
+		);
+
 		/** Calculates the contact data of the collision that happened between
 		 * the given ConvexColliders
 		 *
@@ -156,6 +262,18 @@ namespace se::physics {
 		 *			to remove */
 		void removeInvalidContacts(Manifold& manifold) const;
 
+		/** Sets the identifiers of the Contacts of the given Manifold after
+		 * calculating them from scratch. The Contacts close to any of the
+		 * old ones keep their identifiers, the other ones get new ones
+		 *
+		 * @param	oldContacts the Contacts of the Manifold before calculating
+		 *			the new ones
+		 * @param	manifold the Manifold with the new Contacts */
+		void updateContactIds(
+			const utils::FixedVector<Contact, Manifold::kMaxContacts>& oldContacts,
+			Manifold& manifold
+		) const;
+
 		/** Checks if the given Contact is close to any of the other Contacts
 		 *
 		 * @param	newContact the Contact to compare
@@ -25,6 +25,20 @@ namespace se::physics {
 			Count				///< The number of States
 		};
 
+		/** The data of the last GJK test between the Manifold Colliders, used
+		 * for warm starting the next one */
+		struct GJKCache
+		{
+			/** The last search direction of the GJK algorithm. If the
+			 * Colliders weren't intersecting it's a separating axis, otherwise
+			 * it's the Contact normal. Zero if there is no previous test */
+			glm::vec3 direction = glm::vec3(0.0f);
+
+			/** The local coordinates in the first and second Colliders of the
+			 * points of the last simplex that contained the origin */
+			utils::FixedVector<std::array<glm::vec3, 2>, 4> simplexPoints;
+		};
+
 		/** The maximum number of Contacts in the Manifold */
 		static constexpr std::size_t kMaxContacts = 4;
 
@@ -37,6 +51,12 @@ namespace se::physics {
 		/** All the Contacs the Contact Manifold can hold */
 		utils::FixedVector<Contact, kMaxContacts> contacts;
 
+		/** The data cached from the last GJK test */
+		GJKCache gjkCache;
+
+		/** The identifier to set to the next new Contact of the Manifold */
+		std::uint32_t nextContactId = 0;
+
 		/** Creates a new Manifold
 		 *
 		 * @param	c1 a pointer to the first Collider of the Manifold
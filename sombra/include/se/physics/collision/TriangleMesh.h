@@ -0,0 +1,115 @@
+#ifndef TRIANGLE_MESH_H
+#define TRIANGLE_MESH_H
+
+#include <array>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include "AABB.h"
+
+namespace se::physics {
+
+	class StaticAABBTree;
+
+
+	/**
+	 * Class TriangleMesh, it holds the immutable data of a triangle mesh in
+	 * local space: its vertices, the indices of its triangles and a
+	 * StaticAABBTree of the triangles. It's meant to be shared between all the
+	 * TriangleMeshColliders that use the same mesh, so the data is stored only
+	 * once and the Colliders can be copied without copying it
+	 */
+	class TriangleMesh
+	{
+	private:	// Attributes
+		/** The vertices of the TriangleMesh in local space */
+		std::vector<glm::vec3> mVertices;
+
+		/** The indices to the vertices of the triangle faces */
+		std::vector<std::uint32_t> mIndices;
+
+		/** The AABB Tree in local space used for checking ray casts and
+		 * overlaps, its primitives are the triangle indices */
+		std::unique_ptr<StaticAABBTree> mAABBTree;
+
+	public:		// Functions
+		/** Creates a new TriangleMesh
+		 *
+		 * @param	vertices a pointer to the vertices location in local space
+		 * @param	numVertices the number of vertices
+		 * @param	indices a pointer to the indices of the triangle faces
+		 * @param	numIndices the number indices */
+		TriangleMesh(
+			const glm::vec3* vertices, std::size_t numVertices,
+			const std::uint32_t* indices, std::size_t numIndices
+		);
+
+		/** Creates a new TriangleMesh from 16 bit indices
+		 *
+		 * @param	vertices a pointer to the vertices location in local space
+		 * @param	numVertices the number of vertices
+		 * @param	indices a pointer to the indices of the triangle faces
+		 * @param	numIndices the number indices */
+		TriangleMesh(
+			const glm::vec3* vertices, std::size_t numVertices,
+			const std::uint16_t* indices, std::size_t numIndices
+		);
+		TriangleMesh(const TriangleMesh& other) = delete;
+		TriangleMesh(TriangleMesh&& other) = delete;
+
+		/** Class destructor */
+		~TriangleMesh();
+
+		/** Assignment operator */
+		TriangleMesh& operator=(const TriangleMesh& other) = delete;
+		TriangleMesh& operator=(TriangleMesh&& other) = delete;
+
+		/** @return	a pointer to the vertices in local space of the
+		 *			TriangleMesh */
+		const glm::vec3* getVertices() const { return mVertices.data(); };
+
+		/** @return	the number of vertices of the TriangleMesh */
+		std::size_t getNumVertices() const { return mVertices.size(); };
+
+		/** @return	a pointer to the indices of the TriangleMesh */
+		const std::uint32_t* getIndices() const { return mIndices.data(); };
+
+		/** @return	the number of indices of the TriangleMesh */
+		std::size_t getNumIndices() const { return mIndices.size(); };
+
+		/** @return	the number of triangles of the TriangleMesh */
+		std::size_t getNumTriangles() const { return mIndices.size() / 3; };
+
+		/** @return	the AABB of the TriangleMesh in local space */
+		const AABB& getAABB() const;
+
+		/** @return	the AABB Tree of the triangles in local space */
+		const StaticAABBTree& getAABBTree() const
+		{ return *mAABBTree; };
+
+		/** Returns the vertices of the given triangle
+		 *
+		 * @param	iTriangle the index of the triangle
+		 * @return	the vertices in local space of the triangle */
+		std::array<glm::vec3, 3> getTriangle(std::size_t iTriangle) const
+		{
+			return {
+				mVertices[ mIndices[3 * iTriangle] ],
+				mVertices[ mIndices[3 * iTriangle + 1] ],
+				mVertices[ mIndices[3 * iTriangle + 2] ]
+			};
+		};
+
+		/** Returns the AABB of the given triangle
+		 *
+		 * @param	iTriangle the index of the triangle
+		 * @return	the AABB in local space of the triangle */
+		AABB getTriangleAABB(std::size_t iTriangle) const;
+	private:
+		/** Calculates the AABB Tree of the TriangleMesh */
+		void calculateAABBTree();
+	};
+
+}
+
+#endif		// TRIANGLE_MESH_H
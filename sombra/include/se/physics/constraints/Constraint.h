@@ -39,16 +39,20 @@ namespace se::physics {
 		/** The two RigidBodies affected by the constraint */
 		std::array<RigidBody*, 2> mRigidBodies;
 
+		/** The lambda value of the Constraint calculated in the last update,
+		 * used as the initial value of the next one */
+		float mLambda;
+
 	public:		// Functions
 		/** Creates a new Constraint */
-		Constraint() : mRigidBodies{ nullptr, nullptr } {};
+		Constraint() : mRigidBodies{ nullptr, nullptr }, mLambda(0.0f) {};
 
 		/** Creates a new Constraint
 		 *
 		 * @param	rigidBodies the two rigidBodies affected by the
 		 *			Constraint */
 		Constraint(const std::array<RigidBody*, 2>& rigidBodies) :
-			mRigidBodies(rigidBodies) {};
+			mRigidBodies(rigidBodies), mLambda(0.0f) {};
 
 		/** Class destructor */
 		virtual ~Constraint() = default;
@@ -60,6 +64,16 @@ namespace se::physics {
 		RigidBody* getRigidBody(std::size_t rb) const
 		{ return mRigidBodies[rb]; };
 
+		/** @return	the lambda value of the Constraint calculated in the last
+		 *			update */
+		float getLambda() const { return mLambda; };
+
+		/** Sets the lambda value of the Constraint
+		 *
+		 * @param	lambda the new lambda value, it will be used as the
+		 *			initial value in the next update */
+		void setLambda(float lambda) { mLambda = lambda; };
+
 		/** @return	a pointer to a copy of the current Constraint */
 		virtual std::unique_ptr<Constraint> clone() const = 0;
 
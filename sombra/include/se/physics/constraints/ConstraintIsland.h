@@ -10,6 +10,7 @@ namespace se::physics {
 	class RigidBody;
 	class Constraint;
 	class RigidBodyWorld;
+	class ParallelConstraintSolver;
 
 
 	/**
@@ -45,7 +46,7 @@ namespace se::physics {
 
 		/** If the constraints have to be solved again or not, maybe because new
 		 * constraints have been added/removed, the state of the RigidBodies
-		 * have changed, or the Constraints wasn't solved in the last update. */
+		 * have changed, or any of the dynamic RigidBodies is awake */
 		bool mSolveConstraints;
 
 		/** The variable that will be solved by the Constraint resolver.
@@ -96,17 +97,25 @@ namespace se::physics {
 			mMaxConstraintIterations(maxConstraintIterations),
 			mSolveConstraints(false) {};
 
-		/** Registers the given Constraint in the ConstraintIsland, so the
-		 * movement of the RigidBodies that it holds will be restricted.
+		/** Replaces all the Constraints of the ConstraintIsland with the
+		 * given ones. It doesn't force the Constraints to be solved in the
+		 * next update, so the RigidBodies can keep sleeping if none of the
+		 * Constraints has been updated
 		 *
-		 * @param	constraint a pointer to the Constraint that we want to
-		 *			register */
-		void addConstraint(Constraint* constraint);
+		 * @param	constraints a pointer to the Constraints to set, sorted
+		 *			ascendently
+		 * @param	numConstraints the number of Constraints */
+		void setConstraints(
+			Constraint* const* constraints, std::size_t numConstraints
+		);
 
 		/** @return	true if the ConstraintIsland has any constraints inside,
 		 *			false otherwise */
 		bool hasConstraints() const { return !mConstraints.empty(); };
 
+		/** @return	the number of Constraints of the ConstraintIsland */
+		std::size_t getNumConstraints() const { return mConstraints.size(); };
+
 		/** Iterates through all the ConstraintIsland Constraints calling the
 		 * given callback function
 		 *
@@ -114,15 +123,6 @@ namespace se::physics {
 		template <typename F>
 		void processConstraints(F&& callback) const;
 
-		/** Removes the given Constraint from the ConstraintIsland, so the
-		 * movement of the RigidBodies that it holds won't longer be
-		 * restricted.
-		 *
-		 * @param	constraint a pointer to the Constraint that we want to
-		 *			remove
-		 * @return	true if the Constraint was removed, false otherwise */
-		bool removeConstraint(Constraint* constraint);
-
 		/** Returns if the ConstraintIsland has any constraints with the
 		 * given RigidBody or not
 		 *
@@ -138,14 +138,6 @@ namespace se::physics {
 		template <typename F>
 		void processRigidBodies(F&& callback) const;
 
-		/** Removes all the Constraints that constains the given RigidBody
-		 * from the ConstraintIsland.
-		 *
-		 * @param	rigidBody a pointer to the RigidBody whose Constraints we
-		 *			want to remove
-		 * @return	true if the RigidBody was removed, false otherwise */
-		bool removeRigidBody(RigidBody* rigidBody);
-
 		/** Iterates through all the Constraints of the ConstraintIsland that
 		 * containts the given RigidBody calling the given callback function
 		 *
@@ -157,26 +149,43 @@ namespace se::physics {
 			RigidBody* rigidBody, F&& callback
 		) const;
 
-		/** Moves the constraints from the given ConstraintIsland to the
-		 * current one
+		/** Wakes up all the dynamic RigidBodies of the ConstraintIsland if
+		 * any of them is awake, so the RigidBodies connected by the
+		 * Constraints sleep and wake up together
 		 *
-		 * @param	source the source ConstraintIsland, it will be empty of
-		 *			Constraints after the merge operation */
-		void merge(ConstraintIsland& source);
-
-		/** Applies the constraints stored in the ConstraintIsland
+		 * @return	true if the ConstraintIsland is awake, false if all its
+		 *			RigidBodies are sleeping */
+		bool updateSleepingStatus();
+
+		/** Applies the constraints stored in the ConstraintIsland. The
+		 * ConstraintIslands with all their RigidBodies sleeping and without
+		 * any changes to their Constraints are skipped, otherwise all their
+		 * RigidBodies are woken up
 		 *
 		 * @param	deltaTime the elapsed time since the last update in
-		 *			seconds */
-		void update(float deltaTime);
+		 *			seconds
+		 * @param	parallelSolver the ParallelConstraintSolver used for
+		 *			solving the Constraints, nullptr for solving them
+		 *			serially */
+		void update(
+			float deltaTime, ParallelConstraintSolver* parallelSolver = nullptr
+		);
 	private:
 		/** Updates the @see mSolveConstraints flag with the changes made to the
 		 * RigidBodies or Constraints */
 		void updateSolveConstraints();
 
+		/** Wakes up all the sleeping dynamic RigidBodies of the
+		 * ConstraintIsland */
+		void wakeUpRigidBodies();
+
 		/** Updates the lambda min and lambda max matrices value */
 		void updateLambdaBoundsMatrices();
 
+		/** Updates the lambda matrix with the lambda values of the
+		 * Constraints clamped to their current bounds */
+		void updateLambdaMatrix();
+
 		/** Updates the bias matrix value */
 		void updateBiasMatrix();
 
@@ -197,8 +206,13 @@ namespace se::physics {
 		 *	* mLambdaMatrix = etaMatrix
 		 *
 		 * @param	deltaTime the elapsed time since the last update in
-		 *			seconds */
-		void calculateGaussSeidel(float deltaTime);
+		 *			seconds
+		 * @param	parallelSolver the ParallelConstraintSolver used for
+		 *			solving the Constraints, nullptr for solving them
+		 *			serially */
+		void calculateGaussSeidel(
+			float deltaTime, ParallelConstraintSolver* parallelSolver
+		);
 
 		/** Calculates the transposed invMassJacobianMatrix which is
 		 * equal to mInverseMassMatrix * transpose(mJacobianMatrix)
@@ -249,13 +263,6 @@ namespace se::physics {
 		 * @param	deltaTime the elapsed time since the last update in
 		 *			seconds */
 		void updateRigidBodies(float deltaTime);
-
-		/** Deletes the RigidBody located at the given index if it has zero or
-		 * one Constraint users
-		 *
-		 * @param	iRB the index of the RigidBody in mRigidBodies
-		 * @return	true if the RigidBody was removed, false otherwise */
-		bool tryRemoveRigidBody(std::size_t iRB);
 	};
 
 
@@ -2,26 +2,83 @@
 #define CONSTRAINT_MANAGER_H
 
 #include <mutex>
+#include <memory>
+#include <algorithm>
+#include "Constraint.h"
 #include "ConstraintIsland.h"
 
 namespace se::physics {
 
+	/**
+	 * Struct IslandStats, it holds a snapshot of the ConstraintIslands
+	 * solved in the last update of the ConstraintManager
+	 */
+	struct IslandStats
+	{
+		/** The number of buckets of @see sizeHistogram */
+		static constexpr std::size_t kNumSizeBuckets = 16;
+
+		/** The number of ConstraintIslands */
+		std::size_t numIslands = 0;
+
+		/** The number of Constraints of all the ConstraintIslands */
+		std::size_t numConstraints = 0;
+
+		/** The number of Constraints of the largest ConstraintIsland */
+		std::size_t maxIslandConstraints = 0;
+
+		/** The number of ConstraintIslands solved with the parallel solver */
+		std::size_t numParallelIslands = 0;
+
+		/** The number of tasks used for solving the rest of the
+		 * ConstraintIslands */
+		std::size_t numTasks = 0;
+
+		/** The number of ConstraintIslands by their number of Constraints.
+		 * The bucket i holds the ones with [2^i, 2^(i+1)) Constraints, and
+		 * the last one also holds all the larger ones */
+		std::array<std::size_t, kNumSizeBuckets> sizeHistogram = {};
+	};
+
+
 	/**
 	 * Class ConstraintManager, it's the class used for solving the physics
 	 * constraints between the rigid bodies of the Physics System. It will
 	 * split the constraints to solve in smaller sets called islands that
-	 * will be responsible for solving them independently
+	 * will be responsible for solving them independently. The islands are
+	 * rebuilt from the graph of Constraints whenever it changes
 	 */
 	class ConstraintManager
 	{
 	private:	// Attributes
+		/** The number of tasks submitted to each thread for solving the
+		 * islands, so the threads that finish earlier can pick the
+		 * remaining ones */
+		static constexpr std::size_t kTasksPerThread = 4;
+
 		/** A reference to the RigidBodyWorld that holds the RigidBodies */
 		RigidBodyWorld* mParentWorld;
 
-		/** The Constraint islands used for solving the Constraints */
+		/** All the Constraints of the ConstraintManager sorted ascendently */
+		std::vector<Constraint*> mConstraints;
+
+		/** If the Constraints have been added or removed since the last
+		 * time that the islands were built */
+		bool mRebuildIslands;
+
+		/** The Constraint islands used for solving the Constraints, sorted
+		 * descendently by their number of Constraints */
 		std::vector<ConstraintIsland> mIslands;
 
-		/** The mutex used for protecting @see mIslands */
+		/** The stats of the islands of the last update */
+		IslandStats mIslandStats;
+
+		/** The solver used for the ConstraintIslands with a large number of
+		 * Constraints */
+		std::unique_ptr<ParallelConstraintSolver> mParallelSolver;
+
+		/** The mutex used for protecting @see mConstraints and
+		 * @see mIslands */
 		mutable std::mutex mMutex;
 
 	public:		// Constraints
@@ -29,8 +86,10 @@ namespace se::physics {
 		 *
 		 * @param	parentWorld the RigidBodyWorld that holds all the
 		 *			RigidBodies to update */
-		ConstraintManager(RigidBodyWorld& parentWorld) :
-			mParentWorld(&parentWorld) {};
+		ConstraintManager(RigidBodyWorld& parentWorld);
+
+		/** Class destructor */
+		~ConstraintManager();
 
 		/** Registers the given Constraint in the ConstraintManager, so the
 		 * movement of the RigidBodies that it holds will be restricted.
@@ -39,6 +98,15 @@ namespace se::physics {
 		 *			register */
 		void addConstraint(Constraint* constraint);
 
+		/** Registers the given Constraints in the ConstraintManager at once,
+		 * so the ConstraintIslands are rebuilt only one time
+		 *
+		 * @param	constraints a pointer to the Constraints to register
+		 * @param	numConstraints the number of Constraints */
+		void addConstraints(
+			Constraint* const* constraints, std::size_t numConstraints
+		);
+
 		/** @return	true if the ConstraintManager has any constraints inside,
 		 *			false otherwise */
 		bool hasConstraints() const;
@@ -58,6 +126,15 @@ namespace se::physics {
 		 *			remove */
 		void removeConstraint(Constraint* constraint);
 
+		/** Removes the given Constraints from the ConstraintManager at once,
+		 * so the ConstraintIslands are rebuilt only one time
+		 *
+		 * @param	constraints a pointer to the Constraints to remove
+		 * @param	numConstraints the number of Constraints */
+		void removeConstraints(
+			Constraint* const* constraints, std::size_t numConstraints
+		);
+
 		/** Iterates through all the ConstraintManager RigidBodies calling the
 		 * given callback function
 		 *
@@ -83,11 +160,30 @@ namespace se::physics {
 		 *			want to remove */
 		void removeRigidBody(RigidBody* rigidBody);
 
+		/** Wakes up all the RigidBodies of the islands with any awake
+		 * dynamic RigidBody, so the RigidBodies connected by Constraints
+		 * sleep and wake up together */
+		void updateSleepingStatus();
+
 		/** Applies the constraints stored in the ConstraintManager
 		 *
 		 * @param	deltaTime the elapsed time since the last update in
 		 *			seconds */
 		void update(float deltaTime);
+
+		/** @return	the stats of the islands solved in the last update */
+		IslandStats getIslandStats() const;
+	private:
+		/** Splits the Constraints in islands of Constraints connected by
+		 * non static RigidBodies with an union-find, and sorts them
+		 * descendently by their number of Constraints */
+		void rebuildIslands();
+
+		/** Wakes up the sleeping dynamic RigidBodies of the given Constraint
+		 *
+		 * @param	constraint the Constraint whose RigidBodies will be
+		 *			woken up */
+		static void wakeUpRigidBodies(const Constraint& constraint);
 	};
 
 
@@ -95,8 +191,8 @@ namespace se::physics {
 	void ConstraintManager::processConstraints(F&& callback) const
 	{
 		std::scoped_lock lck(mMutex);
-		for (const ConstraintIsland& island : mIslands) {
-			island.processConstraints(callback);
+		for (Constraint* constraint : mConstraints) {
+			callback(constraint);
 		}
 	}
 
@@ -106,14 +202,12 @@ namespace se::physics {
 	{
 		std::scoped_lock lck(mMutex);
 		std::vector<RigidBody*> rigidBodies;
-		for (const ConstraintIsland& island : mIslands) {
-			island.processRigidBodies([&](RigidBody* rb) {
-				auto it = std::lower_bound(rigidBodies.begin(), rigidBodies.end(), rb);
-				if ((it == rigidBodies.end()) || (*it != rb)) {
-					rigidBodies.insert(it, rb);
-				}
-			});
+		for (Constraint* constraint : mConstraints) {
+			rigidBodies.push_back(constraint->getRigidBody(0));
+			rigidBodies.push_back(constraint->getRigidBody(1));
 		}
+		std::sort(rigidBodies.begin(), rigidBodies.end());
+		rigidBodies.erase(std::unique(rigidBodies.begin(), rigidBodies.end()), rigidBodies.end());
 
 		for (RigidBody* rb : rigidBodies) {
 			callback(rb);
@@ -127,8 +221,12 @@ namespace se::physics {
 	) const
 	{
 		std::scoped_lock lck(mMutex);
-		for (const ConstraintIsland& island : mIslands) {
-			island.processRigidBodyConstraints(rigidBody, callback);
+		for (Constraint* constraint : mConstraints) {
+			if ((constraint->getRigidBody(0) == rigidBody)
+				|| (constraint->getRigidBody(1) == rigidBody)
+			) {
+				callback(constraint);
+			}
 		}
 	}
 
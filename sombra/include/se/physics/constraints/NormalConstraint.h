@@ -80,7 +80,7 @@ namespace se::physics {
 			mSlopPenetration(slopPenetration),
 			mSlopRestitution(slopRestitution),
 			mConstraintVectors{ glm::vec3(0.0f), glm::vec3(0.0f) },
-			mNormal(0.0f), mDeltaTime(0.0f) {};
+			mNormal(0.0f), mDeltaTime(0.0f), mUpdated(true) {};
 
 		/** @copydoc Constraint::clone() */
 		virtual std::unique_ptr<Constraint> clone() const override
@@ -0,0 +1,201 @@
+#ifndef MEMORY_TRACKER_H
+#define MEMORY_TRACKER_H
+
+#include <array>
+#include <atomic>
+#include <limits>
+#include <memory>
+
+namespace se::utils {
+
+	/** The subsystems whose memory is tracked by the MemoryTracker */
+	enum class MemoryTag : int
+	{
+		Default = 0,
+		ECS,
+		Repository,
+		Physics,
+		Animation,
+		Graphics,
+		Mesh,
+		Texture,
+		Count
+	};
+
+
+	/**
+	 * Struct MemoryStats, it holds a snapshot of the memory used by the
+	 * allocations of a single MemoryTag
+	 */
+	struct MemoryStats
+	{
+		/** The number of bytes currently allocated */
+		std::size_t currentBytes = 0;
+
+		/** The maximum number of bytes allocated at the same time */
+		std::size_t highWaterMark = 0;
+
+		/** The number of allocations that haven't been released yet */
+		std::size_t liveAllocations = 0;
+
+		/** The number of allocations made since the start of the program */
+		std::size_t totalAllocations = 0;
+
+		/** The number of allocations made in the last finished frame */
+		std::size_t frameAllocations = 0;
+
+		/** The maximum number of bytes that should be allocated at the same
+		 * time */
+		std::size_t budget = std::numeric_limits<std::size_t>::max();
+	};
+
+
+	/**
+	 * Class MemoryTracker, it's the singleton used for tracking the memory
+	 * allocated by each subsystem of the engine. The allocations are reported
+	 * by the TrackedAllocators, so it only knows about the containers that
+	 * use them.
+	 */
+	class MemoryTracker
+	{
+	private:	// Nested types
+		/** Holds the counters of a single MemoryTag */
+		struct TagCounters
+		{
+			std::atomic_size_t currentBytes = { 0 };
+			std::atomic_size_t highWaterMark = { 0 };
+			std::atomic_size_t liveAllocations = { 0 };
+			std::atomic_size_t totalAllocations = { 0 };
+			std::atomic_size_t currentFrameAllocations = { 0 };
+			std::atomic_size_t lastFrameAllocations = { 0 };
+			std::atomic_size_t budget = { std::numeric_limits<std::size_t>::max() };
+			std::atomic_bool budgetExceeded = { false };
+		};
+
+		static constexpr std::size_t kNumTags =
+			static_cast<std::size_t>(MemoryTag::Count);
+
+	private:	// Attributes
+		/** The counters of each MemoryTag */
+		std::array<TagCounters, kNumTags> mCounters;
+
+		/** The number of frames finished */
+		std::atomic_size_t mFrameCount;
+
+	public:		// Functions
+		/** @return	the only instance of the MemoryTracker */
+		static MemoryTracker& getInstance();
+
+		/** @return	the name of the given MemoryTag */
+		static const char* getTagName(MemoryTag tag);
+
+		/** Registers a new allocation
+		 *
+		 * @param	tag the MemoryTag of the allocation
+		 * @param	bytes the number of bytes allocated */
+		void onAllocate(MemoryTag tag, std::size_t bytes);
+
+		/** Registers the release of an allocation
+		 *
+		 * @param	tag the MemoryTag of the allocation
+		 * @param	bytes the number of bytes released */
+		void onDeallocate(MemoryTag tag, std::size_t bytes);
+
+		/** Sets the memory budget of the given MemoryTag. A warning will be
+		 * logged at the end of every frame in which the allocated memory
+		 * went over the budget
+		 *
+		 * @param	tag the MemoryTag to update
+		 * @param	bytes the maximum number of bytes that should be allocated
+		 *			at the same time with the given MemoryTag */
+		void setBudget(MemoryTag tag, std::size_t bytes);
+
+		/** @return	true if the memory allocated with the given MemoryTag
+		 *			is over its budget, false otherwise */
+		bool isOverBudget(MemoryTag tag) const;
+
+		/** Finishes the current frame, storing the number of allocations
+		 * made in it so they can be retrieved with @see getStats, and logs
+		 * the MemoryTags that went over their budgets in it */
+		void endFrame();
+
+		/** @return	the number of frames finished */
+		std::size_t getFrameCount() const { return mFrameCount.load(); };
+
+		/** Returns the memory stats of the given MemoryTag
+		 *
+		 * @param	tag the MemoryTag to check
+		 * @return	a snapshot of the MemoryTag counters */
+		MemoryStats getStats(MemoryTag tag) const;
+
+		/** @return	the memory stats of all the MemoryTags added together */
+		MemoryStats getTotalStats() const;
+
+		/** Resets the high water marks of all the MemoryTags to their current
+		 * number of bytes allocated */
+		void resetHighWaterMarks();
+	private:
+		/** Creates a new MemoryTracker */
+		MemoryTracker() : mFrameCount(0) {};
+	};
+
+
+	/**
+	 * Class TrackedAllocator, it's an allocator that reports all its
+	 * allocations to the MemoryTracker with the given @tparam Tag
+	 */
+	template <typename T, MemoryTag Tag = MemoryTag::Default>
+	class TrackedAllocator
+	{
+	public:		// Nested types
+		using value_type = T;
+
+		template <typename U>
+		struct rebind { using other = TrackedAllocator<U, Tag>; };
+
+	public:		// Functions
+		/** Creates a new TrackedAllocator */
+		TrackedAllocator() noexcept = default;
+
+		/** Creates a new TrackedAllocator from other with a different value
+		 * type */
+		template <typename U>
+		TrackedAllocator(const TrackedAllocator<U, Tag>&) noexcept {}
+
+		/** Allocates memory for the given number of elements
+		 *
+		 * @param	n the number of elements
+		 * @return	a pointer to the allocated memory */
+		T* allocate(std::size_t n)
+		{
+			T* ret = std::allocator<T>().allocate(n);
+			MemoryTracker::getInstance().onAllocate(Tag, n * sizeof(T));
+			return ret;
+		};
+
+		/** Releases the given memory
+		 *
+		 * @param	p a pointer to the memory to release
+		 * @param	n the number of elements allocated with @see allocate */
+		void deallocate(T* p, std::size_t n)
+		{
+			if (p) {
+				std::allocator<T>().deallocate(p, n);
+				MemoryTracker::getInstance().onDeallocate(Tag, n * sizeof(T));
+			}
+		};
+	};
+
+
+	template <typename T, typename U, MemoryTag Tag>
+	bool operator==(const TrackedAllocator<T, Tag>&, const TrackedAllocator<U, Tag>&)
+	{ return true; }
+
+
+	template <typename T, typename U, MemoryTag Tag>
+	bool operator!=(const TrackedAllocator<T, Tag>&, const TrackedAllocator<U, Tag>&)
+	{ return false; }
+
+}
+
+#endif		// MEMORY_TRACKER_H
@@ -184,9 +184,9 @@ namespace se::utils {
 		 * @param	cv1 the first PackedVector to compare
 		 * @param	cv2 the second PackedVector to compare
 		 * @return	true if both PackedVector are equal, false otherwise */
-		template <typename U>
+		template <typename U, typename B>
 		friend bool operator==(
-			const PackedVector<U>& cv1, const PackedVector<U>& cv2
+			const PackedVector<U, B>& cv1, const PackedVector<U, B>& cv2
 		);
 
 		/** Compares the given PackedVectors
@@ -195,9 +195,9 @@ namespace se::utils {
 		 * @param	cv2 the second PackedVector to compare
 		 * @return	true if both PackedVector are different, false
 		 *			otherwise */
-		template <typename U>
+		template <typename U, typename B>
 		friend bool operator!=(
-			const PackedVector<U>& cv1, const PackedVector<U>& cv2
+			const PackedVector<U, B>& cv1, const PackedVector<U, B>& cv2
 		);
 
 		/** @return	the initial iterator of the PackedVector */
@@ -283,8 +283,8 @@ namespace se::utils {
 		 *			created
 		 * @note	the elements currently stored in the vector will be removed
 		 *			and the new ones will be default initialized */
-		template <typename U>
-		void replicate(const PackedVector<U>& other, const T& value = T());
+		template <typename U, typename B>
+		void replicate(const PackedVector<U, B>& other, const T& value = T());
 	};
 
 }
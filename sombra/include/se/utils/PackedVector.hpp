@@ -178,8 +178,8 @@ namespace se::utils {
 
 
 	template <typename T, typename A>
-	template <typename U>
-	void PackedVector<T, A>::replicate(const PackedVector<U>& other, const T& value)
+	template <typename U, typename B>
+	void PackedVector<T, A>::replicate(const PackedVector<U, B>& other, const T& value)
 	{
 		clear();
 
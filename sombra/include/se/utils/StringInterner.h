@@ -0,0 +1,194 @@
+#ifndef STRING_INTERNER_H
+#define STRING_INTERNER_H
+
+#include <string>
+#include <cstdint>
+#include <string_view>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace se::utils {
+
+	/** Calculates the 32-bit FNV-1a hash of the given string
+	 *
+	 * @param	str the string to hash
+	 * @return	the hash of the string */
+	constexpr std::uint32_t hashString32(std::string_view str)
+	{
+		std::uint32_t hash = 2166136261u;
+		for (char c : str) {
+			hash ^= static_cast<std::uint8_t>(c);
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+
+
+	/** Calculates the 64-bit FNV-1a hash of the given string
+	 *
+	 * @param	str the string to hash
+	 * @return	the hash of the string */
+	constexpr std::uint64_t hashString64(std::string_view str)
+	{
+		std::uint64_t hash = 14695981039346656037ull;
+		for (char c : str) {
+			hash ^= static_cast<std::uint8_t>(c);
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+
+	/**
+	 * Class StringInterner, it's the global and thread safe table that holds
+	 * a single copy of every interned string. Each string is identified by
+	 * the hash of its characters, if two different strings have the same
+	 * hash, the last one added will get the next free value.
+	 */
+	class StringInterner
+	{
+	public:		// Nested types
+		using ValueType = std::uint64_t;
+
+		/** The value of the empty string */
+		static constexpr ValueType kEmpty = 0;
+
+	private:	// Attributes
+		/** Maps the ids with the strings. The elements of an unordered_map
+		 * aren't moved when it grows, so the returned pointers remain
+		 * valid */
+		std::unordered_map<ValueType, std::string> mStrings;
+
+		/** The number of hash collisions found */
+		std::size_t mNumCollisions;
+
+		/** The mutex used for protecting @see mStrings */
+		mutable std::shared_mutex mMutex;
+
+	public:		// Functions
+		/** @return	the only instance of the StringInterner */
+		static StringInterner& getInstance();
+
+		/** Interns the given string
+		 *
+		 * @param	str the string to intern
+		 * @return	the id of the string, it will be the same for all the
+		 *			strings with the same characters */
+		ValueType intern(std::string_view str);
+
+		/** Searchs the id of the given string without interning it
+		 *
+		 * @param	str the string to search
+		 * @param	ret where the id of the string will be stored
+		 * @return	true if the string was found, false otherwise */
+		bool find(std::string_view str, ValueType& ret) const;
+
+		/** Returns the string with the given id
+		 *
+		 * @param	id the id of the string
+		 * @return	a pointer to the interned string, an empty string if
+		 *			there is no string with the given id */
+		const char* getString(ValueType id) const;
+
+		/** @return	the number of strings interned */
+		std::size_t size() const;
+
+		/** @return	the number of hash collisions found */
+		std::size_t getNumCollisions() const;
+	private:
+		/** Creates a new StringInterner */
+		StringInterner() : mNumCollisions(0) {};
+
+		/** Searchs the given string starting from its hash
+		 *
+		 * @param	str the string to search
+		 * @param	id the hash of the string, it will be updated to the id of
+		 *			the string or to the first free id found
+		 * @return	true if the string was found, false otherwise
+		 * @note	the mutex must be locked */
+		bool probe(std::string_view str, ValueType& id) const;
+	};
+
+
+	/**
+	 * Class NameId, it's the handle of a string interned in the
+	 * StringInterner. Comparing and hashing NameIds is O(1).
+	 */
+	class NameId
+	{
+	public:		// Nested types
+		using ValueType = StringInterner::ValueType;
+
+		/** The hash function used for storing NameIds in unordered
+		 * containers */
+		struct Hash
+		{
+			std::size_t operator()(const NameId& nameId) const
+			{ return static_cast<std::size_t>(nameId.mValue); };
+		};
+
+	private:	// Attributes
+		/** The id of the string in the StringInterner */
+		ValueType mValue;
+
+	public:		// Functions
+		/** Creates a new NameId with an empty string */
+		NameId() : mValue(StringInterner::kEmpty) {};
+
+		/** Creates a new NameId, interning the given string
+		 *
+		 * @param	str the string of the NameId */
+		explicit NameId(std::string_view str) :
+			mValue(StringInterner::getInstance().intern(str)) {};
+		explicit NameId(const char* str) : NameId(std::string_view(str)) {};
+		explicit NameId(const std::string& str) :
+			NameId(std::string_view(str)) {};
+
+		/** Searchs the NameId of the given string without interning it
+		 *
+		 * @param	str the string to search
+		 * @param	ret where the NameId will be stored
+		 * @return	true if the string was already interned, false
+		 *			otherwise */
+		static bool find(std::string_view str, NameId& ret)
+		{ return StringInterner::getInstance().find(str, ret.mValue); };
+
+		/** @return	the id of the string in the StringInterner */
+		ValueType getValue() const { return mValue; };
+
+		/** @return	true if the string of the NameId is empty, false
+		 *			otherwise */
+		bool empty() const { return mValue == StringInterner::kEmpty; };
+
+		/** @return	a pointer to the interned string, it will remain valid
+		 *			until the end of the program */
+		const char* c_str() const
+		{ return StringInterner::getInstance().getString(mValue); };
+
+		/** @return	a copy of the interned string */
+		std::string str() const { return c_str(); };
+
+		/** Compares the given NameIds
+		 *
+		 * @param	lhs the first NameId to compare
+		 * @param	rhs the second NameId to compare
+		 * @return	true if both NameIds are equal, false otherwise */
+		friend bool operator==(const NameId& lhs, const NameId& rhs)
+		{ return lhs.mValue == rhs.mValue; };
+		friend bool operator!=(const NameId& lhs, const NameId& rhs)
+		{ return lhs.mValue != rhs.mValue; };
+
+		/** Compares the ids of the given NameIds. The order doesn't depend
+		 * on the strings
+		 *
+		 * @param	lhs the first NameId to compare
+		 * @param	rhs the second NameId to compare
+		 * @return	true if the first NameId is less than the second one,
+		 *			false otherwise */
+		friend bool operator<(const NameId& lhs, const NameId& rhs)
+		{ return lhs.mValue < rhs.mValue; };
+	};
+
+}
+
+#endif		// STRING_INTERNER_H
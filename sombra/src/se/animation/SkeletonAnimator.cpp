@@ -1,4 +1,3 @@
-#include <cstring>
 #include <algorithm>
 #include "se/animation/SkeletonAnimator.h"
 
@@ -93,19 +92,18 @@ namespace se::animation {
 
 
 	void SkeletonAnimator::addAnimator(
-		const char* nodeName, TransformationAnimator::TransformationType type,
+		const utils::NameId& nodeName, TransformationAnimator::TransformationType type,
 		TransformationAnimatorUPtr animator
 	) {
 		animator->setLoopTime(mLoopTime);
 
-		NodeAnimator nodeAnimator = { {}, type, std::move(animator) };
-		std::copy(nodeName, nodeName + std::strlen(nodeName), nodeAnimator.nodeName.begin());
-		auto it = std::lower_bound(mNAnimators.begin(), mNAnimators.end(), nodeAnimator.nodeName.data(), compareLessLo);
+		NodeAnimator nodeAnimator = { nodeName, type, std::move(animator) };
+		auto it = std::lower_bound(mNAnimators.begin(), mNAnimators.end(), nodeAnimator.nodeName, compareLessLo);
 		mNAnimators.emplace(it, std::move(nodeAnimator));
 	}
 
 
-	void SkeletonAnimator::removeAnimator(const char* nodeName, TransformationAnimator::TransformationType type)
+	void SkeletonAnimator::removeAnimator(const utils::NameId& nodeName, TransformationAnimator::TransformationType type)
 	{
 		auto itL = std::lower_bound(mNAnimators.begin(), mNAnimators.end(), nodeName, compareLessLo);
 		auto itU = std::upper_bound(mNAnimators.begin(), mNAnimators.end(), nodeName, compareLessUp);
@@ -120,8 +118,8 @@ namespace se::animation {
 	{
 		mRootNodes.push_back(&rootNode);
 		for (auto& descendant : rootNode) {
-			auto itL = std::lower_bound(mNAnimators.begin(), mNAnimators.end(), descendant.getData().name.data(), compareLessLo);
-			auto itU = std::upper_bound(mNAnimators.begin(), mNAnimators.end(), descendant.getData().name.data(), compareLessUp);
+			auto itL = std::lower_bound(mNAnimators.begin(), mNAnimators.end(), descendant.getData().name, compareLessLo);
+			auto itU = std::upper_bound(mNAnimators.begin(), mNAnimators.end(), descendant.getData().name, compareLessUp);
 			for (auto it = itL; it != itU; ++it) {
 				it->animator->addNode(it->type, descendant);
 			}
@@ -132,8 +130,8 @@ namespace se::animation {
 	void SkeletonAnimator::rewindNodeHierarchy(AnimationNode& rootNode)
 	{
 		for (auto& descendant : rootNode) {
-			auto itL = std::lower_bound(mNAnimators.begin(), mNAnimators.end(), descendant.getData().name.data(), compareLessLo);
-			auto itU = std::upper_bound(mNAnimators.begin(), mNAnimators.end(), descendant.getData().name.data(), compareLessUp);
+			auto itL = std::lower_bound(mNAnimators.begin(), mNAnimators.end(), descendant.getData().name, compareLessLo);
+			auto itU = std::upper_bound(mNAnimators.begin(), mNAnimators.end(), descendant.getData().name, compareLessUp);
 			for (auto it = itL; it != itU; ++it) {
 				it->animator->rewindNode(it->type, descendant);
 			}
@@ -148,8 +146,8 @@ namespace se::animation {
 			mRootNodes.end()
 		);
 		for (auto& descendant : rootNode) {
-			auto itL = std::lower_bound(mNAnimators.begin(), mNAnimators.end(), descendant.getData().name.data(), compareLessLo);
-			auto itU = std::upper_bound(mNAnimators.begin(), mNAnimators.end(), descendant.getData().name.data(), compareLessUp);
+			auto itL = std::lower_bound(mNAnimators.begin(), mNAnimators.end(), descendant.getData().name, compareLessLo);
+			auto itU = std::upper_bound(mNAnimators.begin(), mNAnimators.end(), descendant.getData().name, compareLessUp);
 			for (auto it = itL; it != itU; ++it) {
 				it->animator->removeNode(it->type, descendant);
 			}
@@ -157,15 +155,15 @@ namespace se::animation {
 	}
 
 // Private function
-	bool SkeletonAnimator::compareLessLo(const NodeAnimator& lhs, const char* rhs)
+	bool SkeletonAnimator::compareLessLo(const NodeAnimator& lhs, const utils::NameId& rhs)
 	{
-		return std::strcmp(lhs.nodeName.data(), rhs) < 0;
+		return lhs.nodeName < rhs;
 	}
 
 
-	bool SkeletonAnimator::compareLessUp(const char* lhs, const NodeAnimator& rhs)
+	bool SkeletonAnimator::compareLessUp(const utils::NameId& lhs, const NodeAnimator& rhs)
 	{
-		return std::strcmp(lhs, rhs.nodeName.data()) < 0;
+		return lhs < rhs.nodeName;
 	}
 
 }
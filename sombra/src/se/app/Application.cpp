@@ -1,6 +1,8 @@
+#include <thread>
 #include <algorithm>
 #include "se/utils/Log.h"
 #include "se/utils/ThreadPool.h"
+#include "se/utils/MemoryTracker.h"
 #include "se/app/Repository.h"
 #include "se/graphics/GraphicsEngine.h"
 #include "se/graphics/core/Program.h"
@@ -46,79 +48,29 @@ namespace se::app {
 		const physics::WorldProperties& physicsWorldProperties,
 		std::size_t audioDeviceId,
 		float updateTime
-	) : mUpdateTime(updateTime), mStopRunning(false), mState(AppState::Stopped),
+	) : mUpdateTime(updateTime), mHeadless(false), mHeadlessConfig(),
+		mStopRunning(false), mState(AppState::Stopped),
 		mThreadPool(nullptr), mExternalTools(nullptr), mEventManager(nullptr),
 		mRepository(nullptr), mEntityDatabase(nullptr),
 		mAppRenderer(nullptr), mGUIManager(nullptr)
 	{
 		SOMBRA_INFO_LOG << "Creating the Application";
+		init(&windowConfig, physicsWorldProperties, audioDeviceId, kMaxEntities);
+	}
 
-		try {
-			// We need at least 1 extra thread for loading
-			std::size_t numThreads = std::min(std::thread::hardware_concurrency(), 1u);
-			mThreadPool = new utils::ThreadPool(numThreads);
-
-			// External tools
-			mExternalTools = new ExternalTools();
-			mExternalTools->windowManager = new window::WindowManager(windowConfig);
-			mExternalTools->graphicsEngine = new graphics::GraphicsEngine();
-			mExternalTools->rigidBodyWorld = new physics::RigidBodyWorld(physicsWorldProperties);
-			mExternalTools->animationEngine = new animation::AnimationEngine();
-			mExternalTools->audioEngine = new audio::AudioEngine(audioDeviceId);
-
-			mEventManager = new EventManager();
-
-			// Repository
-			mRepository = new Repository();
-			mRepository->init<ProgramRef>();
-			mRepository->init<TextureRef>();
-			mRepository->init<MeshRef>();
-			mRepository->init<graphics::Pass>();
-			mRepository->init<graphics::Technique>();
-			mRepository->init<graphics::Font>();
-			mRepository->init<RenderableShaderStep>();
-			mRepository->init<RenderableShader>();
-			mRepository->init<Script>();
-
-			// Entities
-			mEntityDatabase = new EntityDatabase(kMaxEntities);
-			mEntityDatabase->addComponentTable<TagComponent>(kMaxEntities);
-			mEntityDatabase->addComponentTable<TransformsComponent>(kMaxEntities);
-			mEntityDatabase->addComponentTable<SkinComponent>(kMaxEntities);
-			mEntityDatabase->addComponentTable<AnimationComponent>(kMaxEntities);
-			mEntityDatabase->addComponentTable<CameraComponent>(kMaxCameras);
-			mEntityDatabase->addComponentTable<LightComponent>(kMaxEntities);
-			mEntityDatabase->addComponentTable<LightProbeComponent>(kMaxLightProbes);
-			mEntityDatabase->addComponentTable<MeshComponent>(kMaxEntities);
-			mEntityDatabase->addComponentTable<TerrainComponent>(kMaxTerrains);
-			mEntityDatabase->addComponentTable<ParticleSystemComponent>(kMaxEntities);
-			mEntityDatabase->addComponentTable<RigidBodyComponent>(kMaxEntities);
-			mEntityDatabase->addComponentTable<ScriptComponent>(kMaxEntities);
-			mEntityDatabase->addComponentTable<SoundComponent>(kMaxEntities);
-
-			// Systems
-			mSystems.push_back(new InputSystem(*this));
-			mSystems.push_back(new ScriptSystem(*this));
-			mSystems.push_back(new AnimationSystem(*this));
-			mSystems.push_back(new PhysicsSystem(*this));
-			mSystems.push_back(new AudioSystem(*this));
-			mSystems.push_back(mAppRenderer = new AppRenderer(*this, windowConfig.width, windowConfig.height));
-			mSystems.push_back(new CameraSystem(*this));
-			mSystems.push_back(new LightSystem(*this, kShadowSplitLogFactor));
-			mSystems.push_back(new LightProbeSystem(*this));
-			mSystems.push_back(new TerrainSystem(*this));
-			mSystems.push_back(new MeshSystem(*this));
-			mSystems.push_back(new ParticleSystemSystem(*this));
-
-			// GUI
-			mGUIManager = new GUIManager(*this, { windowConfig.width, windowConfig.height });
 
-			SOMBRA_INFO_LOG << "Application created successfully";
-		}
-		catch (std::exception& e) {
-			mState = AppState::Error;
-			SOMBRA_FATAL_LOG << "Error while creating the Application: " << e.what();
-		}
+	Application::Application(
+		const physics::WorldProperties& physicsWorldProperties,
+		float updateTime,
+		const HeadlessConfig& headlessConfig
+	) : mUpdateTime(updateTime), mHeadless(true), mHeadlessConfig(headlessConfig),
+		mStopRunning(false), mState(AppState::Stopped),
+		mThreadPool(nullptr), mExternalTools(nullptr), mEventManager(nullptr),
+		mRepository(nullptr), mEntityDatabase(nullptr),
+		mAppRenderer(nullptr), mGUIManager(nullptr)
+	{
+		SOMBRA_INFO_LOG << "Creating the headless Application";
+		init(nullptr, physicsWorldProperties, 0, headlessConfig.maxEntities);
 	}
 
 
@@ -169,6 +121,86 @@ namespace se::app {
 	}
 
 // Private functions
+	void Application::init(
+		const window::WindowData* windowConfig,
+		const physics::WorldProperties& physicsWorldProperties,
+		std::size_t audioDeviceId, std::size_t maxEntities
+	) {
+		try {
+			// We need at least 1 extra thread for loading
+			std::size_t numThreads = std::min(std::thread::hardware_concurrency(), 1u);
+			mThreadPool = new utils::ThreadPool(numThreads);
+
+			// External tools
+			mExternalTools = new ExternalTools();
+			if (!mHeadless) {
+				mExternalTools->windowManager = new window::WindowManager(*windowConfig);
+				mExternalTools->graphicsEngine = new graphics::GraphicsEngine();
+				mExternalTools->audioEngine = new audio::AudioEngine(audioDeviceId);
+			}
+			mExternalTools->rigidBodyWorld = new physics::RigidBodyWorld(physicsWorldProperties);
+			mExternalTools->animationEngine = new animation::AnimationEngine();
+
+			mEventManager = new EventManager();
+
+			// Repository
+			mRepository = new Repository();
+			mRepository->init<ProgramRef>();
+			mRepository->init<TextureRef>();
+			mRepository->init<MeshRef>();
+			mRepository->init<graphics::Pass>();
+			mRepository->init<graphics::Technique>();
+			mRepository->init<graphics::Font>();
+			mRepository->init<RenderableShaderStep>();
+			mRepository->init<RenderableShader>();
+			mRepository->init<Script>();
+
+			// Entities
+			mEntityDatabase = new EntityDatabase(maxEntities);
+			mEntityDatabase->addComponentTable<TagComponent>(maxEntities);
+			mEntityDatabase->addComponentTable<TransformsComponent>(maxEntities);
+			mEntityDatabase->addComponentTable<SkinComponent>(maxEntities);
+			mEntityDatabase->addComponentTable<AnimationComponent>(maxEntities);
+			mEntityDatabase->addComponentTable<CameraComponent>(kMaxCameras);
+			mEntityDatabase->addComponentTable<LightComponent>(maxEntities);
+			mEntityDatabase->addComponentTable<LightProbeComponent>(kMaxLightProbes);
+			mEntityDatabase->addComponentTable<MeshComponent>(maxEntities);
+			mEntityDatabase->addComponentTable<TerrainComponent>(kMaxTerrains);
+			mEntityDatabase->addComponentTable<ParticleSystemComponent>(maxEntities);
+			mEntityDatabase->addComponentTable<RigidBodyComponent>(maxEntities);
+			mEntityDatabase->addComponentTable<ScriptComponent>(maxEntities);
+			mEntityDatabase->addComponentTable<SoundComponent>(maxEntities);
+
+			// Systems
+			if (!mHeadless) {
+				mSystems.push_back(new InputSystem(*this));
+			}
+			mSystems.push_back(new ScriptSystem(*this));
+			mSystems.push_back(new AnimationSystem(*this));
+			mSystems.push_back(new PhysicsSystem(*this));
+			if (!mHeadless) {
+				mSystems.push_back(new AudioSystem(*this));
+				mSystems.push_back(mAppRenderer = new AppRenderer(*this, windowConfig->width, windowConfig->height));
+				mSystems.push_back(new CameraSystem(*this));
+				mSystems.push_back(new LightSystem(*this, kShadowSplitLogFactor));
+				mSystems.push_back(new LightProbeSystem(*this));
+				mSystems.push_back(new TerrainSystem(*this));
+				mSystems.push_back(new MeshSystem(*this));
+				mSystems.push_back(new ParticleSystemSystem(*this));
+
+				// GUI
+				mGUIManager = new GUIManager(*this, { windowConfig->width, windowConfig->height });
+			}
+
+			SOMBRA_INFO_LOG << "Application created successfully";
+		}
+		catch (std::exception& e) {
+			mState = AppState::Error;
+			SOMBRA_FATAL_LOG << "Error while creating the Application: " << e.what();
+		}
+	}
+
+
 	bool Application::run()
 	{
 		SOMBRA_INFO_LOG << "Start running";
@@ -186,6 +218,7 @@ namespace se::app {
 
 		/* Based on https://gafferongames.com/post/fix_your_timestep/ */
 		float renderTimeSinceStart = 0.0f, updateTimeSinceStart = 0.0f, updateAccumulator = 0.0f;
+		std::size_t numUpdates = 0;
 		auto lastTP = std::chrono::high_resolution_clock::now();
 
 		while (!mStopRunning) {
@@ -194,20 +227,40 @@ namespace se::app {
 			std::chrono::duration<float> durationInSeconds = currentTP - lastTP;
 			lastTP = currentTP;
 
-			float updateFrameTime = std::min(durationInSeconds.count(), 0.25f);
-			updateAccumulator += updateFrameTime;
+			if (mHeadless && mHeadlessConfig.runAsFastAsPossible) {
+				// Simulate exactly one update per iteration
+				updateAccumulator = mUpdateTime;
+			}
+			else {
+				float updateFrameTime = std::min(durationInSeconds.count(), 0.25f);
+				updateAccumulator += updateFrameTime;
+			}
 
-			while (updateAccumulator >= mUpdateTime) {
+			while (!mStopRunning && (updateAccumulator >= mUpdateTime)) {
 				updateAccumulator -= mUpdateTime;
 				updateTimeSinceStart += mUpdateTime;
 
 				// Update the Systems
 				onUpdate(mUpdateTime, updateTimeSinceStart);
+
+				++numUpdates;
+				if (mHeadless && (mHeadlessConfig.maxUpdates > 0) && (numUpdates >= mHeadlessConfig.maxUpdates)) {
+					mStopRunning = true;
+				}
 			}
 
 			// Draw
 			renderTimeSinceStart += durationInSeconds.count();
 			onRender(durationInSeconds.count(), renderTimeSinceStart);
+
+			// Store the allocations made in the current frame
+			utils::MemoryTracker::getInstance().endFrame();
+
+			// Without vsync there is nothing that limits the loop, so we wait
+			// for the next update instead of spinning
+			if (mHeadless && !mHeadlessConfig.runAsFastAsPossible && !mStopRunning) {
+				std::this_thread::sleep_for(std::chrono::duration<float>(mUpdateTime - updateAccumulator));
+			}
 		}
 
 		mState = AppState::Stopped;
@@ -222,7 +275,9 @@ namespace se::app {
 		utils::TimeGuard t0("onUpdate");
 		SOMBRA_DEBUG_LOG << "Init (" << deltaTime << ")";
 
-		mExternalTools->windowManager->update();
+		if (mExternalTools->windowManager) {
+			mExternalTools->windowManager->update();
+		}
 		for (ISystem* system : mSystems) {
 			system->update(deltaTime, timeSinceStart);
 		}
@@ -236,8 +291,12 @@ namespace se::app {
 		utils::TimeGuard t0("onRender");
 		SOMBRA_DEBUG_LOG << "Init (" << deltaTime << ")";
 
-		mAppRenderer->render();
-		mExternalTools->windowManager->swapBuffers();
+		if (mAppRenderer) {
+			mAppRenderer->render();
+		}
+		if (mExternalTools->windowManager) {
+			mExternalTools->windowManager->swapBuffers();
+		}
 
 		SOMBRA_DEBUG_LOG << "End";
 	}
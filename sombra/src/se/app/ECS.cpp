@@ -86,6 +86,8 @@ namespace se::app {
 		Entity ret = addEntity();
 
 		for (std::size_t i = 0; i < mParent.mComponentTables.size(); ++i) {
+			if (!mParent.mComponentTables[i]) { continue; }
+
 			if (mParent.mComponentTables[i]->copyComponent(source, ret)) {
 				if (mParent.mComponentTables[i]->hasComponentEnabled(ret)) {
 					for (auto& pair : mParent.mSystems) {
@@ -106,6 +108,8 @@ namespace se::app {
 		if (entity == kNullEntity) { return; }
 
 		for (std::size_t i = 0; i < mParent.mComponentTables.size(); ++i) {
+			if (!mParent.mComponentTables[i]) { continue; }
+
 			if (mParent.mComponentTables[i]->hasComponentEnabled(entity)) {
 				for (auto& pair : mParent.mSystems) {
 					if (pair.second[i]) {
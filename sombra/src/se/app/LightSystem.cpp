@@ -133,7 +133,7 @@ namespace se::app {
 		// RenderableShaderSteps
 		mLightVolumeData->stepDeferredStencil = mApplication.getRepository().findByName<RenderableShaderStep>("stepDeferredStencil");
 		if (!mLightVolumeData->stepDeferredStencil) {
-			mLightVolumeData->stepDeferredStencil = mApplication.getRepository().insert(std::make_shared<RenderableShaderStep>(*deferredLightSubGraph->getStencilRenderer()), "stepDeferredStencil");
+			mLightVolumeData->stepDeferredStencil = mApplication.getRepository().insert(Repository::makeShared<RenderableShaderStep>(*deferredLightSubGraph->getStencilRenderer()), "stepDeferredStencil");
 			mLightVolumeData->stepDeferredStencil->addBindable(mLightVolumeData->programDeferredStencil);
 		}
 
@@ -143,7 +143,7 @@ namespace se::app {
 			mLightVolumeData->cameraPosition[LightVolumeData::kDL] = context.create<graphics::UniformVariableValue<glm::vec3>>("uViewPosition")
 				.qedit([=](auto& q, auto& uniform) { uniform.load(*q.getTBindable(program)); });
 
-			mLightVolumeData->stepDeferredLighting[LightVolumeData::kDL] = mApplication.getRepository().insert(std::make_shared<RenderableShaderStep>(*deferredLightSubGraph->getColorRenderer()), "stepDeferredLighting");
+			mLightVolumeData->stepDeferredLighting[LightVolumeData::kDL] = mApplication.getRepository().insert(Repository::makeShared<RenderableShaderStep>(*deferredLightSubGraph->getColorRenderer()), "stepDeferredLighting");
 			mLightVolumeData->stepDeferredLighting[LightVolumeData::kDL]->addBindable(program)
 				.addBindable(
 					context.create<graphics::UniformVariableValue<int>>("uPosition", DeferredLightSubGraph::TexUnits::kPosition)
@@ -170,7 +170,7 @@ namespace se::app {
 			mLightVolumeData->cameraPosition[LightVolumeData::kDLCSM] = context.create<graphics::UniformVariableValue<glm::vec3>>("uViewPosition")
 				.qedit([=](auto& q, auto& uniform) { uniform.load(*q.getTBindable(program)); });
 
-			mLightVolumeData->stepDeferredLighting[LightVolumeData::kDLCSM] = mApplication.getRepository().insert(std::make_shared<RenderableShaderStep>(*deferredLightSubGraph->getColorRenderer()), "stepDeferredLightingCSM");
+			mLightVolumeData->stepDeferredLighting[LightVolumeData::kDLCSM] = mApplication.getRepository().insert(Repository::makeShared<RenderableShaderStep>(*deferredLightSubGraph->getColorRenderer()), "stepDeferredLightingCSM");
 			mLightVolumeData->stepDeferredLighting[LightVolumeData::kDLCSM]->addBindable(program)
 				.addBindable(
 					context.create<graphics::UniformVariableValue<int>>("uPosition", DeferredLightSubGraph::TexUnits::kPosition)
@@ -201,7 +201,7 @@ namespace se::app {
 			mLightVolumeData->cameraPosition[LightVolumeData::kDLPLShadows] = context.create<graphics::UniformVariableValue<glm::vec3>>("uViewPosition")
 				.qedit([=](auto& q, auto& uniform) { uniform.load(*q.getTBindable(program)); });
 
-			mLightVolumeData->stepDeferredLighting[LightVolumeData::kDLPLShadows] = mApplication.getRepository().insert(std::make_shared<RenderableShaderStep>(*deferredLightSubGraph->getColorRenderer()), "stepDeferredLightingPLShadows");
+			mLightVolumeData->stepDeferredLighting[LightVolumeData::kDLPLShadows] = mApplication.getRepository().insert(Repository::makeShared<RenderableShaderStep>(*deferredLightSubGraph->getColorRenderer()), "stepDeferredLightingPLShadows");
 			mLightVolumeData->stepDeferredLighting[LightVolumeData::kDLPLShadows]->addBindable(program)
 				.addBindable(
 					context.create<graphics::UniformVariableValue<int>>("uPosition", DeferredLightSubGraph::TexUnits::kPosition)
@@ -229,21 +229,21 @@ namespace se::app {
 		// RenderableShaders
 		mLightVolumeData->shaderDeferredLighting[LightVolumeData::kDL] = mApplication.getRepository().findByName<RenderableShader>("shaderDeferredLight");
 		if (!mLightVolumeData->shaderDeferredLighting[LightVolumeData::kDL]) {
-			mLightVolumeData->shaderDeferredLighting[LightVolumeData::kDL] = mApplication.getRepository().insert(std::make_shared<RenderableShader>(mApplication.getEventManager()), "shaderDeferredLight");
+			mLightVolumeData->shaderDeferredLighting[LightVolumeData::kDL] = mApplication.getRepository().insert(Repository::makeShared<RenderableShader>(mApplication.getEventManager()), "shaderDeferredLight");
 			mLightVolumeData->shaderDeferredLighting[LightVolumeData::kDL]->addStep(mLightVolumeData->stepDeferredStencil)
 				.addStep(mLightVolumeData->stepDeferredLighting[LightVolumeData::kDL]);
 		}
 
 		mLightVolumeData->shaderDeferredLighting[LightVolumeData::kDLCSM] = mApplication.getRepository().findByName<RenderableShader>("shaderDeferredLightCSM");
 		if (!mLightVolumeData->shaderDeferredLighting[LightVolumeData::kDLCSM]) {
-			mLightVolumeData->shaderDeferredLighting[LightVolumeData::kDLCSM] = mApplication.getRepository().insert(std::make_shared<RenderableShader>(mApplication.getEventManager()), "shaderDeferredLightCSM");
+			mLightVolumeData->shaderDeferredLighting[LightVolumeData::kDLCSM] = mApplication.getRepository().insert(Repository::makeShared<RenderableShader>(mApplication.getEventManager()), "shaderDeferredLightCSM");
 			mLightVolumeData->shaderDeferredLighting[LightVolumeData::kDLCSM]->addStep(mLightVolumeData->stepDeferredStencil)
 				.addStep(mLightVolumeData->stepDeferredLighting[LightVolumeData::kDLCSM]);
 		}
 
 		mLightVolumeData->shaderDeferredLighting[LightVolumeData::kDLPLShadows] = mApplication.getRepository().findByName<RenderableShader>("shaderDeferredLightPLShadows");
 		if (!mLightVolumeData->shaderDeferredLighting[LightVolumeData::kDLPLShadows]) {
-			mLightVolumeData->shaderDeferredLighting[LightVolumeData::kDLPLShadows] = mApplication.getRepository().insert(std::make_shared<RenderableShader>(mApplication.getEventManager()), "shaderDeferredLightPLShadows");
+			mLightVolumeData->shaderDeferredLighting[LightVolumeData::kDLPLShadows] = mApplication.getRepository().insert(Repository::makeShared<RenderableShader>(mApplication.getEventManager()), "shaderDeferredLightPLShadows");
 			mLightVolumeData->shaderDeferredLighting[LightVolumeData::kDLPLShadows]->addStep(mLightVolumeData->stepDeferredStencil)
 				.addStep(mLightVolumeData->stepDeferredLighting[LightVolumeData::kDLPLShadows]);
 		}
@@ -25,26 +25,26 @@ namespace se::app {
 		repository.init<ProgramRef>();
 		repository.init<TextureRef>([](const TextureRef& texture) {
 			auto tBindable = TextureRef::from(texture.clone());
-			return std::make_unique<TextureRef>(tBindable);
+			return Repository::makeShared<TextureRef>(tBindable);
 		});
 		repository.init<MeshRef>([](const MeshRef& mesh) {
 			auto tBindable = MeshRef::from(mesh.clone());
-			return std::make_unique<MeshRef>(tBindable);
+			return Repository::makeShared<MeshRef>(tBindable);
 		});
 		repository.init<DataSource>([](const DataSource& dSource) {
-			return std::make_unique<DataSource>(dSource);
+			return Repository::makeShared<DataSource>(dSource);
 		});
 		repository.init<Force>([](const Force& force) {
 			return force.clone();
 		});
 		repository.init<Skin>([](const Skin& skin) {
-			return std::make_unique<Skin>(skin);
+			return Repository::makeShared<Skin>(skin);
 		});
 		repository.init<LightSource>([](const LightSource& source) {
-			return std::make_unique<LightSource>(source);
+			return Repository::makeShared<LightSource>(source);
 		});
 		repository.init<ParticleEmitter>([](const ParticleEmitter& emitter) {
-			return std::make_unique<ParticleEmitter>(emitter);
+			return Repository::makeShared<ParticleEmitter>(emitter);
 		});
 		repository.init<RenderableShaderStep>([](const RenderableShaderStep& step) {
 			return step.clone();
@@ -15,9 +15,11 @@ namespace se::app {
 		mApplication.getEventManager().subscribe(this, Topic::WindowResize);
 		mApplication.getEventManager().subscribe(this, Topic::Script);
 
-		const auto& windowData = mApplication.getExternalTools().windowManager->getWindowData();
-		mScriptSharedState.windowWidth = static_cast<float>(windowData.width);
-		mScriptSharedState.windowHeight = static_cast<float>(windowData.height);
+		if (auto windowManager = mApplication.getExternalTools().windowManager) {
+			const auto& windowData = windowManager->getWindowData();
+			mScriptSharedState.windowWidth = static_cast<float>(windowData.width);
+			mScriptSharedState.windowHeight = static_cast<float>(windowData.height);
+		}
 		mScriptSharedState.entityDatabase = &mApplication.getEntityDatabase();
 		mScriptSharedState.eventManager = &mApplication.getEventManager();
 	}
@@ -1,4 +1,3 @@
-#include <cstring>
 #include <algorithm>
 #include <glm/gtc/matrix_transform.hpp>
 #include "se/app/SkinComponent.h"
@@ -11,7 +10,7 @@ namespace se::app {
 		for (auto [myNode, index] : mJointIndices) {
 			auto it = std::find_if(otherRootNode->begin(), otherRootNode->end(),
 				[&, myNode = myNode](const animation::AnimationNode& otherNode) {
-					return std::strcmp(myNode->getData().name.data(), otherNode.getData().name.data());
+					return myNode->getData().name == otherNode.getData().name;
 				}
 			);
 			if (it != otherRootNode->end()) {
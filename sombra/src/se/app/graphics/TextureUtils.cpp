@@ -516,7 +516,7 @@ namespace se::app {
 
 		ret.width = width;
 		ret.height = height;
-		ret.pixels = std::unique_ptr<T[]>(new T[ret.width * ret.height * ret.channels]);
+		ret.pixels = allocatePixels<T>(ret.width * ret.height * ret.channels);
 
 		source.edit([&](graphics::Texture& tex) {
 			tex.getImage(type, color, ret.pixels.get());
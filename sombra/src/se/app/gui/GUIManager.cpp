@@ -34,7 +34,7 @@ namespace se::app {
 					SOMBRA_ERROR_LOG << result.description();
 					return;
 				}
-				mProgramResource = mApplication.getRepository().insert(std::make_shared<ProgramRef>(programRef), "program2D");
+				mProgramResource = mApplication.getRepository().insert(Repository::makeShared<ProgramRef>(programRef), "program2D");
 			}
 
 			glm::mat4 projectionMatrix = glm::ortho(0.0f, initialWindowSize.x, initialWindowSize.y, 0.0f, -1.0f, 1.0f);
@@ -55,7 +55,7 @@ namespace se::app {
 				);
 			}
 
-			auto technique2D = std::make_shared<graphics::Technique>();
+			auto technique2D = Repository::makeShared<graphics::Technique>();
 			technique2D->addPass(pass);
 			mTechnique = mApplication.getRepository().insert(std::move(technique2D), "technique2D");
 		}
@@ -280,6 +280,10 @@ namespace se::app {
 
 	Result GLTFImporter::load(const std::string& path, Scene& output)
 	{
+		if (!output.application.getExternalTools().graphicsEngine) {
+			return Result(false, "The GLTF files can't be loaded without a GraphicsEngine");
+		}
+
 		Result result;
 
 		// Create the temporary data of the GLTF file
@@ -786,7 +790,7 @@ namespace se::app {
 			});
 		}
 
-		auto textureRef = mGLTFData->scene.repository.insert(std::make_shared<TextureRef>(texture), name.c_str());
+		auto textureRef = mGLTFData->scene.repository.insert(Repository::makeShared<TextureRef>(texture), name.c_str());
 		if (!textureRef) {
 			return Result(false, "Can't add Texture with name " + name);
 		}
@@ -1063,7 +1067,7 @@ namespace se::app {
 
 	Result GLTFImporter::parseSkin(const nlohmann::json& jsonSkin)
 	{
-		auto skin = std::make_shared<Skin>();
+		auto skin = Repository::makeShared<Skin>();
 		IndexVector jointIndices;
 
 		std::string name = mGLTFData->fileName + "_skin" + std::to_string(mGLTFData->skins.size());
@@ -1341,7 +1345,7 @@ namespace se::app {
 				if (sAnimator.getLoopTime() < tAnimator->getLoopTime()) {
 					sAnimator.setLoopTime(tAnimator->getLoopTime());
 				}
-				sAnimator.addAnimator(mGLTFData->nodes[nodeId].nodeData.name.data(), transformationType, std::move(tAnimator));
+				sAnimator.addAnimator(mGLTFData->nodes[nodeId].nodeData.name, transformationType, std::move(tAnimator));
 				return Result();
 			}
 			else {
@@ -1392,7 +1396,7 @@ namespace se::app {
 			}
 		}
 
-		auto skeletonAnimator = std::make_shared<animation::SkeletonAnimator>();
+		auto skeletonAnimator = Repository::makeShared<animation::SkeletonAnimator>();
 
 		for (std::size_t channelId = 0; channelId < itChannels->size(); ++channelId) {
 			IAnimatorUPtr out;
@@ -1446,16 +1450,16 @@ namespace se::app {
 		auto itType = jsonLight.find("type");
 		if (itType != jsonLight.end()) {
 			if (*itType == "directional") {
-				lightSource = std::make_shared<LightSource>(mGLTFData->scene.application.getEventManager(), LightSource::Type::Directional);
+				lightSource = Repository::makeShared<LightSource>(mGLTFData->scene.application.getEventManager(), LightSource::Type::Directional);
 			}
 			else if (*itType == "point") {
-				lightSource = std::make_shared<LightSource>(mGLTFData->scene.application.getEventManager(), LightSource::Type::Point);
+				lightSource = Repository::makeShared<LightSource>(mGLTFData->scene.application.getEventManager(), LightSource::Type::Point);
 
 				auto itRange = jsonLight.find("range");
 				lightSource->setRange((itRange != jsonLight.end())? itRange->get<float>() : std::numeric_limits<float>::max());
 			}
 			else if (*itType == "spot") {
-				lightSource = std::make_shared<LightSource>(mGLTFData->scene.application.getEventManager(), LightSource::Type::Spot);
+				lightSource = Repository::makeShared<LightSource>(mGLTFData->scene.application.getEventManager(), LightSource::Type::Spot);
 
 				auto itRange = jsonLight.find("range");
 				lightSource->setRange((itRange != jsonLight.end())? itRange->get<float>() : std::numeric_limits<float>::max());
@@ -1508,12 +1512,7 @@ namespace se::app {
 
 		auto itName = jsonNode.find("name");
 		if (itName != jsonNode.end()) {
-			std::string name = *itName;
-			std::size_t length = name.size();
-			if (length >= animation::NodeData::kMaxLength) {
-				length = animation::NodeData::kMaxLength - 1;
-			}
-			name.copy(node.nodeData.name.data(), length);
+			node.nodeData.name = utils::NameId(itName->get<std::string>());
 		}
 
 		auto itMatrix = jsonNode.find("matrix");
@@ -1565,7 +1564,7 @@ namespace se::app {
 				mGLTFData->scene.entities.push_back(node.entity);
 
 				query.emplaceComponent<TransformsComponent>(node.entity);
-				query.emplaceComponent<TagComponent>(node.entity, node.nodeData.name.data());
+				query.emplaceComponent<TagComponent>(node.entity, node.nodeData.name.c_str());
 			});
 
 			if (itCamera != jsonNode.end()) {
@@ -1831,7 +1830,7 @@ namespace se::app {
 		});
 
 		std::string name = mGLTFData->fileName + "_mesh" + std::to_string(PrimitiveMeshData::MyHash()(primitiveMesh));
-		out = mGLTFData->scene.repository.insert(std::make_shared<MeshRef>(meshRef), name.c_str());
+		out = mGLTFData->scene.repository.insert(Repository::makeShared<MeshRef>(meshRef), name.c_str());
 		if (!out) {
 			return Result(false, "Can't add Mesh with name " + name);
 		}
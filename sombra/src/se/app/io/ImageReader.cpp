@@ -1,3 +1,4 @@
+#include <algorithm>
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 #include "se/app/io/ImageReader.h"
@@ -15,11 +16,17 @@ namespace se::app {
 			return Result(false, "Error loading the image located in \""s + path + "\": " + stbi_failure_reason());
 		}
 
+		// The pixels are copied to tracked memory so they are counted by the
+		// MemoryTracker and released with the same allocator
+		int numChannels = (forceNumChannels <= 0)? channels : forceNumChannels;
+		std::size_t length = static_cast<std::size_t>(width) * height * numChannels;
 		output = {
-			std::unique_ptr<unsigned char[]>(pixels),
+			allocatePixels<unsigned char>(length),
 			static_cast<std::size_t>(width), static_cast<std::size_t>(height),
 			channels
 		};
+		std::copy(pixels, pixels + length, output.pixels.get());
+		stbi_image_free(pixels);
 		return Result();
 	}
 
@@ -37,11 +44,17 @@ namespace se::app {
 			return Result(false, "Error loading the HDR image located in \""s + path + "\": " + stbi_failure_reason());
 		}
 
+		// The pixels are copied to tracked memory so they are counted by the
+		// MemoryTracker and released with the same allocator
+		int numChannels = (forceNumChannels <= 0)? channels : forceNumChannels;
+		std::size_t length = static_cast<std::size_t>(width) * height * numChannels;
 		output = {
-			std::unique_ptr<float[]>(pixels),
+			allocatePixels<float>(length),
 			static_cast<std::size_t>(width), static_cast<std::size_t>(height),
 			channels
 		};
+		std::copy(pixels, pixels + length, output.pixels.get());
+		stbi_image_free(pixels);
 		return Result();
 	}
 
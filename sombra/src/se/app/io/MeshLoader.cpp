@@ -428,11 +428,11 @@ namespace se::app {
 	}
 
 
-	std::vector<glm::vec3> MeshLoader::calculateNormals(
-		const std::vector<glm::vec3>& positions,
-		const std::vector<unsigned short>& faceIndices
+	MeshVector<glm::vec3> MeshLoader::calculateNormals(
+		const MeshVector<glm::vec3>& positions,
+		const MeshVector<unsigned short>& faceIndices
 	) {
-		std::vector<glm::vec3> normals(positions.size(), glm::vec3(0.0f));
+		MeshVector<glm::vec3> normals(positions.size(), glm::vec3(0.0f));
 
 		// The normal vector of every vertex is calculated as the sum of the
 		// normal vectors of the faces it belongs to
@@ -456,12 +456,12 @@ namespace se::app {
 	}
 
 
-	std::vector<glm::vec3> MeshLoader::calculateTangents(
-		const std::vector<glm::vec3>& positions,
-		const std::vector<glm::vec2>& texCoords,
-		const std::vector<unsigned short>& faceIndices
+	MeshVector<glm::vec3> MeshLoader::calculateTangents(
+		const MeshVector<glm::vec3>& positions,
+		const MeshVector<glm::vec2>& texCoords,
+		const MeshVector<unsigned short>& faceIndices
 	) {
-		std::vector<glm::vec3> tangents(positions.size(), glm::vec3(0.0f));
+		MeshVector<glm::vec3> tangents(positions.size(), glm::vec3(0.0f));
 
 		// The tangent vector of every vertex is calculated as the sum of the
 		// tangent vectors of the faces it belongs to
@@ -0,0 +1,535 @@
+#include <cmath>
+#include <random>
+#include <cstdint>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include "se/utils/Log.h"
+#include "se/graphics/GraphicsEngine.h"
+#include "se/physics/forces/Gravity.h"
+#include "se/physics/collision/Capsule.h"
+#include "se/physics/collision/QuickHull.h"
+#include "se/physics/collision/BoundingBox.h"
+#include "se/physics/collision/BoundingSphere.h"
+#include "se/physics/collision/TerrainCollider.h"
+#include "se/physics/collision/ConvexPolyhedron.h"
+#include "se/physics/collision/TriangleMeshCollider.h"
+#include "se/animation/SkeletonAnimator.h"
+#include "se/animation/LinearAnimations.h"
+#include "se/app/io/SceneGenerator.h"
+#include "se/app/io/MeshLoader.h"
+#include "se/app/TagComponent.h"
+#include "se/app/TransformsComponent.h"
+#include "se/app/RigidBodyComponent.h"
+#include "se/app/MeshComponent.h"
+#include "se/app/LightComponent.h"
+#include "se/app/SkinComponent.h"
+#include "se/app/AnimationComponent.h"
+#include "se/app/ParticleSystemComponent.h"
+
+using namespace se::physics;
+using namespace se::animation;
+
+namespace se::app {
+
+	/** Random number generator that returns the same values on every
+	 * platform. The std distributions are implementation defined, so the
+	 * floats are calculated from the raw mt19937 values */
+	class SceneRandom
+	{
+	private:	// Attributes
+		std::mt19937 mEngine;
+
+	public:		// Functions
+		SceneRandom(unsigned int seed) : mEngine(seed) {};
+
+		/** @return	a random float in the range [0, 1) */
+		float uniform()
+		{ return static_cast<float>(mEngine() >> 8) * (1.0f / 16777216.0f); };
+
+		/** @return	a random float in the range [a, b) */
+		float uniform(float a, float b) { return a + (b - a) * uniform(); };
+
+		/** @return	a random index in the range [0, n) */
+		std::size_t index(std::size_t n)
+		{ return static_cast<std::size_t>(mEngine() % static_cast<std::uint32_t>(n)); };
+
+		/** @return	a random vector with each component in the range
+		 *			[a, b) */
+		glm::vec3 vec3(const glm::vec3& a, const glm::vec3& b)
+		{ return { uniform(a.x, b.x), uniform(a.y, b.y), uniform(a.z, b.z) }; };
+
+		/** @return	a random orientation */
+		glm::quat orientation()
+		{
+			glm::quat q(uniform(-1.0f, 1.0f), uniform(-1.0f, 1.0f), uniform(-1.0f, 1.0f), uniform(-1.0f, 1.0f));
+			float length = glm::length(q);
+			return (length > 0.0001f)? q / length : glm::quat(1.0f, glm::vec3(0.0f));
+		};
+	};
+
+
+	/** Holds the shared state used while generating a Scene */
+	struct GenerationData
+	{
+		static constexpr std::size_t kNumHulls = 8;
+		static constexpr std::size_t kNumLightSources = 4;
+		static constexpr float kBoneLength = 0.25f;
+
+		const SceneGenerator::Config& config;
+		Scene& scene;
+		SceneRandom random;
+		graphics::GraphicsEngine* graphicsEngine;
+
+		Repository::ResourceRef<Force> gravity;
+		std::vector<HalfEdgeMesh> hulls;
+		RawMesh sphereRawMesh;
+		Repository::ResourceRef<MeshRef> cubeMesh, sphereMesh;
+		Repository::ResourceRef<ParticleEmitter> emitter;
+		std::vector<Repository::ResourceRef<LightSource>> lightSources;
+		Repository::ResourceRef<Skin> skin;
+		Repository::ResourceRef<SkeletonAnimator> skeletonAnimator;
+		std::vector<utils::NameId> boneNames;
+
+		GenerationData(const SceneGenerator::Config& config, Scene& scene) :
+			config(config), scene(scene), random(config.seed),
+			graphicsEngine(scene.application.getExternalTools().graphicsEngine) {};
+	};
+
+
+	static Entity addEntity(
+		GenerationData& data, EntityDatabase::Query& query,
+		const std::string& name, const glm::vec3& position, const glm::quat& orientation,
+		const glm::vec3& scale = glm::vec3(1.0f)
+	) {
+		Entity entity = query.addEntity();
+		if (entity == kNullEntity) {
+			return entity;
+		}
+
+		data.scene.entities.push_back(entity);
+		query.emplaceComponent<TagComponent>(entity, true, name);
+
+		TransformsComponent transforms;
+		transforms.position = position;
+		transforms.orientation = orientation;
+		transforms.scale = scale;
+		query.addComponent(entity, std::move(transforms));
+
+		return entity;
+	}
+
+
+	static void addMesh(GenerationData& data, EntityDatabase::Query& query, Entity entity, const Repository::ResourceRef<MeshRef>& mesh)
+	{
+		if (!mesh) {
+			return;
+		}
+
+		auto meshComponent = query.emplaceComponent<MeshComponent>(entity);
+		if (meshComponent) {
+			std::size_t rIndex = meshComponent->add(false, mesh);
+			if (data.config.shader) {
+				meshComponent->addRenderableShader(rIndex, data.config.shader);
+			}
+		}
+	}
+
+
+	static glm::vec3 randomPosition(GenerationData& data, float minHeight, float maxHeight)
+	{
+		float halfSize = 0.5f * data.config.worldSize;
+		return data.random.vec3({ -halfSize, minHeight, -halfSize }, { halfSize, maxHeight, halfSize });
+	}
+
+
+	static Result createResources(GenerationData& data)
+	{
+		Repository& repository = data.scene.repository;
+
+		data.gravity = repository.insert<Force>(Repository::makeShared<Gravity>(), "stressGravity");
+
+		// Convex hulls of random point clouds
+		QuickHull quickHull(0.0001f);
+		for (std::size_t i = 0; i < GenerationData::kNumHulls; ++i) {
+			HalfEdgeMesh pointCloud;
+			for (std::size_t j = 0; j < 16; ++j) {
+				addVertex(pointCloud, data.random.vec3(glm::vec3(-1.0f), glm::vec3(1.0f)));
+			}
+
+			quickHull.calculate(pointCloud);
+			data.hulls.push_back(quickHull.getMesh());
+			quickHull.resetData();
+		}
+
+		data.sphereRawMesh = MeshLoader::createSphereMesh("stressSphere", 16, 8, 1.0f);
+
+		// Graphics meshes
+		if (data.graphicsEngine) {
+			RawMesh cubeRawMesh = MeshLoader::createBoxMesh("stressCube", glm::vec3(1.0f));
+			cubeRawMesh.normals = MeshLoader::calculateNormals(cubeRawMesh.positions, cubeRawMesh.indices);
+			cubeRawMesh.tangents = MeshLoader::calculateTangents(cubeRawMesh.positions, cubeRawMesh.texCoords, cubeRawMesh.indices);
+			data.cubeMesh = repository.insert(Repository::makeShared<MeshRef>(MeshLoader::createGraphicsMesh(data.graphicsEngine->getContext(), cubeRawMesh)), "stressCube");
+
+			RawMesh sphereRawMesh = data.sphereRawMesh;
+			sphereRawMesh.normals = MeshLoader::calculateNormals(sphereRawMesh.positions, sphereRawMesh.indices);
+			sphereRawMesh.tangents = MeshLoader::calculateTangents(sphereRawMesh.positions, sphereRawMesh.texCoords, sphereRawMesh.indices);
+			data.sphereMesh = repository.insert(Repository::makeShared<MeshRef>(MeshLoader::createGraphicsMesh(data.graphicsEngine->getContext(), sphereRawMesh)), "stressSphere");
+		}
+
+		// Particles
+		auto emitter = Repository::makeShared<ParticleEmitter>();
+		emitter->maxParticles = 256;
+		emitter->duration = 5.0f;
+		emitter->loop = true;
+		emitter->initialVelocity = 2.0f;
+		emitter->initialPositionRandomFactor = 0.5f;
+		emitter->initialVelocityRandomFactor = 0.5f;
+		emitter->initialRotationRandomFactor = 0.5f;
+		emitter->scale = 0.1f;
+		emitter->lifeLength = 2.0f;
+		emitter->lifeLengthRandomFactor = 0.5f;
+		emitter->gravity = 9.8f;
+		data.emitter = repository.insert(std::move(emitter), "stressEmitter");
+
+		// Lights
+		for (std::size_t i = 0; i < GenerationData::kNumLightSources; ++i) {
+			auto type = (i % 2 == 0)? LightSource::Type::Point : LightSource::Type::Spot;
+			auto source = Repository::makeShared<LightSource>(data.scene.application.getEventManager(), type);
+			source->setColor(data.random.vec3(glm::vec3(0.5f), glm::vec3(1.0f)));
+			source->setIntensity(data.random.uniform(1.0f, 10.0f));
+			source->setRange(data.random.uniform(5.0f, 20.0f));
+			if (type == LightSource::Type::Spot) {
+				source->setSpotLightRange(glm::pi<float>() / 12.0f, glm::pi<float>() / 6.0f);
+			}
+			data.lightSources.push_back( repository.insert(std::move(source), ("stressLight" + std::to_string(i)).c_str()) );
+		}
+
+		// Skeleton animation shared by all the characters
+		std::size_t numBones = data.config.numBonesPerCharacter;
+		if (numBones > Skin::kMaxJoints) {
+			return Result(false, "The number of bones per character can't be larger than " + std::to_string(Skin::kMaxJoints));
+		}
+
+		if ((data.config.numCharacters > 0) && (numBones > 0)) {
+			static constexpr float kLoopTime = 2.0f;
+
+			auto skin = Repository::makeShared<Skin>();
+			auto skeletonAnimator = Repository::makeShared<SkeletonAnimator>(kLoopTime);
+			for (std::size_t i = 0; i < numBones; ++i) {
+				data.boneNames.emplace_back("stressBone" + std::to_string(i));
+
+				float boneHeight = (i + 1) * GenerationData::kBoneLength;
+				skin->inverseBindMatrices.push_back(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -boneHeight, 0.0f)));
+
+				auto rotations = std::make_shared<AnimationQuatLinear>();
+				for (std::size_t k = 0; k < 4; ++k) {
+					float angle = data.random.uniform(-0.25f, 0.25f) * glm::pi<float>();
+					glm::vec3 axis = glm::normalize(data.random.vec3(glm::vec3(-1.0f), glm::vec3(1.0f)) + glm::vec3(0.0f, 0.0f, 0.001f));
+					rotations->addKeyFrame({ glm::angleAxis(angle, axis), k * kLoopTime / 3.0f });
+				}
+				skeletonAnimator->addAnimator(
+					data.boneNames.back(), TransformationAnimator::TransformationType::Rotation,
+					std::make_unique<QuatAnimator>(rotations)
+				);
+			}
+
+			data.skin = repository.insert(std::move(skin), "stressSkin");
+			data.skeletonAnimator = repository.insert(std::move(skeletonAnimator), "stressSkeletonAnimator");
+		}
+
+		return Result();
+	}
+
+
+	static Result addConvexBodies(GenerationData& data, EntityDatabase::Query& query)
+	{
+		for (std::size_t i = 0; i < data.config.numConvexBodies; ++i) {
+			glm::vec3 position = randomPosition(data, 1.0f, 0.25f * data.config.worldSize);
+			Entity entity = addEntity(data, query, "stressConvex" + std::to_string(i), position, data.random.orientation());
+			if (entity == kNullEntity) {
+				return Result(false, "Can't add more Entities");
+			}
+
+			float size = data.random.uniform(0.5f, 2.0f);
+			float mass = data.random.uniform(1.0f, 10.0f);
+
+			RigidBodyProperties properties(mass, glm::mat3(2.0f / 5.0f * mass * size * size));
+			properties.linearDrag = 0.05f;
+			properties.angularDrag = 0.05f;
+			properties.frictionCoefficient = 0.5f;
+
+			RigidBodyComponent rbComponent(properties);
+			switch (data.random.index(4)) {
+				case 0:
+					rbComponent.get().setCollider(std::make_unique<BoundingBox>(glm::vec3(size)));
+					addMesh(data, query, entity, data.cubeMesh);
+					break;
+				case 1:
+					rbComponent.get().setCollider(std::make_unique<BoundingSphere>(0.5f * size));
+					addMesh(data, query, entity, data.sphereMesh);
+					break;
+				case 2:
+					rbComponent.get().setCollider(std::make_unique<Capsule>(0.25f * size, 0.5f * size));
+					addMesh(data, query, entity, data.sphereMesh);
+					break;
+				default: {
+					const HalfEdgeMesh& hull = data.hulls[data.random.index(data.hulls.size())];
+					rbComponent.get().setCollider(std::make_unique<ConvexPolyhedron>(hull));
+					addMesh(data, query, entity, data.cubeMesh);
+				} break;
+			}
+			rbComponent.addForce(data.gravity);
+			query.addComponent(entity, std::move(rbComponent));
+		}
+
+		return Result();
+	}
+
+
+	static Result addMeshBodies(GenerationData& data, EntityDatabase::Query& query)
+	{
+		const RawMesh& rawMesh = data.sphereRawMesh;
+
+		for (std::size_t i = 0; i < data.config.numMeshBodies; ++i) {
+			glm::vec3 position = randomPosition(data, 0.0f, 0.0f);
+			float scale = data.random.uniform(2.0f, 6.0f);
+			Entity entity = addEntity(data, query, "stressMeshBody" + std::to_string(i), position, data.random.orientation(), glm::vec3(scale));
+			if (entity == kNullEntity) {
+				return Result(false, "Can't add more Entities");
+			}
+
+			std::vector<glm::vec3> vertices;
+			vertices.reserve(rawMesh.positions.size());
+			for (const glm::vec3& p : rawMesh.positions) {
+				vertices.push_back(scale * p);
+			}
+
+			RigidBodyComponent rbComponent;
+			rbComponent.get().setCollider(std::make_unique<TriangleMeshCollider>(std::make_shared<TriangleMesh>(
+				vertices.data(), vertices.size(),
+				rawMesh.indices.data(), rawMesh.indices.size()
+			)));
+			query.addComponent(entity, std::move(rbComponent));
+
+			addMesh(data, query, entity, data.sphereMesh);
+		}
+
+		return Result();
+	}
+
+
+	static Result addTerrains(GenerationData& data, EntityDatabase::Query& query)
+	{
+		std::size_t resolution = std::max(data.config.terrainResolution, std::size_t(2));
+		std::size_t terrainsPerSide = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<float>(data.config.numTerrains))));
+		float terrainSize = data.config.worldSize / std::max(terrainsPerSide, std::size_t(1));
+		float maxHeight = 0.05f * data.config.worldSize;
+
+		for (std::size_t i = 0; i < data.config.numTerrains; ++i) {
+			glm::vec3 position(
+				((i % terrainsPerSide) + 0.5f) * terrainSize - 0.5f * data.config.worldSize,
+				0.0f,
+				((i / terrainsPerSide) + 0.5f) * terrainSize - 0.5f * data.config.worldSize
+			);
+			Entity entity = addEntity(data, query, "stressTerrain" + std::to_string(i), position, glm::quat(1.0f, glm::vec3(0.0f)));
+			if (entity == kNullEntity) {
+				return Result(false, "Can't add more Entities");
+			}
+
+			// Sum of waves with random phases, the heights must be in the
+			// range [-0.5, 0.5]
+			glm::vec3 phases = data.random.vec3(glm::vec3(0.0f), glm::vec3(glm::two_pi<float>()));
+			std::vector<float> heights(resolution * resolution);
+			for (std::size_t z = 0; z < resolution; ++z) {
+				for (std::size_t x = 0; x < resolution; ++x) {
+					float u = glm::two_pi<float>() * x / (resolution - 1);
+					float v = glm::two_pi<float>() * z / (resolution - 1);
+					heights[z * resolution + x] = 0.25f * std::sin(u + phases.x) * std::cos(v + phases.y)
+						+ 0.15f * std::sin(3.0f * u + phases.z)
+						+ 0.1f * std::cos(5.0f * v + phases.x);
+				}
+			}
+
+			auto collider = std::make_unique<TerrainCollider>();
+			collider->setHeights(heights.data(), resolution, resolution);
+
+			RigidBodyComponent rbComponent;
+			rbComponent.get().setCollider(std::move(collider));
+			rbComponent.get().setColliderLocalTrasforms(glm::scale(glm::mat4(1.0f), glm::vec3(terrainSize, maxHeight, terrainSize)));
+			query.addComponent(entity, std::move(rbComponent));
+		}
+
+		return Result();
+	}
+
+
+	static Result addCharacters(GenerationData& data, EntityDatabase::Query& query)
+	{
+		if (!data.skeletonAnimator) {
+			return Result();
+		}
+
+		for (std::size_t i = 0; i < data.config.numCharacters; ++i) {
+			std::string name = "stressCharacter" + std::to_string(i);
+			glm::vec3 position = randomPosition(data, 0.0f, 0.0f);
+			glm::quat orientation = glm::angleAxis(data.random.uniform(0.0f, glm::two_pi<float>()), glm::vec3(0.0f, 1.0f, 0.0f));
+			Entity entity = addEntity(data, query, name, position, orientation);
+			if (entity == kNullEntity) {
+				return Result(false, "Can't add more Entities");
+			}
+
+			// Root node and chain of bones
+			NodeData rootData;
+			rootData.name = utils::NameId(name);
+			rootData.localTransforms.position = position;
+			rootData.localTransforms.orientation = orientation;
+			auto itRoot = data.scene.rootNode.emplace(data.scene.rootNode.cend(), rootData);
+			AnimationNode* rootNode = &(*itRoot);
+
+			SkinComponent::MapNodeJoint jointIndices;
+			AnimationNode* parentNode = rootNode;
+			for (std::size_t j = 0; j < data.boneNames.size(); ++j) {
+				NodeData boneData;
+				boneData.name = data.boneNames[j];
+				boneData.localTransforms.position = glm::vec3(0.0f, GenerationData::kBoneLength, 0.0f);
+
+				auto itBone = parentNode->emplace(parentNode->cend(), boneData);
+				parentNode = &(*itBone);
+				jointIndices.emplace_back(parentNode, j);
+			}
+			updateWorldTransforms(*rootNode);
+
+			auto animation = query.emplaceComponent<AnimationComponent>(entity, true, rootNode);
+			if (animation) {
+				animation->addAnimator(data.skeletonAnimator);
+			}
+			query.emplaceComponent<SkinComponent>(entity, true, rootNode, data.skin, std::move(jointIndices));
+		}
+
+		return Result();
+	}
+
+
+	static Result addParticleEmitters(GenerationData& data, EntityDatabase::Query& query)
+	{
+		if (!data.graphicsEngine) {
+			if (data.config.numParticleEmitters > 0) {
+				SOMBRA_WARN_LOG << "The ParticleSystems need a GraphicsEngine, skipping "
+					<< data.config.numParticleEmitters << " particle emitters";
+			}
+			return Result();
+		}
+
+		for (std::size_t i = 0; i < data.config.numParticleEmitters; ++i) {
+			glm::vec3 position = randomPosition(data, 0.0f, 0.1f * data.config.worldSize);
+			Entity entity = addEntity(data, query, "stressParticles" + std::to_string(i), position, glm::quat(1.0f, glm::vec3(0.0f)));
+			if (entity == kNullEntity) {
+				return Result(false, "Can't add more Entities");
+			}
+
+			ParticleSystemComponent particleSystem;
+			particleSystem.setMesh(data.cubeMesh);
+			particleSystem.setEmitter(data.emitter);
+			if (data.config.shader) {
+				particleSystem.addRenderableShader(data.config.shader);
+			}
+			query.addComponent(entity, std::move(particleSystem));
+		}
+
+		return Result();
+	}
+
+
+	static Result addLights(GenerationData& data, EntityDatabase::Query& query)
+	{
+		for (std::size_t i = 0; i < data.config.numLights; ++i) {
+			glm::vec3 position = randomPosition(data, 2.0f, 0.1f * data.config.worldSize);
+			glm::quat orientation = glm::angleAxis(-0.5f * glm::pi<float>(), glm::vec3(1.0f, 0.0f, 0.0f));
+			Entity entity = addEntity(data, query, "stressLight" + std::to_string(i), position, orientation);
+			if (entity == kNullEntity) {
+				return Result(false, "Can't add more Entities");
+			}
+
+			LightComponent light;
+			light.setSource(data.lightSources[data.random.index(data.lightSources.size())]);
+			query.addComponent(entity, std::move(light));
+		}
+
+		return Result();
+	}
+
+
+	static Result addStaticMeshes(GenerationData& data, EntityDatabase::Query& query)
+	{
+		if (!data.graphicsEngine && (data.config.numStaticMeshes > 0)) {
+			SOMBRA_WARN_LOG << "The Meshes need a GraphicsEngine, the static meshes will only have TransformsComponents";
+		}
+
+		for (std::size_t i = 0; i < data.config.numStaticMeshes; ++i) {
+			glm::vec3 position = randomPosition(data, 0.0f, 0.1f * data.config.worldSize);
+			Entity entity = addEntity(data, query, "stressStaticMesh" + std::to_string(i), position, data.random.orientation());
+			if (entity == kNullEntity) {
+				return Result(false, "Can't add more Entities");
+			}
+
+			addMesh(data, query, entity, (data.random.index(2) == 0)? data.cubeMesh : data.sphereMesh);
+		}
+
+		return Result();
+	}
+
+
+	SceneGenerator::Config SceneGenerator::createConfig(std::size_t numEntities, unsigned int seed)
+	{
+		Config config;
+		config.seed = seed;
+		config.worldSize = 20.0f * std::sqrt(static_cast<float>(std::max(numEntities, std::size_t(1))));
+		config.numTerrains = (numEntities >= 1000)? 4 : 1;
+		config.numMeshBodies = numEntities / 20;
+		config.numCharacters = numEntities / 20;
+		config.numParticleEmitters = numEntities / 50;
+		config.numLights = numEntities / 50;
+		config.numStaticMeshes = numEntities / 4;
+
+		std::size_t numOthers = config.numTerrains + config.numMeshBodies + config.numCharacters
+			+ config.numParticleEmitters + config.numLights + config.numStaticMeshes;
+		config.numConvexBodies = (numEntities > numOthers)? numEntities - numOthers : 0;
+
+		return config;
+	}
+
+
+	Result SceneGenerator::generate(const Config& config, Scene& output)
+	{
+		SOMBRA_INFO_LOG << "Generating Scene " << output.name << " with seed " << config.seed;
+
+		GenerationData data(config, output);
+		if (auto result = createResources(data); !result) {
+			return result;
+		}
+
+		Result result;
+		output.application.getEntityDatabase().executeQuery([&](EntityDatabase::Query& query) {
+			auto steps = {
+				&addTerrains, &addMeshBodies, &addConvexBodies, &addCharacters,
+				&addParticleEmitters, &addLights, &addStaticMeshes
+			};
+			for (auto step : steps) {
+				if (result = step(data, query); !result) {
+					break;
+				}
+			}
+		});
+
+		if (result) {
+			SOMBRA_INFO_LOG << "Scene " << output.name << " generated with " << output.entities.size() << " Entities";
+		}
+		else {
+			SOMBRA_ERROR_LOG << "Failed to generate the Scene " << output.name << ": " << result.description();
+		}
+
+		return result;
+	}
+
+}
@@ -4,6 +4,7 @@
 #include <iomanip>
 #include <optional>
 #include "GLMJSON.h"
+#include "se/utils/Log.h"
 #include "se/physics/forces/Gravity.h"
 #include "se/physics/forces/PunctualForce.h"
 #include "se/physics/forces/DirectionalForce.h"
@@ -113,6 +114,7 @@ namespace se::app {
 		> futureTextures;
 		nlohmann::json buffersJson;
 		nlohmann::json accessorsJson;
+		std::unordered_map<const TriangleMesh*, std::pair<std::size_t, std::size_t>> triangleMeshBuffersMap;
 	};
 
 	struct DeserializeData
@@ -124,6 +126,7 @@ namespace se::app {
 		std::unordered_map<std::size_t, AnimationNode*> indexNodeMap;
 		nlohmann::json& buffersJson;
 		nlohmann::json& accessorsJson;
+		std::unordered_map<std::size_t, std::shared_ptr<const TriangleMesh>> indexTriangleMeshMap;
 	};
 
 	template <typename T>
@@ -415,7 +418,7 @@ namespace se::app {
 				.setBounds(minimum, maximum);
 		});
 
-		mesh = scene.repository.insert(std::make_shared<MeshRef>(meshRef));
+		mesh = scene.repository.insert(Repository::makeShared<MeshRef>(meshRef));
 
 		return Result();
 	}
@@ -451,7 +454,7 @@ namespace se::app {
 			return Result(false, "Failed to parse buffer " + std::to_string(iBuffer) + ": " + result.description());
 		}
 
-		auto skinSPtr = std::make_shared<Skin>();
+		auto skinSPtr = Repository::makeShared<Skin>();
 
 		glm::mat4* bufPtr = reinterpret_cast<glm::mat4*>(buffer.data());
 		std::copy(bufPtr, bufPtr + buffer.size() / sizeof(glm::mat4), skinSPtr->inverseBindMatrices.end());
@@ -528,7 +531,7 @@ namespace se::app {
 	template <>
 	Result deserializeResource<SkeletonAnimator>(const nlohmann::json& json, Repository::ResourceRef<SkeletonAnimator>& animator, DeserializeData& data, Scene& scene)
 	{
-		auto animatorSPtr = std::make_shared<SkeletonAnimator>();
+		auto animatorSPtr = Repository::makeShared<SkeletonAnimator>();
 
 		auto itNodeAnimators = json.find("nodeAnimators");
 		if (itNodeAnimators == json.end()) {
@@ -690,7 +693,7 @@ namespace se::app {
 			return Result(false, "Missing \"type\" property");
 		}
 
-		auto lightSPtr = std::make_shared<LightSource>(scene.application.getEventManager(), static_cast<LightSource::Type>(itType->get<int>()));
+		auto lightSPtr = Repository::makeShared<LightSource>(scene.application.getEventManager(), static_cast<LightSource::Type>(itType->get<int>()));
 
 		auto itColor = json.find("color");
 		if (itColor != json.end()) {
@@ -865,7 +868,7 @@ namespace se::app {
 				});
 			}
 
-			texture = scene.repository.insert(std::make_shared<TextureRef>(textureRef));
+			texture = scene.repository.insert(Repository::makeShared<TextureRef>(textureRef));
 			texture.setPath(path);
 		}
 		else if (itBuffer != json.end()) {
@@ -909,7 +912,7 @@ namespace se::app {
 				});
 			}
 
-			texture = scene.repository.insert(std::make_shared<TextureRef>(textureRef));
+			texture = scene.repository.insert(Repository::makeShared<TextureRef>(textureRef));
 		}
 		else {
 			return Result(false, "Missing \"path\" and \"buffer\" properties");
@@ -961,7 +964,7 @@ namespace se::app {
 			return Result(false, "Couldn't create the program: " + std::string(result.description()));
 		}
 
-		program = scene.repository.insert(std::make_shared<ProgramRef>(programRef));
+		program = scene.repository.insert(Repository::makeShared<ProgramRef>(programRef));
 		program.setPath( itPath->get<std::string>() );
 
 		return Result();
@@ -1152,7 +1155,7 @@ namespace se::app {
 
 		ProgramRef programRef;
 
-		auto stepSPtr = std::make_shared<RenderableShaderStep>(*renderer);
+		auto stepSPtr = Repository::makeShared<RenderableShaderStep>(*renderer);
 		for (std::size_t i = 0; i < itBindables->size(); ++i) {
 			const auto& jBindable = (*itBindables)[i];
 			Context::BindableRef bindable;
@@ -1429,7 +1432,7 @@ namespace se::app {
 			return Result(false, "Missing \"steps\" property");
 		}
 
-		auto shaderSPtr = std::make_shared<RenderableShader>(scene.application.getEventManager());
+		auto shaderSPtr = Repository::makeShared<RenderableShader>(scene.application.getEventManager());
 		for (std::size_t i = 0; i < itSteps->size(); ++i) {
 			std::string stepName = (*itSteps)[i].get<std::string>();
 			auto step = scene.repository.findByName<RenderableShaderStep>(stepName.c_str());
@@ -1480,7 +1483,7 @@ namespace se::app {
 				return Result(false, "Gravity missing \"value\" property");
 			}
 
-			forceSPtr = std::make_shared<Gravity>(itValue->get<float>());
+			forceSPtr = Repository::makeShared<Gravity>(itValue->get<float>());
 		}
 		else if (type == "DirectionalForce") {
 			auto itValue = json.find("value");
@@ -1493,7 +1496,7 @@ namespace se::app {
 				return Result(false, "Wrong \"value\" property");
 			}
 
-			forceSPtr = std::make_shared<DirectionalForce>(value);
+			forceSPtr = Repository::makeShared<DirectionalForce>(value);
 		}
 		else if (type == "PunctualForce") {
 			auto itValue = json.find("value");
@@ -1516,7 +1519,7 @@ namespace se::app {
 				return Result(false, "Wrong \"point\" property");
 			}
 
-			forceSPtr = std::make_shared<PunctualForce>(value, point);
+			forceSPtr = Repository::makeShared<PunctualForce>(value, point);
 		}
 		else {
 			return Result(false, "Wrong \"type\" value = " + type);
@@ -1547,7 +1550,7 @@ namespace se::app {
 	template <>
 	Result deserializeResource<ParticleEmitter>(const nlohmann::json& json, Repository::ResourceRef<ParticleEmitter>& emitter, DeserializeData&, Scene& scene)
 	{
-		auto emitterSPtr = std::make_shared<ParticleEmitter>();
+		auto emitterSPtr = Repository::makeShared<ParticleEmitter>();
 
 		auto itMaxParticles = json.find("maxParticles");
 		if (itMaxParticles != json.end()) {
@@ -2115,26 +2118,37 @@ namespace se::app {
 			json["prismHeight"] = terrain->getPrismHeight();
 			json["heights"] = data.buffersJson.size() - 1;
 		}
-		else if (auto triangleMesh = dynamic_cast<const TriangleMeshCollider*>(&collider)) {
-			nlohmann::json vertexBufferJson;
-			serializeBuffer(
-				reinterpret_cast<const std::byte*>( glm::value_ptr(triangleMesh->getVertices()[0]) ),
-				3 * triangleMesh->getNumVertices() * sizeof(float),
-				vertexBufferJson, dataStream
-			);
-			data.buffersJson.emplace_back(std::move(vertexBufferJson));
-
-			nlohmann::json indexBufferJson;
-			serializeBuffer(
-				reinterpret_cast<const std::byte*>(triangleMesh->getIndices()),
-				triangleMesh->getNumIndices() * sizeof(unsigned short),
-				indexBufferJson, dataStream
-			);
-			data.buffersJson.emplace_back(std::move(indexBufferJson));
+		else if (auto triangleMeshCollider = dynamic_cast<const TriangleMeshCollider*>(&collider)) {
+			// The TriangleMeshes shared by multiple Colliders are stored only
+			// once
+			const TriangleMesh* triangleMesh = triangleMeshCollider->getMesh().get();
+			auto itBuffers = data.triangleMeshBuffersMap.find(triangleMesh);
+			if (itBuffers == data.triangleMeshBuffersMap.end()) {
+				nlohmann::json vertexBufferJson;
+				serializeBuffer(
+					reinterpret_cast<const std::byte*>( glm::value_ptr(triangleMesh->getVertices()[0]) ),
+					3 * triangleMesh->getNumVertices() * sizeof(float),
+					vertexBufferJson, dataStream
+				);
+				data.buffersJson.emplace_back(std::move(vertexBufferJson));
+
+				nlohmann::json indexBufferJson;
+				serializeBuffer(
+					reinterpret_cast<const std::byte*>(triangleMesh->getIndices()),
+					triangleMesh->getNumIndices() * sizeof(std::uint32_t),
+					indexBufferJson, dataStream
+				);
+				data.buffersJson.emplace_back(std::move(indexBufferJson));
+
+				itBuffers = data.triangleMeshBuffersMap.emplace(
+					triangleMesh, std::make_pair(data.buffersJson.size() - 2, data.buffersJson.size() - 1)
+				).first;
+			}
 
 			json["type"] = "TriangleMeshCollider";
-			json["vertices"] = data.buffersJson.size() - 2;
-			json["indices"] = data.buffersJson.size() - 1;
+			json["vertices"] = itBuffers->second.first;
+			json["indices"] = itBuffers->second.second;
+			json["indexSize"] = sizeof(std::uint32_t);
 		}
 		else if (auto composite = dynamic_cast<const CompositeCollider*>(&collider)) {
 			auto colliderPartsJson = nlohmann::json::array();
@@ -2344,9 +2358,6 @@ namespace se::app {
 				return { Result(false, "Vertices buffer " + std::to_string(vertices) + " out of bounds"), std::nullopt };
 			}
 
-			MemBuffer vertexBuffer;
-			deserializeBuffer(data.buffersJson[vertices], data.dataStream, vertexBuffer);
-
 			auto itIndices = json.find("indices");
 			if (itIndices == json.end()) {
 				return { Result(false, "Missing TriangleMeshCollider \"indices\" property"), std::nullopt };
@@ -2357,14 +2368,38 @@ namespace se::app {
 				return { Result(false, "Indices buffer " + std::to_string(indices) + " out of bounds"), std::nullopt };
 			}
 
-			MemBuffer indexBuffer;
-			deserializeBuffer(data.buffersJson[indices], data.dataStream, indexBuffer);
+			// The indices were stored with 16 bits in the older versions
+			auto itIndexSize = json.find("indexSize");
+			std::size_t indexSize = (itIndexSize != json.end())? itIndexSize->get<std::size_t>() : sizeof(std::uint16_t);
+			if ((indexSize != sizeof(std::uint16_t)) && (indexSize != sizeof(std::uint32_t))) {
+				return { Result(false, "Invalid TriangleMeshCollider index size " + std::to_string(indexSize)), std::nullopt };
+			}
 
-			auto triangleMesh = std::make_unique<TriangleMeshCollider>(
-				reinterpret_cast<glm::vec3*>(vertexBuffer.data()), vertexBuffer.size() / sizeof(glm::vec3),
-				reinterpret_cast<unsigned short*>(indexBuffer.data()), indexBuffer.size() / sizeof(unsigned short)
-			);
-			collider = std::move(triangleMesh);
+			auto itMesh = data.indexTriangleMeshMap.find(vertices);
+			if (itMesh == data.indexTriangleMeshMap.end()) {
+				MemBuffer vertexBuffer;
+				deserializeBuffer(data.buffersJson[vertices], data.dataStream, vertexBuffer);
+
+				MemBuffer indexBuffer;
+				deserializeBuffer(data.buffersJson[indices], data.dataStream, indexBuffer);
+
+				std::shared_ptr<const TriangleMesh> triangleMesh;
+				if (indexSize == sizeof(std::uint16_t)) {
+					triangleMesh = std::make_shared<TriangleMesh>(
+						reinterpret_cast<glm::vec3*>(vertexBuffer.data()), vertexBuffer.size() / sizeof(glm::vec3),
+						reinterpret_cast<std::uint16_t*>(indexBuffer.data()), indexBuffer.size() / sizeof(std::uint16_t)
+					);
+				}
+				else {
+					triangleMesh = std::make_shared<TriangleMesh>(
+						reinterpret_cast<glm::vec3*>(vertexBuffer.data()), vertexBuffer.size() / sizeof(glm::vec3),
+						reinterpret_cast<std::uint32_t*>(indexBuffer.data()), indexBuffer.size() / sizeof(std::uint32_t)
+					);
+				}
+				itMesh = data.indexTriangleMeshMap.emplace(vertices, std::move(triangleMesh)).first;
+			}
+
+			collider = std::make_unique<TriangleMeshCollider>(itMesh->second);
 		}
 		else if (*itType == "CompositeCollider") {
 			auto itParts = json.find("parts");
@@ -2768,7 +2803,7 @@ namespace se::app {
 	) {
 		auto& nodeData = node.getData();
 
-		json["name"] = nodeData.name.data();
+		json["name"] = nodeData.name.c_str();
 
 		nlohmann::json nodeLocalJson;
 		nodeLocalJson["position"] = toJson(nodeData.localTransforms.position);
@@ -2791,8 +2826,7 @@ namespace se::app {
 
 		auto itName = json.find("name");
 		if (itName != json.end()) {
-			std::string name = *itName;
-			std::copy(name.begin(), name.end(), nodeData.name.begin());
+			nodeData.name = utils::NameId(itName->get<std::string>());
 		}
 		else {
 			return Result(false, "Missing name");
@@ -2852,10 +2886,13 @@ namespace se::app {
 	}
 
 	template <typename T>
-	Result deserializeRVector(const std::string& tag, DeserializeData& data, Scene& scene)
+	Result deserializeRVector(const std::string& tag, DeserializeData& data, Scene& scene, bool canLoad = true)
 	{
 		auto it = data.json.find(tag);
-		if (it != data.json.end()) {
+		if ((it != data.json.end()) && !canLoad) {
+			SOMBRA_WARN_LOG << "Skipping " << it->size() << " " << tag << ", the Application doesn't have the needed ExternalTools";
+		}
+		else if (it != data.json.end()) {
 			for (std::size_t i = 0; i < it->size(); ++i) {
 				auto& resourceJson = (*it)[i];
 				Repository::ResourceRef<T> r;
@@ -2912,10 +2949,13 @@ namespace se::app {
 	}
 
 	template <typename T>
-	Result deserializeCVector(const std::string& tag, DeserializeData& data, Scene& scene)
+	Result deserializeCVector(const std::string& tag, DeserializeData& data, Scene& scene, bool canLoad = true)
 	{
 		auto it = data.json.find(tag);
-		if (it != data.json.end()) {
+		if ((it != data.json.end()) && !canLoad) {
+			SOMBRA_WARN_LOG << "Skipping " << it->size() << " " << tag << ", the Application doesn't have the needed ExternalTools";
+		}
+		else if (it != data.json.end()) {
 			for (std::size_t i = 0; i < it->size(); ++i) {
 				auto& componentJson = (*it)[i];
 
@@ -3093,17 +3133,20 @@ namespace se::app {
 
 	Result deserializeRepository(DeserializeData& data, Scene& scene)
 	{
-		if (auto result = deserializeRVector<MeshRef>("meshes", data, scene); !result) { return result; }
+		bool hasGraphics = (scene.application.getExternalTools().graphicsEngine != nullptr);
+		bool hasAudio = (scene.application.getExternalTools().audioEngine != nullptr);
+
+		if (auto result = deserializeRVector<MeshRef>("meshes", data, scene, hasGraphics); !result) { return result; }
 		if (auto result = deserializeRVector<Skin>("skins", data, scene); !result) { return result; }
 		if (auto result = deserializeRVector<SkeletonAnimator>("skeletonAnimators", data, scene); !result) { return result; }
 		if (auto result = deserializeRVector<LightSource>("lightSources", data, scene); !result) { return result; }
-		if (auto result = deserializeRVector<TextureRef>("textures", data, scene); !result) { return result; }
-		if (auto result = deserializeRVector<ProgramRef>("programs", data, scene); !result) { return result; }
-		if (auto result = deserializeRVector<RenderableShaderStep>("steps", data, scene); !result) { return result; }
-		if (auto result = deserializeRVector<RenderableShader>("shaders", data, scene); !result) { return result; }
+		if (auto result = deserializeRVector<TextureRef>("textures", data, scene, hasGraphics); !result) { return result; }
+		if (auto result = deserializeRVector<ProgramRef>("programs", data, scene, hasGraphics); !result) { return result; }
+		if (auto result = deserializeRVector<RenderableShaderStep>("steps", data, scene, hasGraphics); !result) { return result; }
+		if (auto result = deserializeRVector<RenderableShader>("shaders", data, scene, hasGraphics); !result) { return result; }
 		if (auto result = deserializeRVector<Force>("forces", data, scene); !result) { return result; }
 		if (auto result = deserializeRVector<ParticleEmitter>("particleEmitter", data, scene); !result) { return result; }
-		if (auto result = deserializeRVector<DataSource>("dataSources", data, scene); !result) { return result; }
+		if (auto result = deserializeRVector<DataSource>("dataSources", data, scene, hasAudio); !result) { return result; }
 		return Result();
 	}
 
@@ -3225,18 +3268,21 @@ namespace se::app {
 
 	Result deserializeComponents(DeserializeData& data, Scene& scene)
 	{
+		bool hasGraphics = (scene.application.getExternalTools().graphicsEngine != nullptr);
+		bool hasAudio = (scene.application.getExternalTools().audioEngine != nullptr);
+
 		if (auto result = deserializeCVector<TagComponent>("tags", data, scene); !result) { return result; }
 		if (auto result = deserializeCVector<TransformsComponent>("transforms", data, scene); !result) { return result; }
 		if (auto result = deserializeCVector<CameraComponent>("cameras", data, scene); !result) { return result; }
-		if (auto result = deserializeCVector<MeshComponent>("meshComponents", data, scene); !result) { return result; }
-		if (auto result = deserializeCVector<TerrainComponent>("terrainComponents", data, scene); !result) { return result; }
+		if (auto result = deserializeCVector<MeshComponent>("meshComponents", data, scene, hasGraphics); !result) { return result; }
+		if (auto result = deserializeCVector<TerrainComponent>("terrainComponents", data, scene, hasGraphics); !result) { return result; }
 		if (auto result = deserializeCVector<LightComponent>("lights", data, scene); !result) { return result; }
-		if (auto result = deserializeCVector<LightProbeComponent>("lightProbes", data, scene); !result) { return result; }
+		if (auto result = deserializeCVector<LightProbeComponent>("lightProbes", data, scene, hasGraphics); !result) { return result; }
 		if (auto result = deserializeCVector<RigidBodyComponent>("rigidBodies", data, scene); !result) { return result; }
 		if (auto result = deserializeCVector<SkinComponent>("skinComponents", data, scene); !result) { return result; }
 		if (auto result = deserializeCVector<AnimationComponent>("animationComponents", data, scene); !result) { return result; }
-		if (auto result = deserializeCVector<ParticleSystemComponent>("particleSystemComponents", data, scene); !result) { return result; }
-		if (auto result = deserializeCVector<SoundComponent>("SoundComponents", data, scene); !result) { return result; }
+		if (auto result = deserializeCVector<ParticleSystemComponent>("particleSystemComponents", data, scene, hasGraphics); !result) { return result; }
+		if (auto result = deserializeCVector<SoundComponent>("SoundComponents", data, scene, hasAudio); !result) { return result; }
 		if (auto result = deserializeCVector<ScriptComponent>("scriptComponents", data, scene); !result) { return result; }
 		return Result();
 	}
@@ -3251,7 +3297,7 @@ namespace se::app {
 		}
 
 		nlohmann::json outputJson;
-		SerializeData data = { scene, {}, {}, {}, {}, nlohmann::json::array(), nlohmann::json::array() };
+		SerializeData data = { scene, {}, {}, {}, {}, nlohmann::json::array(), nlohmann::json::array(), {} };
 		serializeLinkedFiles(data, outputJson);
 		serializeRepository(data, outputJson, outputDATAStream);
 		serializeNodes(data, outputJson);
@@ -3297,7 +3343,7 @@ namespace se::app {
 
 		auto& buffers = *itBuffers;
 		auto& accessors = *itAccessors;
-		DeserializeData data = { std::move(json), std::move(dataStream), {}, {}, {}, buffers, accessors };
+		DeserializeData data = { std::move(json), std::move(dataStream), {}, {}, {}, buffers, accessors, {} };
 		if (auto result = deserializeLinkedFiles(data, output); !result) {
 			return Result(false, "Failed to deserialized the linked files: " + std::string(result.description()));
 		}
@@ -1,10 +1,11 @@
 #include "se/graphics/core/IndexBuffer.h"
+#include "se/utils/MemoryTracker.h"
 #include "GLWrapper.h"
 
 namespace se::graphics {
 
 	IndexBuffer::IndexBuffer() :
-		mIndexType(TypeId::Byte), mIndexCount(0)
+		mIndexType(TypeId::Byte), mIndexCount(0), mSize(0)
 	{
 		GL_WRAP( glGenBuffers(1, &mBufferId) );
 		SOMBRA_TRACE_LOG << "Created IBO " << mBufferId;
@@ -12,9 +13,10 @@ namespace se::graphics {
 
 
 	IndexBuffer::IndexBuffer(IndexBuffer&& other) :
-		mBufferId(other.mBufferId), mIndexType(other.mIndexType), mIndexCount(other.mIndexCount)
+		mBufferId(other.mBufferId), mIndexType(other.mIndexType), mIndexCount(other.mIndexCount), mSize(other.mSize)
 	{
 		other.mBufferId = 0;
+		other.mSize = 0;
 	}
 
 
@@ -23,6 +25,9 @@ namespace se::graphics {
 		if (mBufferId != 0) {
 			GL_WRAP( glDeleteBuffers(1, &mBufferId) );
 			SOMBRA_TRACE_LOG << "Deleted IBO " << mBufferId;
+			if (mSize > 0) {
+				utils::MemoryTracker::getInstance().onDeallocate(utils::MemoryTag::Mesh, mSize);
+			}
 		}
 	}
 
@@ -32,13 +37,18 @@ namespace se::graphics {
 		if (mBufferId != 0) {
 			GL_WRAP( glDeleteBuffers(1, &mBufferId) );
 			SOMBRA_TRACE_LOG << "Deleted IBO " << mBufferId;
+			if (mSize > 0) {
+				utils::MemoryTracker::getInstance().onDeallocate(utils::MemoryTag::Mesh, mSize);
+			}
 		}
 
 		mBufferId = other.mBufferId;
 		mIndexType = other.mIndexType;
 		mIndexCount = other.mIndexCount;
+		mSize = other.mSize;
 
 		other.mBufferId = 0;
+		other.mSize = 0;
 
 		return *this;
 	}
@@ -60,6 +70,15 @@ namespace se::graphics {
 
 		bind();
 		GL_WRAP( glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, GL_STATIC_DRAW) );
+
+		auto& memoryTracker = utils::MemoryTracker::getInstance();
+		if (mSize > 0) {
+			memoryTracker.onDeallocate(utils::MemoryTag::Mesh, mSize);
+		}
+		if (size > 0) {
+			memoryTracker.onAllocate(utils::MemoryTag::Mesh, size);
+		}
+		mSize = size;
 	}
 
 
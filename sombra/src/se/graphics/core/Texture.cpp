@@ -1,4 +1,6 @@
+#include <algorithm>
 #include "se/graphics/core/Texture.h"
+#include "se/utils/MemoryTracker.h"
 #include "GLWrapper.h"
 
 namespace se::graphics {
@@ -7,7 +9,7 @@ namespace se::graphics {
 	static const Texture* sTextureUnits[kMaxTextures] = {};
 
 
-	Texture::Texture(TextureTarget target) : mTarget(target), mTextureUnit(-1), mImageUnit(-1), mHasMipMaps(false)
+	Texture::Texture(TextureTarget target) : mTarget(target), mTextureUnit(-1), mImageUnit(-1), mHasMipMaps(false), mImageSize(0)
 	{
 		GL_WRAP( glGenTextures(1, &mTextureId) );
 		SOMBRA_TRACE_LOG << "Created Texture " << mTextureId;
@@ -19,9 +21,11 @@ namespace se::graphics {
 	Texture::Texture(Texture&& other) :
 		mTarget(other.mTarget), mTextureId(other.mTextureId),
 		mTextureUnit(other.mTextureUnit), mImageUnit(other.mImageUnit),
-		mColorFormat(other.mColorFormat), mHasMipMaps(other.mHasMipMaps)
+		mColorFormat(other.mColorFormat), mHasMipMaps(other.mHasMipMaps),
+		mImageSize(other.mImageSize)
 	{
 		other.mTextureId = 0;
+		other.mImageSize = 0;
 	}
 
 
@@ -31,6 +35,7 @@ namespace se::graphics {
 		if (mTextureId != 0) {
 			GL_WRAP( glDeleteTextures(1, &mTextureId) );
 			SOMBRA_TRACE_LOG << "Deleted Texture " << mTextureId;
+			updateMemory(0, false);
 		}
 	}
 
@@ -41,6 +46,7 @@ namespace se::graphics {
 		if (mTextureId != 0) {
 			GL_WRAP( glDeleteTextures(1, &mTextureId) );
 			SOMBRA_TRACE_LOG << "Deleted Texture " << mTextureId;
+			updateMemory(0, false);
 		}
 
 		mTarget = other.mTarget;
@@ -49,7 +55,9 @@ namespace se::graphics {
 		mImageUnit = other.mImageUnit;
 		mColorFormat = other.mColorFormat;
 		mHasMipMaps = other.mHasMipMaps;
+		mImageSize = other.mImageSize;
 		other.mTextureId = 0;
+		other.mImageSize = 0;
 
 		return *this;
 	}
@@ -292,8 +300,6 @@ namespace se::graphics {
 		ColorFormat textureFormat,
 		std::size_t width, std::size_t height, std::size_t depth, int orientation
 	) {
-		mHasMipMaps = false;
-
 		GLenum glTarget = toGLTextureTarget(mTarget);
 		GLenum glType = toGLType(sourceType);
 		GLenum glFormat = toGLColorFormat(sourceFormat);
@@ -355,6 +361,13 @@ namespace se::graphics {
 			GL_WRAP( glPixelStorei(GL_UNPACK_ALIGNMENT, 4) );
 		}
 
+		std::size_t imageSize = width * std::max(height, std::size_t(1)) * std::max(depth, std::size_t(1))
+			* toTexelSize(textureFormat, sourceType);
+		if (mTarget == TextureTarget::CubeMap) {
+			imageSize *= 6;
+		}
+		updateMemory(imageSize, false);
+
 		return *this;
 	}
 
@@ -363,7 +376,7 @@ namespace se::graphics {
 	{
 		GL_WRAP( glBindTexture(toGLTextureTarget(mTarget), mTextureId) );
 		GL_WRAP( glGenerateMipmap(toGLTextureTarget(mTarget)) );
-		mHasMipMaps = true;
+		updateMemory(mImageSize, true);
 
 		return *this;
 	}
@@ -437,4 +450,24 @@ namespace se::graphics {
 		}
 	}
 
+
+	void Texture::updateMemory(std::size_t imageSize, bool hasMipMaps)
+	{
+		// The rest of the mipmap levels add up to a third of the first one
+		std::size_t oldSize = mHasMipMaps? mImageSize + mImageSize / 3 : mImageSize;
+		std::size_t newSize = hasMipMaps? imageSize + imageSize / 3 : imageSize;
+		mImageSize = imageSize;
+		mHasMipMaps = hasMipMaps;
+
+		if (oldSize != newSize) {
+			auto& memoryTracker = utils::MemoryTracker::getInstance();
+			if (oldSize > 0) {
+				memoryTracker.onDeallocate(utils::MemoryTag::Texture, oldSize);
+			}
+			if (newSize > 0) {
+				memoryTracker.onAllocate(utils::MemoryTag::Texture, newSize);
+			}
+		}
+	}
+
 }
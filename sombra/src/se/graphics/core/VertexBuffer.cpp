@@ -1,18 +1,20 @@
 #include "se/graphics/core/VertexBuffer.h"
+#include "se/utils/MemoryTracker.h"
 #include "se/graphics/core/GLWrapper.h"
 
 namespace se::graphics {
 
-	VertexBuffer::VertexBuffer()
+	VertexBuffer::VertexBuffer() : mSize(0)
 	{
 		GL_WRAP( glGenBuffers(1, &mBufferId) );
 		SOMBRA_TRACE_LOG << "Created VBO " << mBufferId;
 	}
 
 
-	VertexBuffer::VertexBuffer(VertexBuffer&& other) : mBufferId(other.mBufferId)
+	VertexBuffer::VertexBuffer(VertexBuffer&& other) : mBufferId(other.mBufferId), mSize(other.mSize)
 	{
 		other.mBufferId = 0;
+		other.mSize = 0;
 	}
 
 
@@ -21,6 +23,9 @@ namespace se::graphics {
 		if (mBufferId != 0) {
 			GL_WRAP( glDeleteBuffers(1, &mBufferId) );
 			SOMBRA_TRACE_LOG << "Deleted VBO " << mBufferId;
+			if (mSize > 0) {
+				utils::MemoryTracker::getInstance().onDeallocate(utils::MemoryTag::Mesh, mSize);
+			}
 		}
 	}
 
@@ -30,10 +35,15 @@ namespace se::graphics {
 		if (mBufferId != 0) {
 			GL_WRAP( glDeleteBuffers(1, &mBufferId) );
 			SOMBRA_TRACE_LOG << "Deleted VBO " << mBufferId;
+			if (mSize > 0) {
+				utils::MemoryTracker::getInstance().onDeallocate(utils::MemoryTag::Mesh, mSize);
+			}
 		}
 
 		mBufferId = other.mBufferId;
+		mSize = other.mSize;
 		other.mBufferId = 0;
+		other.mSize = 0;
 
 		return *this;
 	}
@@ -52,6 +62,15 @@ namespace se::graphics {
 	{
 		bind();
 		GL_WRAP( glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW) );
+
+		auto& memoryTracker = utils::MemoryTracker::getInstance();
+		if (mSize > 0) {
+			memoryTracker.onDeallocate(utils::MemoryTag::Mesh, mSize);
+		}
+		if (size > 0) {
+			memoryTracker.onAllocate(utils::MemoryTag::Mesh, size);
+		}
+		mSize = size;
 	}
 
 
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <glm/gtx/string_cast.hpp>
 #include "se/utils/Log.h"
 #include "se/physics/RigidBodyWorld.h"
@@ -7,30 +8,38 @@ namespace se::physics {
 
 	CollisionSolver::CollisionSolver(RigidBodyWorld& parentWorld) : mParentWorld(parentWorld)
 	{
-		mManifoldConstraintIndicesMap.reserve(4 * mParentWorld.getProperties().maxCollidingRBs / Manifold::kMaxContacts);
-		mContactNormalConstraints.reserve(4 * mParentWorld.getProperties().maxCollidingRBs);
-		mContactFrictionConstraints.reserve(8 * mParentWorld.getProperties().maxCollidingRBs);
+		std::size_t numManifolds = mParentWorld.getProperties().maxCollidingRBs;
+		mManifoldColliders.resize(numManifolds, ColliderPair{ nullptr, nullptr });
+		mContactSlots.resize(numManifolds * Manifold::kMaxContacts);
+		mContactNormalConstraints.resize(numManifolds * Manifold::kMaxContacts);
+		mContactFrictionConstraints.resize(numManifolds * Manifold::kMaxContacts);
+		mDirtyContactSlots.reserve(numManifolds * Manifold::kMaxContacts);
 	}
 
 
 	CollisionSolver::~CollisionSolver()
 	{
-		for (auto& normalConstraint : mContactNormalConstraints) {
-			mParentWorld.getConstraintManager().removeConstraint(&normalConstraint);
-		}
-		for (auto& frictionConstraint : mContactFrictionConstraints) {
-			mParentWorld.getConstraintManager().removeConstraint(&frictionConstraint);
+		for (std::size_t i = 0; i < mContactSlots.size(); ++i) {
+			setContactActive(i, false);
 		}
+		flushContactChanges();
 	}
 
 
-	void CollisionSolver::onCollision(const Manifold& manifold)
+	void CollisionSolver::onCollision(const Manifold& manifold, std::size_t manifoldIndex)
 	{
 		RigidBody* rb1 = manifold.colliders[0]->getParent();
 		RigidBody* rb2 = manifold.colliders[1]->getParent();
 
 		if (rb1 && rb2) {
-			if ((rb1->getProperties().type == RigidBodyProperties::Type::Dynamic)
+			if (rb1->getStatus(RigidBody::Status::Sleeping) && rb2->getStatus(RigidBody::Status::Sleeping)
+				&& manifold.state[Manifold::State::Intersecting]
+			) {
+				// The Contact Constraints are kept as they are until any of
+				// the RigidBodies wakes up
+				SOMBRA_TRACE_LOG << "Skipping CollisionEvent between sleeping RigidBodies " << rb1 << " and " << rb2;
+			}
+			else if ((rb1->getProperties().type == RigidBodyProperties::Type::Dynamic)
 				|| (rb2->getProperties().type == RigidBodyProperties::Type::Dynamic)
 			) {
 				SOMBRA_DEBUG_LOG << "Handling CollisionEvent between "
@@ -38,10 +47,10 @@ namespace se::physics {
 					<< rb2 << " (p=" << glm::to_string(rb2->getState().position) << ", o=" << glm::to_string(rb2->getState().orientation) << ")";
 
 				if (manifold.state[Manifold::State::Intersecting]) {
-					handleIntersectingManifold(manifold);
+					handleIntersectingManifold(manifold, manifoldIndex);
 				}
 				else {
-					handleDisjointManifold(manifold);
+					handleDisjointManifold(manifoldIndex);
 				}
 			}
 			else {
@@ -54,115 +63,164 @@ namespace se::physics {
 	void CollisionSolver::removeRigidBody(const RigidBody* rigidBody)
 	{
 		std::scoped_lock lock(mMutex);
-		for (auto itPair = mManifoldConstraintIndicesMap.begin(); itPair != mManifoldConstraintIndicesMap.end();) {
-			if ((rigidBody == itPair->first->colliders[0]->getParent())
-				|| (rigidBody == itPair->first->colliders[1]->getParent())
-			) {
-				for (auto& constraintIndices : itPair->second) {
-					mParentWorld.getConstraintManager().removeConstraint(&mContactNormalConstraints[constraintIndices.iNormalConstraint]);
-					mParentWorld.getConstraintManager().removeConstraint(&mContactFrictionConstraints[constraintIndices.iFrictionConstraints[0]]);
-					mParentWorld.getConstraintManager().removeConstraint(&mContactFrictionConstraints[constraintIndices.iFrictionConstraints[1]]);
-
-					mContactNormalConstraints.erase(mContactNormalConstraints.begin().setIndex(constraintIndices.iNormalConstraint));
-					mContactFrictionConstraints.erase(mContactFrictionConstraints.begin().setIndex(constraintIndices.iFrictionConstraints[0]));
-					mContactFrictionConstraints.erase(mContactFrictionConstraints.begin().setIndex(constraintIndices.iFrictionConstraints[1]));
-				}
 
-				itPair = mManifoldConstraintIndicesMap.erase(itPair);
+		for (std::size_t i = 0; i < mContactSlots.size(); ++i) {
+			if (mContactSlots[i].active
+				&& ((rigidBody == mContactNormalConstraints[i].getRigidBody(0))
+					|| (rigidBody == mContactNormalConstraints[i].getRigidBody(1)))
+			) {
+				setContactActive(i, false);
 			}
-			else {
-				++itPair;
+		}
+
+		// The Constraints must be removed before the RigidBody is destroyed
+		flushContactChanges();
+	}
+
+
+	void CollisionSolver::removeCollider(const Collider* collider)
+	{
+		std::scoped_lock lock(mMutex);
+
+		// The CollisionDetector doesn't notify the Manifolds removed with
+		// the Collider
+		for (std::size_t i = 0; i < mManifoldColliders.size(); ++i) {
+			if ((mManifoldColliders[i][0] == collider) || (mManifoldColliders[i][1] == collider)) {
+				for (std::size_t k = 0; k < Manifold::kMaxContacts; ++k) {
+					if (mContactSlots[i * Manifold::kMaxContacts + k].active) {
+						setContactActive(i * Manifold::kMaxContacts + k, false);
+					}
+				}
+				mManifoldColliders[i] = ColliderPair{ nullptr, nullptr };
 			}
 		}
+
+		// The Constraints must be removed before the slots are reused by
+		// other RigidBodies
+		flushContactChanges();
 	}
 
 
 	void CollisionSolver::update(float deltaTime)
 	{
 		std::scoped_lock lock(mMutex);
-		for (auto& normalConstraint : mContactNormalConstraints) {
-			normalConstraint.setDeltaTime(deltaTime);
+
+		flushContactChanges();
+
+		// The lambda values of the last substep are scaled down before using
+		// them as the initial ones, because they also hold the penetration
+		// corrections
+		float warmStartingFactor = mParentWorld.getProperties().warmStartingFactor;
+		for (std::size_t i = 0; i < mContactSlots.size(); ++i) {
+			if (mContactSlots[i].active) {
+				mContactNormalConstraints[i].setDeltaTime(deltaTime);
+				mContactNormalConstraints[i].setLambda(warmStartingFactor * mContactNormalConstraints[i].getLambda());
+				for (FrictionConstraint& frictionConstraint : mContactFrictionConstraints[i]) {
+					frictionConstraint.setLambda(warmStartingFactor * frictionConstraint.getLambda());
+				}
+			}
 		}
 	}
 
 // Private functions
-	void CollisionSolver::handleIntersectingManifold(const Manifold& manifold)
+	void CollisionSolver::handleIntersectingManifold(const Manifold& manifold, std::size_t manifoldIndex)
 	{
 		std::scoped_lock lock(mMutex);
 
+		if (manifoldIndex >= mManifoldColliders.size()) {
+			SOMBRA_WARN_LOG << "Maximum number of Contacts reached";
+			return;
+		}
+
 		RigidBody* rb1 = manifold.colliders[0]->getParent();
 		RigidBody* rb2 = manifold.colliders[1]->getParent();
-		auto& manifoldConstraintIndices = mManifoldConstraintIndicesMap[&manifold];
+		std::size_t iFirstSlot = manifoldIndex * Manifold::kMaxContacts;
+		ContactSlot* contactSlots = &mContactSlots[iFirstSlot];
 		bool updateFrictionMasses = false;
 
-		int contactsDiff = static_cast<int>(manifold.contacts.size()) - static_cast<int>(manifoldConstraintIndices.size());
-		if (contactsDiff > 0) {
-			if (mContactNormalConstraints.size() + contactsDiff <= 4 * mParentWorld.getProperties().maxCollidingRBs) {
-				float mu1 = rb1->getProperties().frictionCoefficient, mu2 = rb2->getProperties().frictionCoefficient;
-				float mu = std::sqrt(0.5f * (mu1 * mu1 + mu2 * mu2));
-				SOMBRA_DEBUG_LOG << "Using frictionCoefficient=" << mu;
-
-				// Increase the number of constraints up to the number of contacts
-				for (std::size_t i = manifoldConstraintIndices.size(); i < manifold.contacts.size(); ++i) {
-					auto itNormalConstraint = mContactNormalConstraints.emplace(
-						std::array{ rb1, rb2 },
-						mParentWorld.getProperties().collisionBeta,
-						mParentWorld.getProperties().collisionRestitutionFactor,
-						mParentWorld.getProperties().collisionSlopPenetration,
-						mParentWorld.getProperties().collisionSlopRestitution
-					);
-					auto itFrictionConstraint0 = mContactFrictionConstraints.emplace(
-						std::array{ rb1, rb2 }, mParentWorld.getProperties().frictionGravityAcceleration, mu
-					);
-					auto itFrictionConstraint1 = mContactFrictionConstraints.emplace(
-						std::array{ rb1, rb2 }, mParentWorld.getProperties().frictionGravityAcceleration, mu
-					);
-
-					mParentWorld.getConstraintManager().addConstraint(&(*itNormalConstraint));
-					mParentWorld.getConstraintManager().addConstraint(&(*itFrictionConstraint0));
-					mParentWorld.getConstraintManager().addConstraint(&(*itFrictionConstraint1));
-
-					manifoldConstraintIndices.emplace_back(ContactConstraintIndices{
-						itNormalConstraint.getIndex(), { itFrictionConstraint0.getIndex(), itFrictionConstraint1.getIndex() }
-					});
-
-					SOMBRA_DEBUG_LOG << "Added contact Constraints [" << i << "]";
+		if (mManifoldColliders[manifoldIndex] != manifold.colliders) {
+			// The index was used by a Manifold of other Colliders that was
+			// removed without being notified. Its Constraints are removed
+			// right now, because the RigidBodies of the reused ones change
+			for (std::size_t k = 0; k < Manifold::kMaxContacts; ++k) {
+				if (contactSlots[k].active) {
+					setContactActive(iFirstSlot + k, false);
 				}
+			}
+			flushContactChanges();
+			mManifoldColliders[manifoldIndex] = manifold.colliders;
+		}
 
-				updateFrictionMasses = true;
+		// Match the Constraints with the Contacts by their identifiers, so
+		// the Constraints of the Contacts that persist keep their lambda
+		// values
+		std::array<std::size_t, Manifold::kMaxContacts> contactSlotIndices;
+		std::array<bool, Manifold::kMaxContacts> matchedSlots = {};
+		for (std::size_t i = 0; i < manifold.contacts.size(); ++i) {
+			contactSlotIndices[i] = Manifold::kMaxContacts;
+			for (std::size_t k = 0; k < Manifold::kMaxContacts; ++k) {
+				if (contactSlots[k].active && (contactSlots[k].contactId == manifold.contacts[i].id)) {
+					contactSlotIndices[i] = k;
+					matchedSlots[k] = true;
+					break;
+				}
 			}
-			else {
-				SOMBRA_WARN_LOG << "Maximum number of Contacts reached";
+		}
+
+		// Remove the Constraints of the Contacts that no longer exist
+		for (std::size_t k = 0; k < Manifold::kMaxContacts; ++k) {
+			if (contactSlots[k].active && !matchedSlots[k]) {
+				setContactActive(iFirstSlot + k, false);
+				updateFrictionMasses = true;
+
+				SOMBRA_DEBUG_LOG << "Removed contact Constraints of the Contact " << contactSlots[k].contactId;
 			}
 		}
-		else if (contactsDiff < 0) {
-			// Decrease the number of constraints down to the number of contacts
-			for (std::size_t i = manifoldConstraintIndices.size(); i > manifold.contacts.size(); --i) {
-				ContactConstraintIndices& constraintIndices = manifoldConstraintIndices.back();
-				mParentWorld.getConstraintManager().removeConstraint(&mContactNormalConstraints[constraintIndices.iNormalConstraint]);
-				mParentWorld.getConstraintManager().removeConstraint(&mContactFrictionConstraints[constraintIndices.iFrictionConstraints[0]]);
-				mParentWorld.getConstraintManager().removeConstraint(&mContactFrictionConstraints[constraintIndices.iFrictionConstraints[1]]);
 
-				mContactNormalConstraints.erase(mContactNormalConstraints.begin().setIndex(constraintIndices.iNormalConstraint));
-				mContactFrictionConstraints.erase(mContactFrictionConstraints.begin().setIndex(constraintIndices.iFrictionConstraints[0]));
-				mContactFrictionConstraints.erase(mContactFrictionConstraints.begin().setIndex(constraintIndices.iFrictionConstraints[1]));
+		// The Contacts that aren't matched reuse the free Constraints
+		float mu1 = rb1->getProperties().frictionCoefficient, mu2 = rb2->getProperties().frictionCoefficient;
+		float mu = std::sqrt(0.5f * (mu1 * mu1 + mu2 * mu2));
+
+		for (std::size_t i = 0; i < manifold.contacts.size(); ++i) {
+			if (contactSlotIndices[i] < Manifold::kMaxContacts) {
+				continue;
+			}
 
-				manifoldConstraintIndices.pop_back();
+			std::size_t k = 0;
+			while (contactSlots[k].active) {
+				++k;
+			}
 
-				SOMBRA_DEBUG_LOG << "Removed contact Constraints [" << i-1 << "]";
+			mContactNormalConstraints[iFirstSlot + k] = NormalConstraint(
+				std::array{ rb1, rb2 },
+				mParentWorld.getProperties().collisionBeta,
+				mParentWorld.getProperties().collisionRestitutionFactor,
+				mParentWorld.getProperties().collisionSlopPenetration,
+				mParentWorld.getProperties().collisionSlopRestitution
+			);
+			for (FrictionConstraint& frictionConstraint : mContactFrictionConstraints[iFirstSlot + k]) {
+				frictionConstraint = FrictionConstraint(
+					std::array{ rb1, rb2 }, mParentWorld.getProperties().frictionGravityAcceleration, mu
+				);
 			}
 
+			contactSlots[k].contactId = manifold.contacts[i].id;
+			setContactActive(iFirstSlot + k, true);
+			contactSlotIndices[i] = k;
 			updateFrictionMasses = true;
+
+			SOMBRA_DEBUG_LOG << "Added contact Constraints [" << i << "] with frictionCoefficient=" << mu;
 		}
 
-		if (updateFrictionMasses) {
+		if (updateFrictionMasses && !manifold.contacts.empty()) {
 			// Update the friction constraint masses
 			float averageMass = 0.5f * (1.0f / rb1->getProperties().invertedMass + 1.0f / rb2->getProperties().invertedMass);
-			float perContactMass = averageMass / manifoldConstraintIndices.size();
+			float perContactMass = averageMass / manifold.contacts.size();
 
-			for (ContactConstraintIndices& constraintIndices : manifoldConstraintIndices) {
-				mContactFrictionConstraints[constraintIndices.iFrictionConstraints[0]].calculateConstraintBounds(perContactMass);
-				mContactFrictionConstraints[constraintIndices.iFrictionConstraints[1]].calculateConstraintBounds(perContactMass);
+			for (std::size_t i = 0; i < manifold.contacts.size(); ++i) {
+				for (FrictionConstraint& frictionConstraint : mContactFrictionConstraints[iFirstSlot + contactSlotIndices[i]]) {
+					frictionConstraint.calculateConstraintBounds(perContactMass);
+				}
 			}
 
 			SOMBRA_DEBUG_LOG << "Updated FrictionConstraint masses to " << perContactMass;
@@ -171,6 +229,8 @@ namespace se::physics {
 		// Update the constraints data
 		for (std::size_t i = 0; i < manifold.contacts.size(); ++i) {
 			const Contact& contact = manifold.contacts[i];
+			NormalConstraint& normalConstraint = mContactNormalConstraints[iFirstSlot + contactSlotIndices[i]];
+			auto& frictionConstraints = mContactFrictionConstraints[iFirstSlot + contactSlotIndices[i]];
 
 			// Calculate the vectors that points from the RigidBodies center of
 			// mass to their contact points
@@ -186,12 +246,17 @@ namespace se::physics {
 			glm::vec3 tangent1 = glm::normalize(glm::cross(contact.normal, vAxis));
 			glm::vec3 tangent2 = glm::normalize(glm::cross(contact.normal, tangent1));
 
-			mContactNormalConstraints[manifoldConstraintIndices[i].iNormalConstraint].setNormal(contact.normal);
-			mContactNormalConstraints[manifoldConstraintIndices[i].iNormalConstraint].setConstraintVectors({ r1, r2 });
-			mContactFrictionConstraints[manifoldConstraintIndices[i].iFrictionConstraints[0]].setTangent(tangent1);
-			mContactFrictionConstraints[manifoldConstraintIndices[i].iFrictionConstraints[0]].setConstraintVectors({ r1, r2 });
-			mContactFrictionConstraints[manifoldConstraintIndices[i].iFrictionConstraints[1]].setTangent(tangent2);
-			mContactFrictionConstraints[manifoldConstraintIndices[i].iFrictionConstraints[1]].setConstraintVectors({ r1, r2 });
+			normalConstraint.setNormal(contact.normal);
+			normalConstraint.setConstraintVectors({ r1, r2 });
+			frictionConstraints[0].setTangent(tangent1);
+			frictionConstraints[0].setConstraintVectors({ r1, r2 });
+			frictionConstraints[1].setTangent(tangent2);
+			frictionConstraints[1].setConstraintVectors({ r1, r2 });
+
+			// The tangents can change between updates, so the FrictionConstraints
+			// are only warm started between the substeps of the same update
+			frictionConstraints[0].setLambda(0.0f);
+			frictionConstraints[1].setLambda(0.0f);
 
 			SOMBRA_DEBUG_LOG << "Updated contact Constraints [" << i << "]: "
 				<< "r1=" << glm::to_string(r1) << ", " << "r2=" << glm::to_string(r2) << ", "
@@ -201,28 +266,68 @@ namespace se::physics {
 	}
 
 
-	void CollisionSolver::handleDisjointManifold(const Manifold& manifold)
+	void CollisionSolver::handleDisjointManifold(std::size_t manifoldIndex)
 	{
 		std::scoped_lock lock(mMutex);
 
-		auto itPair = mManifoldConstraintIndicesMap.find(&manifold);
-		if (itPair != mManifoldConstraintIndicesMap.end()) {
-			for (auto& constraintIndices : itPair->second) {
-				mParentWorld.getConstraintManager().removeConstraint(&mContactNormalConstraints[constraintIndices.iNormalConstraint]);
-				mParentWorld.getConstraintManager().removeConstraint(&mContactFrictionConstraints[constraintIndices.iFrictionConstraints[0]]);
-				mParentWorld.getConstraintManager().removeConstraint(&mContactFrictionConstraints[constraintIndices.iFrictionConstraints[1]]);
+		if (manifoldIndex >= mManifoldColliders.size()) {
+			return;
+		}
 
-				mContactNormalConstraints.erase(mContactNormalConstraints.begin().setIndex(constraintIndices.iNormalConstraint));
-				mContactFrictionConstraints.erase(mContactFrictionConstraints.begin().setIndex(constraintIndices.iFrictionConstraints[0]));
-				mContactFrictionConstraints.erase(mContactFrictionConstraints.begin().setIndex(constraintIndices.iFrictionConstraints[1]));
+		std::size_t numRemoved = 0;
+		for (std::size_t i = manifoldIndex * Manifold::kMaxContacts; i < (manifoldIndex + 1) * Manifold::kMaxContacts; ++i) {
+			if (mContactSlots[i].active) {
+				setContactActive(i, false);
+				++numRemoved;
 			}
+		}
+		mManifoldColliders[manifoldIndex] = { nullptr, nullptr };
 
-			SOMBRA_DEBUG_LOG << "Removed all the contact Constraints (" << itPair->second.size() << ")";
-			mManifoldConstraintIndicesMap.erase(itPair);
+		if (numRemoved > 0) {
+			SOMBRA_DEBUG_LOG << "Removed all the contact Constraints (" << numRemoved << ")";
 		}
 		else {
 			SOMBRA_WARN_LOG << "Doesn't exists any contact Constraints";
 		}
 	}
 
+
+	void CollisionSolver::setContactActive(std::size_t iContactSlot, bool active)
+	{
+		ContactSlot& contactSlot = mContactSlots[iContactSlot];
+		contactSlot.active = active;
+		if (!contactSlot.dirty) {
+			contactSlot.dirty = true;
+			mDirtyContactSlots.push_back(iContactSlot);
+		}
+	}
+
+
+	void CollisionSolver::flushContactChanges()
+	{
+		// The Contacts removed and added again since the last update reuse
+		// their Constraints in place, so they don't need to be sent
+		std::vector<Constraint*> addedConstraints, removedConstraints;
+		for (std::size_t iContactSlot : mDirtyContactSlots) {
+			ContactSlot& contactSlot = mContactSlots[iContactSlot];
+			contactSlot.dirty = false;
+
+			if (contactSlot.active != contactSlot.registered) {
+				auto& constraints = contactSlot.active? addedConstraints : removedConstraints;
+				constraints.push_back(&mContactNormalConstraints[iContactSlot]);
+				constraints.push_back(&mContactFrictionConstraints[iContactSlot][0]);
+				constraints.push_back(&mContactFrictionConstraints[iContactSlot][1]);
+				contactSlot.registered = contactSlot.active;
+			}
+		}
+		mDirtyContactSlots.clear();
+
+		if (!removedConstraints.empty()) {
+			mParentWorld.getConstraintManager().removeConstraints(removedConstraints.data(), removedConstraints.size());
+		}
+		if (!addedConstraints.empty()) {
+			mParentWorld.getConstraintManager().addConstraints(addedConstraints.data(), addedConstraints.size());
+		}
+	}
+
 }
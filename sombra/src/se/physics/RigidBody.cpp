@@ -21,6 +21,10 @@ namespace se::physics {
 	) : mProperties(properties), mState(state),
 		mCollider(std::move(collider)), mColliderLocalTransforms(colliderLocalTransforms)
 	{
+		if (mCollider) {
+			mCollider->setParent(this);
+		}
+
 		setStatus(Status::PropertiesChanged, true);
 		setStatus(Status::StateChanged, true);
 		setStatus(Status::ColliderChanged, true);
@@ -0,0 +1,239 @@
+#include <cmath>
+#include "se/physics/RigidBody.h"
+#include "se/physics/forces/Force.h"
+#include "RigidBodyStateStore.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+	#include <emmintrin.h>
+	#define SOMBRA_STATE_STORE_SSE
+#endif
+
+namespace se::physics {
+
+	void RigidBodyStateStore::setRigidBodies(RigidBody* const* rigidBodies, std::size_t numRigidBodies)
+	{
+		mRigidBodies.assign(rigidBodies, rigidBodies + numRigidBodies);
+
+		for (auto* components : {
+			&mPositions, &mLinearVelocities, &mAngularVelocities, &mLinearAccelerations,
+			&mAngularAccelerations, &mForceSums, &mTorqueSums
+		}) {
+			for (std::vector<float>& component : *components) {
+				component.resize(numRigidBodies);
+			}
+		}
+		for (std::vector<float>& component : mOrientations) {
+			component.resize(numRigidBodies);
+		}
+		for (std::vector<float>& component : mInvertedInertiaTensors) {
+			component.resize(numRigidBodies);
+		}
+		mInvertedMasses.resize(numRigidBodies);
+		mLinearDragFactors.resize(numRigidBodies);
+		mAngularDragFactors.resize(numRigidBodies);
+	}
+
+
+	void RigidBodyStateStore::integrate(std::size_t iFirst, std::size_t iLast, float deltaTime)
+	{
+		load(iFirst, iLast, deltaTime);
+		integrateStates(iFirst, iLast, deltaTime);
+		store(iFirst, iLast);
+	}
+
+// Private functions
+	void RigidBodyStateStore::load(std::size_t iFirst, std::size_t iLast, float deltaTime)
+	{
+		for (std::size_t i = iFirst; i < iLast; ++i) {
+			const RigidBody& rigidBody = *mRigidBodies[i];
+			const RigidBodyState& state = rigidBody.mState;
+			const RigidBodyProperties& properties = rigidBody.mProperties;
+
+			glm::vec3 forceSum(0.0f), torqueSum(0.0f);
+			rigidBody.processForces([&](const std::shared_ptr<Force>& force) {
+				auto [curForce, curTorque] = force->calculate(rigidBody);
+				forceSum += curForce;
+				torqueSum += curTorque;
+			});
+
+			for (int j = 0; j < 3; ++j) {
+				mPositions[j][i] = state.position[j];
+				mLinearVelocities[j][i] = state.linearVelocity[j];
+				mAngularVelocities[j][i] = state.angularVelocity[j];
+				mForceSums[j][i] = forceSum[j];
+				mTorqueSums[j][i] = torqueSum[j];
+			}
+			mOrientations[0][i] = state.orientation.w;
+			mOrientations[1][i] = state.orientation.x;
+			mOrientations[2][i] = state.orientation.y;
+			mOrientations[3][i] = state.orientation.z;
+			for (int c = 0; c < 3; ++c) {
+				for (int r = 0; r < 3; ++r) {
+					mInvertedInertiaTensors[3 * c + r][i] = state.invertedInertiaTensorWorld[c][r];
+				}
+			}
+			mInvertedMasses[i] = properties.invertedMass;
+
+			// pow(1, x) is always 1, so it's only calculated with drag
+			mLinearDragFactors[i] = (properties.linearDrag != 0.0f)? std::pow(1.0f - properties.linearDrag, deltaTime) : 1.0f;
+			mAngularDragFactors[i] = (properties.angularDrag != 0.0f)? std::pow(1.0f - properties.angularDrag, deltaTime) : 1.0f;
+		}
+	}
+
+
+	void RigidBodyStateStore::integrateStates(std::size_t iFirst, std::size_t iLast, float deltaTime)
+	{
+		float halfDeltaTime = 0.5f * deltaTime;
+		std::size_t i = iFirst;
+
+#ifdef SOMBRA_STATE_STORE_SSE
+		const __m128 dt = _mm_set1_ps(deltaTime);
+		const __m128 hdt = _mm_set1_ps(halfDeltaTime);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+
+		for (; i + 4 <= iLast; i += 4) {
+			// Linear attributes
+			__m128 invMass = _mm_loadu_ps(&mInvertedMasses[i]);
+			__m128 linearDrag = _mm_loadu_ps(&mLinearDragFactors[i]);
+			for (int j = 0; j < 3; ++j) {
+				__m128 acceleration = _mm_mul_ps(invMass, _mm_loadu_ps(&mForceSums[j][i]));
+				__m128 velocity = _mm_add_ps(
+					_mm_mul_ps(_mm_loadu_ps(&mLinearVelocities[j][i]), linearDrag),
+					_mm_mul_ps(acceleration, dt)
+				);
+				__m128 position = _mm_add_ps(_mm_loadu_ps(&mPositions[j][i]), _mm_mul_ps(velocity, dt));
+				_mm_storeu_ps(&mLinearAccelerations[j][i], acceleration);
+				_mm_storeu_ps(&mLinearVelocities[j][i], velocity);
+				_mm_storeu_ps(&mPositions[j][i], position);
+			}
+
+			// Angular attributes
+			__m128 torque[3], angularVelocity[3];
+			for (int j = 0; j < 3; ++j) {
+				torque[j] = _mm_loadu_ps(&mTorqueSums[j][i]);
+			}
+			__m128 angularDrag = _mm_loadu_ps(&mAngularDragFactors[i]);
+			for (int r = 0; r < 3; ++r) {
+				__m128 acceleration = _mm_mul_ps(_mm_loadu_ps(&mInvertedInertiaTensors[r][i]), torque[0]);
+				acceleration = _mm_add_ps(acceleration, _mm_mul_ps(_mm_loadu_ps(&mInvertedInertiaTensors[3 + r][i]), torque[1]));
+				acceleration = _mm_add_ps(acceleration, _mm_mul_ps(_mm_loadu_ps(&mInvertedInertiaTensors[6 + r][i]), torque[2]));
+				angularVelocity[r] = _mm_add_ps(
+					_mm_mul_ps(_mm_loadu_ps(&mAngularVelocities[r][i]), angularDrag),
+					_mm_mul_ps(acceleration, dt)
+				);
+				_mm_storeu_ps(&mAngularAccelerations[r][i], acceleration);
+				_mm_storeu_ps(&mAngularVelocities[r][i], angularVelocity[r]);
+			}
+
+			// q += (0.5 * dt * (0, w)) * q
+			__m128 px = _mm_mul_ps(hdt, angularVelocity[0]);
+			__m128 py = _mm_mul_ps(hdt, angularVelocity[1]);
+			__m128 pz = _mm_mul_ps(hdt, angularVelocity[2]);
+			__m128 qw = _mm_loadu_ps(&mOrientations[0][i]);
+			__m128 qx = _mm_loadu_ps(&mOrientations[1][i]);
+			__m128 qy = _mm_loadu_ps(&mOrientations[2][i]);
+			__m128 qz = _mm_loadu_ps(&mOrientations[3][i]);
+			__m128 dw = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(zero, _mm_mul_ps(px, qx)), _mm_mul_ps(py, qy)), _mm_mul_ps(pz, qz));
+			__m128 dx = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(px, qw), _mm_mul_ps(py, qz)), _mm_mul_ps(pz, qy));
+			__m128 dy = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(py, qw), _mm_mul_ps(pz, qx)), _mm_mul_ps(px, qz));
+			__m128 dz = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(pz, qw), _mm_mul_ps(px, qy)), _mm_mul_ps(py, qx));
+			qw = _mm_add_ps(qw, dw);
+			qx = _mm_add_ps(qx, dx);
+			qy = _mm_add_ps(qy, dy);
+			qz = _mm_add_ps(qz, dz);
+
+			// Normalize the orientations, the zero length ones become the
+			// identity
+			__m128 length = _mm_mul_ps(qx, qx);
+			length = _mm_add_ps(length, _mm_mul_ps(qy, qy));
+			length = _mm_add_ps(length, _mm_mul_ps(qz, qz));
+			length = _mm_add_ps(length, _mm_mul_ps(qw, qw));
+			length = _mm_sqrt_ps(length);
+			__m128 valid = _mm_cmpgt_ps(length, zero);
+			__m128 divisor = _mm_or_ps(_mm_and_ps(valid, length), _mm_andnot_ps(valid, one));
+			qw = _mm_or_ps(_mm_and_ps(valid, _mm_div_ps(qw, divisor)), _mm_andnot_ps(valid, one));
+			qx = _mm_and_ps(valid, _mm_div_ps(qx, divisor));
+			qy = _mm_and_ps(valid, _mm_div_ps(qy, divisor));
+			qz = _mm_and_ps(valid, _mm_div_ps(qz, divisor));
+			_mm_storeu_ps(&mOrientations[0][i], qw);
+			_mm_storeu_ps(&mOrientations[1][i], qx);
+			_mm_storeu_ps(&mOrientations[2][i], qy);
+			_mm_storeu_ps(&mOrientations[3][i], qz);
+		}
+#endif		// SOMBRA_STATE_STORE_SSE
+
+		for (; i < iLast; ++i) {
+			// Linear attributes
+			for (int j = 0; j < 3; ++j) {
+				float acceleration = mInvertedMasses[i] * mForceSums[j][i];
+				float velocity = mLinearVelocities[j][i] * mLinearDragFactors[i] + acceleration * deltaTime;
+				mLinearAccelerations[j][i] = acceleration;
+				mLinearVelocities[j][i] = velocity;
+				mPositions[j][i] += velocity * deltaTime;
+			}
+
+			// Angular attributes
+			float angularVelocity[3];
+			for (int r = 0; r < 3; ++r) {
+				float acceleration = mInvertedInertiaTensors[r][i] * mTorqueSums[0][i]
+					+ mInvertedInertiaTensors[3 + r][i] * mTorqueSums[1][i]
+					+ mInvertedInertiaTensors[6 + r][i] * mTorqueSums[2][i];
+				angularVelocity[r] = mAngularVelocities[r][i] * mAngularDragFactors[i] + acceleration * deltaTime;
+				mAngularAccelerations[r][i] = acceleration;
+				mAngularVelocities[r][i] = angularVelocity[r];
+			}
+
+			// q += (0.5 * dt * (0, w)) * q
+			float px = halfDeltaTime * angularVelocity[0];
+			float py = halfDeltaTime * angularVelocity[1];
+			float pz = halfDeltaTime * angularVelocity[2];
+			float qw = mOrientations[0][i], qx = mOrientations[1][i], qy = mOrientations[2][i], qz = mOrientations[3][i];
+			float dw = 0.0f - px * qx - py * qy - pz * qz;
+			float dx = px * qw + py * qz - pz * qy;
+			float dy = py * qw + pz * qx - px * qz;
+			float dz = pz * qw + px * qy - py * qx;
+			qw += dw;
+			qx += dx;
+			qy += dy;
+			qz += dz;
+
+			// Normalize the orientation, the zero length one becomes the
+			// identity
+			float length = std::sqrt(qx * qx + qy * qy + qz * qz + qw * qw);
+			if (length > 0.0f) {
+				mOrientations[0][i] = qw / length;
+				mOrientations[1][i] = qx / length;
+				mOrientations[2][i] = qy / length;
+				mOrientations[3][i] = qz / length;
+			}
+			else {
+				mOrientations[0][i] = 1.0f;
+				mOrientations[1][i] = mOrientations[2][i] = mOrientations[3][i] = 0.0f;
+			}
+		}
+	}
+
+
+	void RigidBodyStateStore::store(std::size_t iFirst, std::size_t iLast)
+	{
+		for (std::size_t i = iFirst; i < iLast; ++i) {
+			RigidBodyState& state = mRigidBodies[i]->mState;
+
+			for (int j = 0; j < 3; ++j) {
+				state.position[j] = mPositions[j][i];
+				state.linearVelocity[j] = mLinearVelocities[j][i];
+				state.angularVelocity[j] = mAngularVelocities[j][i];
+				state.linearAcceleration[j] = mLinearAccelerations[j][i];
+				state.angularAcceleration[j] = mAngularAccelerations[j][i];
+				state.forceSum[j] = mForceSums[j][i];
+				state.torqueSum[j] = mTorqueSums[j][i];
+			}
+			state.orientation.w = mOrientations[0][i];
+			state.orientation.x = mOrientations[1][i];
+			state.orientation.y = mOrientations[2][i];
+			state.orientation.z = mOrientations[3][i];
+		}
+	}
+
+}
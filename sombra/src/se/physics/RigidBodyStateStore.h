@@ -0,0 +1,118 @@
+#ifndef RIGID_BODY_STATE_STORE_H
+#define RIGID_BODY_STATE_STORE_H
+
+#include <array>
+#include <vector>
+
+namespace se::physics {
+
+	class RigidBody;
+
+
+	/**
+	 * Class RigidBodyStateStore, it holds the states of the RigidBodies
+	 * integrated by the RigidBodyWorld in Structure of Arrays layout, so
+	 * they can be integrated with SIMD instructions. The RigidBodies are
+	 * still the owners of their states, the store loads them before the
+	 * integration and writes them back after it.
+	 */
+	class RigidBodyStateStore
+	{
+	private:	// Nested types
+		using Vec3Array = std::array<std::vector<float>, 3>;
+
+	private:	// Attributes
+		/** The RigidBodies whose states are stored */
+		std::vector<RigidBody*> mRigidBodies;
+
+		/** The positions of the RigidBodies */
+		Vec3Array mPositions;
+
+		/** The orientations of the RigidBodies stored as (w, x, y, z) */
+		std::array<std::vector<float>, 4> mOrientations;
+
+		/** The linear velocities of the RigidBodies */
+		Vec3Array mLinearVelocities;
+
+		/** The angular velocities of the RigidBodies */
+		Vec3Array mAngularVelocities;
+
+		/** The linear accelerations of the RigidBodies */
+		Vec3Array mLinearAccelerations;
+
+		/** The angular accelerations of the RigidBodies */
+		Vec3Array mAngularAccelerations;
+
+		/** The sum of the forces applied to the RigidBodies */
+		Vec3Array mForceSums;
+
+		/** The sum of the torques applied to the RigidBodies */
+		Vec3Array mTorqueSums;
+
+		/** The inverse of the masses of the RigidBodies */
+		std::vector<float> mInvertedMasses;
+
+		/** The inverted inertia tensors of the RigidBodies in world space,
+		 * each element is stored as [column * 3 + row] */
+		std::array<std::vector<float>, 9> mInvertedInertiaTensors;
+
+		/** The factor by which the linear velocity of each RigidBody is
+		 * multiplied due to its drag in the current integration */
+		std::vector<float> mLinearDragFactors;
+
+		/** The factor by which the angular velocity of each RigidBody is
+		 * multiplied due to its drag in the current integration */
+		std::vector<float> mAngularDragFactors;
+
+	public:		// Functions
+		/** Sets the RigidBodies to integrate
+		 *
+		 * @param	rigidBodies a pointer to the RigidBodies
+		 * @param	numRigidBodies the number of RigidBodies */
+		void setRigidBodies(
+			RigidBody* const* rigidBodies, std::size_t numRigidBodies
+		);
+
+		/** @return	the number of RigidBodies to integrate */
+		std::size_t getNumRigidBodies() const { return mRigidBodies.size(); };
+
+		/** Calculates the sum of the Forces of a range of the RigidBodies
+		 * and integrates their states by the given amount of time. It can be
+		 * called from multiple threads with disjoint ranges
+		 *
+		 * @param	iFirst the index of the first RigidBody to integrate
+		 * @param	iLast the index after the last RigidBody to integrate
+		 * @param	deltaTime the difference time used to integrate the
+		 *			RigidBodies in seconds */
+		void integrate(std::size_t iFirst, std::size_t iLast, float deltaTime);
+	private:
+		/** Loads the states of a range of the RigidBodies and calculates
+		 * the sum of their Forces
+		 *
+		 * @param	iFirst the index of the first RigidBody to load
+		 * @param	iLast the index after the last RigidBody to load
+		 * @param	deltaTime the difference time used to integrate the
+		 *			RigidBodies in seconds */
+		void load(std::size_t iFirst, std::size_t iLast, float deltaTime);
+
+		/** Integrates the loaded states of a range of the RigidBodies
+		 *
+		 * @param	iFirst the index of the first RigidBody to integrate
+		 * @param	iLast the index after the last RigidBody to integrate
+		 * @param	deltaTime the difference time used to integrate the
+		 *			RigidBodies in seconds */
+		void integrateStates(
+			std::size_t iFirst, std::size_t iLast, float deltaTime
+		);
+
+		/** Writes the integrated states of a range of the RigidBodies back
+		 * to them
+		 *
+		 * @param	iFirst the index of the first RigidBody to store
+		 * @param	iLast the index after the last RigidBody to store */
+		void store(std::size_t iFirst, std::size_t iLast);
+	};
+
+}
+
+#endif		// RIGID_BODY_STATE_STORE_H
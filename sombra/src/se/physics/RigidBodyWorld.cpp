@@ -1,12 +1,14 @@
 #include <algorithm>
 #include "se/physics/RigidBodyWorld.h"
-#include "RigidBodyDynamics.h"
+#include "se/physics/collision/ConvexCollider.h"
+#include "RigidBodyStateStore.h"
 
 namespace se::physics {
 
 	RigidBodyWorld::RigidBodyWorld(const WorldProperties& properties) :
 		mProperties(properties), mThreadPool(properties.numThreads),
-		mCollisionDetector(*this), mConstraintManager(*this), mCollisionSolver(*this)
+		mCollisionDetector(*this), mConstraintManager(*this), mCollisionSolver(*this),
+		mStateStore(std::make_unique<RigidBodyStateStore>())
 	{
 		mCollisionDetector.addListener(&mCollisionSolver);
 	}
@@ -73,7 +75,10 @@ namespace se::physics {
 				// Change the Collider in the CollisionDetector
 				std::size_t iRB = std::distance(mRigidBodies.begin(), it);
 
-				mCollisionDetector.removeCollider(mRigidBodiesColliders[iRB]);
+				if (mRigidBodiesColliders[iRB]) {
+					mCollisionSolver.removeCollider(mRigidBodiesColliders[iRB]);
+					mCollisionDetector.removeCollider(mRigidBodiesColliders[iRB]);
+				}
 				mRigidBodiesColliders[iRB] = (*it)->getCollider();
 				if (mRigidBodiesColliders[iRB]) {
 					mCollisionDetector.addCollider(mRigidBodiesColliders[iRB]);
@@ -81,23 +86,45 @@ namespace se::physics {
 			}
 		}
 
+		// Propagate the wake ups to the RigidBodies connected by Constraints
+		mConstraintManager.updateSleepingStatus();
+
 		// Detect collisions
 		mCollisionDetector.update();
 
+		// Store the initial positions of the RigidBodies with continuous
+		// collision detection, their Colliders aren't moved until the end of
+		// the update
+		std::vector<std::pair<RigidBody*, glm::vec3>> ccdRigidBodies;
+		for (RigidBody* rigidBody : mRigidBodies) {
+			if (rigidBody->getProperties().continuousCollisionDetection
+				&& (rigidBody->getProperties().type == RigidBodyProperties::Type::Dynamic)
+				&& !rigidBody->getStatus(RigidBody::Status::Sleeping)
+				&& rigidBody->getCollider() && (rigidBody->getCollider()->getType() != ColliderType::Concave)
+			) {
+				ccdRigidBodies.emplace_back(rigidBody, rigidBody->getState().position);
+			}
+		}
+
 		// Substeps update
 		float substepTime = deltaTime / mProperties.numSubsteps;
 		for (std::size_t substep = 0; substep < mProperties.numSubsteps; ++substep) {
 			// Simulate the RigidBody dynamics
+			mActiveRigidBodies.clear();
 			for (RigidBody* rigidBody : mRigidBodies) {
 				if ((rigidBody->getProperties().type == RigidBodyProperties::Type::Dynamic)
 					&& isInside(mProperties.worldAABB, rigidBody->getState().position, mProperties.coarseCollisionEpsilon)
 					&& !rigidBody->getStatus(RigidBody::Status::Sleeping)
 				) {
-					RigidBodyDynamics::processForces(*rigidBody);
-					RigidBodyDynamics::integrate(*rigidBody, substepTime);
+					mActiveRigidBodies.push_back(rigidBody);
 				}
 			}
 
+			mStateStore->setRigidBodies(mActiveRigidBodies.data(), mActiveRigidBodies.size());
+			processBatch(mActiveRigidBodies.size(), [&](std::size_t iStart, std::size_t iEnd) {
+				mStateStore->integrate(iStart, iEnd, substepTime);
+			});
+
 			// Update the collision solver
 			mCollisionSolver.update(substepTime);
 
@@ -105,30 +132,103 @@ namespace se::physics {
 			mConstraintManager.update(substepTime);
 		}
 
+		// Prevent the fast RigidBodies from passing through other Colliders
+		for (auto& [rigidBody, initialPosition] : ccdRigidBodies) {
+			processContinuousCollision(*rigidBody, initialPosition);
+		}
+
 		// Update the RigidBodies status and transforms
 		float bias = std::pow(mProperties.motionBias, deltaTime);
-		for (RigidBody* rigidBody : mRigidBodies) {
-			if (rigidBody->getProperties().type == RigidBodyProperties::Type::Static) {
-				rigidBody->setStatus(RigidBody::Status::Sleeping, true);
+		processBatch(mRigidBodies.size(), [&](std::size_t iStart, std::size_t iEnd) {
+			for (std::size_t i = iStart; i < iEnd; ++i) {
+				RigidBody* rigidBody = mRigidBodies[i];
+				if (rigidBody->getProperties().type == RigidBodyProperties::Type::Static) {
+					rigidBody->setStatus(RigidBody::Status::Sleeping, true);
 
-				if (rigidBody->getStatus(RigidBody::Status::StateChanged)) {
-					rigidBody->updateTransforms();
+					if (rigidBody->getStatus(RigidBody::Status::StateChanged)) {
+						rigidBody->updateTransforms();
+					}
 				}
-			}
-			else if (!rigidBody->getStatus(RigidBody::Status::Sleeping)) {
-				rigidBody->updateTransforms();
-				rigidBody->updateMotion(bias, 10.0f * rigidBody->getProperties().sleepMotion);
+				else if (!rigidBody->getStatus(RigidBody::Status::Sleeping)) {
+					rigidBody->updateTransforms();
+					rigidBody->updateMotion(bias, 10.0f * rigidBody->getProperties().sleepMotion);
 
-				if (rigidBody->getState().motion < rigidBody->getProperties().sleepMotion) {
-					rigidBody->setStatus(RigidBody::Status::Sleeping, true);
+					if (rigidBody->getState().motion < rigidBody->getProperties().sleepMotion) {
+						rigidBody->setStatus(RigidBody::Status::Sleeping, true);
+					}
 				}
+
+				rigidBody->setStatus(RigidBody::Status::PropertiesChanged, false);
+				rigidBody->setStatus(RigidBody::Status::StateChanged, false);
+				rigidBody->setStatus(RigidBody::Status::ColliderChanged, false);
+				rigidBody->setStatus(RigidBody::Status::ForcesChanged, false);
 			}
+		});
 
-			rigidBody->setStatus(RigidBody::Status::PropertiesChanged, false);
-			rigidBody->setStatus(RigidBody::Status::StateChanged, false);
-			rigidBody->setStatus(RigidBody::Status::ColliderChanged, false);
-			rigidBody->setStatus(RigidBody::Status::ForcesChanged, false);
+		// The RigidBodies connected by Constraints can only sleep if all of
+		// them are sleeping
+		mConstraintManager.updateSleepingStatus();
+
+		// Publish the new state of the Colliders to the scene queries
+		mCollisionDetector.updateQuerySnapshot();
+	}
+
+// Private functions
+	void RigidBodyWorld::processBatch(std::size_t numElements, const BatchCallback& callback)
+	{
+		// The first chunk of elements is processed by the calling thread
+		std::size_t nThreads = std::clamp(numElements / kMinRigidBodiesPerThread, std::size_t(1), std::max(std::size_t(1), mProperties.numThreads));
+		std::size_t elementsPerThread = numElements / nThreads;
+		std::vector<std::future<void>> threadFutures;
+		threadFutures.reserve(nThreads - 1);
+		for (std::size_t iThread = 1; iThread < nThreads; ++iThread) {
+			std::size_t iStart = iThread * elementsPerThread;
+			std::size_t iEnd = (iThread < nThreads - 1)? (iThread + 1) * elementsPerThread : numElements;
+			threadFutures.push_back(mThreadPool.async([=, &callback]() { callback(iStart, iEnd); }));
+		}
+
+		callback(0, elementsPerThread);
+		for (auto& future : threadFutures) {
+			future.get();
+		}
+	}
+
+
+	void RigidBodyWorld::processContinuousCollision(RigidBody& rigidBody, const glm::vec3& initialPosition)
+	{
+		const auto& collider = static_cast<const ConvexCollider&>(*rigidBody.getCollider());
+
+		// Only the RigidBodies that moved a large distance relative to their
+		// size could have passed through other Colliders
+		glm::vec3 displacement = rigidBody.getState().position - initialPosition;
+		AABB aabb = collider.getAABB();
+		glm::vec3 size = aabb.maximum - aabb.minimum;
+		float minSize = std::min({ size.x, size.y, size.z });
+		if (glm::length(displacement) <= mProperties.continuousCollisionThreshold * minSize) {
+			return;
 		}
+
+		auto [hitCollider, rayHit] = mCollisionDetector.calculateTimeOfImpact(collider, displacement);
+		if (!hitCollider) {
+			return;
+		}
+
+		// Move the RigidBody back to the time of impact, leaving a small gap
+		// with the hit Collider
+		glm::vec3 direction = glm::normalize(displacement);
+		float distance = std::max(rayHit.distance - mProperties.collisionSlopPenetration, 0.0f);
+
+		RigidBodyState state = rigidBody.getState();
+		state.position = initialPosition + distance * direction;
+
+		// Remove the velocity towards the hit Collider
+		glm::vec3 normal = (glm::dot(rayHit.contactNormal, direction) > 0.0f)? -rayHit.contactNormal : rayHit.contactNormal;
+		float normalVelocity = glm::dot(state.linearVelocity, normal);
+		if (normalVelocity < 0.0f) {
+			state.linearVelocity -= normalVelocity * normal;
+		}
+
+		rigidBody.setState(state);
 	}
 
 }
@@ -65,6 +65,13 @@ namespace se::physics {
 	}
 
 
+	bool contains(const AABB& aabb1, const AABB& aabb2)
+	{
+		return glm::all(glm::lessThanEqual(aabb1.minimum, aabb2.minimum))
+			&& glm::all(glm::greaterThanEqual(aabb1.maximum, aabb2.maximum));
+	}
+
+
 	AABB transform(const AABB& aabb, const glm::mat4& transforms)
 	{
 		AABB ret{ glm::vec3(std::numeric_limits<float>::max()), glm::vec3(-std::numeric_limits<float>::max()) };
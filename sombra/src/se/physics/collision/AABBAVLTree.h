@@ -2,6 +2,8 @@
 #define AABB_AVL_TREE_H
 
 #include "se/utils/PackedVector.h"
+#include "se/utils/MemoryTracker.h"
+#include "se/physics/collision/AABB.h"
 #include "se/physics/collision/Ray.h"
 
 namespace se::physics {
@@ -10,7 +12,9 @@ namespace se::physics {
 	 * Class AABBAVLTree, it's an AVL Tree that stores AABBs, it can be used
 	 * for testing ray casts and overlaps between AABBs. The nodes can be added
 	 * or removed dynamically, the Tree will automatically rebalance itself
-	 * with each change
+	 * with each change. The AABBs of the leaf nodes can also be refitted in
+	 * place without rebalancing, in that case @see rebuild can be used from
+	 * time to time for recovering the quality of the Tree
 	 */
 	template <typename T>
 	class AABBAVLTree
@@ -28,12 +32,17 @@ namespace se::physics {
 			T userData;						///< Only for leaf Nodes
 		};
 
-	private:	// Attributes
+	public:		// Attributes
+		/** The index used for marking that there are no nodes */
+		static constexpr std::size_t kNullIndex = static_cast<std::size_t>(-1);
+	private:
 		/** All the Nodes of the Tree */
-		utils::PackedVector<TreeNode> mNodes;
+		utils::PackedVector<
+			TreeNode, utils::TrackedAllocator<TreeNode, utils::MemoryTag::Physics>
+		> mNodes;
 
 		/** The index of the root node in @see mNodes */
-		std::size_t mRootIndex;
+		std::size_t mRootIndex = kNullIndex;
 
 	public:		// Functions
 		/** Adds a node to the AABB Tree
@@ -70,6 +79,26 @@ namespace se::physics {
 		 * @param	nodeId the id of the node to remove */
 		void removeNode(std::size_t nodeId);
 
+		/** Changes the AABB of the given leaf node, reinserting it in the
+		 * best position of the Tree for the new AABB
+		 *
+		 * @param	nodeId the id of the leaf node to update, it won't change
+		 * @param	aabb the new AABB of the node */
+		void updateNode(std::size_t nodeId, const AABB& aabb);
+
+		/** Changes the AABB of the given leaf node in place, updating the
+		 * AABBs of its ancestors without moving any node. It's cheaper than
+		 * @see updateNode but the quality of the Tree can degrade if the new
+		 * AABB is far from the old one
+		 *
+		 * @param	nodeId the id of the leaf node to update
+		 * @param	aabb the new AABB of the node */
+		void refitNode(std::size_t nodeId, const AABB& aabb);
+
+		/** Rebuilds the Tree from scratch with the current leaf nodes AABBs.
+		 * The ids of the leaf nodes won't change */
+		void rebuild();
+
 		/** Calculates all the leaf nodes in the Tree that are currently
 		 * overlaping
 		 *
@@ -104,6 +133,18 @@ namespace se::physics {
 			const Ray& ray, float epsilon, F&& callback
 		) const;
 	private:
+		/** Inserts the given leaf node in the Tree
+		 *
+		 * @param	nodeIndex the index of the node to insert, it must be
+		 *			already in @see mNodes but not linked to any other node */
+		void insertLeaf(std::size_t nodeIndex);
+
+		/** Unlinks the given leaf node from the Tree, removing its parent
+		 * node but not the leaf itself
+		 *
+		 * @param	nodeIndex the index of the node to unlink */
+		void removeLeaf(std::size_t nodeIndex);
+
 		/** Calculate the best sibling node to the given node based on the area
 		 *
 		 * @param	nodeIndex the node index to calculate its best sibling node
@@ -7,84 +7,69 @@ namespace se::physics {
 	std::size_t AABBAVLTree<T>::addNode(const AABB& aabb, const T& userData)
 	{
 		std::size_t nodeIndex = mNodes.emplace().getIndex();
-		mNodes[nodeIndex].parent = nodeIndex;
 		mNodes[nodeIndex].aabb = aabb;
 		mNodes[nodeIndex].userData = userData;
+		insertLeaf(nodeIndex);
 
-		// If there were no nodes in the tree this one will be the new root node
-		if (mNodes.size() == 1) {
-			mRootIndex = nodeIndex;
-			return nodeIndex;
-		}
+		return nodeIndex;
+	}
 
-		// Calculate a sibling node
-		std::size_t siblingIndex = calculateBestSibling(nodeIndex);
 
-		// Insert a new parent node of the sibling and the new leaf node where
-		// the sibling was
-		std::size_t newParentIndex = mNodes.emplace().getIndex();
-		std::size_t oldParentIndex = mNodes[siblingIndex].parent;
-		mNodes[newParentIndex].isLeaf = false;
-		mNodes[newParentIndex].leftChild = nodeIndex;
-		mNodes[newParentIndex].rightChild = siblingIndex;
-		mNodes[siblingIndex].parent = newParentIndex;
-		mNodes[nodeIndex].parent = newParentIndex;
+	template <typename T>
+	void AABBAVLTree<T>::removeNode(std::size_t nodeId)
+	{
+		removeLeaf(nodeId);
+		mNodes.erase(mNodes.begin().setIndex(nodeId));
+	}
 
-		// Update the ancestor nodes
-		if (mRootIndex == siblingIndex) {
-			mNodes[newParentIndex].parent = newParentIndex;
-			mRootIndex = newParentIndex;
-		}
-		else {
-			if (mNodes[oldParentIndex].leftChild == siblingIndex) {
-				mNodes[oldParentIndex].leftChild = newParentIndex;
-			}
-			else {
-				mNodes[oldParentIndex].rightChild = newParentIndex;
-			}
-			mNodes[newParentIndex].parent = oldParentIndex;
-		}
 
-		updateAncestors(nodeIndex);
+	template <typename T>
+	void AABBAVLTree<T>::updateNode(std::size_t nodeId, const AABB& aabb)
+	{
+		removeLeaf(nodeId);
+		mNodes[nodeId].aabb = aabb;
+		insertLeaf(nodeId);
+	}
 
-		return nodeIndex;
+
+	template <typename T>
+	void AABBAVLTree<T>::refitNode(std::size_t nodeId, const AABB& aabb)
+	{
+		mNodes[nodeId].aabb = aabb;
+
+		while (nodeId != mRootIndex) {
+			nodeId = mNodes[nodeId].parent;
+			std::size_t leftChild = mNodes[nodeId].leftChild;
+			std::size_t rightChild = mNodes[nodeId].rightChild;
+			mNodes[nodeId].aabb = expand(mNodes[leftChild].aabb, mNodes[rightChild].aabb);
+		}
 	}
 
 
 	template <typename T>
-	void AABBAVLTree<T>::removeNode(std::size_t nodeId)
+	void AABBAVLTree<T>::rebuild()
 	{
-		if (nodeId != mRootIndex) {
-			// Move the sibling node up
-			std::size_t parentIndex = mNodes[nodeId].parent;
-			std::size_t siblingIndex = (mNodes[parentIndex].leftChild == nodeId)?
-				mNodes[parentIndex].rightChild :
-				mNodes[parentIndex].leftChild;
-
-			if (parentIndex == mRootIndex) {
-				mNodes[siblingIndex].parent = siblingIndex;
-				mRootIndex = siblingIndex;
+		std::vector<std::size_t> leafNodes, internalNodes;
+		leafNodes.reserve(mNodes.size() / 2 + 1);
+		internalNodes.reserve(mNodes.size() / 2);
+
+		for (auto itNode = mNodes.begin(); itNode != mNodes.end(); ++itNode) {
+			if (itNode->isLeaf) {
+				leafNodes.push_back(itNode.getIndex());
 			}
 			else {
-				std::size_t grandparentIndex = mNodes[parentIndex].parent;
-				if (mNodes[grandparentIndex].leftChild == parentIndex) {
-					mNodes[grandparentIndex].leftChild = siblingIndex;
-				}
-				else {
-					mNodes[grandparentIndex].rightChild = siblingIndex;
-				}
-				mNodes[siblingIndex].parent = grandparentIndex;
-
-				// Update the ancestor nodes
-				updateAncestors(siblingIndex);
+				internalNodes.push_back(itNode.getIndex());
 			}
+		}
 
-			// Remove the parent node
-			mNodes.erase(mNodes.begin().setIndex(parentIndex));
+		for (std::size_t nodeIndex : internalNodes) {
+			mNodes.erase(mNodes.begin().setIndex(nodeIndex));
 		}
 
-		// Remove the node
-		mNodes.erase(mNodes.begin().setIndex(nodeId));
+		mRootIndex = kNullIndex;
+		for (std::size_t nodeIndex : leafNodes) {
+			insertLeaf(nodeIndex);
+		}
 	}
 
 
@@ -130,6 +115,10 @@ namespace se::physics {
 	template <typename F>
 	void AABBAVLTree<T>::calculateOverlapsWith(const AABB& aabb, float epsilon, F&& callback) const
 	{
+		if (mRootIndex == kNullIndex) {
+			return;
+		}
+
 		std::vector<std::size_t> treeStack = { mRootIndex };
 		while (!treeStack.empty()) {
 			std::size_t nodeIndex = treeStack.back();
@@ -152,6 +141,10 @@ namespace se::physics {
 	template <typename F>
 	void AABBAVLTree<T>::calculateIntersectionsWith(const Ray& ray, float epsilon, F&& callback) const
 	{
+		if (mRootIndex == kNullIndex) {
+			return;
+		}
+
 		std::vector<std::size_t> treeStack = { mRootIndex };
 		while (!treeStack.empty()) {
 			std::size_t nodeIndex = treeStack.back();
@@ -170,6 +163,87 @@ namespace se::physics {
 	}
 
 // Private functions
+	template <typename T>
+	void AABBAVLTree<T>::insertLeaf(std::size_t nodeIndex)
+	{
+		mNodes[nodeIndex].parent = nodeIndex;
+
+		// If there were no nodes in the tree this one will be the new root node
+		if (mRootIndex == kNullIndex) {
+			mRootIndex = nodeIndex;
+			return;
+		}
+
+		// Calculate a sibling node
+		std::size_t siblingIndex = calculateBestSibling(nodeIndex);
+
+		// Insert a new parent node of the sibling and the new leaf node where
+		// the sibling was
+		std::size_t newParentIndex = mNodes.emplace().getIndex();
+		std::size_t oldParentIndex = mNodes[siblingIndex].parent;
+		mNodes[newParentIndex].isLeaf = false;
+		mNodes[newParentIndex].leftChild = nodeIndex;
+		mNodes[newParentIndex].rightChild = siblingIndex;
+		mNodes[siblingIndex].parent = newParentIndex;
+		mNodes[nodeIndex].parent = newParentIndex;
+
+		// Update the ancestor nodes
+		if (mRootIndex == siblingIndex) {
+			mNodes[newParentIndex].parent = newParentIndex;
+			mRootIndex = newParentIndex;
+		}
+		else {
+			if (mNodes[oldParentIndex].leftChild == siblingIndex) {
+				mNodes[oldParentIndex].leftChild = newParentIndex;
+			}
+			else {
+				mNodes[oldParentIndex].rightChild = newParentIndex;
+			}
+			mNodes[newParentIndex].parent = oldParentIndex;
+		}
+
+		updateAncestors(nodeIndex);
+	}
+
+
+	template <typename T>
+	void AABBAVLTree<T>::removeLeaf(std::size_t nodeIndex)
+	{
+		if (nodeIndex == mRootIndex) {
+			mRootIndex = kNullIndex;
+			return;
+		}
+
+		// Move the sibling node up
+		std::size_t parentIndex = mNodes[nodeIndex].parent;
+		std::size_t siblingIndex = (mNodes[parentIndex].leftChild == nodeIndex)?
+			mNodes[parentIndex].rightChild :
+			mNodes[parentIndex].leftChild;
+
+		if (parentIndex == mRootIndex) {
+			mNodes[siblingIndex].parent = siblingIndex;
+			mRootIndex = siblingIndex;
+		}
+		else {
+			std::size_t grandparentIndex = mNodes[parentIndex].parent;
+			if (mNodes[grandparentIndex].leftChild == parentIndex) {
+				mNodes[grandparentIndex].leftChild = siblingIndex;
+			}
+			else {
+				mNodes[grandparentIndex].rightChild = siblingIndex;
+			}
+			mNodes[siblingIndex].parent = grandparentIndex;
+
+			// Update the ancestor nodes
+			updateAncestors(siblingIndex);
+		}
+
+		// Remove the parent node
+		mNodes.erase(mNodes.begin().setIndex(parentIndex));
+		mNodes[nodeIndex].parent = nodeIndex;
+	}
+
+
 	template <typename T>
 	std::size_t AABBAVLTree<T>::calculateBestSibling(std::size_t nodeIndex)
 	{
@@ -194,7 +268,8 @@ namespace se::physics {
 			}
 
 			if (!mNodes[sContent.nodeIndex].isLeaf) {
-				float branchCost = calculateArea(mNodes[sContent.nodeIndex].aabb) + sContent.ancestorCost;
+				// The children inherit the area increase of the current node
+				float branchCost = currentCost - calculateArea(mNodes[sContent.nodeIndex].aabb);
 				float traverseCost = calculateArea(mNodes[nodeIndex].aabb) + branchCost;
 				if (traverseCost < bestCost) {
 					stack.push_back({ mNodes[sContent.nodeIndex].leftChild, branchCost });
@@ -0,0 +1,723 @@
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "se/utils/MathUtils.h"
+#include "se/physics/collision/BoundingSphere.h"
+#include "se/physics/collision/Capsule.h"
+#include "se/physics/collision/BoundingBox.h"
+#include "AnalyticCollisionDetector.h"
+
+namespace se::physics {
+
+	bool AnalyticCollisionDetector::collideSpheres(
+		const BoundingSphere& sphere1, const BoundingSphere& sphere2,
+		ContactVector& contacts
+	) const
+	{
+		Contact contact;
+		if (!calculateSphereContact(sphere1.getCenter(), sphere1.getRadius(), sphere2.getCenter(), sphere2.getRadius(), contact)) {
+			return false;
+		}
+
+		contacts.push_back(contact);
+		setLocalPositions(sphere1, sphere2, contacts);
+		return true;
+	}
+
+
+	bool AnalyticCollisionDetector::collideSphereCapsule(
+		const BoundingSphere& sphere, const Capsule& capsule,
+		ContactVector& contacts
+	) const
+	{
+		Segment segment = getSegment(capsule);
+		glm::vec3 closest = utils::getClosestPointInEdge(sphere.getCenter(), segment.p1, segment.p2);
+
+		Contact contact;
+		if (!calculateSphereContact(sphere.getCenter(), sphere.getRadius(), closest, capsule.getRadius(), contact)) {
+			return false;
+		}
+
+		contacts.push_back(contact);
+		setLocalPositions(sphere, capsule, contacts);
+		return true;
+	}
+
+
+	bool AnalyticCollisionDetector::collideCapsules(
+		const Capsule& capsule1, const Capsule& capsule2,
+		ContactVector& contacts
+	) const
+	{
+		Segment segment1 = getSegment(capsule1), segment2 = getSegment(capsule2);
+		glm::vec3 d1 = segment1.p2 - segment1.p1, d2 = segment2.p2 - segment2.p1;
+		float length1 = glm::length(d1), length2 = glm::length(d2);
+
+		// If the Capsules are parallel, add a Contact at each side of the
+		// overlapping part of the segments so they can rest on each other
+		if ((length1 > mEpsilon) && (length2 > mEpsilon)
+			&& (std::abs(glm::dot(d1, d2)) >= kParallelCosine * length1 * length2)
+		) {
+			float t1 = glm::dot(segment2.p1 - segment1.p1, d1) / (length1 * length1);
+			float t2 = glm::dot(segment2.p2 - segment1.p1, d1) / (length1 * length1);
+			float tMin = std::max(0.0f, std::min(t1, t2));
+			float tMax = std::min(1.0f, std::max(t1, t2));
+
+			if ((tMax - tMin) * length1 > mEpsilon) {
+				for (float t : { tMin, tMax }) {
+					glm::vec3 point1 = segment1.p1 + t * d1;
+					glm::vec3 point2 = utils::getClosestPointInEdge(point1, segment2.p1, segment2.p2);
+
+					Contact contact;
+					if (calculateSphereContact(point1, capsule1.getRadius(), point2, capsule2.getRadius(), contact)) {
+						contacts.push_back(contact);
+					}
+				}
+
+				if (!contacts.empty()) {
+					setLocalPositions(capsule1, capsule2, contacts);
+					return true;
+				}
+			}
+		}
+
+		glm::vec3 closest1, closest2;
+		getClosestPoints(segment1, segment2, closest1, closest2);
+
+		Contact contact;
+		if (!calculateSphereContact(closest1, capsule1.getRadius(), closest2, capsule2.getRadius(), contact)) {
+			return false;
+		}
+
+		contacts.push_back(contact);
+		setLocalPositions(capsule1, capsule2, contacts);
+		return true;
+	}
+
+
+	bool AnalyticCollisionDetector::collideSphereBox(
+		const BoundingSphere& sphere, const BoundingBox& box,
+		ContactVector& contacts
+	) const
+	{
+		Box boxData = getBox(box);
+		glm::vec3 center = sphere.getCenter();
+		float radius = sphere.getRadius();
+
+		glm::vec3 closest = getClosestPoint(center, boxData);
+		glm::vec3 v = closest - center;
+		float distance2 = glm::dot(v, v);
+		if (distance2 > radius * radius) {
+			return false;
+		}
+
+		Contact contact;
+		if (distance2 > mEpsilon * mEpsilon) {
+			// The center of the sphere is outside the box
+			float distance = std::sqrt(distance2);
+			contact.normal = v / distance;
+			contact.penetration = radius - distance;
+			contact.worldPosition[0] = center + radius * contact.normal;
+			contact.worldPosition[1] = closest;
+		}
+		else {
+			// The center of the sphere is inside the box, so it's pushed out
+			// through the closest face
+			glm::vec3 centerToCenter = center - boxData.center;
+			int iAxis = 0;
+			float projection = 0.0f, faceDistance = std::numeric_limits<float>::max();
+			for (int i = 0; i < 3; ++i) {
+				float currentProjection = glm::dot(centerToCenter, boxData.axes[i]);
+				float currentDistance = boxData.halfLengths[i] - std::abs(currentProjection);
+				if (currentDistance < faceDistance) {
+					iAxis = i;
+					projection = currentProjection;
+					faceDistance = currentDistance;
+				}
+			}
+
+			glm::vec3 faceNormal = (projection >= 0.0f)? boxData.axes[iAxis] : -boxData.axes[iAxis];
+			contact.normal = -faceNormal;
+			contact.penetration = radius + faceDistance;
+			contact.worldPosition[0] = center + radius * contact.normal;
+			contact.worldPosition[1] = center + faceDistance * faceNormal;
+		}
+
+		contacts.push_back(contact);
+		setLocalPositions(sphere, box, contacts);
+		return true;
+	}
+
+
+	bool AnalyticCollisionDetector::collideCapsuleBox(
+		const Capsule& capsule, const BoundingBox& box,
+		ContactVector& contacts
+	) const
+	{
+		Segment segment = getSegment(capsule);
+		Box boxData = getBox(box);
+		float radius = capsule.getRadius();
+
+		glm::vec3 closest1, closest2;
+		float distance2 = getClosestPoints(segment, boxData, closest1, closest2);
+		if (distance2 > radius * radius) {
+			return false;
+		}
+
+		Contact contact;
+		if (distance2 > mEpsilon * mEpsilon) {
+			// The segment is outside the box, if the closest feature of the
+			// box is a face the segment is clipped against it
+			float distance = std::sqrt(distance2);
+			glm::vec3 boxToSegment = (closest1 - closest2) / distance;
+
+			int iAxis = 0;
+			float maxProjection = 0.0f;
+			for (int i = 0; i < 3; ++i) {
+				float projection = glm::dot(boxToSegment, boxData.axes[i]);
+				if (std::abs(projection) > std::abs(maxProjection)) {
+					iAxis = i;
+					maxProjection = projection;
+				}
+			}
+
+			if (std::abs(maxProjection) >= kParallelCosine) {
+				glm::vec3 faceNormal = (maxProjection > 0.0f)? boxData.axes[iAxis] : -boxData.axes[iAxis];
+				clipSegmentWithFace(segment, radius, boxData, iAxis, faceNormal, contacts);
+			}
+
+			contact.normal = -boxToSegment;
+			contact.penetration = radius - distance;
+			contact.worldPosition[0] = closest1 + radius * contact.normal;
+			contact.worldPosition[1] = closest2;
+		}
+		else {
+			// The segment intersects the box, so the capsule is pushed out
+			// through the face axis with the smallest penetration
+			int iAxis = 0;
+			glm::vec3 faceNormal(0.0f);
+			float minPenetration = std::numeric_limits<float>::max();
+			for (int i = 0; i < 3; ++i) {
+				float projection1 = glm::dot(segment.p1 - boxData.center, boxData.axes[i]);
+				float projection2 = glm::dot(segment.p2 - boxData.center, boxData.axes[i]);
+
+				float penetrationPositive = boxData.halfLengths[i] - std::min(projection1, projection2) + radius;
+				if (penetrationPositive < minPenetration) {
+					iAxis = i;
+					faceNormal = boxData.axes[i];
+					minPenetration = penetrationPositive;
+				}
+
+				float penetrationNegative = boxData.halfLengths[i] + std::max(projection1, projection2) + radius;
+				if (penetrationNegative < minPenetration) {
+					iAxis = i;
+					faceNormal = -boxData.axes[i];
+					minPenetration = penetrationNegative;
+				}
+			}
+
+			clipSegmentWithFace(segment, radius, boxData, iAxis, faceNormal, contacts);
+
+			contact.normal = -faceNormal;
+			contact.penetration = minPenetration;
+			contact.worldPosition[0] = closest1 + radius * contact.normal;
+			contact.worldPosition[1] = contact.worldPosition[0] + minPenetration * faceNormal;
+		}
+
+		// Fallback to the Contact of the closest points
+		if (contacts.empty()) {
+			contacts.push_back(contact);
+		}
+
+		setLocalPositions(capsule, box, contacts);
+		return true;
+	}
+
+
+	bool AnalyticCollisionDetector::collideBoxes(
+		const BoundingBox& box1, const BoundingBox& box2,
+		ContactVector& contacts
+	) const
+	{
+		Box boxData1 = getBox(box1), boxData2 = getBox(box2);
+		glm::vec3 centerToCenter = boxData2.center - boxData1.center;
+
+		// Calculates the penetration of the boxes along the given axis, the
+		// normal is updated so it points from the first box to the second
+		auto getPenetration = [&](const glm::vec3& axis, glm::vec3& normal) {
+			float radius1 = 0.0f, radius2 = 0.0f;
+			for (int i = 0; i < 3; ++i) {
+				radius1 += boxData1.halfLengths[i] * std::abs(glm::dot(boxData1.axes[i], axis));
+				radius2 += boxData2.halfLengths[i] * std::abs(glm::dot(boxData2.axes[i], axis));
+			}
+
+			float distance = glm::dot(centerToCenter, axis);
+			normal = (distance >= 0.0f)? axis : -axis;
+			return radius1 + radius2 - std::abs(distance);
+		};
+
+		// Search the axis with the smallest penetration, if there is any
+		// separating axis the boxes aren't intersecting. The face axes of
+		// the first box are preferred over the other ones for coherence
+		enum class AxisType { Face1, Face2, Edge } bestAxisType = AxisType::Face1;
+		int bestAxis1 = 0, bestAxis2 = 0;
+		glm::vec3 bestNormal(0.0f), normal;
+		float minPenetration = std::numeric_limits<float>::max();
+
+		for (int i = 0; i < 3; ++i) {
+			float penetration = getPenetration(boxData1.axes[i], normal);
+			if (penetration < 0.0f) {
+				return false;
+			}
+
+			if (penetration < minPenetration) {
+				bestAxisType = AxisType::Face1;
+				bestAxis1 = i;
+				bestNormal = normal;
+				minPenetration = penetration;
+			}
+		}
+
+		for (int j = 0; j < 3; ++j) {
+			float penetration = getPenetration(boxData2.axes[j], normal);
+			if (penetration < 0.0f) {
+				return false;
+			}
+
+			if (penetration < kFaceAxisTolerance * minPenetration) {
+				bestAxisType = AxisType::Face2;
+				bestAxis2 = j;
+				bestNormal = normal;
+				minPenetration = penetration;
+			}
+		}
+
+		for (int i = 0; i < 3; ++i) {
+			for (int j = 0; j < 3; ++j) {
+				glm::vec3 axis = glm::cross(boxData1.axes[i], boxData2.axes[j]);
+				float axisLength = glm::length(axis);
+				if (axisLength < kMinEdgeAxisLength) {
+					// The edges are parallel, the separation is already
+					// tested with the face axes
+					continue;
+				}
+
+				float penetration = getPenetration(axis / axisLength, normal);
+				if (penetration < 0.0f) {
+					return false;
+				}
+
+				if (penetration < kEdgeAxisTolerance * minPenetration) {
+					bestAxisType = AxisType::Edge;
+					bestAxis1 = i;
+					bestAxis2 = j;
+					bestNormal = normal;
+					minPenetration = penetration;
+				}
+			}
+		}
+
+		if (bestAxisType == AxisType::Face1) {
+			clipBoxFaces(boxData1, boxData2, bestAxis1, bestNormal, contacts);
+		}
+		else if (bestAxisType == AxisType::Face2) {
+			// The Contacts are calculated with the second box as the
+			// reference, so they must be reversed
+			clipBoxFaces(boxData2, boxData1, bestAxis2, -bestNormal, contacts);
+			for (Contact& contact : contacts) {
+				contact.normal = -contact.normal;
+				std::swap(contact.worldPosition[0], contact.worldPosition[1]);
+			}
+		}
+
+		if (bestAxisType == AxisType::Edge) {
+			// Edge-edge Contact between the edges of each box furthest in
+			// the direction of the other box
+			glm::vec3 edgeCenter1 = boxData1.center, edgeCenter2 = boxData2.center;
+			for (int k = 0; k < 3; ++k) {
+				if (k != bestAxis1) {
+					float sign = (glm::dot(boxData1.axes[k], bestNormal) >= 0.0f)? 1.0f : -1.0f;
+					edgeCenter1 += sign * boxData1.halfLengths[k] * boxData1.axes[k];
+				}
+				if (k != bestAxis2) {
+					float sign = (glm::dot(boxData2.axes[k], bestNormal) >= 0.0f)? 1.0f : -1.0f;
+					edgeCenter2 -= sign * boxData2.halfLengths[k] * boxData2.axes[k];
+				}
+			}
+
+			glm::vec3 edgeHalf1 = boxData1.halfLengths[bestAxis1] * boxData1.axes[bestAxis1];
+			glm::vec3 edgeHalf2 = boxData2.halfLengths[bestAxis2] * boxData2.axes[bestAxis2];
+
+			Contact& contact = contacts.emplace_back();
+			contact.normal = bestNormal;
+			contact.penetration = minPenetration;
+			getClosestPoints(
+				Segment{ edgeCenter1 - edgeHalf1, edgeCenter1 + edgeHalf1 },
+				Segment{ edgeCenter2 - edgeHalf2, edgeCenter2 + edgeHalf2 },
+				contact.worldPosition[0], contact.worldPosition[1]
+			);
+		}
+		else if (contacts.empty()) {
+			// Fallback to the Contact at the deepest vertex of the second box
+			Contact& contact = contacts.emplace_back();
+			contact.normal = bestNormal;
+			contact.penetration = minPenetration;
+			contact.worldPosition[1] = boxData2.center;
+			for (int k = 0; k < 3; ++k) {
+				float sign = (glm::dot(boxData2.axes[k], bestNormal) >= 0.0f)? -1.0f : 1.0f;
+				contact.worldPosition[1] += sign * boxData2.halfLengths[k] * boxData2.axes[k];
+			}
+			contact.worldPosition[0] = contact.worldPosition[1] + minPenetration * bestNormal;
+		}
+
+		setLocalPositions(box1, box2, contacts);
+		return true;
+	}
+
+// Private functions
+	bool AnalyticCollisionDetector::calculateSphereContact(
+		const glm::vec3& center1, float radius1,
+		const glm::vec3& center2, float radius2,
+		Contact& contact
+	) const
+	{
+		glm::vec3 v = center2 - center1;
+		float distance2 = glm::dot(v, v);
+		float radiusSum = radius1 + radius2;
+		if (distance2 > radiusSum * radiusSum) {
+			return false;
+		}
+
+		float distance = std::sqrt(distance2);
+		contact.normal = (distance > mEpsilon)? v / distance : glm::vec3(0.0f, 1.0f, 0.0f);
+		contact.penetration = radiusSum - distance;
+		contact.worldPosition[0] = center1 + radius1 * contact.normal;
+		contact.worldPosition[1] = center2 - radius2 * contact.normal;
+		return true;
+	}
+
+
+	void AnalyticCollisionDetector::getClosestPoints(
+		const Segment& segment1, const Segment& segment2,
+		glm::vec3& closest1, glm::vec3& closest2
+	) const
+	{
+		glm::vec3 d1 = segment1.p2 - segment1.p1, d2 = segment2.p2 - segment2.p1;
+		glm::vec3 r = segment1.p1 - segment2.p1;
+		float a = glm::dot(d1, d1), e = glm::dot(d2, d2), f = glm::dot(d2, r);
+
+		float s = 0.0f, t = 0.0f;
+		if ((a <= mEpsilon) && (e <= mEpsilon)) {
+			// Both segments are points
+		}
+		else if (a <= mEpsilon) {
+			t = std::clamp(f / e, 0.0f, 1.0f);
+		}
+		else {
+			float c = glm::dot(d1, r);
+			if (e <= mEpsilon) {
+				s = std::clamp(-c / a, 0.0f, 1.0f);
+			}
+			else {
+				// If the segments are parallel any s is valid, so 0 is used
+				float b = glm::dot(d1, d2);
+				float denominator = a * e - b * b;
+				if (denominator > 0.0f) {
+					s = std::clamp((b * f - c * e) / denominator, 0.0f, 1.0f);
+				}
+
+				t = (b * s + f) / e;
+				if (t < 0.0f) {
+					t = 0.0f;
+					s = std::clamp(-c / a, 0.0f, 1.0f);
+				}
+				else if (t > 1.0f) {
+					t = 1.0f;
+					s = std::clamp((b - c) / a, 0.0f, 1.0f);
+				}
+			}
+		}
+
+		closest1 = segment1.p1 + s * d1;
+		closest2 = segment2.p1 + t * d2;
+	}
+
+
+	float AnalyticCollisionDetector::getClosestPoints(
+		const Segment& segment, const Box& box,
+		glm::vec3& closest1, glm::vec3& closest2
+	) const
+	{
+		// Check if the segment intersects the box by clipping it against the
+		// slabs of each axis
+		glm::vec3 direction = segment.p2 - segment.p1;
+		float tMin = 0.0f, tMax = 1.0f;
+		for (int i = 0; (i < 3) && (tMin <= tMax); ++i) {
+			float origin = glm::dot(segment.p1 - box.center, box.axes[i]);
+			float projection = glm::dot(direction, box.axes[i]);
+			if (std::abs(projection) <= mEpsilon) {
+				if (std::abs(origin) > box.halfLengths[i]) {
+					tMin = 1.0f;
+					tMax = 0.0f;
+				}
+			}
+			else {
+				float t1 = (-box.halfLengths[i] - origin) / projection;
+				float t2 = ( box.halfLengths[i] - origin) / projection;
+				tMin = std::max(tMin, std::min(t1, t2));
+				tMax = std::min(tMax, std::max(t1, t2));
+			}
+		}
+
+		if (tMin <= tMax) {
+			closest1 = closest2 = segment.p1 + (0.5f * (tMin + tMax)) * direction;
+			return 0.0f;
+		}
+
+		// Otherwise the closest points are located at the end points of the
+		// segment or at the edges of the box
+		float minDistance2 = std::numeric_limits<float>::max();
+		auto checkPoints = [&](const glm::vec3& point1, const glm::vec3& point2) {
+			glm::vec3 v = point2 - point1;
+			float distance2 = glm::dot(v, v);
+			if (distance2 < minDistance2) {
+				closest1 = point1;
+				closest2 = point2;
+				minDistance2 = distance2;
+			}
+		};
+
+		checkPoints(segment.p1, getClosestPoint(segment.p1, box));
+		checkPoints(segment.p2, getClosestPoint(segment.p2, box));
+
+		for (int i = 0; i < 3; ++i) {
+			int j = (i + 1) % 3, k = (i + 2) % 3;
+			glm::vec3 edgeHalf = box.halfLengths[i] * box.axes[i];
+			for (float signJ : { -1.0f, 1.0f }) {
+				for (float signK : { -1.0f, 1.0f }) {
+					glm::vec3 edgeCenter = box.center
+						+ signJ * box.halfLengths[j] * box.axes[j]
+						+ signK * box.halfLengths[k] * box.axes[k];
+
+					glm::vec3 point1, point2;
+					getClosestPoints(segment, Segment{ edgeCenter - edgeHalf, edgeCenter + edgeHalf }, point1, point2);
+					checkPoints(point1, point2);
+				}
+			}
+		}
+
+		return minDistance2;
+	}
+
+
+	void AnalyticCollisionDetector::clipSegmentWithFace(
+		const Segment& segment, float radius,
+		const Box& box, int iAxis, const glm::vec3& normal,
+		ContactVector& contacts
+	) const
+	{
+		// Clip the segment against the sides of the face
+		glm::vec3 direction = segment.p2 - segment.p1;
+		float tMin = 0.0f, tMax = 1.0f;
+		for (int i : { (iAxis + 1) % 3, (iAxis + 2) % 3 }) {
+			float origin = glm::dot(segment.p1 - box.center, box.axes[i]);
+			float projection = glm::dot(direction, box.axes[i]);
+			if (std::abs(projection) <= mEpsilon) {
+				if (std::abs(origin) > box.halfLengths[i]) {
+					return;
+				}
+			}
+			else {
+				float t1 = (-box.halfLengths[i] - origin) / projection;
+				float t2 = ( box.halfLengths[i] - origin) / projection;
+				tMin = std::max(tMin, std::min(t1, t2));
+				tMax = std::min(tMax, std::max(t1, t2));
+			}
+		}
+
+		if (tMin > tMax) {
+			return;
+		}
+
+		// Add a Contact at each end of the clipped segment that is below the
+		// face
+		float faceDistance = glm::dot(box.center, normal) + box.halfLengths[iAxis];
+		bool singlePoint = ((tMax - tMin) * glm::length(direction) <= mEpsilon);
+		for (float t : { tMin, tMax }) {
+			glm::vec3 point = segment.p1 + t * direction - radius * normal;
+			float penetration = faceDistance - glm::dot(point, normal);
+			if (penetration >= 0.0f) {
+				Contact& contact = contacts.emplace_back();
+				contact.normal = -normal;
+				contact.penetration = penetration;
+				contact.worldPosition[0] = point;
+				contact.worldPosition[1] = point + penetration * normal;
+			}
+
+			if (singlePoint) {
+				break;
+			}
+		}
+	}
+
+
+	void AnalyticCollisionDetector::clipBoxFaces(
+		const Box& reference, const Box& incident,
+		int iAxis, const glm::vec3& normal,
+		ContactVector& contacts
+	) const
+	{
+		using Polygon = utils::FixedVector<glm::vec3, 8>;
+
+		// Search the face of the incident box most antiparallel to the
+		// reference face
+		int iIncidentAxis = 0;
+		float maxProjection = 0.0f;
+		for (int i = 0; i < 3; ++i) {
+			float projection = glm::dot(incident.axes[i], normal);
+			if (std::abs(projection) > std::abs(maxProjection)) {
+				iIncidentAxis = i;
+				maxProjection = projection;
+			}
+		}
+
+		float incidentSign = (maxProjection > 0.0f)? -1.0f : 1.0f;
+		glm::vec3 incidentCenter = incident.center
+			+ incidentSign * incident.halfLengths[iIncidentAxis] * incident.axes[iIncidentAxis];
+		int iU = (iIncidentAxis + 1) % 3, iV = (iIncidentAxis + 2) % 3;
+		glm::vec3 u = incident.halfLengths[iU] * incident.axes[iU];
+		glm::vec3 v = incident.halfLengths[iV] * incident.axes[iV];
+
+		Polygon polygon = { incidentCenter + u + v, incidentCenter - u + v, incidentCenter - u - v, incidentCenter + u - v };
+
+		// Clip the incident face against the side planes of the reference
+		// face with the Sutherland-Hodgman algorithm
+		for (int i : { (iAxis + 1) % 3, (iAxis + 2) % 3 }) {
+			for (float sign : { -1.0f, 1.0f }) {
+				glm::vec3 planeNormal = sign * reference.axes[i];
+				float planeDistance = glm::dot(reference.center, planeNormal) + reference.halfLengths[i];
+
+				Polygon clipped;
+				for (std::size_t j = 0; j < polygon.size(); ++j) {
+					const glm::vec3& p1 = polygon[j];
+					const glm::vec3& p2 = polygon[(j + 1) % polygon.size()];
+					float distance1 = glm::dot(p1, planeNormal) - planeDistance;
+					float distance2 = glm::dot(p2, planeNormal) - planeDistance;
+
+					if (distance1 <= 0.0f) {
+						clipped.push_back(p1);
+					}
+					if ((distance1 < 0.0f && distance2 > 0.0f) || (distance1 > 0.0f && distance2 < 0.0f)) {
+						clipped.push_back(p1 + (distance1 / (distance1 - distance2)) * (p2 - p1));
+					}
+				}
+
+				polygon = clipped;
+			}
+		}
+
+		// Keep the points below the reference face
+		utils::FixedVector<Contact, 8> candidates;
+		float faceDistance = glm::dot(reference.center, normal) + reference.halfLengths[iAxis];
+		for (const glm::vec3& point : polygon) {
+			float penetration = faceDistance - glm::dot(point, normal);
+			if (penetration >= 0.0f) {
+				Contact& contact = candidates.emplace_back();
+				contact.normal = normal;
+				contact.penetration = penetration;
+				contact.worldPosition[0] = point + penetration * normal;
+				contact.worldPosition[1] = point;
+			}
+		}
+
+		if (candidates.size() <= Manifold::kMaxContacts) {
+			for (const Contact& contact : candidates) {
+				contacts.push_back(contact);
+			}
+			return;
+		}
+
+		// Reduce the Contacts to the deepest one and the ones that maximize
+		// the area of the manifold
+		std::size_t selected[Manifold::kMaxContacts];
+		auto selectMax = [&](std::size_t numSelected, auto&& getValue) {
+			std::size_t iBest = 0;
+			float bestValue = -std::numeric_limits<float>::max();
+			for (std::size_t i = 0; i < candidates.size(); ++i) {
+				if (std::find(selected, selected + numSelected, i) == selected + numSelected) {
+					float value = getValue(candidates[i].worldPosition[1]);
+					if (value > bestValue) {
+						iBest = i;
+						bestValue = value;
+					}
+				}
+			}
+			selected[numSelected] = iBest;
+		};
+
+		selectMax(0, [&](const glm::vec3& point) { return faceDistance - glm::dot(point, normal); });
+		const glm::vec3 p1 = candidates[selected[0]].worldPosition[1];
+		selectMax(1, [&](const glm::vec3& point) { return glm::dot(point - p1, point - p1); });
+		const glm::vec3 p2 = candidates[selected[1]].worldPosition[1];
+		auto signedArea = [&](const glm::vec3& point) { return glm::dot(glm::cross(p2 - p1, point - p1), normal); };
+		selectMax(2, [&](const glm::vec3& point) { return std::abs(signedArea(point)); });
+		float side = (signedArea(candidates[selected[2]].worldPosition[1]) > 0.0f)? -1.0f : 1.0f;
+		selectMax(3, [&](const glm::vec3& point) { return side * signedArea(point); });
+
+		for (std::size_t i : selected) {
+			contacts.push_back(candidates[i]);
+		}
+	}
+
+
+	AnalyticCollisionDetector::Box AnalyticCollisionDetector::getBox(const BoundingBox& box)
+	{
+		glm::mat4 transforms = box.getTransforms();
+
+		Box ret;
+		ret.center = transforms[3];
+		for (int i = 0; i < 3; ++i) {
+			glm::vec3 axis = transforms[i];
+			float scale = glm::length(axis);
+			ret.axes[i] = (scale > 0.0f)? axis / scale : axis;
+			ret.halfLengths[i] = 0.5f * scale * box.getLengths()[i];
+		}
+
+		return ret;
+	}
+
+
+	AnalyticCollisionDetector::Segment AnalyticCollisionDetector::getSegment(const Capsule& capsule)
+	{
+		glm::mat4 transforms = capsule.getTransforms();
+		glm::vec3 halfHeight(0.0f, capsule.getHeight() / 2.0f, 0.0f);
+		return { transforms * glm::vec4(halfHeight, 1.0f), transforms * glm::vec4(-halfHeight, 1.0f) };
+	}
+
+
+	glm::vec3 AnalyticCollisionDetector::getClosestPoint(const glm::vec3& point, const Box& box)
+	{
+		glm::vec3 centerToPoint = point - box.center;
+		glm::vec3 ret = box.center;
+		for (int i = 0; i < 3; ++i) {
+			float distance = glm::dot(centerToPoint, box.axes[i]);
+			ret += std::clamp(distance, -box.halfLengths[i], box.halfLengths[i]) * box.axes[i];
+		}
+
+		return ret;
+	}
+
+
+	void AnalyticCollisionDetector::setLocalPositions(
+		const Collider& collider1, const Collider& collider2,
+		ContactVector& contacts
+	) {
+		glm::mat4 inverseTransforms1 = glm::inverse(collider1.getTransforms());
+		glm::mat4 inverseTransforms2 = glm::inverse(collider2.getTransforms());
+		for (Contact& contact : contacts) {
+			contact.localPosition[0] = inverseTransforms1 * glm::vec4(contact.worldPosition[0], 1.0f);
+			contact.localPosition[1] = inverseTransforms2 * glm::vec4(contact.worldPosition[1], 1.0f);
+		}
+	}
+
+}
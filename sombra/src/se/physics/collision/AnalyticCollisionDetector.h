@@ -0,0 +1,253 @@
+#ifndef ANALYTIC_COLLISION_DETECTOR_H
+#define ANALYTIC_COLLISION_DETECTOR_H
+
+#include <glm/glm.hpp>
+#include "se/physics/collision/Manifold.h"
+
+namespace se::physics {
+
+	class BoundingSphere;
+	class Capsule;
+	class BoundingBox;
+
+
+	/**
+	 * Class AnalyticCollisionDetector, it's the class used for calculating
+	 * the Contacts between BoundingSpheres, Capsules and BoundingBoxes with
+	 * closed form algorithms instead of the iterative GJK and EPA ones.
+	 *
+	 * All the functions calculate the whole set of Contacts between the
+	 * Colliders, so the Contacts of the previous updates can be discarded.
+	 * The Contacts normals point outside the first Collider, and the
+	 * Contacts positions are stored in the same order than the Colliders.
+	 *
+	 * @note	the BoundingBoxes transforms must not have shear
+	 */
+	class AnalyticCollisionDetector
+	{
+	public:		// Nested types
+		/** The Contacts calculated between two Colliders */
+		using ContactVector = utils::FixedVector<Contact, Manifold::kMaxContacts>;
+
+	private:
+		/** Holds the data of a BoundingBox in world space */
+		struct Box
+		{
+			/** The location of the center of the Box */
+			glm::vec3 center;
+
+			/** The normalized directions of the axes of the Box */
+			glm::vec3 axes[3];
+
+			/** The half of the length of the Box in each axis */
+			glm::vec3 halfLengths;
+		};
+
+		/** Holds the data of a Capsule in world space */
+		struct Segment
+		{
+			/** The first point of the Segment */
+			glm::vec3 p1;
+
+			/** The second point of the Segment */
+			glm::vec3 p2;
+		};
+
+	private:	// Attributes
+		/** The minimum cosine of the angle between two directions to treat
+		 * them as parallel */
+		static constexpr float kParallelCosine = 0.999f;
+
+		/** The minimum length of the cross product of two box edges to use it
+		 * as a separating axis */
+		static constexpr float kMinEdgeAxisLength = 0.001f;
+
+		/** The relative penetration that the face axes of the second box must
+		 * improve to be used instead of the first box ones */
+		static constexpr float kFaceAxisTolerance = 0.98f;
+
+		/** The relative penetration that the edge axes must improve to be used
+		 * instead of the face ones */
+		static constexpr float kEdgeAxisTolerance = 0.95f;
+
+		/** The precision of the comparisons of the algorithms */
+		const float mEpsilon;
+
+	public:		// Functions
+		/** Creates a new AnalyticCollisionDetector
+		 *
+		 * @param	epsilon the comparison precision of the algorithms */
+		AnalyticCollisionDetector(float epsilon) : mEpsilon(epsilon) {};
+
+		/** Calculates the Contacts between the given BoundingSpheres
+		 *
+		 * @param	sphere1 the first BoundingSphere
+		 * @param	sphere2 the second BoundingSphere
+		 * @param	contacts the vector where the Contacts will be stored
+		 * @return	true if the Colliders are intersecting, false otherwise */
+		bool collideSpheres(
+			const BoundingSphere& sphere1, const BoundingSphere& sphere2,
+			ContactVector& contacts
+		) const;
+
+		/** Calculates the Contacts between the given BoundingSphere and
+		 * Capsule
+		 *
+		 * @param	sphere the BoundingSphere, the first Collider
+		 * @param	capsule the Capsule, the second Collider
+		 * @param	contacts the vector where the Contacts will be stored
+		 * @return	true if the Colliders are intersecting, false otherwise */
+		bool collideSphereCapsule(
+			const BoundingSphere& sphere, const Capsule& capsule,
+			ContactVector& contacts
+		) const;
+
+		/** Calculates the Contacts between the given Capsules. If the
+		 * Capsules are parallel up to two Contacts are generated
+		 *
+		 * @param	capsule1 the first Capsule
+		 * @param	capsule2 the second Capsule
+		 * @param	contacts the vector where the Contacts will be stored
+		 * @return	true if the Colliders are intersecting, false otherwise */
+		bool collideCapsules(
+			const Capsule& capsule1, const Capsule& capsule2,
+			ContactVector& contacts
+		) const;
+
+		/** Calculates the Contacts between the given BoundingSphere and
+		 * BoundingBox
+		 *
+		 * @param	sphere the BoundingSphere, the first Collider
+		 * @param	box the BoundingBox, the second Collider
+		 * @param	contacts the vector where the Contacts will be stored
+		 * @return	true if the Colliders are intersecting, false otherwise */
+		bool collideSphereBox(
+			const BoundingSphere& sphere, const BoundingBox& box,
+			ContactVector& contacts
+		) const;
+
+		/** Calculates the Contacts between the given Capsule and BoundingBox.
+		 * If the Capsule lies on a face of the BoundingBox up to two Contacts
+		 * are generated
+		 *
+		 * @param	capsule the Capsule, the first Collider
+		 * @param	box the BoundingBox, the second Collider
+		 * @param	contacts the vector where the Contacts will be stored
+		 * @return	true if the Colliders are intersecting, false otherwise */
+		bool collideCapsuleBox(
+			const Capsule& capsule, const BoundingBox& box,
+			ContactVector& contacts
+		) const;
+
+		/** Calculates the Contacts between the given BoundingBoxes with the
+		 * Separating Axis Theorem. The face Contacts are calculated by
+		 * clipping the incident face against the reference one, so up to four
+		 * Contacts can be generated
+		 *
+		 * @param	box1 the first BoundingBox
+		 * @param	box2 the second BoundingBox
+		 * @param	contacts the vector where the Contacts will be stored
+		 * @return	true if the Colliders are intersecting, false otherwise */
+		bool collideBoxes(
+			const BoundingBox& box1, const BoundingBox& box2,
+			ContactVector& contacts
+		) const;
+	private:
+		/** Calculates the Contact between two spheres
+		 *
+		 * @param	center1 the center of the first sphere
+		 * @param	radius1 the radius of the first sphere
+		 * @param	center2 the center of the second sphere
+		 * @param	radius2 the radius of the second sphere
+		 * @param	contact the Contact where the result will be stored
+		 * @return	true if the spheres are intersecting, false otherwise */
+		bool calculateSphereContact(
+			const glm::vec3& center1, float radius1,
+			const glm::vec3& center2, float radius2,
+			Contact& contact
+		) const;
+
+		/** Calculates the closest points between two Segments
+		 *
+		 * @param	segment1 the first Segment
+		 * @param	segment2 the second Segment
+		 * @param	closest1 the closest point in the first Segment
+		 * @param	closest2 the closest point in the second Segment */
+		void getClosestPoints(
+			const Segment& segment1, const Segment& segment2,
+			glm::vec3& closest1, glm::vec3& closest2
+		) const;
+
+		/** Calculates the closest points between a Segment and a Box
+		 *
+		 * @param	segment the Segment
+		 * @param	box the Box
+		 * @param	closest1 the closest point in the Segment
+		 * @param	closest2 the closest point in the Box
+		 * @return	the squared distance between the closest points */
+		float getClosestPoints(
+			const Segment& segment, const Box& box,
+			glm::vec3& closest1, glm::vec3& closest2
+		) const;
+
+		/** Calculates the Contacts between a Segment and one face of a Box
+		 * by clipping the Segment against the face sides
+		 *
+		 * @param	segment the Segment
+		 * @param	radius the radius of the Capsule of the Segment
+		 * @param	box the Box
+		 * @param	iAxis the index of the axis of the Box face
+		 * @param	normal the normal of the Box face, it must point towards
+		 *			the Segment
+		 * @param	contacts the vector where the Contacts will be stored */
+		void clipSegmentWithFace(
+			const Segment& segment, float radius,
+			const Box& box, int iAxis, const glm::vec3& normal,
+			ContactVector& contacts
+		) const;
+
+		/** Calculates the Contacts between two Boxes by clipping the
+		 * incident face of the second Box against the reference face of the
+		 * first Box
+		 *
+		 * @param	reference the Box with the reference face
+		 * @param	incident the Box with the incident face
+		 * @param	iAxis the index of the axis of the reference face
+		 * @param	normal the normal of the reference face, it must point
+		 *			towards the incident Box
+		 * @param	contacts the vector where the Contacts will be stored,
+		 *			their first position is in the reference Box */
+		void clipBoxFaces(
+			const Box& reference, const Box& incident,
+			int iAxis, const glm::vec3& normal,
+			ContactVector& contacts
+		) const;
+
+		/** @return	the world space data of the given BoundingBox */
+		static Box getBox(const BoundingBox& box);
+
+		/** @return	the world space Segment of the given Capsule */
+		static Segment getSegment(const Capsule& capsule);
+
+		/** Calculates the closest point to the given one in a Box
+		 *
+		 * @param	point the point
+		 * @param	box the Box
+		 * @return	the closest point in the Box */
+		static glm::vec3 getClosestPoint(const glm::vec3& point, const Box& box);
+
+		/** Calculates the local positions of the given Contacts from their
+		 * world positions
+		 *
+		 * @param	collider1 the first Collider of the Contacts
+		 * @param	collider2 the second Collider of the Contacts
+		 * @param	contacts the Contacts to update */
+		static void setLocalPositions(
+			const Collider& collider1, const Collider& collider2,
+			ContactVector& contacts
+		);
+	};
+
+}
+
+#endif		// ANALYTIC_COLLISION_DETECTOR_H
@@ -62,11 +62,9 @@ namespace se::physics {
 		a = mTransformsMatrix * glm::vec4(a, 1.0f);
 		b = mTransformsMatrix * glm::vec4(b, 1.0f);
 
-		glm::vec3 ab = b - a;
+		// The furthest point of the segment is always one of its ends
 		glm::vec3 d = glm::normalize(direction);
-		float t = glm::dot(d, ab) / glm::dot(ab, ab);
-		t = std::clamp(t, 0.0f, 1.0f);
-		glm::vec3 c = a + t * ab;
+		glm::vec3 c = (glm::dot(d, b - a) > 0.0f)? b : a;
 
 		pointWorld = c + mRadius * d;
 		pointLocal = mInverseTransformsMatrix * glm::vec4(pointWorld, 1.0f);
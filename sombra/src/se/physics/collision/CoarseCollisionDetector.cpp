@@ -1,11 +1,17 @@
+#include <tuple>
+#include <algorithm>
 #include "se/physics/collision/CoarseCollisionDetector.h"
 #include "se/physics/collision/Collider.h"
+#include "se/utils/ThreadPool.h"
 #include "AABBAVLTree.h"
 
 namespace se::physics {
 
-	CoarseCollisionDetector::CoarseCollisionDetector(float epsilon) :
-		mEpsilon(epsilon), mAABBTree(std::make_unique<AABBAVLTree<std::size_t>>()) {}
+	CoarseCollisionDetector::CoarseCollisionDetector(
+		float epsilon, float aabbMargin, float displacementMultiplier, std::size_t rebuildInterval
+	) : mEpsilon(epsilon), mAABBMargin(aabbMargin), mDisplacementMultiplier(displacementMultiplier),
+		mRebuildInterval(rebuildInterval), mUpdatesSinceRebuild(0),
+		mAABBTree(std::make_unique<AABBAVLTree<std::size_t>>()) {}
 
 
 	CoarseCollisionDetector::~CoarseCollisionDetector() {}
@@ -13,8 +19,9 @@ namespace se::physics {
 
 	void CoarseCollisionDetector::add(Collider* collider)
 	{
-		auto itCollider = mColliders.emplace(ColliderData{ collider, 0 });
-		itCollider->nodeId = mAABBTree->addNode(collider->getAABB(), itCollider.getIndex());
+		AABB aabb = collider->getAABB();
+		auto itCollider = mColliders.emplace(ColliderData{ collider, 0, aabb });
+		itCollider->nodeId = mAABBTree->addNode(calculateFatAABB(aabb, glm::vec3(0.0f)), itCollider.getIndex());
 	}
 
 
@@ -32,29 +39,73 @@ namespace se::physics {
 			return cData.collider == collider;
 		});
 		if (itCollider != mColliders.end()) {
+			std::size_t colliderIndex = itCollider.getIndex();
+			mPairs.erase(
+				std::remove_if(mPairs.begin(), mPairs.end(), [&](const ColliderPair& pair) {
+					return (pair.colliderIndices[0] == colliderIndex) || (pair.colliderIndices[1] == colliderIndex);
+				}),
+				mPairs.end()
+			);
+
 			mAABBTree->removeNode(itCollider->nodeId);
 			mColliders.erase(itCollider);
 		}
 	}
 
 
-	void CoarseCollisionDetector::update()
+	void CoarseCollisionDetector::update(utils::ThreadPool* threadPool, std::size_t numThreads)
 	{
 		for (auto itCollider = mColliders.begin(); itCollider != mColliders.end(); ++itCollider) {
-			if (itCollider->collider->updated()) {
-				mAABBTree->removeNode(itCollider->nodeId);
-				itCollider->nodeId = mAABBTree->addNode(itCollider->collider->getAABB(), itCollider.getIndex());
+			ColliderData& cData = *itCollider;
+			if (!cData.moved && !cData.collider->updated()) {
+				continue;
+			}
+
+			cData.moved = true;
+			mMovedColliders.push_back(itCollider.getIndex());
+
+			AABB aabb = cData.collider->getAABB();
+			glm::vec3 displacement = 0.5f * ((aabb.minimum + aabb.maximum) - (cData.aabb.minimum + cData.aabb.maximum));
+			cData.aabb = aabb;
+
+			const AABB& treeAABB = mAABBTree->getNodeAABB(cData.nodeId);
+			if (!contains(treeAABB, aabb)) {
+				// The Collider has left its fat AABB, so it must be moved to
+				// another place of the tree
+				mAABBTree->updateNode(cData.nodeId, calculateFatAABB(aabb, displacement));
+			}
+			else {
+				// Shrink the fat AABB if it's too large, usually because the
+				// Collider has slowed down
+				AABB fatAABB = calculateFatAABB(aabb, displacement);
+				if (calculateArea(treeAABB) > kMaxFatAreaRatio * calculateArea(fatAABB)) {
+					mAABBTree->refitNode(cData.nodeId, fatAABB);
+				}
+			}
+		}
+
+		if (mRebuildInterval > 0) {
+			++mUpdatesSinceRebuild;
+			if (mUpdatesSinceRebuild >= mRebuildInterval) {
+				mAABBTree->rebuild();
+				mUpdatesSinceRebuild = 0;
 			}
 		}
+
+		updatePairs(threadPool, numThreads);
 	}
 
 
 	void CoarseCollisionDetector::calculateCollisions(const CollisionCallback& callback) const
 	{
 		mAABBTree->calculateAllOverlaps(mEpsilon, [&](std::size_t nodeId1, std::size_t nodeId2) {
-			std::size_t colliderIndex1 = mAABBTree->getNodeUserData(nodeId1);
-			std::size_t colliderIndex2 = mAABBTree->getNodeUserData(nodeId2);
-			callback(mColliders[colliderIndex1].collider, mColliders[colliderIndex2].collider);
+			const ColliderData& cData1 = mColliders[mAABBTree->getNodeUserData(nodeId1)];
+			const ColliderData& cData2 = mColliders[mAABBTree->getNodeUserData(nodeId2)];
+
+			// The fat AABBs overlap, but the real ones could not
+			if (overlaps(cData1.aabb, cData2.aabb, mEpsilon)) {
+				callback(cData1.collider, cData2.collider);
+			}
 		});
 	}
 
@@ -62,9 +113,151 @@ namespace se::physics {
 	void CoarseCollisionDetector::calculateIntersections(const Ray& ray, const ColliderCallback& callback) const
 	{
 		mAABBTree->calculateIntersectionsWith(ray, mEpsilon, [&](std::size_t nodeId) {
-			std::size_t colliderIndex = mAABBTree->getNodeUserData(nodeId);
-			callback(mColliders[colliderIndex].collider);
+			const ColliderData& cData = mColliders[mAABBTree->getNodeUserData(nodeId)];
+			if (intersects(cData.aabb, ray, mEpsilon)) {
+				callback(cData.collider);
+			}
 		});
 	}
 
+
+	void CoarseCollisionDetector::calculateOverlaps(const AABB& aabb, const ColliderCallback& callback) const
+	{
+		mAABBTree->calculateOverlapsWith(aabb, mEpsilon, [&](std::size_t nodeId) {
+			const ColliderData& cData = mColliders[mAABBTree->getNodeUserData(nodeId)];
+			if (overlaps(cData.aabb, aabb, mEpsilon)) {
+				callback(cData.collider);
+			}
+		});
+	}
+
+// Private functions
+	AABB CoarseCollisionDetector::calculateFatAABB(const AABB& aabb, const glm::vec3& displacement) const
+	{
+		glm::vec3 predictedDisplacement = mDisplacementMultiplier * displacement;
+
+		AABB ret;
+		ret.minimum = aabb.minimum - mAABBMargin + glm::min(predictedDisplacement, glm::vec3(0.0f));
+		ret.maximum = aabb.maximum + mAABBMargin + glm::max(predictedDisplacement, glm::vec3(0.0f));
+		return ret;
+	}
+
+
+	void CoarseCollisionDetector::updatePairs(utils::ThreadPool* threadPool, std::size_t numThreads)
+	{
+		// Remove the pairs that ended in the previous update
+		mPairs.erase(
+			std::remove_if(mPairs.begin(), mPairs.end(), [](const ColliderPair& pair) {
+				return pair.state == PairState::End;
+			}),
+			mPairs.end()
+		);
+
+		// Search the pairs of the Colliders that have moved, the AABB Tree
+		// isn't modified so it can be done in parallel. Each thread
+		// processes a contiguous range of the moved Colliders
+		std::size_t numTasks = 1;
+		if (threadPool && (numThreads > 1)) {
+			numTasks = std::clamp(mMovedColliders.size() / kMinMovedCollidersPerThread, std::size_t(1), numThreads);
+		}
+
+		mThreadPairs.resize(std::max(mThreadPairs.size(), numTasks));
+		for (std::size_t iTask = 0; iTask < numTasks; ++iTask) {
+			mThreadPairs[iTask].clear();
+		}
+
+		if (numTasks == 1) {
+			findNewPairs(0, mMovedColliders.size(), mThreadPairs[0]);
+		}
+		else {
+			std::size_t collidersPerTask = mMovedColliders.size() / numTasks;
+			std::vector<std::future<void>> taskFutures(numTasks);
+			for (std::size_t iTask = 0; iTask < numTasks; ++iTask) {
+				taskFutures[iTask] = threadPool->async([=]() {
+					std::size_t iStart = iTask * collidersPerTask;
+					std::size_t iEnd = (iTask < numTasks - 1)? (iTask + 1) * collidersPerTask : mMovedColliders.size();
+					findNewPairs(iStart, iEnd, mThreadPairs[iTask]);
+				});
+			}
+
+			for (auto& future : taskFutures) {
+				future.get();
+			}
+		}
+
+		// Every pair is found only once, so sorting them makes the result
+		// independent of the number of threads
+		mNewPairs.clear();
+		for (std::size_t iTask = 0; iTask < numTasks; ++iTask) {
+			mNewPairs.insert(mNewPairs.end(), mThreadPairs[iTask].begin(), mThreadPairs[iTask].end());
+		}
+
+		auto compare = [](const ColliderPair& pair1, const ColliderPair& pair2) {
+			return std::tie(pair1.colliderIndices[0], pair1.colliderIndices[1])
+				< std::tie(pair2.colliderIndices[0], pair2.colliderIndices[1]);
+		};
+		std::sort(mNewPairs.begin(), mNewPairs.end(), compare);
+
+		// Merge the old pairs with the new ones. The old pairs of the
+		// Colliders that have moved that weren't found again have ended
+		mMergedPairs.clear();
+		auto itOld = mPairs.begin(), itNew = mNewPairs.begin();
+		while ((itOld != mPairs.end()) || (itNew != mNewPairs.end())) {
+			if ((itNew == mNewPairs.end()) || ((itOld != mPairs.end()) && compare(*itOld, *itNew))) {
+				bool moved = mColliders[itOld->colliderIndices[0]].moved
+					|| mColliders[itOld->colliderIndices[1]].moved;
+				mMergedPairs.push_back(*itOld);
+				mMergedPairs.back().state = moved? PairState::End : PairState::Persist;
+				++itOld;
+			}
+			else if ((itOld == mPairs.end()) || compare(*itNew, *itOld)) {
+				mMergedPairs.push_back(*itNew);
+				++itNew;
+			}
+			else {
+				mMergedPairs.push_back(*itOld);
+				mMergedPairs.back().state = PairState::Persist;
+				++itOld;
+				++itNew;
+			}
+		}
+		std::swap(mPairs, mMergedPairs);
+
+		for (std::size_t colliderIndex : mMovedColliders) {
+			mColliders[colliderIndex].moved = false;
+		}
+		mMovedColliders.clear();
+	}
+
+
+	void CoarseCollisionDetector::findNewPairs(
+		std::size_t iStart, std::size_t iEnd,
+		std::vector<ColliderPair>& output
+	) const
+	{
+		// If both Colliders have moved the pair is only added by the one
+		// with the smallest index
+		for (std::size_t i = iStart; i < iEnd; ++i) {
+			std::size_t colliderIndex1 = mMovedColliders[i];
+			const ColliderData& cData1 = mColliders[colliderIndex1];
+			mAABBTree->calculateOverlapsWith(cData1.aabb, mEpsilon, [&](std::size_t nodeId) {
+				std::size_t colliderIndex2 = mAABBTree->getNodeUserData(nodeId);
+				const ColliderData& cData2 = mColliders[colliderIndex2];
+				if ((colliderIndex1 == colliderIndex2)
+					|| (cData2.moved && (colliderIndex2 < colliderIndex1))
+					|| !overlaps(cData1.aabb, cData2.aabb, mEpsilon)
+				) {
+					return;
+				}
+
+				ColliderPair& pair = output.emplace_back();
+				pair.colliderIndices[0] = std::min(colliderIndex1, colliderIndex2);
+				pair.colliderIndices[1] = std::max(colliderIndex1, colliderIndex2);
+				pair.colliders[0] = mColliders[pair.colliderIndices[0]].collider;
+				pair.colliders[1] = mColliders[pair.colliderIndices[1]].collider;
+				pair.state = PairState::Begin;
+			});
+		}
+	}
+
 }
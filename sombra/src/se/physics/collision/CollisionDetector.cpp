@@ -1,23 +1,31 @@
 #include <algorithm>
+#include <glm/gtc/matrix_transform.hpp>
 #include "se/utils/Log.h"
 #include "se/physics/RigidBodyWorld.h"
 #include "se/physics/collision/CollisionDetector.h"
+#include "se/physics/collision/BoundingBox.h"
+#include "se/physics/collision/BoundingSphere.h"
+#include "QuerySnapshot.h"
 
 namespace se::physics {
 
 	CollisionDetector::CollisionDetector(RigidBodyWorld& parentWorld) :
 		mParentWorld(parentWorld),
-		mCoarseCollisionDetector(mParentWorld.getProperties().coarseCollisionEpsilon),
+		mCoarseCollisionDetector(
+			mParentWorld.getProperties().coarseCollisionEpsilon,
+			mParentWorld.getProperties().coarseCollisionAABBMargin,
+			mParentWorld.getProperties().coarseCollisionDisplacementMultiplier,
+			mParentWorld.getProperties().coarseCollisionRebuildInterval
+		),
 		mFineCollisionDetector(
 			mParentWorld.getProperties().coarseCollisionEpsilon,
 			mParentWorld.getProperties().minFDifference, mParentWorld.getProperties().maxIterations,
 			mParentWorld.getProperties().contactPrecision, mParentWorld.getProperties().contactSeparation,
-			mParentWorld.getProperties().raycastPrecision
+			mParentWorld.getProperties().raycastPrecision, mParentWorld.getProperties().contactMatchDistance
 		)
 	{
-		mCoarseCollidersColliding.reserve(mParentWorld.getProperties().maxCollidingRBs);
+		mCoarsePairIndices.reserve(mParentWorld.getProperties().maxCollidingRBs);
 		mManifolds.reserve(mParentWorld.getProperties().maxCollidingRBs);
-		mCollidersManifoldMap.reserve(mParentWorld.getProperties().maxCollidingRBs);
 	}
 
 
@@ -31,17 +39,24 @@ namespace se::physics {
 	void CollisionDetector::removeCollider(Collider* collider)
 	{
 		std::scoped_lock lck(mMutex);
-		mCoarseCollisionDetector.remove(collider);
 
-		for (auto it = mCollidersManifoldMap.begin(); it != mCollidersManifoldMap.end();) {
-			if ((collider == it->first.first) || (collider == it->first.second)) {
-				mManifolds.erase(mManifolds.begin().setIndex(it->second));
-				it = mCollidersManifoldMap.erase(it);
-			}
-			else {
-				++it;
+		for (ColliderPair& pair : mCoarseCollisionDetector.getPairs()) {
+			if (((collider == pair.colliders[0]) || (collider == pair.colliders[1]))
+				&& (pair.userData != ColliderPair::kNoUserData)
+			) {
+				mManifolds.erase(mManifolds.begin().setIndex(pair.userData));
+				pair.userData = ColliderPair::kNoUserData;
 			}
 		}
+
+		mCoarseCollisionDetector.remove(collider);
+		mColliderCopies.erase(collider);
+
+		// The removed Collider can't be used by the scene queries
+		auto querySnapshot = std::atomic_load(&mQuerySnapshot);
+		if (querySnapshot && querySnapshot->contains(collider)) {
+			std::atomic_store(&mQuerySnapshot, std::make_shared<const QuerySnapshot>(*querySnapshot, collider));
+		}
 	}
 
 
@@ -49,19 +64,32 @@ namespace se::physics {
 	{
 		std::scoped_lock lck(mMutex);
 
-		// Clean old non intersecting Manifolds
-		for (auto it = mCollidersManifoldMap.begin(); it != mCollidersManifoldMap.end();) {
-			if (!mManifolds[it->second].state[Manifold::State::Intersecting]) {
-				mManifolds.erase( mManifolds.begin().setIndex(it->second) );
-				it = mCollidersManifoldMap.erase(it);
+		// Clean old non intersecting Manifolds. It must be done before
+		// updating the CoarseCollisionDetector because it removes the pairs
+		// that ended in the previous update
+		for (ColliderPair& pair : mCoarseCollisionDetector.getPairs()) {
+			if (pair.userData == ColliderPair::kNoUserData) {
+				continue;
+			}
+
+			Manifold& manifold = mManifolds[pair.userData];
+			if (!manifold.state[Manifold::State::Intersecting]) {
+				mManifolds.erase( mManifolds.begin().setIndex(pair.userData) );
+				pair.userData = ColliderPair::kNoUserData;
+			}
+			else if (!pair.colliders[0]->updated() && !pair.colliders[1]->updated()) {
+				// The Colliders haven't moved (usually because their
+				// RigidBodies are sleeping), so the pair is skipped by the
+				// narrow collision detection step and the Manifold is kept
+				// as it is
+				manifold.state.reset(Manifold::State::Updated);
 			}
 			else {
 				// Set the remaining Manifolds' state to not intersecting, so
 				// the state of those skipped by the coarse collision detection
 				// are also updated
-				mManifolds[it->second].state.reset(Manifold::State::Intersecting);
-				mManifolds[it->second].state.set(Manifold::State::Updated);
-				++it;
+				manifold.state.reset(Manifold::State::Intersecting);
+				manifold.state.set(Manifold::State::Updated);
 			}
 		}
 
@@ -70,13 +98,35 @@ namespace se::physics {
 
 		// Notify the ICollisionListeners
 		for (ICollisionListener* listener : mListeners) {
-			for (auto& manifold : mManifolds) {
-				listener->onCollision(manifold);
+			for (auto it = mManifolds.begin(); it != mManifolds.end(); ++it) {
+				listener->onCollision(*it, it.getIndex());
 			}
 		}
 	}
 
 
+	void CollisionDetector::updateQuerySnapshot()
+	{
+		std::vector<Collider*> colliders;
+		std::vector<QuerySnapshot::ColliderSPtr> colliderCopies;
+
+		std::scoped_lock lck(mMutex);
+		mCoarseCollisionDetector.processColliders([&](Collider* collider) {
+			// Only the Colliders updated since the last snapshot are copied
+			// again, the rest share their copies with it
+			auto& colliderCopy = mColliderCopies[collider];
+			if (!colliderCopy || collider->updated()) {
+				colliderCopy = collider->clone();
+			}
+
+			colliders.push_back(collider);
+			colliderCopies.push_back(colliderCopy);
+		});
+
+		std::atomic_store(&mQuerySnapshot, std::make_shared<const QuerySnapshot>(colliders, std::move(colliderCopies)));
+	}
+
+
 	void CollisionDetector::addListener(ICollisionListener* listener)
 	{
 		if (listener) {
@@ -126,24 +176,183 @@ namespace se::physics {
 		return { collider, rayHit };
 	}
 
+	void CollisionDetector::rayCastBatch(
+		const Ray* rays, std::size_t numRays, RayCastResult* results,
+		float maxDistance, const LayerMask& layers
+	) const {
+		auto querySnapshot = std::atomic_load(&mQuerySnapshot);
+		if (!querySnapshot) {
+			RayHit rayHit;
+			rayHit.distance = std::numeric_limits<float>::max();
+			std::fill(results, results + numRays, RayCastResult(nullptr, rayHit));
+			return;
+		}
+
+		processBatch(numRays, [&](std::size_t iStart, std::size_t iEnd) {
+			for (std::size_t i = iStart; i < iEnd; ++i) {
+				results[i] = castClosest(
+					*querySnapshot, rays[i], glm::vec3(0.0f), maxDistance, layers, nullptr,
+					[&](const Collider& collider, float) { return mFineCollisionDetector.intersects(rays[i], collider); }
+				);
+			}
+		});
+	}
+
+
+	CollisionDetector::RayCastResult CollisionDetector::shapeCastFirst(
+		const ConvexCollider& shape, const glm::vec3& direction,
+		float maxDistance, const LayerMask& layers
+	) const {
+		ShapeCast shapeCast = { &shape, direction };
+		RayCastResult result;
+		shapeCastBatch(&shapeCast, 1, &result, maxDistance, layers);
+		return result;
+	}
+
+
+	void CollisionDetector::shapeCastBatch(
+		const ShapeCast* shapeCasts, std::size_t numShapeCasts, RayCastResult* results,
+		float maxDistance, const LayerMask& layers
+	) const {
+		auto querySnapshot = std::atomic_load(&mQuerySnapshot);
+		if (!querySnapshot) {
+			RayHit rayHit;
+			rayHit.distance = std::numeric_limits<float>::max();
+			std::fill(results, results + numShapeCasts, RayCastResult(nullptr, rayHit));
+			return;
+		}
+
+		processBatch(numShapeCasts, [&](std::size_t iStart, std::size_t iEnd) {
+			for (std::size_t i = iStart; i < iEnd; ++i) {
+				// The broad phase sweeps the AABB of the shape
+				const ConvexCollider& shape = *shapeCasts[i].shape;
+				AABB shapeAABB = shape.getAABB();
+				Ray ray(0.5f * (shapeAABB.minimum + shapeAABB.maximum), shapeCasts[i].direction);
+				glm::vec3 halfExtents = 0.5f * (shapeAABB.maximum - shapeAABB.minimum);
+
+				results[i] = castClosest(
+					*querySnapshot, ray, halfExtents, maxDistance, layers, &shape,
+					[&](const Collider& collider, float currentDistance) {
+						return mFineCollisionDetector.intersects(shape, ray.direction, currentDistance, collider);
+					}
+				);
+			}
+		});
+	}
+
+	std::size_t CollisionDetector::overlapAABB(
+		const AABB& aabb, Collider** results, std::size_t maxResults,
+		const LayerMask& layers
+	) const {
+		BoundingBox box(aabb.maximum - aabb.minimum);
+		box.setTransforms(glm::translate(glm::mat4(1.0f), 0.5f * (aabb.minimum + aabb.maximum)));
+		return overlapShape(box, results, maxResults, layers);
+	}
+
+
+	std::size_t CollisionDetector::overlapSphere(
+		const glm::vec3& center, float radius,
+		Collider** results, std::size_t maxResults,
+		const LayerMask& layers
+	) const {
+		BoundingSphere sphere(radius);
+		sphere.setTransforms(glm::translate(glm::mat4(1.0f), center));
+		return overlapShape(sphere, results, maxResults, layers);
+	}
+
+
+	std::size_t CollisionDetector::overlapShape(
+		const ConvexCollider& shape,
+		Collider** results, std::size_t maxResults,
+		const LayerMask& layers
+	) const {
+		auto querySnapshot = std::atomic_load(&mQuerySnapshot);
+		if (!querySnapshot) {
+			return 0;
+		}
+
+		// The broad phase culls the Colliders with the AABB of the shape,
+		// and the narrow phase checks the exact overlaps
+		std::size_t numResults = 0;
+		AABB shapeAABB = shape.getAABB();
+		float epsilon = mParentWorld.getProperties().coarseCollisionEpsilon;
+		querySnapshot->getAABBTree().calculateOverlapsWith(shapeAABB, epsilon, [&](std::uint32_t iCollider) {
+			Collider* collider = querySnapshot->getCollider(iCollider);
+			if ((numResults < maxResults) && collider && (collider != &shape)
+				&& (querySnapshot->getLayers(iCollider) & layers).any()
+				&& overlaps(querySnapshot->getAABB(iCollider), shapeAABB, epsilon)
+				&& mFineCollisionDetector.overlaps(shape, querySnapshot->getColliderCopy(iCollider))
+			) {
+				results[numResults++] = collider;
+			}
+		});
+
+		return numResults;
+	}
+
+
+	CollisionDetector::RayCastResult CollisionDetector::calculateTimeOfImpact(
+		const ConvexCollider& collider, const glm::vec3& displacement
+	) {
+		Collider* collider2 = nullptr;
+		RayHit rayHit;
+		rayHit.distance = std::numeric_limits<float>::max();
+
+		float maxDistance = glm::length(displacement);
+		if (maxDistance == 0.0f) {
+			return { collider2, rayHit };
+		}
+
+		glm::vec3 direction = displacement / maxDistance;
+		AABB sweptAABB = collider.getAABB();
+		sweptAABB.minimum += glm::min(displacement, glm::vec3(0.0f));
+		sweptAABB.maximum += glm::max(displacement, glm::vec3(0.0f));
+
+		std::scoped_lock lck(mMutex);
+		mCoarseCollisionDetector.calculateOverlaps(sweptAABB, [&](Collider* collider3) {
+			if ((collider3 == &collider) || (collider3->getLayers() & collider.getLayers()).none()) {
+				return;
+			}
+
+			auto [intersects, rayHit3] = mFineCollisionDetector.intersects(collider, direction, maxDistance, *collider3);
+			bool separated = (rayHit3.contactNormal != glm::vec3(0.0f));
+			if (intersects && separated && (rayHit3.distance <= maxDistance)
+				&& (!collider2 || (rayHit3.distance < rayHit.distance))
+			) {
+				collider2 = collider3;
+				rayHit = rayHit3;
+			}
+		});
+
+		return { collider2, rayHit };
+	}
+
 // Private functions
 	void CollisionDetector::broadCollisionDetection()
 	{
-		mCoarseCollisionDetector.update();
-
-		// Store all the Colliders intersecting in mCoarseCollidersColliding
-		mCoarseCollidersColliding.clear();
-		mCoarseCollisionDetector.calculateCollisions([this](Collider* collider1, Collider* collider2) {
-			// Skip non updated Colliders and Colliders without any common layer
-			if ((collider1->updated() || collider2->updated())
-				&& ((collider1->getLayers() & collider2->getLayers()).any())
+		mCoarseCollisionDetector.update(&mParentWorld.getThreadPool(), mParentWorld.getProperties().numThreads);
+
+		// Store the pairs to check in mCoarsePairIndices
+		mCoarsePairIndices.clear();
+		const auto& pairs = mCoarseCollisionDetector.getPairs();
+		for (std::size_t i = 0; i < pairs.size(); ++i) {
+			// Skip the pairs that have ended, non updated Colliders and
+			// Colliders without any common layer
+			const ColliderPair& pair = pairs[i];
+			if ((pair.state != CoarseCollisionDetector::PairState::End)
+				&& (pair.colliders[0]->updated() || pair.colliders[1]->updated())
+				&& ((pair.colliders[0]->getLayers() & pair.colliders[1]->getLayers()).any())
 			) {
-				mCoarseCollidersColliding.emplace_back(collider1, collider2);
+				mCoarsePairIndices.push_back(i);
 			}
-		});
+		}
 
-		// Reset the updated state of all the Colliders
-		mCoarseCollisionDetector.processColliders([](Collider* collider) {
+		// Reset the updated state of all the Colliders. The copies of the
+		// updated ones used by the scene queries are outdated
+		mCoarseCollisionDetector.processColliders([this](Collider* collider) {
+			if (collider->updated()) {
+				mColliderCopies.erase(collider);
+			}
 			collider->resetUpdatedState();
 		});
 	}
@@ -152,42 +361,39 @@ namespace se::physics {
 	void CollisionDetector::narrowCollisionDetection()
 	{
 		// Execute singleNarrowCollision with the pairs stored in
-		// mCoarseCollidersColliding in parallel
+		// mCoarsePairIndices in parallel
 		std::size_t nThreads = mParentWorld.getProperties().numThreads;
-		std::size_t pairsPerThread = mCoarseCollidersColliding.size() / nThreads;
-		std::vector<std::future<std::vector<Manifold>>> threadFutures(nThreads);
+		std::size_t pairsPerThread = mCoarsePairIndices.size() / nThreads;
+		std::vector<std::future<std::vector<NewManifold>>> threadFutures(nThreads);
 
 		for (std::size_t iThread = 0; iThread < nThreads; ++iThread) {
 			threadFutures[iThread] = mParentWorld.getThreadPool().async([=]() {
 				std::size_t iStart = iThread * pairsPerThread;
 				std::size_t iEnd = (iThread < nThreads - 1)?
 					(iThread + 1) * pairsPerThread :
-					mCoarseCollidersColliding.size();
+					mCoarsePairIndices.size();
 
-				std::vector<Manifold> newManifolds;
+				std::vector<NewManifold> newManifolds;
 				for (std::size_t i = iStart; i < iEnd; ++i) {
-					singleNarrowCollision(mCoarseCollidersColliding[i], newManifolds);
+					singleNarrowCollision(mCoarsePairIndices[i], newManifolds);
 				}
 				return newManifolds;
 			});
 		}
 
-		// The new manifolds doesn't repeat and their colliders are
-		// already sorted
-		std::vector<Manifold> newManifolds;
+		// The new manifolds doesn't repeat and are already sorted by their
+		// pair indices
+		std::vector<NewManifold> newManifolds;
 		for (auto& future : threadFutures) {
-			std::vector<Manifold> thNewManifolds = future.get();
+			std::vector<NewManifold> thNewManifolds = future.get();
 			newManifolds.insert(newManifolds.end(), thNewManifolds.begin(), thNewManifolds.end());
 		}
 
+		auto& pairs = mCoarseCollisionDetector.getPairs();
 		for (auto& newManifold : newManifolds) {
 			if (mManifolds.size() < mManifolds.capacity()) {
-				auto itManifold = mManifolds.emplace(std::move(newManifold));
-				mCollidersManifoldMap.emplace(
-					std::piecewise_construct,
-					std::forward_as_tuple(itManifold->colliders[0], itManifold->colliders[1]),
-					std::forward_as_tuple(itManifold.getIndex())
-				);
+				auto itManifold = mManifolds.emplace(std::move(newManifold.manifold));
+				pairs[newManifold.pairIndex].userData = itManifold.getIndex();
 			}
 			else {
 				SOMBRA_ERROR_LOG << "Can't create more Manifolds";
@@ -197,28 +403,82 @@ namespace se::physics {
 	}
 
 
-	void CollisionDetector::singleNarrowCollision(const ColliderPair& pair, std::vector<Manifold>& newManifolds)
+	void CollisionDetector::singleNarrowCollision(std::size_t pairIndex, std::vector<NewManifold>& newManifolds)
 	{
-		// Find a Manifold between the colliders
-		ColliderPair sortedPair = (pair.first <= pair.second)? pair : ColliderPair(pair.second, pair.first);
-
-		auto itPairManifold = mCollidersManifoldMap.find(sortedPair);
-		if (itPairManifold != mCollidersManifoldMap.end()) {
+		const ColliderPair& pair = mCoarseCollisionDetector.getPairs()[pairIndex];
+		if (pair.userData != ColliderPair::kNoUserData) {
 			// Set the Manifold back to its old state (if we are at this
 			// stage it was Intersecting in the previous frame)
-			mManifolds[itPairManifold->second].state.set(Manifold::State::Intersecting);
-			mManifolds[itPairManifold->second].state.reset(Manifold::State::Updated);
+			Manifold& manifold = mManifolds[pair.userData];
+			manifold.state.set(Manifold::State::Intersecting);
+			manifold.state.reset(Manifold::State::Updated);
 
 			// Update the Manifold data
-			mFineCollisionDetector.collide(mManifolds[itPairManifold->second]);
+			mFineCollisionDetector.collide(manifold);
 		}
 		else {
 			// Create a new Manifold
-			Manifold manifold(sortedPair.first, sortedPair.second);
+			Manifold manifold(pair.colliders[0], pair.colliders[1]);
 			if (mFineCollisionDetector.collide(manifold)) {
-				newManifolds.push_back(std::move(manifold));
+				newManifolds.push_back({ pairIndex, std::move(manifold) });
 			}
 		}
 	}
 
+
+
+	void CollisionDetector::processBatch(std::size_t numQueries, const BatchCallback& callback) const
+	{
+		// The first chunk of queries is processed by the calling thread
+		std::size_t nThreads = std::clamp(numQueries / kMinQueriesPerThread, std::size_t(1), std::max(std::size_t(1), mParentWorld.getProperties().numThreads));
+		std::size_t queriesPerThread = numQueries / nThreads;
+		std::vector<std::future<void>> threadFutures;
+		threadFutures.reserve(nThreads - 1);
+		for (std::size_t iThread = 1; iThread < nThreads; ++iThread) {
+			std::size_t iStart = iThread * queriesPerThread;
+			std::size_t iEnd = (iThread < nThreads - 1)? (iThread + 1) * queriesPerThread : numQueries;
+			threadFutures.push_back(mParentWorld.getThreadPool().async([=, &callback]() { callback(iStart, iEnd); }));
+		}
+
+		callback(0, queriesPerThread);
+		for (auto& future : threadFutures) {
+			future.get();
+		}
+	}
+
+
+	CollisionDetector::RayCastResult CollisionDetector::castClosest(
+		const QuerySnapshot& snapshot, const Ray& ray,
+		const glm::vec3& halfExtents, float maxDistance,
+		const LayerMask& layers, const Collider* ignoredCollider,
+		const CastCallback& castCollider
+	) const {
+		Collider* collider = nullptr;
+		RayHit rayHit;
+		rayHit.distance = std::numeric_limits<float>::max();
+
+		// The Colliders are visited from the closest to the furthest one, and
+		// each hit shortens the ray so the further Colliders are skipped
+		float epsilon = mParentWorld.getProperties().coarseCollisionEpsilon;
+		snapshot.getAABBTree().calculateClosestIntersectionsWith(ray, halfExtents, epsilon, maxDistance, [&](std::uint32_t iCollider, float currentDistance) {
+			Collider* collider2 = snapshot.getCollider(iCollider);
+			if (!collider2 || (collider2 == ignoredCollider) || (snapshot.getLayers(iCollider) & layers).none()) {
+				return currentDistance;
+			}
+
+			const AABB& colliderAABB = snapshot.getAABB(iCollider);
+			if (intersects({ colliderAABB.minimum - halfExtents, colliderAABB.maximum + halfExtents }, ray, epsilon)) {
+				auto [intersects, rayHit2] = castCollider(snapshot.getColliderCopy(iCollider), currentDistance);
+				if (intersects && (rayHit2.distance <= currentDistance)) {
+					collider = collider2;
+					rayHit = rayHit2;
+					return rayHit2.distance;
+				}
+			}
+			return currentDistance;
+		});
+
+		return { collider, rayHit };
+	}
+
 }
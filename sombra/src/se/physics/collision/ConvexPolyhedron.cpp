@@ -1,6 +1,8 @@
 #include <limits>
+#include <algorithm>
 #include "se/physics/collision/HalfEdgeMeshExt.h"
 #include "se/physics/collision/ConvexPolyhedron.h"
+#include "SIMDSupport.h"
 
 namespace se::physics {
 
@@ -22,6 +24,19 @@ namespace se::physics {
 	{
 		mMesh = meshData;
 		mLocalVertices = meshData.vertices;
+
+		mVertexIndices.clear();
+		for (auto it = mLocalVertices.begin(); it != mLocalVertices.end(); ++it) {
+			mVertexIndices.push_back(it.getIndex());
+		}
+		if (!mVertexIndices.empty()) {
+			std::size_t numPaddedVertices = kSupportPointsPadding * ((mVertexIndices.size() + kSupportPointsPadding - 1) / kSupportPointsPadding);
+			mVertexIndices.resize(numPaddedVertices, mVertexIndices.front());
+		}
+		mVertexXs.resize(mVertexIndices.size());
+		mVertexYs.resize(mVertexIndices.size());
+		mVertexZs.resize(mVertexIndices.size());
+
 		setTransforms(mTransformsMatrix);
 	}
 
@@ -35,6 +50,13 @@ namespace se::physics {
 			vertex.location = mTransformsMatrix * glm::vec4(vertex.location, 1.0);
 		}
 
+		for (std::size_t i = 0; i < mVertexIndices.size(); ++i) {
+			const glm::vec3& location = mMesh.vertices[mVertexIndices[i]].location;
+			mVertexXs[i] = location.x;
+			mVertexYs[i] = location.y;
+			mVertexZs[i] = location.z;
+		}
+
 		mUpdated = true;
 	}
 
@@ -50,10 +72,51 @@ namespace se::physics {
 		glm::vec3& pointWorld, glm::vec3& pointLocal
 	) const
 	{
-		int iVertex = getFurthestVertexInDirection(mMesh, direction);
+		if (mVertexIndices.empty()) {
+			// An empty ConvexPolyhedron is handled as a point in its origin
+			pointWorld = mTransformsMatrix[3];
+			pointLocal = glm::vec3(0.0f);
+			return;
+		}
 
+		std::size_t i = getFurthestPoint(
+			mVertexXs.data(), mVertexYs.data(), mVertexZs.data(), mVertexIndices.size(),
+			direction
+		);
+
+		int iVertex = mVertexIndices[i];
 		pointWorld = mMesh.vertices[iVertex].location;
 		pointLocal = mLocalVertices[iVertex].location;
 	}
 
+
+	void ConvexPolyhedron::getFurthestPointsInDirections(
+		const glm::vec3* directions, std::size_t numDirections,
+		glm::vec3* pointsWorld, glm::vec3* pointsLocal
+	) const
+	{
+		static constexpr std::size_t kMaxDirections = 8;
+
+		if (mVertexIndices.empty()) {
+			std::fill(pointsWorld, pointsWorld + numDirections, glm::vec3(mTransformsMatrix[3]));
+			std::fill(pointsLocal, pointsLocal + numDirections, glm::vec3(0.0f));
+			return;
+		}
+
+		std::size_t indices[kMaxDirections];
+		for (std::size_t i = 0; i < numDirections; i += kMaxDirections) {
+			std::size_t batchSize = std::min(kMaxDirections, numDirections - i);
+			getFurthestPoints(
+				mVertexXs.data(), mVertexYs.data(), mVertexZs.data(), mVertexIndices.size(),
+				directions + i, batchSize, indices
+			);
+
+			for (std::size_t j = 0; j < batchSize; ++j) {
+				int iVertex = mVertexIndices[indices[j]];
+				pointsWorld[i + j] = mMesh.vertices[iVertex].location;
+				pointsLocal[i + j] = mLocalVertices[iVertex].location;
+			}
+		}
+	}
+
 }
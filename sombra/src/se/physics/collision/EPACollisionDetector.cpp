@@ -4,7 +4,6 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include "se/physics/collision/Contact.h"
 #include "se/physics/collision/ConvexCollider.h"
-#include "se/physics/collision/HalfEdgeMeshExt.h"
 #include "se/physics/collision/FineCollisionDetector.h"
 #include "EPACollisionDetector.h"
 
@@ -37,13 +36,15 @@ namespace se::physics {
 		}
 		else if (simplex.size() > 1) {
 			// Create the initial polytope to expand from the simplex points
-			Polytope polytope = createInitialPolytope(collider1, collider2, simplex);
+			// in the scratch Polytope of the current thread
+			thread_local Polytope polytope;
+			createInitialPolytope(collider1, collider2, simplex, polytope);
 
 			// Calculate the closest face to the origin
-			int iClosestFace = expandPolytope(collider1, collider2, polytope);
-			if (iClosestFace >= 0) {
+			Polytope::Face closestFace;
+			if (expandPolytope(collider1, collider2, polytope, closestFace)) {
 				// Fill the Contact data with the closest face of the Polytope
-				ret.second = calculateContactData(polytope, iClosestFace);
+				ret.second = calculateContactData(polytope, closestFace);
 				ret.first = true;
 			}
 		}
@@ -52,9 +53,9 @@ namespace se::physics {
 	}
 
 // Private functions
-	Polytope EPACollisionDetector::createInitialPolytope(
+	void EPACollisionDetector::createInitialPolytope(
 		const ConvexCollider& collider1, const ConvexCollider& collider2,
-		Simplex& simplex
+		Simplex& simplex, Polytope& polytope
 	) const
 	{
 		if (simplex.size() == 2) {
@@ -64,7 +65,7 @@ namespace se::physics {
 			tetrahedronFromTriangle(collider1, collider2, simplex);
 		}
 
-		return Polytope(simplex, mProjectionPrecision);
+		polytope.reset(simplex, mProjectionPrecision);
 	}
 
 
@@ -89,11 +90,13 @@ namespace se::physics {
 		// 3. Calculate 3 new points around the vector v01 by rotating vNormal
 		// 2*pi/3 radians around v01
 		glm::mat3 rotate2Pi3 = glm::mat3(glm::rotate(glm::mat4(1.0f), 2.0f * glm::pi<float>() / 3.0f, v01));
-		glm::vec3 searchDir = vNormal;
-		for (int i = 0; i < 3; ++i) {
-			vertices.emplace_back(collider1, collider2, searchDir);
-			searchDir = rotate2Pi3 * searchDir;
-		}
+		glm::vec3 searchDirs[3];
+		searchDirs[0] = vNormal;
+		searchDirs[1] = rotate2Pi3 * searchDirs[0];
+		searchDirs[2] = rotate2Pi3 * searchDirs[1];
+
+		vertices.resize(3);
+		calculateSupportPoints(collider1, collider2, searchDirs, 3, vertices.data());
 
 		// 4. The fourth point of the polytope must be either simplex[0] or
 		// simplex[1], we select the one that creates a tetrahedron with the
@@ -124,180 +127,99 @@ namespace se::physics {
 		glm::vec3 v02 = simplex[2].getCSOPosition() - simplex[0].getCSOPosition();
 		glm::vec3 tNormal = glm::cross(v01, v02);
 
-		SupportPoint sp1(collider1, collider2, tNormal);
-		SupportPoint sp2(collider1, collider2,-tNormal);
+		glm::vec3 searchDirs[2] = { tNormal, -tNormal };
+		SupportPoint sps[2];
+		calculateSupportPoints(collider1, collider2, searchDirs, 2, sps);
+		const SupportPoint &sp1 = sps[0], &sp2 = sps[1];
 
-		simplex = { simplex[0], simplex[1], sp1, sp2 };
+		Simplex triangle = simplex;
+		simplex = { triangle[0], triangle[1], sp1, sp2 };
 		if (!isOriginInside(simplex, mProjectionPrecision)) {
-			simplex = { simplex[1], simplex[2], sp1, sp2 };
+			simplex = { triangle[1], triangle[2], sp1, sp2 };
 
 			if (!isOriginInside(simplex, mProjectionPrecision)) {
-				simplex = { simplex[2], simplex[0], sp1, sp2 };
+				simplex = { triangle[2], triangle[0], sp1, sp2 };
 			}
 		}
 	}
 
 
-	int EPACollisionDetector::expandPolytope(
+	bool EPACollisionDetector::expandPolytope(
 		const ConvexCollider& collider1, const ConvexCollider& collider2,
-		Polytope& polytope
-	) {
-		auto compareDistances = [&](int iF1, int iF2) {
-			return (polytope.getDistanceData(iF1).distance > polytope.getDistanceData(iF2).distance);
-		};
-
-		// Store the HEFace indices in a vector ordered by their distance to
-		// the origin
-		const HalfEdgeMesh& meshData = polytope.getMesh();
-		std::vector<int> facesByDistance;
-		facesByDistance.reserve(meshData.faces.size());
-		for (auto itFace = meshData.faces.begin(); itFace != meshData.faces.end(); ++itFace) {
-			if (polytope.getDistanceData(itFace.getIndex()).inside) {
-				facesByDistance.insert(
-					std::lower_bound(facesByDistance.begin(), facesByDistance.end(), itFace.getIndex(), compareDistances),
-					itFace.getIndex()
-				);
-			}
-		}
-
+		Polytope& polytope, Polytope::Face& closestFace
+	) const
+	{
 		// Check if there is no polytope face with its closest point to the
 		// origin inside
-		if (facesByDistance.empty()) {
-			return -1;
+		int iCurrentFace = polytope.popClosestFace();
+		if (iCurrentFace < 0) {
+			return false;
 		}
 
-		// Check if the closest HEFace to the origin is already touching it
-		int iCurrentFace = facesByDistance.back();
-		glm::vec3 currentFaceNormal = polytope.getNormal(iCurrentFace);
-		FaceDistanceData currentFaceDistance = polytope.getDistanceData(iCurrentFace);
-		facesByDistance.pop_back();
-		if (currentFaceDistance.distance == 0.0f) {
-			return iCurrentFace;
+		// Check if the closest Face to the origin is already touching it
+		closestFace = polytope.getFace(iCurrentFace);
+		if (closestFace.distanceData.distance == 0.0f) {
+			return true;
 		}
 
-		// Expand the polytope until the closest HEFace is found
+		// Expand the polytope until the closest Face is found. The closest
+		// Face is copied because it can be removed in the next expansions
 		std::size_t iteration = 0;
-		int iClosestFace = -1;
 		float closestSeparation = std::numeric_limits<float>::max();
-		std::vector<int> overlappingFaces, horizon, facesToRemove;
-		utils::FixedVector<int, 3> closestFaceIndices;
+		float currentDistance = 0.0f;
 		do {
-			// 1. Search a new SupportPoint along the HEFace's closest point
-			// direction
-			SupportPoint sp(collider1, collider2, currentFaceNormal);
+			const Polytope::Face& currentFace = polytope.getFace(iCurrentFace);
+			currentDistance = currentFace.distanceData.distance;
 
-			// 2. Update the closest HEFace
-			float currentSeparation = glm::dot(sp.getCSOPosition(), currentFaceNormal);
+			// 1. Search a new SupportPoint along the Face's normal direction
+			SupportPoint sp(collider1, collider2, currentFace.normal);
+
+			// 2. Update the closest Face
+			float currentSeparation = glm::dot(sp.getCSOPosition(), currentFace.normal);
 			if (currentSeparation < closestSeparation) {
-				iClosestFace = iCurrentFace;
+				closestFace = currentFace;
 				closestSeparation = currentSeparation;
 			}
 
-			// 3. If the current HEFace is closer to the origin than the closest
-			// one then we expand the polytope
-			if (closestSeparation - currentFaceDistance.distance > mMinFThreshold) {
-				// 3.1 Add the SupportPoint to the Polytope
-				int iSp = polytope.addVertex(sp);
-
-				// 3.2. Calculate the horizon HEEdges and HEFaces to remove
-				// from the current eyePoint perspective
-				horizon.clear();
-				facesToRemove.clear();
-				calculateHorizon(meshData, polytope.getNormals(), sp.getCSOPosition(), iCurrentFace, horizon, facesToRemove);
-
-				// 3.3. Remove all the HEFaces that can be seen from the new
-				// SupportPoint
-				for (int iFaceToRemove : facesToRemove) {
-					// If we are going to remove the closest HEFace then we
-					// store its indices for recoving it later if necessary
-					if (iClosestFace == iFaceToRemove) {
-						closestFaceIndices.clear();
-						getFaceIndices(polytope.getMesh(), iClosestFace, std::back_inserter(closestFaceIndices));
-						iClosestFace = -1;
-						overlappingFaces.clear();
-					}
-
-					polytope.removeFace(iFaceToRemove);
-					facesByDistance.erase(
-						std::remove(facesByDistance.begin(), facesByDistance.end(), iFaceToRemove),
-						facesByDistance.end()
-					);
-				}
-
-				// 3.4. Add new HEFaces to the Polytope by connecting the
-				// HEEdges of the horizon to the new SupportPoint
-				for (int iHorizonEdge : horizon) {
-					const HEEdge& currentEdge = meshData.edges[iHorizonEdge];
-					const HEEdge& oppositeEdge = meshData.edges[currentEdge.oppositeEdge];
-
-					// Add the HEFace
-					int iV0 = oppositeEdge.vertex, iV1 = currentEdge.vertex;
-					int iNewFace = polytope.addFace({ iV0, iV1, iSp });
-
-					// Store the HEFace index if we removed the closest HEFace
-					if (iClosestFace < 0) {
-						overlappingFaces.push_back(iNewFace);
-					}
-
-					// Add the HEFace to the facesByDistance vector if its
-					// closest point is an internal point
-					if (polytope.getDistanceData(iNewFace).inside) {
-						facesByDistance.insert(
-							std::lower_bound(facesByDistance.begin(), facesByDistance.end(), iNewFace, compareDistances),
-							iNewFace
-						);
-					}
-				}
+			// 3. If the current Face is closer to the origin than the closest
+			// one then we expand the polytope. If there is no space left we
+			// stop with the closest Face found
+			if ((closestSeparation - currentDistance > mMinFThreshold)
+				&& !polytope.expand(sp, iCurrentFace)
+			) {
+				break;
 			}
 
-			// Check if there are more HEFaces to evaluate
-			if (!facesByDistance.empty()) {
-				// Get the next HEFace
-				iCurrentFace = facesByDistance.back();
-				currentFaceNormal = polytope.getNormal(iCurrentFace);
-				currentFaceDistance = polytope.getDistanceData(iCurrentFace);
-				facesByDistance.pop_back();
+			// Get the next Face
+			iCurrentFace = polytope.popClosestFace();
+			if (iCurrentFace >= 0) {
+				currentDistance = polytope.getFace(iCurrentFace).distanceData.distance;
 			}
 
 			++iteration;
 		}
-		while (!facesByDistance.empty()
-			&& (closestSeparation - currentFaceDistance.distance > mMinFThreshold)
+		while ((iCurrentFace >= 0)
+			&& (closestSeparation - currentDistance > mMinFThreshold)
 			&& (iteration < mMaxIterations)
 		);
 
-		// If we removed the closest HEFace then we have to recover it
-		if (iClosestFace < 0) {
-			for (int iFace : overlappingFaces) {
-				polytope.removeFace(iFace);
-			}
-			iClosestFace = polytope.addFace(closestFaceIndices);
-		}
-
-		return iClosestFace;
+		return true;
 	}
 
 
-	Contact EPACollisionDetector::calculateContactData(const Polytope& polytope, int iClosestFace) const
+	Contact EPACollisionDetector::calculateContactData(
+		const Polytope& polytope, const Polytope::Face& closestFace
+	) const
 	{
 		Contact ret;
 
-		const HalfEdgeMesh& meshData = polytope.getMesh();
-		glm::vec3 faceNormal = polytope.getNormal(iClosestFace);
-		FaceDistanceData faceDistance = polytope.getDistanceData(iClosestFace);
-
-		const HEEdge& edge1		= meshData.edges[meshData.faces[iClosestFace].edge];
-		const SupportPoint& sp2	= polytope.getSupportPoint(edge1.vertex);
-
-		const HEEdge& edge2		= meshData.edges[edge1.nextEdge];
-		const SupportPoint& sp3	= polytope.getSupportPoint(edge2.vertex);
-
-		const HEEdge& edge3		= meshData.edges[edge2.nextEdge];
-		const SupportPoint& sp1	= polytope.getSupportPoint(edge3.vertex);
+		const SupportPoint& sp1 = polytope.getSupportPoint(closestFace.vertices[0]);
+		const SupportPoint& sp2 = polytope.getSupportPoint(closestFace.vertices[1]);
+		const SupportPoint& sp3 = polytope.getSupportPoint(closestFace.vertices[2]);
 
-		const glm::vec3& originBarycentricCoords = faceDistance.closestPointBarycentricCoords;
-		ret.penetration = faceDistance.distance;
-		ret.normal = faceNormal;
+		const glm::vec3& originBarycentricCoords = closestFace.distanceData.closestPointBarycentricCoords;
+		ret.penetration = closestFace.distanceData.distance;
+		ret.normal = closestFace.normal;
 		for (int i = 0; i < 2; ++i) {
 			ret.worldPosition[i] = originBarycentricCoords.x * sp1.getWorldPosition(i)
 				+ originBarycentricCoords.y * sp2.getWorldPosition(i)
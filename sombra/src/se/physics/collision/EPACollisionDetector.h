@@ -14,6 +14,8 @@ namespace se::physics {
 	 * Class EPACollisionDetector, it's the class used to calculate the
 	 * Contact coordinates, normal and penetration from the given simplex
 	 * polytopes with Expanding Polytope Algorithm.
+	 * The Polytope is expanded in a fixed capacity scratch memory owned by
+	 * each thread, so the algorithm doesn't do any allocation.
 	 */
 	class EPACollisionDetector
 	{
@@ -23,7 +25,8 @@ namespace se::physics {
 		 * needed for checking if we found the closest face to the origin */
 		const float mMinFThreshold;
 
-		/** The maximum number of iteration of the GJK algorithm */
+		/** The maximum number of iterations of the EPA algorithm. It's also
+		 * limited by the capacity of the Polytope */
 		const std::size_t mMaxIterations;
 
 		/** The precision of the projected point onto a triangle */
@@ -42,7 +45,9 @@ namespace se::physics {
 		);
 
 		/** Calculates the deepest Contact point between the given colliders
-		 * using the EPA algorithm
+		 * using the EPA algorithm. If the iterations or the Polytope capacity
+		 * are exhausted before finding the closest face to the origin, the
+		 * Contact is calculated with the closest face found until then
 		 *
 		 * @param	collider1 the first of the ConvexColliders that are
 		 *			intersecting
@@ -63,12 +68,13 @@ namespace se::physics {
 		 * @param	collider2 the second of the ConvexColliders that are
 		 *			intersecting
 		 * @param	simplex the points of the initial simplex
-		 * @return	the polytope
+		 * @param	polytope the Polytope where the initial polytope will be
+		 *			stored
 		 * @note	if the given simplex is an edge or a triangle it will be
 		 *			expanded to a tetrahedron */
-		Polytope createInitialPolytope(
+		void createInitialPolytope(
 			const ConvexCollider& collider1, const ConvexCollider& collider2,
-			Simplex& simplex
+			Simplex& simplex, Polytope& polytope
 		) const;
 
 		/** Expands the given edge simplex to a tetrahedron
@@ -107,13 +113,15 @@ namespace se::physics {
 		 * @param	collider2 the second of the ConvexColliders that are
 		 *			intersecting
 		 * @param	polytope a reference to the Polytope to expand its faces
-		 * @return	the index of the closest face if the polytope was expanded
-		 *			successfully, -1 otherwise
+		 * @param	closestFace the Face where the closest face to the origin
+		 *			will be stored
+		 * @return	true if the closest face was found, false if none of the
+		 *			polytope faces contains the projection of the origin
 		 * @note	the initial polytope must be a tetrahedron */
-		int expandPolytope(
+		bool expandPolytope(
 			const ConvexCollider& collider1, const ConvexCollider& collider2,
-			Polytope& polytope
-		);
+			Polytope& polytope, Polytope::Face& closestFace
+		) const;
 
 		/** Calculates the Contact data with the normal of closest face in the
 		 * Polytope to the origin, and the distance and coordinates of the
@@ -121,10 +129,10 @@ namespace se::physics {
 		 *
 		 * @param	polytope the Polytope with which we want to fill the Contact
 		 *			data
-		 * @param	iClosestFace the index of the closest face in the Polytope
+		 * @param	closestFace the closest face in the Polytope
 		 * @return	the Contact data */
 		Contact calculateContactData(
-			const Polytope& polytope, int iClosestFace
+			const Polytope& polytope, const Polytope::Face& closestFace
 		) const;
 	};
 
@@ -5,22 +5,68 @@
 #include "se/physics/collision/Collider.h"
 #include "se/physics/collision/ConvexCollider.h"
 #include "se/physics/collision/ConcaveCollider.h"
+#include "se/physics/collision/BoundingSphere.h"
+#include "se/physics/collision/Capsule.h"
+#include "se/physics/collision/BoundingBox.h"
 #include "se/physics/collision/FineCollisionDetector.h"
 #include "GJKCollisionDetector.h"
 #include "EPACollisionDetector.h"
 #include "GJKRayCaster.h"
+#include "AnalyticCollisionDetector.h"
 
 namespace se::physics {
 
+	using ACD = AnalyticCollisionDetector;
+	const FineCollisionDetector::CollideFunctionTable FineCollisionDetector::kCollideFunctions = {{
+		{{	// BoundingSphere
+			&FineCollisionDetector::dispatchAnalytic<BoundingSphere, BoundingSphere, &ACD::collideSpheres, false>,
+			&FineCollisionDetector::dispatchAnalytic<BoundingSphere, Capsule, &ACD::collideSphereCapsule, false>,
+			&FineCollisionDetector::dispatchAnalytic<BoundingSphere, BoundingBox, &ACD::collideSphereBox, false>,
+			&FineCollisionDetector::dispatchConvexConvex,
+			&FineCollisionDetector::dispatchConvexConcave
+		}},
+		{{	// Capsule
+			&FineCollisionDetector::dispatchAnalytic<BoundingSphere, Capsule, &ACD::collideSphereCapsule, true>,
+			&FineCollisionDetector::dispatchAnalytic<Capsule, Capsule, &ACD::collideCapsules, false>,
+			&FineCollisionDetector::dispatchAnalytic<Capsule, BoundingBox, &ACD::collideCapsuleBox, false>,
+			&FineCollisionDetector::dispatchConvexConvex,
+			&FineCollisionDetector::dispatchConvexConcave
+		}},
+		{{	// BoundingBox
+			&FineCollisionDetector::dispatchAnalytic<BoundingSphere, BoundingBox, &ACD::collideSphereBox, true>,
+			&FineCollisionDetector::dispatchAnalytic<Capsule, BoundingBox, &ACD::collideCapsuleBox, true>,
+			&FineCollisionDetector::dispatchAnalytic<BoundingBox, BoundingBox, &ACD::collideBoxes, false>,
+			&FineCollisionDetector::dispatchConvexConvex,
+			&FineCollisionDetector::dispatchConvexConcave
+		}},
+		{{	// Convex
+			&FineCollisionDetector::dispatchConvexConvex,
+			&FineCollisionDetector::dispatchConvexConvex,
+			&FineCollisionDetector::dispatchConvexConvex,
+			&FineCollisionDetector::dispatchConvexConvex,
+			&FineCollisionDetector::dispatchConvexConcave
+		}},
+		{{	// Concave
+			&FineCollisionDetector::dispatchConcaveConvex,
+			&FineCollisionDetector::dispatchConcaveConvex,
+			&FineCollisionDetector::dispatchConcaveConvex,
+			&FineCollisionDetector::dispatchConcaveConvex,
+			&FineCollisionDetector::dispatchConcaveConcave
+		}}
+	}};
+
+
 	FineCollisionDetector::FineCollisionDetector(
 		float coarseEpsilon,
 		float minFDifference, std::size_t maxIterations,
 		float contactPrecision, float contactSeparation,
-		float raycastPrecision
+		float raycastPrecision, float contactMatchDistance
 	) : mGJKCollisionDetector( std::make_unique<GJKCollisionDetector>(contactPrecision, maxIterations) ),
 		mEPACollisionDetector( std::make_unique<EPACollisionDetector>(minFDifference, maxIterations, contactPrecision) ),
 		mGJKRayCaster( std::make_unique<GJKRayCaster>(raycastPrecision, maxIterations) ),
-		mCoarseEpsilon(coarseEpsilon), mContactSeparation2(contactSeparation * contactSeparation) {}
+		mAnalyticCollisionDetector( std::make_unique<AnalyticCollisionDetector>(contactPrecision) ),
+		mCoarseEpsilon(coarseEpsilon), mContactSeparation2(contactSeparation * contactSeparation),
+		mContactMatchDistance2(contactMatchDistance * contactMatchDistance) {}
 
 
 	FineCollisionDetector::~FineCollisionDetector() {}
@@ -34,40 +80,62 @@ namespace se::physics {
 			return false;
 		}
 
-		if (auto convexCollider1 = dynamic_cast<const ConvexCollider*>(collider1)) {
-			if (auto convexCollider2 = dynamic_cast<const ConvexCollider*>(collider2)) {
-				return collideConvex(*convexCollider1, *convexCollider2, manifold);
-			}
-			else {
-				auto concaveCollider2 = static_cast<const ConcaveCollider*>(collider2);
-				return collideConvexConcave(*convexCollider1, *concaveCollider2, manifold, true);
-			}
+		auto type1 = static_cast<std::size_t>(collider1->getType());
+		auto type2 = static_cast<std::size_t>(collider2->getType());
+		return (this->*kCollideFunctions[type1][type2])(*collider1, *collider2, manifold);
+	}
+
+
+	std::pair<bool, RayHit> FineCollisionDetector::intersects(const Ray& ray, const Collider& collider) const
+	{
+		bool intersects = false;
+		RayHit rayHit;
+		rayHit.distance = std::numeric_limits<float>::max();
+
+		if (collider.getType() != ColliderType::Concave) {
+			auto& convexCollider = static_cast<const ConvexCollider&>(collider);
+			std::tie(intersects, rayHit) = mGJKRayCaster->calculateRayCast(ray, convexCollider);
 		}
 		else {
-			auto concaveCollider1 = static_cast<const ConcaveCollider*>(collider1);
-			if (auto convexCollider2 = dynamic_cast<const ConvexCollider*>(collider2)) {
-				return collideConvexConcave(*convexCollider2, *concaveCollider1, manifold, false);
-			}
-			else {
-				auto concaveCollider2 = static_cast<const ConcaveCollider*>(collider2);
-				return collideConcave(*concaveCollider1, *concaveCollider2, manifold);
-			}
+			auto& concaveCollider = static_cast<const ConcaveCollider&>(collider);
+			concaveCollider.processIntersectingParts(ray, mCoarseEpsilon, [&](const ConvexCollider& convexCollider2) {
+				auto [intersects2, rayHit2] = mGJKRayCaster->calculateRayCast(ray, convexCollider2);
+				if (intersects2 && (!intersects || (rayHit2.distance < rayHit.distance))) {
+					intersects = intersects2;
+					rayHit = rayHit2;
+				}
+			});
 		}
+
+		return { intersects, rayHit };
 	}
 
 
-	std::pair<bool, RayHit> FineCollisionDetector::intersects(const Ray& ray, const Collider& collider)
-	{
+	std::pair<bool, RayHit> FineCollisionDetector::intersects(
+		const ConvexCollider& shape, const glm::vec3& direction,
+		float maxDistance, const Collider& collider
+	) const {
 		bool intersects = false;
 		RayHit rayHit;
 		rayHit.distance = std::numeric_limits<float>::max();
 
-		if (auto convexCollider = dynamic_cast<const ConvexCollider*>(&collider)) {
-			std::tie(intersects, rayHit) = mGJKRayCaster->calculateRayCast(ray, *convexCollider);
+		if (collider.getType() != ColliderType::Concave) {
+			auto& convexCollider = static_cast<const ConvexCollider&>(collider);
+			std::tie(intersects, rayHit) = mGJKRayCaster->calculateShapeCast(shape, direction, convexCollider);
 		}
-		else if (auto concaveCollider = dynamic_cast<const ConcaveCollider*>(&collider)) {
-			concaveCollider->processIntersectingParts(ray, mCoarseEpsilon, [&](const ConvexCollider& convexCollider2) {
-				auto [intersects2, rayHit2] = mGJKRayCaster->calculateRayCast(ray, convexCollider2);
+		else {
+			// The shape can't move further than the Collider AABB, so the
+			// parts are searched only inside the AABB swept by the shape
+			AABB shapeAABB = shape.getAABB(), colliderAABB = collider.getAABB();
+			float maxSweepDistance = glm::length(0.5f * (colliderAABB.minimum + colliderAABB.maximum - shapeAABB.minimum - shapeAABB.maximum))
+				+ 0.5f * glm::length(colliderAABB.maximum - colliderAABB.minimum)
+				+ 0.5f * glm::length(shapeAABB.maximum - shapeAABB.minimum);
+			glm::vec3 displacement = std::min(maxDistance, maxSweepDistance / glm::length(direction)) * direction;
+			AABB sweptAABB = expand(shapeAABB, { shapeAABB.minimum + displacement, shapeAABB.maximum + displacement });
+
+			auto& concaveCollider = static_cast<const ConcaveCollider&>(collider);
+			concaveCollider.processOverlapingParts(sweptAABB, mCoarseEpsilon, [&](const ConvexCollider& convexCollider2) {
+				auto [intersects2, rayHit2] = mGJKRayCaster->calculateShapeCast(shape, direction, convexCollider2);
 				if (intersects2 && (!intersects || (rayHit2.distance < rayHit.distance))) {
 					intersects = intersects2;
 					rayHit = rayHit2;
@@ -78,13 +146,118 @@ namespace se::physics {
 		return { intersects, rayHit };
 	}
 
+
+	bool FineCollisionDetector::overlaps(const ConvexCollider& shape, const Collider& collider) const
+	{
+		if (collider.getType() != ColliderType::Concave) {
+			auto& convexCollider = static_cast<const ConvexCollider&>(collider);
+			return mGJKCollisionDetector->calculateIntersection(shape, convexCollider).first;
+		}
+
+		bool overlaps = false;
+		auto& concaveCollider = static_cast<const ConcaveCollider&>(collider);
+		concaveCollider.processOverlapingParts(shape.getAABB(), mCoarseEpsilon, [&](const ConvexCollider& part) {
+			overlaps = overlaps || mGJKCollisionDetector->calculateIntersection(shape, part).first;
+		});
+
+		return overlaps;
+	}
+
 // Private functions
+	bool FineCollisionDetector::dispatchConvexConvex(
+		const Collider& collider1, const Collider& collider2,
+		Manifold& manifold
+	) {
+		return collideConvex(
+			static_cast<const ConvexCollider&>(collider1), static_cast<const ConvexCollider&>(collider2),
+			manifold
+		);
+	}
+
+
+	bool FineCollisionDetector::dispatchConvexConcave(
+		const Collider& collider1, const Collider& collider2,
+		Manifold& manifold
+	) {
+		return collideConvexConcave(
+			static_cast<const ConvexCollider&>(collider1), static_cast<const ConcaveCollider&>(collider2),
+			manifold, true
+		);
+	}
+
+
+	bool FineCollisionDetector::dispatchConcaveConvex(
+		const Collider& collider1, const Collider& collider2,
+		Manifold& manifold
+	) {
+		return collideConvexConcave(
+			static_cast<const ConvexCollider&>(collider2), static_cast<const ConcaveCollider&>(collider1),
+			manifold, false
+		);
+	}
+
+
+	bool FineCollisionDetector::dispatchConcaveConcave(
+		const Collider& collider1, const Collider& collider2,
+		Manifold& manifold
+	) {
+		return collideConcave(
+			static_cast<const ConcaveCollider&>(collider1), static_cast<const ConcaveCollider&>(collider2),
+			manifold
+		);
+	}
+
+
+	template <typename T1, typename T2, auto F, bool kSwap>
+	bool FineCollisionDetector::dispatchAnalytic(
+		const Collider& collider1, const Collider& collider2,
+		Manifold& manifold
+	) {
+		// The Contacts are calculated from scratch, so the old ones are kept
+		// for matching their identifiers
+		const auto oldContacts = manifold.contacts;
+		manifold.contacts.clear();
+
+		bool intersects = false;
+		if constexpr (kSwap) {
+			intersects = (mAnalyticCollisionDetector.get()->*F)(
+				static_cast<const T1&>(collider2), static_cast<const T2&>(collider1),
+				manifold.contacts
+			);
+			for (Contact& contact : manifold.contacts) {
+				contact.normal = -contact.normal;
+				std::swap(contact.worldPosition[0], contact.worldPosition[1]);
+				std::swap(contact.localPosition[0], contact.localPosition[1]);
+			}
+		}
+		else {
+			intersects = (mAnalyticCollisionDetector.get()->*F)(
+				static_cast<const T1&>(collider1), static_cast<const T2&>(collider2),
+				manifold.contacts
+			);
+		}
+
+		updateContactIds(oldContacts, manifold);
+
+		manifold.state.set(Manifold::State::Intersecting, intersects);
+		manifold.state.set(Manifold::State::Updated);
+		return intersects;
+	}
+
+
 	bool FineCollisionDetector::collideConvex(
 		const ConvexCollider& collider1, const ConvexCollider& collider2,
 		Manifold& manifold
 	) {
-		// GJK algorithm
-		auto [collides, simplex] = mGJKCollisionDetector->calculateIntersection(collider1, collider2);
+		// GJK algorithm, warm started with the result of the previous update
+		Manifold::GJKCache& gjkCache = manifold.gjkCache;
+		Simplex simplex;
+		for (const auto& [localPosition1, localPosition2] : gjkCache.simplexPoints) {
+			simplex.emplace_back(glm::vec3(0.0f), localPosition1, glm::vec3(0.0f), localPosition2);
+		}
+
+		bool collides = mGJKCollisionDetector->calculateIntersection(collider1, collider2, gjkCache.direction, simplex);
+		gjkCache.simplexPoints.clear();
 		if (!collides) {
 			manifold.contacts.clear();
 			manifold.state.reset(Manifold::State::Intersecting);
@@ -92,14 +265,20 @@ namespace se::physics {
 			return false;
 		}
 
+		for (const SupportPoint& sp : simplex) {
+			gjkCache.simplexPoints.push_back({ sp.getLocalPosition(false), sp.getLocalPosition(true) });
+		}
+
 		// EPA Algorithm
 		auto [success, contact] = mEPACollisionDetector->calculate(collider1, collider2, simplex);
 		if (!success) {
+			gjkCache.simplexPoints.clear();
 			manifold.contacts.clear();
 			manifold.state.reset(Manifold::State::Intersecting);
 			manifold.state.set(Manifold::State::Updated);
 			return false;
 		}
+		gjkCache.direction = contact.normal;
 
 		// Remove the contacts that are no longer valid from the manifold
 		removeInvalidContacts(manifold);
@@ -221,6 +400,8 @@ namespace se::physics {
 	{
 		// Check if the Contact is far enough from the Manifold contacts
 		if (!isClose(contact, manifold.contacts.data(), manifold.contacts.size())) {
+			contact.id = manifold.nextContactId++;
+
 			if (manifold.contacts.size() < Manifold::kMaxContacts) {
 				// Add the new contact to the manifold
 				manifold.contacts.push_back(contact);
@@ -269,6 +450,33 @@ namespace se::physics {
 	}
 
 
+	void FineCollisionDetector::updateContactIds(
+		const utils::FixedVector<Contact, Manifold::kMaxContacts>& oldContacts,
+		Manifold& manifold
+	) const
+	{
+		std::array<bool, Manifold::kMaxContacts> matched = {};
+		for (Contact& contact : manifold.contacts) {
+			// The Colliders could have moved since the last update, so the
+			// Contacts are compared by their local coordinates
+			bool found = false;
+			for (std::size_t i = 0; (i < oldContacts.size()) && !found; ++i) {
+				glm::vec3 v0 = contact.localPosition[0] - oldContacts[i].localPosition[0];
+				glm::vec3 v1 = contact.localPosition[1] - oldContacts[i].localPosition[1];
+				if (!matched[i] && (glm::dot(v0, v0) < mContactMatchDistance2) && (glm::dot(v1, v1) < mContactMatchDistance2)) {
+					contact.id = oldContacts[i].id;
+					matched[i] = true;
+					found = true;
+				}
+			}
+
+			if (!found) {
+				contact.id = manifold.nextContactId++;
+			}
+		}
+	}
+
+
 	bool FineCollisionDetector::isClose(
 		const Contact& newContact,
 		const Contact* contacts, std::size_t numContacts
@@ -1,3 +1,4 @@
+#include <cmath>
 #include <cassert>
 #include <glm/gtc/random.hpp>
 #include <glm/gtc/epsilon.hpp>
@@ -10,18 +11,56 @@ namespace se::physics {
 		const ConvexCollider& collider1, const ConvexCollider& collider2
 	) const
 	{
-		// Get an initial point in the direction from one collider to another
-		glm::vec3 c1Location = collider1.getTransforms() * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
-		glm::vec3 c2Location = collider2.getTransforms() * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
-		glm::vec3 direction = (c1Location == c2Location)? glm::sphericalRand(1.0f) : glm::normalize(c2Location - c1Location);
-		Simplex simplex = { SupportPoint(collider1, collider2, direction) };
+		glm::vec3 direction(0.0f);
+		Simplex simplex;
+		bool collides = calculateIntersection(collider1, collider2, direction, simplex);
+		return std::make_pair(collides, simplex);
+	}
+
+
+	bool GJKCollisionDetector::calculateIntersection(
+		const ConvexCollider& collider1, const ConvexCollider& collider2,
+		glm::vec3& direction, Simplex& simplex
+	) const
+	{
+		// Reuse the previous simplex if it still contains the origin with
+		// the current transforms of the colliders
+		if (simplex.size() == 4) {
+			glm::mat4 transforms1 = collider1.getTransforms();
+			glm::mat4 transforms2 = collider2.getTransforms();
+			for (SupportPoint& sp : simplex) {
+				glm::vec3 localPosition1 = sp.getLocalPosition(false), localPosition2 = sp.getLocalPosition(true);
+				sp = SupportPoint(
+					transforms1 * glm::vec4(localPosition1, 1.0f), localPosition1,
+					transforms2 * glm::vec4(localPosition2, 1.0f), localPosition2
+				);
+			}
+
+			if (tetrahedronContainsOrigin(simplex)) {
+				return true;
+			}
+		}
+
+		// Get an initial point in the given direction or in the direction
+		// from one collider to another
+		if (direction == glm::vec3(0.0f)) {
+			glm::vec3 c1Location = collider1.getTransforms() * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+			glm::vec3 c2Location = collider2.getTransforms() * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+			direction = (c1Location == c2Location)? glm::sphericalRand(1.0f) : glm::normalize(c2Location - c1Location);
+		}
+		simplex = { SupportPoint(collider1, collider2, direction) };
+
+		// If the direction is still a separating axis there is no collision
+		if (glm::dot(simplex[0].getCSOPosition(), direction) < -mEpsilon) {
+			return false;
+		}
 
 		std::size_t iteration = 0;
 		bool containsOrigin = doSimplex(simplex, direction);
 		while (!containsOrigin) {
 			// Exit if we exceeded the maximum number of iterations
 			if (iteration >= mMaxIterations) {
-				return std::make_pair(false, simplex);
+				return false;
 			}
 
 			// Get a support point along the current direction
@@ -30,7 +69,7 @@ namespace se::physics {
 			// Check if the support point is further along the search direction
 			if (glm::dot(sp.getCSOPosition(), direction) < -mEpsilon) {
 				// There is no collision, exit without finishing the simplex
-				return std::make_pair(false, simplex);
+				return false;
 			}
 			else {
 				// Add the point and update the simplex
@@ -41,10 +80,32 @@ namespace se::physics {
 			++iteration;
 		}
 
-		return std::make_pair(true, simplex);
+		return true;
 	}
 
 // Private functions
+	bool GJKCollisionDetector::tetrahedronContainsOrigin(const Simplex& simplex) const
+	{
+		// The origin must be at the same side of each face than the opposite
+		// vertex
+		for (int i = 0; i < 4; ++i) {
+			glm::vec3 a = simplex[i].getCSOPosition();
+			glm::vec3 b = simplex[(i + 1) % 4].getCSOPosition();
+			glm::vec3 c = simplex[(i + 2) % 4].getCSOPosition();
+			glm::vec3 d = simplex[(i + 3) % 4].getCSOPosition();
+
+			glm::vec3 normal = glm::cross(b - a, c - a);
+			float vertexDistance = glm::dot(normal, d - a);
+			float originDistance = glm::dot(normal, -a);
+			if ((std::abs(vertexDistance) <= mEpsilon) || (vertexDistance * originDistance < 0.0f)) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+
 	bool GJKCollisionDetector::doSimplex(Simplex& simplex, glm::vec3& searchDir) const
 	{
 		assert(!simplex.empty() && "The simplex has to have at least one initial point");
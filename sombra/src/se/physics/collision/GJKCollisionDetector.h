@@ -51,7 +51,35 @@ namespace se::physics {
 		std::pair<bool, Simplex> calculateIntersection(
 			const ConvexCollider& collider1, const ConvexCollider& collider2
 		) const;
+
+		/** Checks if the given ConvexColliders are intersecting with the GJK
+		 * algorithm, starting from the result of a previous test between them
+		 *
+		 * @param	collider1 the first ConvexCollider that we want to check
+		 * @param	collider2 the second ConvexCollider that we want to check
+		 * @param	direction the initial search direction, zero for using the
+		 *			direction between the ConvexColliders. If the support point
+		 *			in this direction is behind the origin, the ConvexColliders
+		 *			are separated without more iterations. It will be updated
+		 *			with the last search direction
+		 * @param	simplex the simplex of the previous test, its SupportPoints
+		 *			world positions are recalculated from their local ones. If
+		 *			it still contains the origin the algorithm finishes
+		 *			without any iteration. It will be replaced with the
+		 *			simplex needed to check the collision
+		 * @return	true if the two ConvexColliders are intersecting, false
+		 *			otherwise */
+		bool calculateIntersection(
+			const ConvexCollider& collider1, const ConvexCollider& collider2,
+			glm::vec3& direction, Simplex& simplex
+		) const;
 	private:
+		/** Checks if the origin is inside the given tetrahedron
+		 *
+		 * @param	simplex a simplex with the 4 points of the tetrahedron
+		 * @return	true if the origin is inside, false otherwise */
+		bool tetrahedronContainsOrigin(const Simplex& simplex) const;
+
 		/** Updates the given direction and simplex, reducing it to the lowest
 		 * dimension possible by discarding vertices.
 		 *
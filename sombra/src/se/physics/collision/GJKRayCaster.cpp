@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <glm/gtc/random.hpp>
 #include <glm/gtc/epsilon.hpp>
 #include "se/utils/MathUtils.h"
@@ -6,15 +7,129 @@
 
 namespace se::physics {
 
+	/** Calculates the closest point to the origin of coordinates in the
+	 * given triangle
+	 *
+	 * @param	a the first vertex of the triangle
+	 * @param	b the second vertex of the triangle
+	 * @param	c the third vertex of the triangle
+	 * @return	the barycentric coordinates of the closest point
+	 * @see		Real-Time Collision Detection by Christer Ericson, 5.1.5 */
+	static glm::vec3 calculateClosestPointInTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+	{
+		glm::vec3 ab = b - a, ac = c - a;
+
+		float d1 = -glm::dot(ab, a), d2 = -glm::dot(ac, a);
+		if ((d1 <= 0.0f) && (d2 <= 0.0f)) {
+			return { 1.0f, 0.0f, 0.0f };
+		}
+
+		float d3 = -glm::dot(ab, b), d4 = -glm::dot(ac, b);
+		if ((d3 >= 0.0f) && (d4 <= d3)) {
+			return { 0.0f, 1.0f, 0.0f };
+		}
+
+		float vc = d1 * d4 - d3 * d2;
+		if ((vc <= 0.0f) && (d1 >= 0.0f) && (d3 <= 0.0f)) {
+			float v = d1 / (d1 - d3);
+			return { 1.0f - v, v, 0.0f };
+		}
+
+		float d5 = -glm::dot(ab, c), d6 = -glm::dot(ac, c);
+		if ((d6 >= 0.0f) && (d5 <= d6)) {
+			return { 0.0f, 0.0f, 1.0f };
+		}
+
+		float vb = d5 * d2 - d1 * d6;
+		if ((vb <= 0.0f) && (d2 >= 0.0f) && (d6 <= 0.0f)) {
+			float w = d2 / (d2 - d6);
+			return { 1.0f - w, 0.0f, w };
+		}
+
+		float va = d3 * d6 - d5 * d4;
+		if ((va <= 0.0f) && (d4 - d3 >= 0.0f) && (d5 - d6 >= 0.0f)) {
+			float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+			return { 0.0f, 1.0f - w, w };
+		}
+
+		float denominator = va + vb + vc;
+		if (denominator == 0.0f) {
+			// Degenerate triangle
+			return { 1.0f, 0.0f, 0.0f };
+		}
+
+		float v = vb / denominator, w = vc / denominator;
+		return { 1.0f - v - w, v, w };
+	}
+
+
+	/** Interpolates the given SupportPoints of the given simplex
+	 *
+	 * @param	simplex the simplex that holds the SupportPoints
+	 * @param	iVertices the indices of the SupportPoints to interpolate
+	 * @param	weights the weight of each of the SupportPoints
+	 * @param	numVertices the number of SupportPoints to interpolate
+	 * @return	the interpolated SupportPoint */
+	static SupportPoint interpolate(
+		const Simplex& simplex, const int* iVertices, const float* weights, std::size_t numVertices
+	) {
+		glm::vec3 worldPosition[2] = { glm::vec3(0.0f), glm::vec3(0.0f) };
+		glm::vec3 localPosition[2] = { glm::vec3(0.0f), glm::vec3(0.0f) };
+		for (int j = 0; j < 2; ++j) {
+			for (std::size_t k = 0; k < numVertices; ++k) {
+				worldPosition[j] += weights[k] * simplex[iVertices[k]].getWorldPosition(j);
+				localPosition[j] += weights[k] * simplex[iVertices[k]].getLocalPosition(j);
+			}
+		}
+
+		return SupportPoint(worldPosition[0], localPosition[0], worldPosition[1], localPosition[1]);
+	}
+
+
 	std::pair<bool, RayHit> GJKRayCaster::calculateRayCast(const Ray& ray, const ConvexCollider& collider) const
 	{
-		glm::vec3 pointRandomW(0.0f), pointRandomL(0.0f);
-		collider.getFurthestPointInDirection(glm::sphericalRand(1.0f), pointRandomW, pointRandomL);
+		return calculateCast(ray.origin, nullptr, ray.direction, collider);
+	}
+
+
+	std::pair<bool, RayHit> GJKRayCaster::calculateShapeCast(
+		const ConvexCollider& shape, const glm::vec3& direction, const ConvexCollider& collider
+	) const
+	{
+		return calculateCast(glm::vec3(0.0f), &shape, direction, collider);
+	}
+
+// Private functions
+	std::pair<bool, RayHit> GJKRayCaster::calculateCast(
+		const glm::vec3& origin, const ConvexCollider* shape,
+		const glm::vec3& direction, const ConvexCollider& collider
+	) const
+	{
+		// The cast is done as a ray cast from the origin of coordinates
+		// against the CSO of the collider and the shape (or the origin point
+		// if there isn't any shape), so the first point of each SupportPoint
+		// is in the shape and the second one in the collider. The first
+		// points are moved with the shape in every iteration
+		auto getSupportPoint = [&](const glm::vec3& v) {
+			if (shape) {
+				return SupportPoint(*shape, collider, -v);
+			}
+
+			glm::vec3 pointWorld(0.0f), pointLocal(0.0f);
+			collider.getFurthestPointInDirection(v, pointWorld, pointLocal);
+			return SupportPoint(origin, glm::vec3(0.0f), pointWorld, pointLocal);
+		};
+		auto translate = [](const SupportPoint& sp, const glm::vec3& translation) {
+			return SupportPoint(
+				sp.getWorldPosition(0) + translation, sp.getLocalPosition(0),
+				sp.getWorldPosition(1), sp.getLocalPosition(1)
+			);
+		};
 
 		float lambda = 0.0f;
-		glm::vec3 x = ray.origin;
+		glm::vec3 x(0.0f);
 		glm::vec3 n(0.0f);
-		glm::vec3 v = SupportPoint(x, glm::vec3(0.0f), pointRandomW, pointRandomL).getCSOPosition();
+		glm::vec3 v = getSupportPoint(glm::sphericalRand(1.0f)).getCSOPosition();
 		Simplex simplex;
 		utils::FixedVector<bool, 4> closestSimplexPoints;
 
@@ -22,33 +137,38 @@ namespace se::physics {
 		std::size_t iteration = 0;
 		while ((dist2 > mEpsilon * mEpsilon) && (iteration < mMaxIterations)) {
 			// Search a new point in the v direction
-			glm::vec3 pointWorld(0.0f), pointLocal(0.0f);
-			collider.getFurthestPointInDirection(v, pointWorld, pointLocal);
+			SupportPoint sp = translate(getSupportPoint(v), x);
 
-			glm::vec3 w = x - pointWorld;
+			glm::vec3 w = sp.getCSOPosition();
+			bool changed = false;
 			if (glm::dot(v, w) > mEpsilon) {
-				if (glm::dot(v, ray.direction) >= -mEpsilon) {
+				if (glm::dot(v, direction) >= -mEpsilon) {
 					return { false, RayHit() };
 				}
 				else {
-					lambda -= glm::dot(v, w) / glm::dot(v, ray.direction);
-					x = ray.origin + lambda * ray.direction;
+					lambda -= glm::dot(v, w) / glm::dot(v, direction);
+					glm::vec3 translation = lambda * direction - x;
+					x = lambda * direction;
 					n = v;
-				}
-			}
 
-			// Update the world x position in the simplex
-			Simplex newSimplex;
-			for (const SupportPoint& sp : simplex) {
-				newSimplex.emplace_back(x, glm::vec3(0.0f), sp.getWorldPosition(1), sp.getLocalPosition(1));
+					// Update the positions of the shape in the simplex
+					for (SupportPoint& sp2 : simplex) {
+						sp2 = translate(sp2, translation);
+					}
+					sp = translate(sp, translation);
+					changed = true;
+				}
 			}
-			simplex = newSimplex;
 
 			// Insert a new support point if it isn't close to the other points
-			SupportPoint sp(x, glm::vec3(0.0f), pointWorld, pointLocal);
 			if (!isClose(simplex, sp.getCSOPosition(), mEpsilon)) {
 				simplex.push_back(sp);
 				closestSimplexPoints.push_back(false);
+				changed = true;
+			}
+			else if (!changed) {
+				// The next iterations would be the same than this one
+				break;
 			}
 
 			// Calculate the closest point to the origin
@@ -59,6 +179,10 @@ namespace se::physics {
 
 				// Remove old simplex points
 				reduce(simplex, closestSimplexPoints);
+				if (simplex.size() == 4) {
+					// The origin is inside the tetrahedron
+					dist2 = 0.0f;
+				}
 			}
 			else {
 				dist2 = 0.0f;
@@ -84,7 +208,7 @@ namespace se::physics {
 		}
 	}
 
-// Private functions
+
 	std::pair<bool, SupportPoint> GJKRayCaster::calculateClosestPoint(
 		const Simplex& simplex, utils::FixedVector<bool, 4>& closestPoints
 	) const
@@ -112,36 +236,16 @@ namespace se::physics {
 		const Simplex& simplex, utils::FixedVector<bool, 4>& closestPoints
 	) const
 	{
-		auto [inside, originBarycentricCoords] = utils::projectPointOnEdge(
-			glm::vec3(0.0f),
-			{ simplex[0].getCSOPosition(), simplex[1].getCSOPosition() },
-			mEpsilon
-		);
-		if (!inside) {
-			if (originBarycentricCoords[0] < -mEpsilon) {
-				closestPoints[0] = true;
-				closestPoints[1] = false;
-			}
-			else if (originBarycentricCoords[1] < -mEpsilon) {
-				closestPoints[0] = false;
-				closestPoints[1] = true;
-			}
-
-			originBarycentricCoords = glm::clamp(originBarycentricCoords, glm::vec2(0.0f), glm::vec2(1.0f));
-		}
-		else {
-			closestPoints[0] = closestPoints[1] = true;
-		}
+		glm::vec3 a = simplex[0].getCSOPosition(), ab = simplex[1].getCSOPosition() - a;
+		float ab2 = glm::dot(ab, ab);
+		float t = (ab2 > mEpsilon * mEpsilon)? std::clamp(-glm::dot(a, ab) / ab2, 0.0f, 1.0f) : 0.0f;
 
-		glm::vec3 worldPosition[2], localPosition[2];
-		for (int i = 0; i < 2; ++i) {
-			worldPosition[i] = originBarycentricCoords.x * simplex[0].getWorldPosition(i)
-				+ originBarycentricCoords.y * simplex[1].getWorldPosition(i);
-			localPosition[i] = originBarycentricCoords.x * simplex[0].getLocalPosition(i)
-				+ originBarycentricCoords.y * simplex[1].getLocalPosition(i);
-		}
+		const int iVertices[2] = { 0, 1 };
+		const float weights[2] = { 1.0f - t, t };
+		closestPoints[0] = (weights[0] > 0.0f);
+		closestPoints[1] = (weights[1] > 0.0f);
 
-		return { true, SupportPoint(worldPosition[0], localPosition[0], worldPosition[1], localPosition[1]) };
+		return { true, interpolate(simplex, iVertices, weights, 2) };
 	}
 
 
@@ -149,33 +253,15 @@ namespace se::physics {
 		const Simplex& simplex, utils::FixedVector<bool, 4>& closestPoints
 	) const
 	{
-		auto [inside, originBarycentricCoords] = utils::projectPointOnTriangle(
-			glm::vec3(0.0f),
-			{ simplex[0].getCSOPosition(), simplex[1].getCSOPosition(), simplex[2].getCSOPosition() },
-			mEpsilon
+		const int iVertices[3] = { 0, 1, 2 };
+		glm::vec3 weights = calculateClosestPointInTriangle(
+			simplex[0].getCSOPosition(), simplex[1].getCSOPosition(), simplex[2].getCSOPosition()
 		);
-		if (!inside) {
-			closestPoints[0] = (originBarycentricCoords[0] >= -mEpsilon);
-			closestPoints[1] = (originBarycentricCoords[1] >= -mEpsilon);
-			closestPoints[2] = (originBarycentricCoords[2] >= -mEpsilon);
-
-			originBarycentricCoords = glm::clamp(originBarycentricCoords, glm::vec3(0.0f), glm::vec3(1.0f));
-		}
-		else {
-			closestPoints[0] = closestPoints[1] = closestPoints[2] = true;
+		for (int j = 0; j < 3; ++j) {
+			closestPoints[j] = (weights[j] > 0.0f);
 		}
 
-		glm::vec3 worldPosition[2], localPosition[2];
-		for (int i = 0; i < 2; ++i) {
-			worldPosition[i] = originBarycentricCoords.x * simplex[0].getWorldPosition(i)
-				+ originBarycentricCoords.y * simplex[1].getWorldPosition(i)
-				+ originBarycentricCoords.z * simplex[2].getWorldPosition(i);
-			localPosition[i] = originBarycentricCoords.x * simplex[0].getLocalPosition(i)
-				+ originBarycentricCoords.y * simplex[1].getLocalPosition(i)
-				+ originBarycentricCoords.z * simplex[2].getLocalPosition(i);
-		}
-
-		return { true, SupportPoint(worldPosition[0], localPosition[0], worldPosition[1], localPosition[1]) };
+		return { true, interpolate(simplex, iVertices, &weights[0], 3) };
 	}
 
 
@@ -183,45 +269,47 @@ namespace se::physics {
 		const Simplex& simplex, utils::FixedVector<bool, 4>& closestPoints
 	) const
 	{
+		// If the origin is inside the tetrahedron its closest point is the
+		// origin itself, calculated with its barycentric coordinates
+		glm::vec3 a = simplex[0].getCSOPosition(), b = simplex[1].getCSOPosition(),
+			c = simplex[2].getCSOPosition(), d = simplex[3].getCSOPosition();
+		float volume = glm::dot(b - a, glm::cross(c - a, d - a));
+		if (volume != 0.0f) {
+			const int iVertices[4] = { 0, 1, 2, 3 };
+			const float weights[4] = {
+				glm::dot(b, glm::cross(c, d)) / volume,
+				glm::dot(-a, glm::cross(c - a, d - a)) / volume,
+				glm::dot(b - a, glm::cross(-a, d - a)) / volume,
+				glm::dot(b - a, glm::cross(c - a, -a)) / volume
+			};
+			if ((weights[0] >= 0.0f) && (weights[1] >= 0.0f) && (weights[2] >= 0.0f) && (weights[3] >= 0.0f)) {
+				closestPoints = { true, true, true, true };
+				return { true, interpolate(simplex, iVertices, weights, 4) };
+			}
+		}
+
+		// Otherwise it's in one of the faces, each face skips one vertex
 		bool success = false;
 		SupportPoint value;
 
 		float minDistance = std::numeric_limits<float>::max();
 		for (int i = 0; i < 4; ++i) {
-			int iV1 = i % 3, iV2 = (i + 1) % 3, iV3 = (i + 2) % 3;
-			utils::FixedVector<bool, 4> currentClosestPoints = { false, false, false, false };
-
-			auto [inside, originBarycentricCoords] = utils::projectPointOnTriangle(
-				glm::vec3(0.0f),
-				{ simplex[iV1].getCSOPosition(), simplex[iV2].getCSOPosition(), simplex[iV3].getCSOPosition() },
-				mEpsilon
+			const int iVertices[3] = { (i + 1) % 4, (i + 2) % 4, (i + 3) % 4 };
+			glm::vec3 weights = calculateClosestPointInTriangle(
+				simplex[iVertices[0]].getCSOPosition(), simplex[iVertices[1]].getCSOPosition(), simplex[iVertices[2]].getCSOPosition()
 			);
-			if (!inside) {
-				currentClosestPoints[iV1] = (originBarycentricCoords[iV1] >= -mEpsilon);
-				currentClosestPoints[iV2] = (originBarycentricCoords[iV2] >= -mEpsilon);
-				currentClosestPoints[iV3] = (originBarycentricCoords[iV3] >= -mEpsilon);
-				originBarycentricCoords = glm::clamp(originBarycentricCoords, glm::vec3(0.0f), glm::vec3(1.0f));
-			}
-			else {
-				closestPoints[iV1] = closestPoints[iV2] = closestPoints[iV3] = true;
-			}
-
-			glm::vec3 worldPosition[2], localPosition[2];
-			for (int j = 0; j < 2; ++j) {
-				worldPosition[j] = originBarycentricCoords.x * simplex[iV1].getWorldPosition(j)
-					+ originBarycentricCoords.y * simplex[iV2].getWorldPosition(j)
-					+ originBarycentricCoords.z * simplex[iV3].getWorldPosition(j);
-				localPosition[j] = originBarycentricCoords.x * simplex[iV1].getLocalPosition(j)
-					+ originBarycentricCoords.y * simplex[iV2].getLocalPosition(j)
-					+ originBarycentricCoords.z * simplex[iV3].getLocalPosition(j);
-			}
-			SupportPoint sp(worldPosition[0], localPosition[0], worldPosition[1], localPosition[1]);
+			SupportPoint sp = interpolate(simplex, iVertices, &weights[0], 3);
 
 			float currentDistance = glm::dot(sp.getCSOPosition(), sp.getCSOPosition());
 			if (currentDistance < minDistance) {
+				minDistance = currentDistance;
 				value = sp;
 				success = true;
-				closestPoints = currentClosestPoints;
+
+				closestPoints = { false, false, false, false };
+				for (int j = 0; j < 3; ++j) {
+					closestPoints[iVertices[j]] = (weights[j] > 0.0f);
+				}
 			}
 		}
 
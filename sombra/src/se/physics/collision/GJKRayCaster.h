@@ -45,7 +45,38 @@ namespace se::physics {
 		std::pair<bool, RayHit> calculateRayCast(
 			const Ray& ray, const ConvexCollider& collider
 		) const;
+
+		/** Checks if the given shape intersects the given collider when it's
+		 * moved in the given direction
+		 *
+		 * @param	shape the shape to move, located at its initial position
+		 * @param	direction the direction in which the shape is moved
+		 * @param	collider the collider to test
+		 * @return	a pair with a boolean that tell if the shape intersects
+		 *			the collider and the cast data. The distance of the cast
+		 *			data is the displacement along the direction until the
+		 *			impact, and its contact point and normal are located in
+		 *			the surface of the collider */
+		std::pair<bool, RayHit> calculateShapeCast(
+			const ConvexCollider& shape, const glm::vec3& direction,
+			const ConvexCollider& collider
+		) const;
 	private:
+		/** Implements @see calculateRayCast and @see calculateShapeCast
+		 *
+		 * @param	origin the origin of the ray, only used if there isn't
+		 *			any shape
+		 * @param	shape a pointer to the shape to move, nullptr for a ray
+		 *			cast
+		 * @param	direction the direction of the ray or the shape
+		 * @param	collider the collider to test
+		 * @return	a pair with a boolean that tell if the ray or shape
+		 *			intersects the collider and the cast data */
+		std::pair<bool, RayHit> calculateCast(
+			const glm::vec3& origin, const ConvexCollider* shape,
+			const glm::vec3& direction, const ConvexCollider& collider
+		) const;
+
 		/** Calculates the closest point to the origin of coordinates in CSO
 		 * space in the given simplex
 		 *
@@ -1,77 +1,215 @@
 #include <algorithm>
-#include <glm/gtc/matrix_transform.hpp>
-#include "se/physics/collision/HalfEdgeMeshExt.h"
+#include "se/utils/MathUtils.h"
 #include "Polytope.h"
 
 namespace se::physics {
 
-	Polytope::Polytope(const utils::FixedVector<SupportPoint, 4>& simplex, float precision) :
-		mPrecision(precision)
+	void Polytope::reset(const utils::FixedVector<SupportPoint, 4>& simplex, float precision)
 	{
-		// Add the HEVertices
-		utils::FixedVector<int, 4> vertexIndices = {
-			addVertex(simplex[0]), addVertex(simplex[1]),
-			addVertex(simplex[2]), addVertex(simplex[3])
-		};
+		mPrecision = precision;
+		mVertices.clear();
+		mFaces.clear();
+		mFaceQueue.clear();
+
+		// Add the vertices
+		for (const SupportPoint& sp : simplex) {
+			mVertices.push_back(sp);
+		}
 
-		const glm::vec3 p0CSO = mMesh.vertices[vertexIndices[0]].location;
-		const glm::vec3 p1CSO = mMesh.vertices[vertexIndices[1]].location;
-		const glm::vec3 p2CSO = mMesh.vertices[vertexIndices[2]].location;
-		const glm::vec3 p3CSO = mMesh.vertices[vertexIndices[3]].location;
+		const glm::vec3 p0CSO = mVertices[0].getCSOPosition();
+		const glm::vec3 p1CSO = mVertices[1].getCSOPosition();
+		const glm::vec3 p2CSO = mVertices[2].getCSOPosition();
+		const glm::vec3 p3CSO = mVertices[3].getCSOPosition();
 
-		// Add the HEFaces with the correct normal winding order
+		// Add the Faces with the correct normal winding order
 		const glm::vec3 tNormal = glm::cross(p1CSO - p0CSO, p2CSO - p0CSO);
 		if (glm::dot(p3CSO - p0CSO, tNormal) <= 0.0f) {
-			addFace({ vertexIndices[0], vertexIndices[1], vertexIndices[2] });
-			addFace({ vertexIndices[0], vertexIndices[3], vertexIndices[1] });
-			addFace({ vertexIndices[0], vertexIndices[2], vertexIndices[3] });
-			addFace({ vertexIndices[1], vertexIndices[3], vertexIndices[2] });
+			addFace(0, 1, 2);
+			addFace(0, 3, 1);
+			addFace(0, 2, 3);
+			addFace(1, 3, 2);
 		}
 		else {
-			addFace({ vertexIndices[0], vertexIndices[2], vertexIndices[1] });
-			addFace({ vertexIndices[0], vertexIndices[1], vertexIndices[3] });
-			addFace({ vertexIndices[0], vertexIndices[3], vertexIndices[2] });
-			addFace({ vertexIndices[1], vertexIndices[2], vertexIndices[3] });
+			addFace(0, 2, 1);
+			addFace(0, 1, 3);
+			addFace(0, 3, 2);
+			addFace(1, 2, 3);
+		}
+
+		// Connect the Faces, each edge is shared with the Face that has the
+		// same vertices in the opposite order
+		for (Face& face : mFaces) {
+			for (int i = 0; i < 3; ++i) {
+				int iV0 = face.vertices[i], iV1 = face.vertices[(i + 1) % 3];
+				for (std::size_t iOther = 0; iOther < mFaces.size(); ++iOther) {
+					const Face& other = mFaces[iOther];
+					for (int j = 0; j < 3; ++j) {
+						if ((other.vertices[j] == iV1) && (other.vertices[(j + 1) % 3] == iV0)) {
+							face.neighbours[i] = static_cast<int>(iOther);
+						}
+					}
+				}
+			}
 		}
 	}
 
 
-	int Polytope::addVertex(const SupportPoint& sp)
+	int Polytope::popClosestFace()
 	{
-		int iVertex = se::physics::addVertex(mMesh, sp.getCSOPosition());
-		mVertexSupportPoints.emplace(sp);
+		auto compareDistances = [](const QueuedFace& f1, const QueuedFace& f2) {
+			return f1.distance > f2.distance;
+		};
+
+		// The removed Faces aren't erased from the queue, so they must be
+		// skipped
+		while (!mFaceQueue.empty()) {
+			std::pop_heap(mFaceQueue.begin(), mFaceQueue.end(), compareDistances);
+			int iFace = mFaceQueue.back().iFace;
+			mFaceQueue.pop_back();
 
-		return iVertex;
+			if (!mFaces[iFace].removed) {
+				return iFace;
+			}
+		}
+
+		return -1;
 	}
 
 
-	int Polytope::addFace(const utils::FixedVector<int, 3>& faceIndices)
+	bool Polytope::expand(const SupportPoint& sp, int iVisibleFace)
 	{
-		int iFace = se::physics::addFace(mMesh, faceIndices.begin(), faceIndices.end());
+		Face& visibleFace = mFaces[iVisibleFace];
+		const glm::vec3 eyePoint = sp.getCSOPosition();
+		const glm::vec3 faceVertex = mVertices[visibleFace.vertices[0]].getCSOPosition();
+		if (visibleFace.removed || (glm::dot(eyePoint - faceVertex, visibleFace.normal) <= 0.0f)
+			|| (mVertices.size() >= kMaxVertices)
+		) {
+			return false;
+		}
 
-		// Add the normal of the HEFace to mFaceNormals
-		mFaceNormals.emplace( calculateFaceNormal(mMesh, iFace) );
+		// Calculate the horizon edges and remove the visible Faces with the
+		// DFS algorithm, the horizon edges are stored in order
+		mHorizon.clear();
+		mVisibleFaces.clear();
+		visibleFace.removed = true;
+		mVisibleFaces.push_back(iVisibleFace);
+		for (int i = 0; i < 3; ++i) {
+			int iNeighbour = visibleFace.neighbours[i];
+			calculateHorizon(eyePoint, iNeighbour, getSharedEdge(iNeighbour, iVisibleFace));
+		}
+
+		// Restore the removed Faces if there isn't enough space for the new
+		// ones
+		if ((mHorizon.size() < 3) || (mFaces.size() + mHorizon.size() > kMaxFaces)) {
+			for (int iFace : mVisibleFaces) {
+				mFaces[iFace].removed = false;
+			}
+			return false;
+		}
 
-		// Add the distance data of the HEFace to mFaceDistances
-		const glm::vec3 p0CSO = mMesh.vertices[faceIndices[0]].location;
-		const glm::vec3 p1CSO = mMesh.vertices[faceIndices[1]].location;
-		const glm::vec3 p2CSO = mMesh.vertices[faceIndices[2]].location;
+		// Add the new Faces by connecting the horizon edges to the new vertex
+		int iSp = static_cast<int>(mVertices.size());
+		mVertices.push_back(sp);
+
+		int iFirstNewFace = static_cast<int>(mFaces.size());
+		for (const HorizonEdge& edge : mHorizon) {
+			const Face& horizonFace = mFaces[edge.iFace];
+			int iV0 = horizonFace.vertices[(edge.iEdge + 1) % 3], iV1 = horizonFace.vertices[edge.iEdge];
+			int iNewFace = addFace(iV0, iV1, iSp);
+			mFaces[iNewFace].neighbours[0] = edge.iFace;
+			mFaces[edge.iFace].neighbours[edge.iEdge] = iNewFace;
+		}
+
+		// Connect the new Faces between them, each one shares the edge that
+		// goes to the new vertex with the one that starts at its second vertex
+		int iEndNewFaces = static_cast<int>(mFaces.size());
+		for (int iFace1 = iFirstNewFace; iFace1 < iEndNewFaces; ++iFace1) {
+			for (int iFace2 = iFirstNewFace; iFace2 < iEndNewFaces; ++iFace2) {
+				if (mFaces[iFace1].vertices[1] == mFaces[iFace2].vertices[0]) {
+					mFaces[iFace1].neighbours[1] = iFace2;
+					mFaces[iFace2].neighbours[2] = iFace1;
+				}
+			}
+		}
+
+		return true;
+	}
+
+// Private functions
+	int Polytope::addFace(int iV0, int iV1, int iV2)
+	{
+		const glm::vec3 p0CSO = mVertices[iV0].getCSOPosition();
+		const glm::vec3 p1CSO = mVertices[iV1].getCSOPosition();
+		const glm::vec3 p2CSO = mVertices[iV2].getCSOPosition();
+
+		Face& face = mFaces.emplace_back();
+		face.vertices[0] = iV0;
+		face.vertices[1] = iV1;
+		face.vertices[2] = iV2;
+		face.neighbours[0] = face.neighbours[1] = face.neighbours[2] = -1;
+		face.removed = false;
+
+		// Calculate the normal of the Face
+		glm::vec3 normal = glm::cross(p1CSO - p0CSO, p2CSO - p0CSO);
+		float normalLength = glm::length(normal);
+		face.normal = (normalLength < sKEpsilon)? normal : normal / normalLength;
+
+		// Calculate the distance data of the Face
 		glm::vec3 closestPoint = utils::getClosestPointInPlane(glm::vec3(0.0f), { p0CSO, p1CSO, p2CSO });
 		float distance = glm::length(closestPoint);
 		auto [inside, closestPointBarycentricCoords] = utils::projectPointOnTriangle(
 			closestPoint, { p0CSO, p1CSO, p2CSO }, mPrecision
 		);
-		mFaceDistances.emplace(FaceDistanceData{ closestPoint, distance, inside, closestPointBarycentricCoords });
+		face.distanceData = { closestPoint, distance, inside, closestPointBarycentricCoords };
+
+		// Add the Face to the queue if its closest point is an internal point
+		// and it isn't degenerate
+		int iFace = static_cast<int>(mFaces.size()) - 1;
+		if (inside && (normalLength >= sKEpsilon)) {
+			mFaceQueue.push_back({ distance, iFace });
+			std::push_heap(mFaceQueue.begin(), mFaceQueue.end(), [](const QueuedFace& f1, const QueuedFace& f2) {
+				return f1.distance > f2.distance;
+			});
+		}
 
 		return iFace;
 	}
 
 
-	void Polytope::removeFace(int iFace)
+	void Polytope::calculateHorizon(const glm::vec3& point, int iFace, int iEdge)
+	{
+		Face& face = mFaces[iFace];
+		if (face.removed) {
+			return;
+		}
+
+		const glm::vec3 faceVertex = mVertices[face.vertices[0]].getCSOPosition();
+		if (glm::dot(point - faceVertex, face.normal) <= 0.0f) {
+			// The edge from which we arrived is an horizon one
+			mHorizon.push_back({ iFace, iEdge });
+		}
+		else {
+			// Remove the Face and continue searching through its other edges
+			face.removed = true;
+			mVisibleFaces.push_back(iFace);
+			for (int i = 1; i < 3; ++i) {
+				int iNeighbour = face.neighbours[(iEdge + i) % 3];
+				calculateHorizon(point, iNeighbour, getSharedEdge(iNeighbour, iFace));
+			}
+		}
+	}
+
+
+	int Polytope::getSharedEdge(int iFace, int iNeighbour) const
 	{
-		se::physics::removeFace(mMesh, iFace);
-		mFaceNormals.erase( mFaceNormals.begin().setIndex(iFace) );
-		mFaceDistances.erase( mFaceDistances.begin().setIndex(iFace) );
+		const Face& face = mFaces[iFace];
+		for (int i = 0; i < 3; ++i) {
+			if (face.neighbours[i] == iNeighbour) {
+				return i;
+			}
+		}
+
+		return -1;
 	}
 
 }
@@ -3,13 +3,9 @@
 
 #include "se/utils/FixedVector.h"
 #include "se/physics/collision/SupportPoint.h"
-#include "se/physics/collision/HalfEdgeMesh.h"
 
 namespace se::physics {
 
-	class ConvexCollider;
-
-
 	/**
 	 * Struct FaceDistanceData, it stores the distance data of a face to
 	 * the origin
@@ -35,87 +31,160 @@ namespace se::physics {
 	/**
 	 * Class Polytope, it's the class that holds the polytope data that the EPA
 	 * algorithm must expand.
-	 * This class also handles the Polytope creation from the simplex generated
-	 * by the GJK algorithm, which also serves as input to the EPA algorithm.
+	 * The Polytope is stored in flat arrays with a fixed capacity, so it can
+	 * be reused between EPA calls without doing any allocation. Its triangular
+	 * faces are never erased, only marked as removed, so the indices to them
+	 * are always valid until the next call to reset.
 	 */
 	class Polytope
 	{
+	public:		// Nested types
+		/** Holds the data of a triangular face of the Polytope */
+		struct Face
+		{
+			/** The indices of the vertices of the Face in counter-clockwise
+			 * order seen from outside of the Polytope */
+			int vertices[3];
+
+			/** The indices of the adjacent Faces. The Face at the index i is
+			 * the one that shares the edge that goes from the vertex i to the
+			 * vertex i + 1 */
+			int neighbours[3];
+
+			/** The normal vector of the Face */
+			glm::vec3 normal;
+
+			/** The distance data of the Face */
+			FaceDistanceData distanceData;
+
+			/** If the Face has been removed from the Polytope or not */
+			bool removed;
+		};
+
+		/** The maximum number of vertices of the Polytope */
+		static constexpr std::size_t kMaxVertices = 128;
+
+		/** The maximum number of Faces that can be added to the Polytope */
+		static constexpr std::size_t kMaxFaces = 4 * kMaxVertices;
+
+	private:
+		/** Holds an edge of the horizon seen from a new vertex */
+		struct HorizonEdge
+		{
+			/** The index of the non visible Face that contains the edge */
+			int iFace;
+
+			/** The index of the edge in the Face */
+			int iEdge;
+		};
+
+		/** Holds a Face index and its distance to the origin in the queue of
+		 * Faces to expand */
+		struct QueuedFace
+		{
+			/** The distance of the Face to the origin */
+			float distance;
+
+			/** The index of the Face */
+			int iFace;
+		};
+
 	private:	// Attributes
 		static constexpr float sKEpsilon = 0.0001f;
 
 		/** The precision of the calculated projections */
 		float mPrecision;
 
-		/** The Half-Edge Mesh with the convex hull of the current Mesh */
-		HalfEdgeMesh mMesh;
+		/** The SupportPoint of each vertex */
+		utils::FixedVector<SupportPoint, kMaxVertices> mVertices;
 
-		/** The normal vectors of each HEFace */
-		utils::PackedVector<glm::vec3> mFaceNormals;
+		/** All the Faces added to the Polytope, including the removed ones */
+		utils::FixedVector<Face, kMaxFaces> mFaces;
 
-		/** The distance data of eahc HEFace */
-		utils::PackedVector<FaceDistanceData> mFaceDistances;
+		/** A min heap with the Faces whose closest point to the origin is
+		 * inside them, ordered by their distance to the origin */
+		utils::FixedVector<QueuedFace, kMaxFaces> mFaceQueue;
 
-		/** The SupportPoint of each HEVertex */
-		utils::PackedVector<SupportPoint> mVertexSupportPoints;
+		/** The horizon edges calculated in the last expansion */
+		utils::FixedVector<HorizonEdge, kMaxFaces> mHorizon;
+
+		/** The Faces removed in the last expansion */
+		utils::FixedVector<int, kMaxFaces> mVisibleFaces;
 
 	public:		//Functions
-		/** Creates a new Polytope from the given simplex points by expanding it
-		 * until a tetrahedron is created
+		/** Creates a new empty Polytope */
+		Polytope() : mPrecision(0.0f) {};
+
+		/** Replaces the current Polytope data with the tetrahedron of the
+		 * given simplex points
 		 *
 		 * @param	simplex the 4 initial simplex points
 		 * @param	precision the precision of the projected points of the
 		 *			polytope */
-		Polytope(
+		void reset(
 			const utils::FixedVector<SupportPoint, 4>& simplex,
 			float precision
 		);
 
-		/** @return	the HalfEdgeMesh of the Polytope */
-		const HalfEdgeMesh& getMesh() const { return mMesh; };
-
-		/** @return	the normal vectors of the HEFaces of the Polytope's
-		 *			HalfEdgeMesh */
-		const utils::PackedVector<glm::vec3>& getNormals() const
-		{ return mFaceNormals; };
-
-		/** Returns the SupportPoint of the given Polytope HEVertex
+		/** Returns the SupportPoint of the given Polytope vertex
 		 *
-		 * @param	iVertex the index of the HEVertex in the Polytope
-		 * @return	the SupportPoint of the HEVertex */
+		 * @param	iVertex the index of the vertex in the Polytope
+		 * @return	the SupportPoint of the vertex */
 		const SupportPoint& getSupportPoint(int iVertex) const
-		{ return mVertexSupportPoints[iVertex]; };
+		{ return mVertices[iVertex]; };
 
-		/** Returns the normal vector of the given Polytope HEFace
+		/** Returns the given Polytope Face
 		 *
-		 * @param	iFace the index of the HEFace in the Polytope
-		 * @return	the normal vector of the HEFace */
-		const glm::vec3& getNormal(int iFace) const
-		{ return mFaceNormals[iFace]; };
+		 * @param	iFace the index of the Face in the Polytope
+		 * @return	the Face */
+		const Face& getFace(int iFace) const
+		{ return mFaces[iFace]; };
 
-		/** Returns the FaceDistanceData of the given Polytope HEFace
+		/** Removes the closest non removed Face to the origin from the queue
+		 * of Faces to expand
 		 *
-		 * @param	iFace the index of the HEFace in the Polytope
-		 * @return	the FaceDistanceData of the HEFace */
-		const FaceDistanceData& getDistanceData(int iFace) const
-		{ return mFaceDistances[iFace]; };
+		 * @return	the index of the Face, -1 if there are no more Faces in
+		 *			the queue */
+		int popClosestFace();
 
-		/** Creates a new HEVertex from the given SupportPoint and adds it to
-		 * the Polytope Mesh
+		/** Expands the Polytope with the given SupportPoint, removing all
+		 * the Faces that can be seen from it and connecting the horizon edges
+		 * to it
 		 *
-		 * @param	sp the SupportPoint used to create the HEVertex */
-		int addVertex(const SupportPoint& sp);
-
-		/** Creates a HEFace and pushes it at the front of the faces queue if
-		 * it's closer to the origin than the current head, at the back
-		 * otherwise
+		 * @param	sp the new SupportPoint
+		 * @param	iVisibleFace the index of a Face that can be seen from the
+		 *			SupportPoint
+		 * @return	true if the Polytope was expanded, false if there is no
+		 *			capacity left for the new vertex or Faces or if the given
+		 *			Face isn't visible. In this case the Polytope is not
+		 *			modified */
+		bool expand(const SupportPoint& sp, int iVisibleFace);
+	private:
+		/** Creates a new Face and adds it to the queue of Faces to expand if
+		 * the closest point to the origin is inside it and it isn't degenerate
 		 *
-		 * @param	faceIndices the indices of the new face's vertices */
-		int addFace(const utils::FixedVector<int, 3>& faceIndices);
-
-		/** Removes the given HEFace and its data from the Polytope
+		 * @param	iV0 the index of the first vertex of the Face
+		 * @param	iV1 the index of the second vertex of the Face
+		 * @param	iV2 the index of the third vertex of the Face
+		 * @return	the index of the new Face */
+		int addFace(int iV0, int iV1, int iV2);
+
+		/** Calculates the horizon edges seen from the given point, starting
+		 * from the given Face, and marks the visible Faces as removed
+		 *
+		 * @param	point the point from which the horizon will be calculated
+		 * @param	iFace the index of the Face to check
+		 * @param	iEdge the index of the edge of the Face from which we
+		 *			arrived to it */
+		void calculateHorizon(const glm::vec3& point, int iFace, int iEdge);
+
+		/** Returns the index of the edge of a Face that is shared with
+		 * another one
 		 *
-		 * @param	iFace the index of the HEFace to remove */
-		void removeFace(int iFace);
+		 * @param	iFace the index of the Face
+		 * @param	iNeighbour the index of the adjacent Face
+		 * @return	the index of the edge in the first Face */
+		int getSharedEdge(int iFace, int iNeighbour) const;
 	};
 
 }
@@ -0,0 +1,44 @@
+#include <algorithm>
+#include "QuerySnapshot.h"
+
+namespace se::physics {
+
+	QuerySnapshot::QuerySnapshot(
+		const std::vector<Collider*>& colliders,
+		std::vector<ColliderSPtr> colliderCopies
+	) : mColliders(colliders), mColliderCopies(std::move(colliderCopies)),
+		mAABBTree(std::make_shared<LazyAABBTree>())
+	{
+		mAABBs.reserve(mColliderCopies.size());
+		mLayers.reserve(mColliderCopies.size());
+		for (const ColliderSPtr& colliderCopy : mColliderCopies) {
+			mAABBs.push_back(colliderCopy->getAABB());
+			mLayers.push_back(colliderCopy->getLayers());
+		}
+	}
+
+
+	QuerySnapshot::QuerySnapshot(const QuerySnapshot& other, const Collider* collider) :
+		mColliders(other.mColliders), mColliderCopies(other.mColliderCopies),
+		mAABBs(other.mAABBs), mLayers(other.mLayers), mAABBTree(other.mAABBTree)
+	{
+		std::replace(mColliders.begin(), mColliders.end(), const_cast<Collider*>(collider), static_cast<Collider*>(nullptr));
+	}
+
+
+	bool QuerySnapshot::contains(const Collider* collider) const
+	{
+		return std::find(mColliders.begin(), mColliders.end(), collider) != mColliders.end();
+	}
+
+
+	const StaticAABBTree& QuerySnapshot::getAABBTree() const
+	{
+		std::call_once(mAABBTree->builtFlag, [this]() {
+			mAABBTree->tree.build(mAABBs.data(), mAABBs.size());
+		});
+
+		return mAABBTree->tree;
+	}
+
+}
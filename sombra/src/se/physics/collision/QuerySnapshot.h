@@ -0,0 +1,122 @@
+#ifndef QUERY_SNAPSHOT_H
+#define QUERY_SNAPSHOT_H
+
+#include <mutex>
+#include <memory>
+#include <vector>
+#include "se/physics/collision/Collider.h"
+#include "StaticAABBTree.h"
+
+namespace se::physics {
+
+	/**
+	 * Class QuerySnapshot, it holds an immutable copy of the Colliders of the
+	 * CollisionDetector, with their AABBs and layers, at the end of a
+	 * RigidBodyWorld update. It's used for executing the scene queries from
+	 * multiple threads without locking the CollisionDetector.
+	 * The StaticAABBTree of the Colliders is built the first time it's
+	 * needed, so the steps without any query don't pay for it.
+	 * The narrow phase of the queries uses the copies of the Colliders, with
+	 * their transforms and shape data at the moment of the snapshot, so the
+	 * queries can run while the RigidBodyWorld updates the Colliders.
+	 */
+	class QuerySnapshot
+	{
+	public:		// Nested types
+		using LayerMask = std::bitset<Collider::kMaxLayers>;
+		using ColliderSPtr = std::shared_ptr<const Collider>;
+	private:
+		/** Holds the StaticAABBTree and the flag used for building it only
+		 * once. It's shared between the copies of the QuerySnapshot */
+		struct LazyAABBTree
+		{
+			std::once_flag builtFlag;
+			StaticAABBTree tree;
+		};
+
+	private:	// Attributes
+		/** The Colliders of the QuerySnapshot, the removed ones are set to
+		 * nullptr so the indices of the StaticAABBTree remain valid */
+		std::vector<Collider*> mColliders;
+
+		/** The copies of the Colliders at the moment of the snapshot. They
+		 * are never modified, so they can be shared with other
+		 * QuerySnapshots */
+		std::vector<ColliderSPtr> mColliderCopies;
+
+		/** The AABBs of the Colliders at the moment of the snapshot */
+		std::vector<AABB> mAABBs;
+
+		/** The layers of the Colliders at the moment of the snapshot */
+		std::vector<LayerMask> mLayers;
+
+		/** The StaticAABBTree of @see mAABBs */
+		std::shared_ptr<LazyAABBTree> mAABBTree;
+
+	public:		// Functions
+		/** Creates a new QuerySnapshot
+		 *
+		 * @param	colliders the Colliders to store in the QuerySnapshot
+		 * @param	colliderCopies the copies of each of the Colliders */
+		QuerySnapshot(
+			const std::vector<Collider*>& colliders,
+			std::vector<ColliderSPtr> colliderCopies
+		);
+
+		/** Creates a copy of the given QuerySnapshot without the given
+		 * Collider. The StaticAABBTree is shared with the other one
+		 *
+		 * @param	other the QuerySnapshot to copy
+		 * @param	collider a pointer to the Collider to remove */
+		QuerySnapshot(const QuerySnapshot& other, const Collider* collider);
+
+		/** Checks if the given Collider is in the QuerySnapshot
+		 *
+		 * @param	collider a pointer to the Collider to check
+		 * @return	true if the Collider was found, false otherwise */
+		bool contains(const Collider* collider) const;
+
+		/** @return	the number of Colliders of the QuerySnapshot, including
+		 *			the removed ones */
+		std::size_t getNumColliders() const { return mColliders.size(); };
+
+		/** Returns the given Collider
+		 *
+		 * @param	iCollider the index of the Collider
+		 * @return	a pointer to the Collider, nullptr if it was removed */
+		Collider* getCollider(std::size_t iCollider) const
+		{ return mColliders[iCollider]; };
+
+		/** Returns the copy of the given Collider
+		 *
+		 * @param	iCollider the index of the Collider
+		 * @return	the Collider at the moment of the snapshot, it must only
+		 *			be used if the Collider wasn't removed */
+		const Collider& getColliderCopy(std::size_t iCollider) const
+		{ return *mColliderCopies[iCollider]; };
+
+		/** Returns the AABB of the given Collider
+		 *
+		 * @param	iCollider the index of the Collider
+		 * @return	the AABB of the Collider at the moment of the snapshot */
+		const AABB& getAABB(std::size_t iCollider) const
+		{ return mAABBs[iCollider]; };
+
+		/** Returns the layers of the given Collider
+		 *
+		 * @param	iCollider the index of the Collider
+		 * @return	the layers of the Collider at the moment of the
+		 *			snapshot */
+		const LayerMask& getLayers(std::size_t iCollider) const
+		{ return mLayers[iCollider]; };
+
+		/** @return	the StaticAABBTree of the Colliders AABBs, its primitives
+		 *			are the Collider indices. It's built in the first
+		 *			call, the function can be called from multiple threads
+		 *			at the same time */
+		const StaticAABBTree& getAABBTree() const;
+	};
+
+}
+
+#endif		// QUERY_SNAPSHOT_H
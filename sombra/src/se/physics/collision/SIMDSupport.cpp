@@ -0,0 +1,178 @@
+#include <limits>
+#include <algorithm>
+#include "SIMDSupport.h"
+
+#if defined(__AVX__)
+	#include <immintrin.h>
+	#define SOMBRA_SUPPORT_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+	#include <emmintrin.h>
+	#define SOMBRA_SUPPORT_SSE
+#endif
+
+namespace se::physics {
+
+	/** The maximum number of directions evaluated in the same pass over
+	 * the points */
+	static constexpr std::size_t kMaxBatchDirections = 4;
+
+
+	/** Holds the furthest point found in each SIMD lane for a direction */
+	struct LaneResults
+	{
+		/** The maximum number of lanes */
+		static constexpr std::size_t kMaxLanes = 8;
+
+		/** The distance of the furthest point of each lane */
+		float distances[kMaxLanes];
+
+		/** The index of the furthest point of each lane */
+		float indices[kMaxLanes];
+	};
+
+
+	/** Reduces the results of the given SIMD lanes to the index of the
+	 * furthest point, the ties are resolved with the smallest index
+	 *
+	 * @param	results the results of each lane
+	 * @param	numLanes the number of lanes
+	 * @return	the index of the furthest point */
+	static std::size_t reduceLanes(const LaneResults& results, std::size_t numLanes)
+	{
+		std::size_t iBestLane = 0;
+		for (std::size_t i = 1; i < numLanes; ++i) {
+			if ((results.distances[i] > results.distances[iBestLane])
+				|| ((results.distances[i] == results.distances[iBestLane]) && (results.indices[i] < results.indices[iBestLane]))
+			) {
+				iBestLane = i;
+			}
+		}
+
+		return static_cast<std::size_t>(results.indices[iBestLane]);
+	}
+
+
+	/** Calculates the furthest points in up to kMaxBatchDirections
+	 * directions with a single pass over the points
+	 *
+	 * @see getFurthestPoints */
+	static void getFurthestPointsBatch(
+		const float* xs, const float* ys, const float* zs, std::size_t numPoints,
+		const glm::vec3* directions, std::size_t numDirections,
+		std::size_t* indices
+	) {
+		LaneResults results[kMaxBatchDirections];
+
+#if defined(SOMBRA_SUPPORT_AVX)
+		constexpr std::size_t kNumLanes = 8;
+
+		__m256 dxs[kMaxBatchDirections], dys[kMaxBatchDirections], dzs[kMaxBatchDirections];
+		__m256 bestDistances[kMaxBatchDirections], bestIndices[kMaxBatchDirections];
+		for (std::size_t j = 0; j < numDirections; ++j) {
+			dxs[j] = _mm256_set1_ps(directions[j].x);
+			dys[j] = _mm256_set1_ps(directions[j].y);
+			dzs[j] = _mm256_set1_ps(directions[j].z);
+			bestDistances[j] = _mm256_set1_ps(-std::numeric_limits<float>::max());
+			bestIndices[j] = _mm256_setzero_ps();
+		}
+
+		__m256 currentIndices = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+		const __m256 indexIncrement = _mm256_set1_ps(static_cast<float>(kNumLanes));
+		for (std::size_t i = 0; i < numPoints; i += kNumLanes) {
+			__m256 x = _mm256_loadu_ps(xs + i), y = _mm256_loadu_ps(ys + i), z = _mm256_loadu_ps(zs + i);
+			for (std::size_t j = 0; j < numDirections; ++j) {
+				__m256 distance = _mm256_add_ps(
+					_mm256_add_ps(_mm256_mul_ps(x, dxs[j]), _mm256_mul_ps(y, dys[j])),
+					_mm256_mul_ps(z, dzs[j])
+				);
+				__m256 mask = _mm256_cmp_ps(distance, bestDistances[j], _CMP_GT_OQ);
+				bestDistances[j] = _mm256_blendv_ps(bestDistances[j], distance, mask);
+				bestIndices[j] = _mm256_blendv_ps(bestIndices[j], currentIndices, mask);
+			}
+			currentIndices = _mm256_add_ps(currentIndices, indexIncrement);
+		}
+
+		for (std::size_t j = 0; j < numDirections; ++j) {
+			_mm256_storeu_ps(results[j].distances, bestDistances[j]);
+			_mm256_storeu_ps(results[j].indices, bestIndices[j]);
+		}
+#elif defined(SOMBRA_SUPPORT_SSE)
+		constexpr std::size_t kNumLanes = 4;
+
+		__m128 dxs[kMaxBatchDirections], dys[kMaxBatchDirections], dzs[kMaxBatchDirections];
+		__m128 bestDistances[kMaxBatchDirections], bestIndices[kMaxBatchDirections];
+		for (std::size_t j = 0; j < numDirections; ++j) {
+			dxs[j] = _mm_set1_ps(directions[j].x);
+			dys[j] = _mm_set1_ps(directions[j].y);
+			dzs[j] = _mm_set1_ps(directions[j].z);
+			bestDistances[j] = _mm_set1_ps(-std::numeric_limits<float>::max());
+			bestIndices[j] = _mm_setzero_ps();
+		}
+
+		__m128 currentIndices = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+		const __m128 indexIncrement = _mm_set1_ps(static_cast<float>(kNumLanes));
+		for (std::size_t i = 0; i < numPoints; i += kNumLanes) {
+			__m128 x = _mm_loadu_ps(xs + i), y = _mm_loadu_ps(ys + i), z = _mm_loadu_ps(zs + i);
+			for (std::size_t j = 0; j < numDirections; ++j) {
+				__m128 distance = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(x, dxs[j]), _mm_mul_ps(y, dys[j])),
+					_mm_mul_ps(z, dzs[j])
+				);
+				__m128 mask = _mm_cmpgt_ps(distance, bestDistances[j]);
+				bestDistances[j] = _mm_or_ps(_mm_and_ps(mask, distance), _mm_andnot_ps(mask, bestDistances[j]));
+				bestIndices[j] = _mm_or_ps(_mm_and_ps(mask, currentIndices), _mm_andnot_ps(mask, bestIndices[j]));
+			}
+			currentIndices = _mm_add_ps(currentIndices, indexIncrement);
+		}
+
+		for (std::size_t j = 0; j < numDirections; ++j) {
+			_mm_storeu_ps(results[j].distances, bestDistances[j]);
+			_mm_storeu_ps(results[j].indices, bestIndices[j]);
+		}
+#else
+		constexpr std::size_t kNumLanes = 1;
+
+		for (std::size_t j = 0; j < numDirections; ++j) {
+			results[j].distances[0] = -std::numeric_limits<float>::max();
+			results[j].indices[0] = 0.0f;
+		}
+
+		for (std::size_t i = 0; i < numPoints; ++i) {
+			for (std::size_t j = 0; j < numDirections; ++j) {
+				float distance = xs[i] * directions[j].x + ys[i] * directions[j].y + zs[i] * directions[j].z;
+				if (distance > results[j].distances[0]) {
+					results[j].distances[0] = distance;
+					results[j].indices[0] = static_cast<float>(i);
+				}
+			}
+		}
+#endif
+
+		for (std::size_t j = 0; j < numDirections; ++j) {
+			indices[j] = reduceLanes(results[j], kNumLanes);
+		}
+	}
+
+
+	std::size_t getFurthestPoint(
+		const float* xs, const float* ys, const float* zs, std::size_t numPoints,
+		const glm::vec3& direction
+	) {
+		std::size_t ret = 0;
+		getFurthestPointsBatch(xs, ys, zs, numPoints, &direction, 1, &ret);
+		return ret;
+	}
+
+
+	void getFurthestPoints(
+		const float* xs, const float* ys, const float* zs, std::size_t numPoints,
+		const glm::vec3* directions, std::size_t numDirections,
+		std::size_t* indices
+	) {
+		for (std::size_t i = 0; i < numDirections; i += kMaxBatchDirections) {
+			std::size_t batchSize = std::min(kMaxBatchDirections, numDirections - i);
+			getFurthestPointsBatch(xs, ys, zs, numPoints, directions + i, batchSize, indices + i);
+		}
+	}
+
+}
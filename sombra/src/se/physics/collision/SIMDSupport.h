@@ -0,0 +1,54 @@
+#ifndef SIMD_SUPPORT_H
+#define SIMD_SUPPORT_H
+
+#include <cstddef>
+#include <glm/glm.hpp>
+
+namespace se::physics {
+
+	/** The number of points that must be evaluated together by the support
+	 * functions, the point arrays must be padded to a multiple of it */
+	constexpr std::size_t kSupportPointsPadding = 8;
+
+
+	/** Calculates the furthest point in the given direction from a set of
+	 * points stored in Structure of Arrays layout. It uses AVX or SSE
+	 * instructions when they are available, or a scalar loop otherwise
+	 *
+	 * @param	xs the x coordinates of the points
+	 * @param	ys the y coordinates of the points
+	 * @param	zs the z coordinates of the points
+	 * @param	numPoints the number of points, it must be a multiple of
+	 *			kSupportPointsPadding
+	 * @param	direction the direction in which we want to search
+	 * @return	the index of the furthest point. If there are multiple points
+	 *			at the same distance, the first one is returned */
+	std::size_t getFurthestPoint(
+		const float* xs, const float* ys, const float* zs, std::size_t numPoints,
+		const glm::vec3& direction
+	);
+
+
+	/** Calculates the furthest points in each of the given directions from a
+	 * set of points stored in Structure of Arrays layout. The points are
+	 * read only once for every four directions
+	 *
+	 * @param	xs the x coordinates of the points
+	 * @param	ys the y coordinates of the points
+	 * @param	zs the z coordinates of the points
+	 * @param	numPoints the number of points, it must be a multiple of
+	 *			kSupportPointsPadding
+	 * @param	directions a pointer to the directions in which we want to
+	 *			search
+	 * @param	numDirections the number of directions
+	 * @param	indices a pointer to the array where the index of the
+	 *			furthest point in each direction will be stored */
+	void getFurthestPoints(
+		const float* xs, const float* ys, const float* zs, std::size_t numPoints,
+		const glm::vec3* directions, std::size_t numDirections,
+		std::size_t* indices
+	);
+
+}
+
+#endif		// SIMD_SUPPORT_H
@@ -0,0 +1,394 @@
+#include <limits>
+#include <algorithm>
+#include "StaticAABBTree.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+	#include <emmintrin.h>
+	#define SOMBRA_STATIC_TREE_SSE
+#endif
+
+namespace se::physics {
+
+	/** Holds the data of a Node of the binary Tree that is later collapsed
+	 * into the StaticAABBTree */
+	struct BinaryNode
+	{
+		/** The AABB of the Node */
+		AABB aabb;
+
+		/** The indices of the children Nodes, only for inner Nodes */
+		std::uint32_t children[2] = {};
+
+		/** The index of the first primitive of the Node */
+		std::uint32_t first = 0;
+
+		/** The number of primitives of the Node, 0 if it's an inner Node */
+		std::uint32_t count = 0;
+	};
+
+
+	/** Holds all the data used while building the binary Tree */
+	struct BuildData
+	{
+		/** The AABBs of the primitives */
+		const AABB* aabbs;
+
+		/** The center of the AABB of each primitive */
+		std::vector<glm::vec3> centroids;
+
+		/** The indices of the primitives, sorted by Node */
+		std::vector<std::uint32_t>& primitives;
+
+		/** The Nodes of the binary Tree, the first one is the root */
+		std::vector<BinaryNode> nodes;
+	};
+
+
+	/** Holds the primitives that fall in a bin of the SAH evaluation */
+	struct Bin
+	{
+		/** The AABB of the primitives of the Bin */
+		AABB aabb = {
+			glm::vec3( std::numeric_limits<float>::max()),
+			glm::vec3(-std::numeric_limits<float>::max())
+		};
+
+		/** The number of primitives of the Bin */
+		std::size_t count = 0;
+	};
+
+
+	/** Calculates the area of the AABB of the given Bin
+	 *
+	 * @param	bin the Bin to calculate its area
+	 * @return	the area of the AABB of the Bin, 0 if it's empty */
+	static float calculateBinArea(const Bin& bin)
+	{
+		return (bin.count > 0)? calculateArea(bin.aabb) : 0.0f;
+	}
+
+
+	/** Recursively builds the binary Tree of the given primitives with the
+	 * binned Surface Area Heuristic
+	 *
+	 * @param	data the data of the build
+	 * @param	first the index of the first primitive of the Node
+	 * @param	count the number of primitives of the Node
+	 * @param	depth the depth of the Node
+	 * @return	the index of the new Node */
+	static std::uint32_t buildBinaryNode(BuildData& data, std::uint32_t first, std::uint32_t count, std::size_t depth)
+	{
+		constexpr std::size_t kNumBins = StaticAABBTree::kNumBins;
+		constexpr std::size_t kMaxLeafSize = StaticAABBTree::kMaxLeafSize;
+		constexpr std::size_t kMaxSAHDepth = StaticAABBTree::kMaxSAHDepth;
+		constexpr float kTraversalCost = 1.0f;
+
+		auto itBegin = data.primitives.begin() + first, itEnd = itBegin + count;
+
+		AABB aabb = data.aabbs[*itBegin];
+		AABB centroidsAABB = { data.centroids[*itBegin], data.centroids[*itBegin] };
+		for (auto it = itBegin + 1; it != itEnd; ++it) {
+			aabb.minimum = glm::min(aabb.minimum, data.aabbs[*it].minimum);
+			aabb.maximum = glm::max(aabb.maximum, data.aabbs[*it].maximum);
+			centroidsAABB.minimum = glm::min(centroidsAABB.minimum, data.centroids[*it]);
+			centroidsAABB.maximum = glm::max(centroidsAABB.maximum, data.centroids[*it]);
+		}
+
+		auto iNode = static_cast<std::uint32_t>(data.nodes.size());
+		data.nodes.emplace_back();
+		data.nodes[iNode].aabb = aabb;
+
+		if (count == 1) {
+			data.nodes[iNode].first = first;
+			data.nodes[iNode].count = count;
+			return iNode;
+		}
+
+		// Search the best split with the SAH
+		int bestAxis = -1;
+		std::size_t bestBin = 0;
+		float bestCost = std::numeric_limits<float>::max();
+		if (depth < kMaxSAHDepth) {
+			for (int axis = 0; axis < 3; ++axis) {
+				float axisMinimum = centroidsAABB.minimum[axis];
+				float axisLength = centroidsAABB.maximum[axis] - axisMinimum;
+				if (axisLength <= 0.0f) {
+					continue;
+				}
+
+				Bin bins[kNumBins];
+				float binScale = kNumBins / axisLength;
+				for (auto it = itBegin; it != itEnd; ++it) {
+					auto iBin = std::min(kNumBins - 1, static_cast<std::size_t>((data.centroids[*it][axis] - axisMinimum) * binScale));
+					bins[iBin].aabb.minimum = glm::min(bins[iBin].aabb.minimum, data.aabbs[*it].minimum);
+					bins[iBin].aabb.maximum = glm::max(bins[iBin].aabb.maximum, data.aabbs[*it].maximum);
+					bins[iBin].count++;
+				}
+
+				// Accumulate the costs of the right side from the last bin and
+				// the left side from the first one
+				float rightCosts[kNumBins];
+				Bin accumulated;
+				for (std::size_t i = kNumBins - 1; i > 0; --i) {
+					accumulated.aabb = expand(accumulated.aabb, bins[i].aabb);
+					accumulated.count += bins[i].count;
+					rightCosts[i] = calculateBinArea(accumulated) * accumulated.count;
+				}
+
+				accumulated = Bin();
+				for (std::size_t i = 0; i < kNumBins - 1; ++i) {
+					accumulated.aabb = expand(accumulated.aabb, bins[i].aabb);
+					accumulated.count += bins[i].count;
+					float cost = calculateBinArea(accumulated) * accumulated.count + rightCosts[i + 1];
+					if ((accumulated.count > 0) && (accumulated.count < count) && (cost < bestCost)) {
+						bestAxis = axis;
+						bestBin = i;
+						bestCost = cost;
+					}
+				}
+			}
+		}
+
+		float leafCost = calculateArea(aabb) * count;
+		float splitCost = kTraversalCost * calculateArea(aabb) + bestCost;
+		if ((count <= kMaxLeafSize) && ((bestAxis < 0) || (leafCost <= splitCost))) {
+			data.nodes[iNode].first = first;
+			data.nodes[iNode].count = count;
+			return iNode;
+		}
+
+		// Split the primitives
+		auto itMiddle = itBegin + count / 2;
+		if (bestAxis >= 0) {
+			float axisMinimum = centroidsAABB.minimum[bestAxis];
+			float binScale = kNumBins / (centroidsAABB.maximum[bestAxis] - axisMinimum);
+			itMiddle = std::partition(itBegin, itEnd, [&](std::uint32_t iPrimitive) {
+				auto iBin = std::min(kNumBins - 1, static_cast<std::size_t>((data.centroids[iPrimitive][bestAxis] - axisMinimum) * binScale));
+				return iBin <= bestBin;
+			});
+		}
+		else {
+			// There is no valid SAH split, so the primitives are split by the
+			// median of the longest axis
+			glm::vec3 lengths = centroidsAABB.maximum - centroidsAABB.minimum;
+			int axis = (lengths.x > lengths.y)? ((lengths.x > lengths.z)? 0 : 2) : ((lengths.y > lengths.z)? 1 : 2);
+			std::nth_element(itBegin, itMiddle, itEnd, [&](std::uint32_t iPrimitive1, std::uint32_t iPrimitive2) {
+				return data.centroids[iPrimitive1][axis] < data.centroids[iPrimitive2][axis];
+			});
+		}
+
+		auto leftCount = static_cast<std::uint32_t>(itMiddle - itBegin);
+		std::uint32_t leftChild = buildBinaryNode(data, first, leftCount, depth + 1);
+		std::uint32_t rightChild = buildBinaryNode(data, first + leftCount, count - leftCount, depth + 1);
+		data.nodes[iNode].children[0] = leftChild;
+		data.nodes[iNode].children[1] = rightChild;
+		return iNode;
+	}
+
+
+	/** Recursively collapses the binary Tree Nodes into StaticAABBTree Nodes
+	 *
+	 * @param	binaryNodes the Nodes of the binary Tree
+	 * @param	iBinaryNode the index of the binary Node to collapse
+	 * @param	nodes the Nodes of the StaticAABBTree
+	 * @return	the index of the new StaticAABBTree Node */
+	static std::uint32_t collapseBinaryNode(
+		const std::vector<BinaryNode>& binaryNodes, std::uint32_t iBinaryNode,
+		std::vector<StaticAABBTree::Node>& nodes
+	) {
+		constexpr std::size_t kNodeWidth = StaticAABBTree::kNodeWidth;
+
+		// Open the inner children with the largest area until the Node is full
+		std::uint32_t children[kNodeWidth] = { iBinaryNode };
+		std::size_t numChildren = 1;
+		bool canOpen = true;
+		while (canOpen) {
+			canOpen = false;
+
+			std::size_t iLargest = 0;
+			float largestArea = -1.0f;
+			for (std::size_t i = 0; i < numChildren; ++i) {
+				const BinaryNode& child = binaryNodes[children[i]];
+				float area = calculateArea(child.aabb);
+				if ((child.count == 0) && (area > largestArea)) {
+					iLargest = i;
+					largestArea = area;
+				}
+			}
+
+			if ((largestArea >= 0.0f) && (numChildren < kNodeWidth)) {
+				const BinaryNode& child = binaryNodes[children[iLargest]];
+				children[iLargest] = child.children[0];
+				children[numChildren++] = child.children[1];
+				canOpen = true;
+			}
+		}
+
+		auto iNode = static_cast<std::uint32_t>(nodes.size());
+		nodes.emplace_back();
+		nodes[iNode].numChildren = static_cast<std::uint32_t>(numChildren);
+		for (std::size_t i = 0; i < kNodeWidth; ++i) {
+			// The unused children are left as empty AABBs
+			const AABB aabb = (i < numChildren)? binaryNodes[children[i]].aabb : AABB();
+			for (int axis = 0; axis < 3; ++axis) {
+				nodes[iNode].minimums[axis][i] = aabb.minimum[axis];
+				nodes[iNode].maximums[axis][i] = aabb.maximum[axis];
+			}
+			nodes[iNode].children[i] = 0;
+			nodes[iNode].counts[i] = 0;
+		}
+
+		for (std::size_t i = 0; i < numChildren; ++i) {
+			const BinaryNode& child = binaryNodes[children[i]];
+			if (child.count > 0) {
+				nodes[iNode].children[i] = child.first;
+				nodes[iNode].counts[i] = child.count;
+			}
+			else {
+				std::uint32_t iChildNode = collapseBinaryNode(binaryNodes, children[i], nodes);
+				nodes[iNode].children[i] = iChildNode;
+			}
+		}
+
+		return iNode;
+	}
+
+
+	void StaticAABBTree::build(const AABB* aabbs, std::size_t numAABBs)
+	{
+		mNodes.clear();
+		mPrimitives.clear();
+		mAABB = AABB();
+		if (numAABBs == 0) {
+			return;
+		}
+
+		mPrimitives.reserve(numAABBs);
+		BuildData data = { aabbs, {}, mPrimitives, {} };
+		data.centroids.reserve(numAABBs);
+		for (std::size_t i = 0; i < numAABBs; ++i) {
+			mPrimitives.push_back(static_cast<std::uint32_t>(i));
+			data.centroids.push_back(0.5f * (aabbs[i].minimum + aabbs[i].maximum));
+		}
+		data.nodes.reserve(2 * numAABBs);
+
+		buildBinaryNode(data, 0, static_cast<std::uint32_t>(numAABBs), 0);
+		mAABB = data.nodes.front().aabb;
+
+		mNodes.reserve(data.nodes.size() / 2 + 1);
+		collapseBinaryNode(data.nodes, 0, mNodes);
+		mNodes.shrink_to_fit();
+	}
+
+// Private functions
+	unsigned int StaticAABBTree::calculateOverlapMask(const Node& node, const AABB& aabb, float epsilon)
+	{
+		unsigned int mask = 0;
+
+#ifdef SOMBRA_STATIC_TREE_SSE
+		__m128 overlaps = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		for (int axis = 0; axis < 3; ++axis) {
+			__m128 queryMinimum = _mm_set1_ps(aabb.minimum[axis] - epsilon);
+			__m128 queryMaximum = _mm_set1_ps(aabb.maximum[axis] + epsilon);
+			__m128 childMinimums = _mm_load_ps(node.minimums[axis]);
+			__m128 childMaximums = _mm_load_ps(node.maximums[axis]);
+			overlaps = _mm_and_ps(overlaps, _mm_and_ps(
+				_mm_cmple_ps(queryMinimum, childMaximums),
+				_mm_cmpge_ps(queryMaximum, childMinimums)
+			));
+		}
+		mask = static_cast<unsigned int>(_mm_movemask_ps(overlaps));
+#else
+		for (std::size_t i = 0; i < kNodeWidth; ++i) {
+			bool overlaps = true;
+			for (int axis = 0; axis < 3; ++axis) {
+				overlaps = overlaps
+					&& (aabb.minimum[axis] - epsilon <= node.maximums[axis][i])
+					&& (aabb.maximum[axis] + epsilon >= node.minimums[axis][i]);
+			}
+			mask |= overlaps? (1u << i) : 0u;
+		}
+#endif
+
+		return mask;
+	}
+
+
+	unsigned int StaticAABBTree::calculateIntersectionMask(const Node& node, const Ray& ray, float epsilon)
+	{
+		unsigned int mask = 0;
+
+#ifdef SOMBRA_STATIC_TREE_SSE
+		__m128 tMin = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+		__m128 tMax = _mm_set1_ps(std::numeric_limits<float>::infinity());
+		for (int axis = 0; axis < 3; ++axis) {
+			__m128 origin = _mm_set1_ps(ray.origin[axis]);
+			__m128 invertedDirection = _mm_set1_ps(ray.invertedDirection[axis]);
+			__m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minimums[axis]), origin), invertedDirection);
+			__m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maximums[axis]), origin), invertedDirection);
+			tMin = _mm_max_ps(tMin, _mm_min_ps(t1, t2));
+			tMax = _mm_min_ps(tMax, _mm_max_ps(t1, t2));
+		}
+		__m128 intersects = _mm_cmpgt_ps(_mm_add_ps(tMax, _mm_set1_ps(epsilon)), tMin);
+		mask = static_cast<unsigned int>(_mm_movemask_ps(intersects));
+#else
+		for (std::size_t i = 0; i < kNodeWidth; ++i) {
+			float tMin = -std::numeric_limits<float>::infinity();
+			float tMax = std::numeric_limits<float>::infinity();
+			for (int axis = 0; axis < 3; ++axis) {
+				float t1 = (node.minimums[axis][i] - ray.origin[axis]) * ray.invertedDirection[axis];
+				float t2 = (node.maximums[axis][i] - ray.origin[axis]) * ray.invertedDirection[axis];
+				tMin = std::max(tMin, std::min(t1, t2));
+				tMax = std::min(tMax, std::max(t1, t2));
+			}
+			mask |= (tMax + epsilon > tMin)? (1u << i) : 0u;
+		}
+#endif
+
+		return mask;
+	}
+
+
+
+	unsigned int StaticAABBTree::calculateSegmentIntersectionMask(
+		const Node& node, const Ray& ray, const glm::vec3& halfExtents,
+		float epsilon, float maxDistance, float (&distances)[kNodeWidth]
+	) {
+		unsigned int mask = 0;
+
+#ifdef SOMBRA_STATIC_TREE_SSE
+		__m128 tMin = _mm_setzero_ps();
+		__m128 tMax = _mm_set1_ps(maxDistance + epsilon);
+		for (int axis = 0; axis < 3; ++axis) {
+			__m128 origin = _mm_set1_ps(ray.origin[axis]);
+			__m128 invertedDirection = _mm_set1_ps(ray.invertedDirection[axis]);
+			__m128 halfExtent = _mm_set1_ps(halfExtents[axis]);
+			__m128 minimums = _mm_sub_ps(_mm_load_ps(node.minimums[axis]), halfExtent);
+			__m128 maximums = _mm_add_ps(_mm_load_ps(node.maximums[axis]), halfExtent);
+			__m128 t1 = _mm_mul_ps(_mm_sub_ps(minimums, origin), invertedDirection);
+			__m128 t2 = _mm_mul_ps(_mm_sub_ps(maximums, origin), invertedDirection);
+			tMin = _mm_max_ps(tMin, _mm_min_ps(t1, t2));
+			tMax = _mm_min_ps(tMax, _mm_max_ps(t1, t2));
+		}
+		__m128 intersects = _mm_cmpgt_ps(_mm_add_ps(tMax, _mm_set1_ps(epsilon)), tMin);
+		mask = static_cast<unsigned int>(_mm_movemask_ps(intersects));
+		_mm_storeu_ps(distances, tMin);
+#else
+		for (std::size_t i = 0; i < kNodeWidth; ++i) {
+			float tMin = 0.0f;
+			float tMax = maxDistance + epsilon;
+			for (int axis = 0; axis < 3; ++axis) {
+				float t1 = (node.minimums[axis][i] - halfExtents[axis] - ray.origin[axis]) * ray.invertedDirection[axis];
+				float t2 = (node.maximums[axis][i] + halfExtents[axis] - ray.origin[axis]) * ray.invertedDirection[axis];
+				tMin = std::max(tMin, std::min(t1, t2));
+				tMax = std::min(tMax, std::max(t1, t2));
+			}
+			mask |= (tMax + epsilon > tMin)? (1u << i) : 0u;
+			distances[i] = tMin;
+		}
+#endif
+
+		return mask;
+	}
+
+}
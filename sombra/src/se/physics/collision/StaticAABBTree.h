@@ -0,0 +1,196 @@
+#ifndef STATIC_AABB_TREE_H
+#define STATIC_AABB_TREE_H
+
+#include <vector>
+#include <cstdint>
+#include "se/physics/collision/AABB.h"
+
+namespace se::physics {
+
+	/**
+	 * Class StaticAABBTree, it's an immutable AABB Tree built with the binned
+	 * Surface Area Heuristic, so it has a better quality than the
+	 * AABBAVLTree at the cost of a slower build. It's meant for static data
+	 * like the triangles of a TriangleMesh.
+	 * Each Node has up to kNodeWidth children whose AABBs are stored in
+	 * Structure of Arrays layout, so all of them can be tested at once with
+	 * SIMD instructions. The Nodes and the primitive indices are stored in
+	 * flat arrays in depth first order.
+	 */
+	class StaticAABBTree
+	{
+	public:		// Nested types
+		/** The maximum number of children of each Node */
+		static constexpr std::size_t kNodeWidth = 4;
+
+		/** The maximum number of primitives in each leaf */
+		static constexpr std::size_t kMaxLeafSize = 4;
+
+		/** The number of bins used for evaluating the SAH of each split */
+		static constexpr std::size_t kNumBins = 16;
+
+		/** The maximum depth at which the SAH is used, the deeper Nodes are
+		 * split by the median so the depth of the Tree is bounded */
+		static constexpr std::size_t kMaxSAHDepth = 32;
+
+		/** Holds the data of an inner Node of the Tree */
+		struct alignas(16) Node
+		{
+			/** The minimum coordinates of the AABB of each child, indexed
+			 * by axis and then by child */
+			float minimums[3][kNodeWidth];
+
+			/** The maximum coordinates of the AABB of each child, indexed
+			 * by axis and then by child */
+			float maximums[3][kNodeWidth];
+
+			/** The index of the Node of each child if it's an inner one, or
+			 * the index of its first primitive in the primitive indices array
+			 * if it's a leaf */
+			std::uint32_t children[kNodeWidth];
+
+			/** The number of primitives of each child, 0 if it's an inner
+			 * Node */
+			std::uint32_t counts[kNodeWidth];
+
+			/** The number of children of the Node */
+			std::uint32_t numChildren;
+		};
+
+	private:	// Attributes
+		/** The size of the stack used for traversing the Tree, the median
+		 * splits add at most 32 levels after kMaxSAHDepth */
+		static constexpr std::size_t kStackSize =
+			(kNodeWidth - 1) * (kMaxSAHDepth + 32) + 1;
+
+		/** The Nodes of the Tree, the first one is the root */
+		std::vector<Node> mNodes;
+
+		/** The indices of the primitives of all the leaves */
+		std::vector<std::uint32_t> mPrimitives;
+
+		/** The AABB of the whole Tree */
+		AABB mAABB;
+
+	public:		// Functions
+		/** Builds the Tree from the given AABBs, replacing any previous data
+		 *
+		 * @param	aabbs a pointer to the AABBs of the primitives, the index
+		 *			of each AABB will be used as the primitive index
+		 * @param	numAABBs the number of AABBs */
+		void build(const AABB* aabbs, std::size_t numAABBs);
+
+		/** @return	the Nodes of the Tree */
+		const std::vector<Node>& getNodes() const { return mNodes; };
+
+		/** @return	the number of primitives in the Tree */
+		std::size_t getNumPrimitives() const { return mPrimitives.size(); };
+
+		/** @return	the AABB of all the primitives */
+		const AABB& getAABB() const { return mAABB; };
+
+		/** Calculates all the primitives whose leaves overlaps with the given
+		 * AABB
+		 *
+		 * @param	aabb the AABB to compare
+		 * @param	epsilon the epsilon value used for the comparisons
+		 * @param	callback the function that will be called for every
+		 *			primitive in a leaf overlaping with the AABB with the
+		 *			primitive index as parameter */
+		template <typename F>
+		void calculateOverlapsWith(
+			const AABB& aabb, float epsilon, F&& callback
+		) const;
+
+		/** Calculates all the primitives whose leaves intersects with the
+		 * given ray
+		 *
+		 * @param	ray the ray to test
+		 * @param	epsilon the epsilon value used for the comparisons
+		 * @param	callback the function that will be called for every
+		 *			primitive in a leaf intersecting with the ray with the
+		 *			primitive index as parameter */
+		template <typename F>
+		void calculateIntersectionsWith(
+			const Ray& ray, float epsilon, F&& callback
+		) const;
+
+		/** Calculates the primitives whose leaves intersects with the given
+		 * ray segment from the closest one to the furthest one. The segment
+		 * is shortened with the distances returned by the callback, so the
+		 * leaves further than the closest hit found aren't visited. The
+		 * AABBs of the leaves can be enlarged for sweeping an AABB centered
+		 * at the ray origin instead of a ray
+		 *
+		 * @param	ray the ray to test
+		 * @param	halfExtents the half size of the AABB to sweep, added in
+		 *			every direction to the AABBs of the Tree
+		 * @param	epsilon the epsilon value used for the comparisons
+		 * @param	maxDistance the maximum distance along the ray direction
+		 *			of the segment
+		 * @param	callback the function that will be called for every
+		 *			primitive in a leaf intersecting with the segment with the
+		 *			primitive index and the current maximum distance as
+		 *			parameters. It must return the new maximum distance */
+		template <typename F>
+		void calculateClosestIntersectionsWith(
+			const Ray& ray, const glm::vec3& halfExtents,
+			float epsilon, float maxDistance, F&& callback
+		) const;
+	private:
+		/** Tests the AABBs of the children of the given Node against the
+		 * given AABB
+		 *
+		 * @param	node the Node to test
+		 * @param	aabb the AABB to compare
+		 * @param	epsilon the epsilon value used for the comparisons
+		 * @return	a mask with the bit of each overlaping child set */
+		static unsigned int calculateOverlapMask(
+			const Node& node, const AABB& aabb, float epsilon
+		);
+
+		/** Tests the AABBs of the children of the given Node against the
+		 * given ray
+		 *
+		 * @param	node the Node to test
+		 * @param	ray the ray to test
+		 * @param	epsilon the epsilon value used for the comparisons
+		 * @return	a mask with the bit of each intersecting child set */
+		static unsigned int calculateIntersectionMask(
+			const Node& node, const Ray& ray, float epsilon
+		);
+
+		/** Tests the AABBs of the children of the given Node against the
+		 * given ray segment
+		 *
+		 * @param	node the Node to test
+		 * @param	ray the ray to test
+		 * @param	halfExtents the size added in every direction to the
+		 *			AABBs of the children
+		 * @param	epsilon the epsilon value used for the comparisons
+		 * @param	maxDistance the maximum distance along the ray direction
+		 *			of the segment
+		 * @param	distances the array where the distance to the entry point
+		 *			of the segment in each child AABB will be stored
+		 * @return	a mask with the bit of each intersecting child set */
+		static unsigned int calculateSegmentIntersectionMask(
+			const Node& node, const Ray& ray, const glm::vec3& halfExtents,
+			float epsilon, float maxDistance, float (&distances)[kNodeWidth]
+		);
+
+		/** Traverses the Tree calling the given callback for every primitive
+		 * in the leaves that pass the given Node test
+		 *
+		 * @param	testNode the function used for calculating the mask of
+		 *			the children of a Node to visit
+		 * @param	callback the function to call with each primitive
+		 *			index */
+		template <typename T, typename F>
+		void traverse(T&& testNode, F&& callback) const;
+	};
+
+}
+
+#include "StaticAABBTree.hpp"
+
+#endif		// STATIC_AABB_TREE_H
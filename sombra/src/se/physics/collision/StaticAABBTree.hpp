@@ -0,0 +1,119 @@
+#ifndef STATIC_AABB_TREE_HPP
+#define STATIC_AABB_TREE_HPP
+
+namespace se::physics {
+
+	template <typename F>
+	void StaticAABBTree::calculateOverlapsWith(const AABB& aabb, float epsilon, F&& callback) const
+	{
+		traverse(
+			[&](const Node& node) { return calculateOverlapMask(node, aabb, epsilon); },
+			std::forward<F>(callback)
+		);
+	}
+
+
+	template <typename F>
+	void StaticAABBTree::calculateIntersectionsWith(const Ray& ray, float epsilon, F&& callback) const
+	{
+		traverse(
+			[&](const Node& node) { return calculateIntersectionMask(node, ray, epsilon); },
+			std::forward<F>(callback)
+		);
+	}
+
+
+	template <typename F>
+	void StaticAABBTree::calculateClosestIntersectionsWith(
+		const Ray& ray, const glm::vec3& halfExtents,
+		float epsilon, float maxDistance, F&& callback
+	) const
+	{
+		if (mNodes.empty()) {
+			return;
+		}
+
+		struct StackEntry
+		{
+			std::uint32_t iNode;
+			float distance;
+		};
+
+		StackEntry nodeStack[kStackSize];
+		std::size_t stackSize = 0;
+		nodeStack[stackSize++] = { 0, 0.0f };
+		while (stackSize > 0) {
+			StackEntry entry = nodeStack[--stackSize];
+			if (entry.distance > maxDistance) {
+				continue;
+			}
+
+			const Node& node = mNodes[entry.iNode];
+			float distances[kNodeWidth];
+			unsigned int mask = calculateSegmentIntersectionMask(node, ray, halfExtents, epsilon, maxDistance, distances);
+
+			// Sort the intersected children by their distance
+			std::uint32_t children[kNodeWidth];
+			std::uint32_t numChildren = 0;
+			for (std::uint32_t i = 0; i < node.numChildren; ++i) {
+				if (mask & (1u << i)) {
+					std::uint32_t j = numChildren++;
+					for (; (j > 0) && (distances[children[j - 1]] > distances[i]); --j) {
+						children[j] = children[j - 1];
+					}
+					children[j] = i;
+				}
+			}
+
+			// Process the leaves from the closest to the furthest one, and
+			// push the inner Nodes so the closest one is visited first
+			for (std::uint32_t j = 0; j < numChildren; ++j) {
+				std::uint32_t i = children[j];
+				if ((node.counts[i] > 0) && (distances[i] <= maxDistance)) {
+					for (std::uint32_t k = 0; k < node.counts[i]; ++k) {
+						maxDistance = callback(mPrimitives[node.children[i] + k], maxDistance);
+					}
+				}
+			}
+			for (std::uint32_t j = numChildren; j > 0; --j) {
+				std::uint32_t i = children[j - 1];
+				if ((node.counts[i] == 0) && (distances[i] <= maxDistance)) {
+					nodeStack[stackSize++] = { node.children[i], distances[i] };
+				}
+			}
+		}
+	}
+
+// Private functions
+	template <typename T, typename F>
+	void StaticAABBTree::traverse(T&& testNode, F&& callback) const
+	{
+		if (mNodes.empty()) {
+			return;
+		}
+
+		std::uint32_t nodeStack[kStackSize];
+		std::size_t stackSize = 0;
+		nodeStack[stackSize++] = 0;
+		while (stackSize > 0) {
+			const Node& node = mNodes[nodeStack[--stackSize]];
+
+			unsigned int mask = testNode(node);
+			for (std::uint32_t i = 0; i < node.numChildren; ++i) {
+				if (mask & (1u << i)) {
+					if (node.counts[i] > 0) {
+						for (std::uint32_t j = 0; j < node.counts[i]; ++j) {
+							callback(mPrimitives[node.children[i] + j]);
+						}
+					}
+					else {
+						nodeStack[stackSize++] = node.children[i];
+					}
+				}
+			}
+		}
+	}
+
+}
+
+#endif		// STATIC_AABB_TREE_HPP
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include "se/physics/collision/ConvexCollider.h"
 #include "SupportPoint.h"
 
@@ -27,6 +28,33 @@ namespace se::physics {
 	}
 
 
+	void calculateSupportPoints(
+		const ConvexCollider& collider1, const ConvexCollider& collider2,
+		const glm::vec3* directions, std::size_t numDirections,
+		SupportPoint* supportPoints
+	) {
+		static constexpr std::size_t kMaxDirections = 4;
+
+		glm::vec3 oppositeDirections[kMaxDirections];
+		glm::vec3 worldPositions[2][kMaxDirections], localPositions[2][kMaxDirections];
+		for (std::size_t i = 0; i < numDirections; i += kMaxDirections) {
+			std::size_t batchSize = std::min(kMaxDirections, numDirections - i);
+			for (std::size_t j = 0; j < batchSize; ++j) {
+				oppositeDirections[j] = -directions[i + j];
+			}
+
+			collider1.getFurthestPointsInDirections(directions + i, batchSize, worldPositions[0], localPositions[0]);
+			collider2.getFurthestPointsInDirections(oppositeDirections, batchSize, worldPositions[1], localPositions[1]);
+			for (std::size_t j = 0; j < batchSize; ++j) {
+				supportPoints[i + j] = SupportPoint(
+					worldPositions[0][j], localPositions[0][j],
+					worldPositions[1][j], localPositions[1][j]
+				);
+			}
+		}
+	}
+
+
 	bool operator==(const SupportPoint& sp1, const SupportPoint& sp2)
 	{
 		return (sp1.mWorldPosition[0] == sp2.mWorldPosition[0])
@@ -1,6 +1,7 @@
 #ifndef SUPPORT_POINT_H
 #define SUPPORT_POINT_H
 
+#include <cstddef>
 #include <glm/glm.hpp>
 
 namespace se::physics {
@@ -91,6 +92,25 @@ namespace se::physics {
 		{ return mWorldPosition[second]; };
 	};
 
+
+	/** Calculates the SupportPoints in each of the given directions with the
+	 * batched support functions of the ConvexColliders
+	 *
+	 * @param	collider1 the first ConvexCollider with which we want to
+	 *			calculate the SupportPoints
+	 * @param	collider2 the second ConvexCollider with which we want to
+	 *			calculate the SupportPoints
+	 * @param	directions a pointer to the directions to search the
+	 *			SupportPoints
+	 * @param	numDirections the number of directions
+	 * @param	supportPoints a pointer to the array where the SupportPoints
+	 *			will be stored */
+	void calculateSupportPoints(
+		const ConvexCollider& collider1, const ConvexCollider& collider2,
+		const glm::vec3* directions, std::size_t numDirections,
+		SupportPoint* supportPoints
+	);
+
 }
 
 #endif		// SUPPORT_POINT_H
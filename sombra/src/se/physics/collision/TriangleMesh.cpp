@@ -0,0 +1,54 @@
+#include "se/physics/collision/TriangleMesh.h"
+#include "StaticAABBTree.h"
+
+namespace se::physics {
+
+	TriangleMesh::TriangleMesh(
+		const glm::vec3* vertices, std::size_t numVertices,
+		const std::uint32_t* indices, std::size_t numIndices
+	) : mVertices(vertices, vertices + numVertices),
+		mIndices(indices, indices + numIndices)
+	{
+		calculateAABBTree();
+	}
+
+
+	TriangleMesh::TriangleMesh(
+		const glm::vec3* vertices, std::size_t numVertices,
+		const std::uint16_t* indices, std::size_t numIndices
+	) : mVertices(vertices, vertices + numVertices),
+		mIndices(indices, indices + numIndices)
+	{
+		calculateAABBTree();
+	}
+
+
+	TriangleMesh::~TriangleMesh() {}
+
+
+	const AABB& TriangleMesh::getAABB() const
+	{
+		return mAABBTree->getAABB();
+	}
+
+
+	AABB TriangleMesh::getTriangleAABB(std::size_t iTriangle) const
+	{
+		auto [v0, v1, v2] = getTriangle(iTriangle);
+		return { glm::min(glm::min(v0, v1), v2), glm::max(glm::max(v0, v1), v2) };
+	}
+
+// Private functions
+	void TriangleMesh::calculateAABBTree()
+	{
+		std::vector<AABB> triangleAABBs;
+		triangleAABBs.reserve(getNumTriangles());
+		for (std::size_t iTriangle = 0; iTriangle < getNumTriangles(); ++iTriangle) {
+			triangleAABBs.push_back(getTriangleAABB(iTriangle));
+		}
+
+		mAABBTree = std::make_unique<StaticAABBTree>();
+		mAABBTree->build(triangleAABBs.data(), triangleAABBs.size());
+	}
+
+}
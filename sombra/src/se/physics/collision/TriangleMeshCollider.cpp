@@ -1,47 +1,16 @@
 #include "se/physics/collision/TriangleMeshCollider.h"
 #include "se/physics/collision/TriangleCollider.h"
-#include "AABBAVLTree.h"
+#include "StaticAABBTree.h"
 
 namespace se::physics {
 
-	TriangleMeshCollider::TriangleMeshCollider(
-		const glm::vec3* vertices, std::size_t numVertices,
-		const unsigned short* indices, std::size_t numIndices
-	) : mVertices(vertices, vertices + numVertices),
-		mIndices(indices, indices + numIndices),
-		mTransformsMatrix(1.0f)
-	{
-		calculateAABBTree();
-	}
-
-
-	TriangleMeshCollider::TriangleMeshCollider(const TriangleMeshCollider& other) :
-		ConcaveCollider(other), mVertices(other.mVertices), mIndices(other.mIndices),
-		mAABBTree( std::make_unique<AABBAVLTree<unsigned short>>(*other.mAABBTree) ),
-		mTransformsMatrix(other.mTransformsMatrix) {}
-
+	TriangleMeshCollider::TriangleMeshCollider(TriangleMeshSPtr mesh) :
+		mMesh(std::move(mesh)), mTransformsMatrix(1.0f), mInverseTransformsMatrix(1.0f) {}
 
-	TriangleMeshCollider::~TriangleMeshCollider() {}
 
-
-	TriangleMeshCollider& TriangleMeshCollider::operator=(const TriangleMeshCollider& other)
+	void TriangleMeshCollider::setMesh(TriangleMeshSPtr mesh)
 	{
-		ConcaveCollider::operator=(other);
-		mVertices = other.mVertices;
-		mIndices = other.mIndices;
-		mAABBTree = std::make_unique<AABBAVLTree<unsigned short>>(*other.mAABBTree);
-		mTransformsMatrix = other.mTransformsMatrix;
-		return *this;
-	}
-
-
-	void TriangleMeshCollider::setMesh(
-		const glm::vec3* vertices, std::size_t numVertices,
-		const unsigned short* indices, std::size_t numIndices
-	) {
-		mVertices = std::vector<glm::vec3>(vertices, vertices + numVertices);
-		mIndices = std::vector<unsigned short>(indices, indices + numIndices);
-		calculateAABBTree();
+		mMesh = std::move(mesh);
 		mUpdated = true;
 	}
 
@@ -49,15 +18,15 @@ namespace se::physics {
 	void TriangleMeshCollider::setTransforms(const glm::mat4& transforms)
 	{
 		mTransformsMatrix = transforms;
-		calculateAABBTree();
+		mInverseTransformsMatrix = glm::inverse(transforms);
 		mUpdated = true;
 	}
 
 
 	AABB TriangleMeshCollider::getAABB() const
 	{
-		if (mAABBTree && (mAABBTree->getNumNodes() > 0)) {
-			return mAABBTree->getRootNodeAABB();
+		if (mMesh && (mMesh->getNumTriangles() > 0)) {
+			return transform(mMesh->getAABB(), mTransformsMatrix);
 		}
 		return AABB();
 	}
@@ -65,41 +34,45 @@ namespace se::physics {
 
 	void TriangleMeshCollider::processOverlapingParts(const AABB& aabb, float epsilon, const ConvexShapeCallback& callback) const
 	{
-		mAABBTree->calculateOverlapsWith(aabb, epsilon, [&](std::size_t nodeId) {
-			unsigned short triIndex = mAABBTree->getNodeUserData(nodeId);
-			TriangleCollider collider = getTriangleCollider(triIndex);
-			callback(collider);
+		if (!mMesh) {
+			return;
+		}
+
+		// The leaves of the AABB Tree hold multiple triangles, so each one
+		// must be also checked in local and world space
+		AABB localAABB = transform(aabb, mInverseTransformsMatrix);
+		mMesh->getAABBTree().calculateOverlapsWith(localAABB, epsilon, [&](std::uint32_t iTriangle) {
+			if (overlaps(mMesh->getTriangleAABB(iTriangle), localAABB, epsilon)) {
+				TriangleCollider collider = getTriangleCollider(iTriangle);
+				if (overlaps(collider.getAABB(), aabb, epsilon)) {
+					callback(collider);
+				}
+			}
 		});
 	}
 
 
 	void TriangleMeshCollider::processIntersectingParts(const Ray& ray, float epsilon, const ConvexShapeCallback& callback) const
 	{
-		mAABBTree->calculateIntersectionsWith(ray, epsilon, [&](std::size_t nodeId) {
-			unsigned short triIndex = mAABBTree->getNodeUserData(nodeId);
-			TriangleCollider collider = getTriangleCollider(triIndex);
-			callback(collider);
+		if (!mMesh) {
+			return;
+		}
+
+		Ray localRay(
+			mInverseTransformsMatrix * glm::vec4(ray.origin, 1.0f),
+			mInverseTransformsMatrix * glm::vec4(ray.direction, 0.0f)
+		);
+		mMesh->getAABBTree().calculateIntersectionsWith(localRay, epsilon, [&](std::uint32_t iTriangle) {
+			if (intersects(mMesh->getTriangleAABB(iTriangle), localRay, epsilon)) {
+				callback(getTriangleCollider(iTriangle));
+			}
 		});
 	}
 
 // Private functions
-	void TriangleMeshCollider::calculateAABBTree()
-	{
-		mAABBTree = std::make_unique<AABBAVLTree<unsigned short>>();
-
-		for (unsigned short triIndex = 0; triIndex < mIndices.size() / 3; ++triIndex) {
-			mAABBTree->addNode(getTriangleCollider(triIndex).getAABB(), triIndex);
-		}
-	}
-
-
-	TriangleCollider TriangleMeshCollider::getTriangleCollider(unsigned short triangleIndex) const
+	TriangleCollider TriangleMeshCollider::getTriangleCollider(std::size_t triangleIndex) const
 	{
-		TriangleCollider collider({
-			mVertices[ mIndices[3 * triangleIndex] ],
-			mVertices[ mIndices[3 * triangleIndex + 1] ],
-			mVertices[ mIndices[3 * triangleIndex + 2] ]
-		});
+		TriangleCollider collider(mMesh->getTriangle(triangleIndex));
 		collider.setTransforms(mTransformsMatrix);
 
 		return collider;
@@ -4,89 +4,42 @@
 #include "se/physics/constraints/Constraint.h"
 #include "se/physics/constraints/ConstraintIsland.h"
 #include "../RigidBodyDynamics.h"
+#include "ParallelConstraintSolver.h"
 
 namespace se::physics {
 
-	void ConstraintIsland::addConstraint(Constraint* constraint)
+	void ConstraintIsland::setConstraints(Constraint* const* constraints, std::size_t numConstraints)
 	{
-		IndexPair rbIndices;
-		for (std::size_t i = 0; i < 2; ++i) {
-			RigidBody* rb = constraint->getRigidBody(i);
-
-			// Get the index of the RigidBody in the mRigidBodies vector
-			auto it = std::lower_bound(mRigidBodies.begin(), mRigidBodies.end(), rb);
-			std::size_t iRB = std::distance(mRigidBodies.begin(), it);
-
-			if ((it == mRigidBodies.end()) || (*it != rb)) {
-				// The RigidBody wasn't in the vector, insert it preserving
-				// the order
-				mRigidBodies.insert(it, rb);
-				mInverseMassMatrix.insert(mInverseMassMatrix.begin() + iRB, glm::mat3(rb->mProperties.invertedMass));
-				mInverseMassMatrix.insert(mInverseMassMatrix.begin() + iRB, rb->mState.invertedInertiaTensorWorld);
-				mVelocityMatrix.insert(mVelocityMatrix.begin() + iRB, rb->mState.linearVelocity);
-				mVelocityMatrix.insert(mVelocityMatrix.begin() + iRB, rb->mState.angularVelocity);
-				mForceExtMatrix.insert(mForceExtMatrix.begin() + iRB, rb->mState.forceSum);
-				mForceExtMatrix.insert(mForceExtMatrix.begin() + iRB, rb->mState.torqueSum);
-
-				// Shift the mConstraintRBMap RigidBody indices right
-				for (IndexPair& pair : mConstraintRBMap) {
-					if (pair[0] >= iRB) { ++pair[0]; }
-					if (pair[1] >= iRB) { ++pair[1]; }
-				}
-
-				// Shift the other RigidBody index in the new Constraint right
-				if ((i == 1) && (rbIndices[0] >= iRB)) { ++rbIndices[0]; }
-			}
+		mConstraints.assign(constraints, constraints + numConstraints);
 
-			rbIndices[i] = iRB;
+		// Get the RigidBodies of the Constraints sorted ascendently
+		mRigidBodies.clear();
+		for (Constraint* constraint : mConstraints) {
+			mRigidBodies.push_back(constraint->getRigidBody(0));
+			mRigidBodies.push_back(constraint->getRigidBody(1));
 		}
-
-		// Add the constraint and its data
-		auto it = std::lower_bound(mConstraints.begin(), mConstraints.end(), constraint);
-		std::size_t iConstraint = std::distance(mConstraints.begin(), it);
-
-		auto cb = constraint->getConstraintBounds();
-		mConstraints.insert(it, constraint);
-		mConstraintRBMap.insert(mConstraintRBMap.begin() + iConstraint, rbIndices);
-		mLambdaMatrix.insert(mLambdaMatrix.begin() + iConstraint, 0.0f);
-		mLambdaMinMatrix.insert(mLambdaMinMatrix.begin() + iConstraint, cb.lambdaMin);
-		mLambdaMaxMatrix.insert(mLambdaMaxMatrix.begin() + iConstraint, cb.lambdaMax);
-		mBiasMatrix.insert(mBiasMatrix.begin() + iConstraint, constraint->getBias());
-		mJacobianMatrix.insert(mJacobianMatrix.begin() + iConstraint, constraint->getJacobianMatrix());
-
-		// Change the mSolveConstraints to solve the rest of the Constraints
-		// in the next update
-		mSolveConstraints = true;
-	}
-
-
-	bool ConstraintIsland::removeConstraint(Constraint* constraint)
-	{
-		auto itConstraint = std::lower_bound(mConstraints.begin(), mConstraints.end(), constraint);
-		if ((itConstraint == mConstraints.end()) || (*itConstraint != constraint)) { return false; }
-
-		std::size_t iConstraint = std::distance(mConstraints.begin(), itConstraint);
-
-		// Remove the RigidBodies if the constraint to remove is the only one
-		// that uses them
-		for (std::size_t iRB : mConstraintRBMap[iConstraint]) {
-			tryRemoveRigidBody(iRB);
+		std::sort(mRigidBodies.begin(), mRigidBodies.end());
+		mRigidBodies.erase(std::unique(mRigidBodies.begin(), mRigidBodies.end()), mRigidBodies.end());
+
+		mConstraintRBMap.resize(numConstraints);
+		for (std::size_t iConstraint = 0; iConstraint < numConstraints; ++iConstraint) {
+			for (std::size_t i = 0; i < 2; ++i) {
+				auto it = std::lower_bound(mRigidBodies.begin(), mRigidBodies.end(), mConstraints[iConstraint]->getRigidBody(i));
+				mConstraintRBMap[iConstraint][i] = std::distance(mRigidBodies.begin(), it);
+			}
 		}
 
-		// Remove the constraint and its cached data
-		mConstraints.erase(itConstraint);
-		mConstraintRBMap.erase(mConstraintRBMap.begin() + iConstraint);
-		mLambdaMatrix.erase(mLambdaMatrix.begin() + iConstraint);
-		mLambdaMinMatrix.erase(mLambdaMinMatrix.begin() + iConstraint);
-		mLambdaMaxMatrix.erase(mLambdaMaxMatrix.begin() + iConstraint);
-		mBiasMatrix.erase(mBiasMatrix.begin() + iConstraint);
-		mJacobianMatrix.erase(mJacobianMatrix.begin() + iConstraint);
-
-		// Change the mSolveConstraints to solve the rest of the Constraints
-		// in the next update
-		mSolveConstraints = true;
-
-		return true;
+		// The data of the matrices is calculated in the next update
+		mLambdaMatrix.resize(numConstraints);
+		mLambdaMinMatrix.resize(numConstraints);
+		mLambdaMaxMatrix.resize(numConstraints);
+		mBiasMatrix.resize(numConstraints);
+		mJacobianMatrix.resize(numConstraints);
+		mInverseMassMatrix.resize(2 * mRigidBodies.size());
+		mVelocityMatrix.resize(2 * mRigidBodies.size());
+		mForceExtMatrix.resize(2 * mRigidBodies.size());
+
+		mSolveConstraints = false;
 	}
 
 
@@ -97,91 +50,35 @@ namespace se::physics {
 	}
 
 
-	bool ConstraintIsland::removeRigidBody(RigidBody* rigidBody)
+	bool ConstraintIsland::updateSleepingStatus()
 	{
-		auto itRigidBody = std::lower_bound(mRigidBodies.begin(), mRigidBodies.end(), rigidBody);
-		if ((itRigidBody == mRigidBodies.end()) || (*itRigidBody != rigidBody)) { return false; }
-
-		std::size_t iRB = std::distance(mRigidBodies.begin(), itRigidBody);
-		for (std::size_t iConstraint = 0; iConstraint < mConstraints.size();) {
-			// Check if any of the Constraint RigidBodies is the RigidBody to
-			// remove
-			bool shouldRemove = false;
-			std::size_t iiRB = 0, iRB2 = 0;
-			if (iRB == mConstraintRBMap[iConstraint][0]) {
-				shouldRemove = true;
-				iiRB = 0;
-				iRB2 = mConstraintRBMap[iConstraint][1];
-			}
-			else if (iRB == mConstraintRBMap[iConstraint][1]) {
-				shouldRemove = true;
-				iiRB = 1;
-				iRB2 = mConstraintRBMap[iConstraint][0];
-			}
+		bool awake = std::any_of(mRigidBodies.begin(), mRigidBodies.end(), [](const RigidBody* rb) {
+			return (rb->mProperties.type == RigidBodyProperties::Type::Dynamic)
+				&& !rb->getStatus(RigidBody::Status::Sleeping);
+		});
 
-			if (shouldRemove) {
-				// Remove the other RigidBody if the constraint to remove is
-				// the only one that uses it
-				if (tryRemoveRigidBody(iRB2)) {
-					// Update the iRB index with its new value due to the
-					// removal stage
-					iRB = mConstraintRBMap[iConstraint][iiRB];
-				}
-
-				// Remove the constraint and its cached data
-				mConstraints.erase(mConstraints.begin() + iConstraint);
-				mConstraintRBMap.erase(mConstraintRBMap.begin() + iConstraint);
-				mLambdaMatrix.erase(mLambdaMatrix.begin() + iConstraint);
-				mLambdaMinMatrix.erase(mLambdaMinMatrix.begin() + iConstraint);
-				mLambdaMaxMatrix.erase(mLambdaMaxMatrix.begin() + iConstraint);
-				mBiasMatrix.erase(mBiasMatrix.begin() + iConstraint);
-				mJacobianMatrix.erase(mJacobianMatrix.begin() + iConstraint);
-			}
-			else {
-				++iConstraint;
-			}
-		}
-
-		// Remove the current RigidBody
-		tryRemoveRigidBody(iRB);
-
-		// Change the mSolveConstraints to solve the rest of the Constraints
-		// in the next update
-		mSolveConstraints = true;
-
-		return true;
-	}
-
-
-	void ConstraintIsland::merge(ConstraintIsland& source)
-	{
-		while (!source.mConstraints.empty()) {
-			addConstraint(source.mConstraints.back());
-			source.mConstraints.pop_back();
+		if (awake) {
+			wakeUpRigidBodies();
 		}
 
-		source.mRigidBodies.clear();
-		source.mConstraintRBMap.clear();
-		source.mLambdaMatrix.clear();
-		source.mLambdaMinMatrix.clear();
-		source.mLambdaMaxMatrix.clear();
-		source.mBiasMatrix.clear();
-		source.mJacobianMatrix.clear();
-		source.mInverseMassMatrix.clear();
-		source.mVelocityMatrix.clear();
-		source.mForceExtMatrix.clear();
+		return awake;
 	}
 
 
-	void ConstraintIsland::update(float deltaTime)
+	void ConstraintIsland::update(float deltaTime, ParallelConstraintSolver* parallelSolver)
 	{
 		// 1. Check if the constraints should be solved again or not
 		updateSolveConstraints();
 		if (mSolveConstraints) {
 			mSolveConstraints = false;
 
+			// The changes to any of the RigidBodies or Constraints are
+			// propagated to the whole island
+			wakeUpRigidBodies();
+
 			// 2. Update the matrices
 			updateLambdaBoundsMatrices();
+			updateLambdaMatrix();
 			updateBiasMatrix();
 			updateJacobianMatrix();
 			updateInverseMassMatrix();
@@ -192,9 +89,15 @@ namespace se::physics {
 			// mJacobianMatrix * mInverseMassMatrix * transpose(mJacobianMatrix)
 			//	* mLambdaMatrix = etaMatrix
 			// With the Gauss-Seidel algorithm
-			calculateGaussSeidel(deltaTime);
+			calculateGaussSeidel(deltaTime, parallelSolver);
 
-			// 3. Update the velocity and position of the RigidBodies
+			// 4. Store the lambda values in the Constraints, so they can be
+			// used as the initial values in the next update
+			for (std::size_t iConstraint = 0; iConstraint < mConstraints.size(); ++iConstraint) {
+				mConstraints[iConstraint]->setLambda(mLambdaMatrix[iConstraint]);
+			}
+
+			// 5. Update the velocity and position of the RigidBodies
 			updateRigidBodies(deltaTime);
 		}
 	}
@@ -209,7 +112,9 @@ namespace se::physics {
 
 		if (!mSolveConstraints) {
 			for (std::size_t iRB = 0; iRB < mRigidBodies.size(); ++iRB) {
-				if (!mRigidBodies[iRB]->getStatus(RigidBody::Status::Sleeping)) {
+				if ((mRigidBodies[iRB]->mProperties.type == RigidBodyProperties::Type::Dynamic)
+					&& !mRigidBodies[iRB]->getStatus(RigidBody::Status::Sleeping)
+				) {
 					mSolveConstraints = true;
 					break;
 				}
@@ -218,6 +123,18 @@ namespace se::physics {
 	}
 
 
+	void ConstraintIsland::wakeUpRigidBodies()
+	{
+		for (RigidBody* rb : mRigidBodies) {
+			if ((rb->mProperties.type == RigidBodyProperties::Type::Dynamic)
+				&& rb->getStatus(RigidBody::Status::Sleeping)
+			) {
+				rb->setStatus(RigidBody::Status::Sleeping, false);
+			}
+		}
+	}
+
+
 	void ConstraintIsland::updateLambdaBoundsMatrices()
 	{
 		for (std::size_t iConstraint = 0; iConstraint < mConstraints.size(); ++iConstraint) {
@@ -228,6 +145,20 @@ namespace se::physics {
 	}
 
 
+	void ConstraintIsland::updateLambdaMatrix()
+	{
+		// The lambda values of the last update are used as the initial ones
+		// (warm starting), so the Gauss-Seidel algorithm needs less
+		// iterations to converge
+		for (std::size_t iConstraint = 0; iConstraint < mConstraints.size(); ++iConstraint) {
+			mLambdaMatrix[iConstraint] = std::clamp(
+				mConstraints[iConstraint]->getLambda(),
+				mLambdaMinMatrix[iConstraint], mLambdaMaxMatrix[iConstraint]
+			);
+		}
+	}
+
+
 	void ConstraintIsland::updateBiasMatrix()
 	{
 		for (std::size_t iConstraint = 0; iConstraint < mConstraints.size(); ++iConstraint) {
@@ -271,7 +202,7 @@ namespace se::physics {
 	}
 
 
-	void ConstraintIsland::calculateGaussSeidel(float deltaTime)
+	void ConstraintIsland::calculateGaussSeidel(float deltaTime, ParallelConstraintSolver* parallelSolver)
 	{
 		const std::vector<float> etaMatrix = calculateEtaMatrix(deltaTime);
 		const std::vector<vec12> invMassJacobianMatrix = calculateInvMassJacobianMatrix();
@@ -281,6 +212,30 @@ namespace se::physics {
 		// which is too big, by exploiting the sparsity of invMassJacobianMatrix
 		// and mJacobian matrices
 		const std::vector<float> diagonalJInvMJMatrix = calculateDiagonalJInvMJMatrix(mJacobianMatrix, invMassJacobianMatrix);
+
+		if (parallelSolver) {
+			// Only the dynamic RigidBodies are changed by the Constraints
+			std::vector<std::uint8_t> dynamicRBs(mRigidBodies.size());
+			for (std::size_t iRB = 0; iRB < mRigidBodies.size(); ++iRB) {
+				dynamicRBs[iRB] = (mRigidBodies[iRB]->mProperties.type == RigidBodyProperties::Type::Dynamic)
+					&& (mRigidBodies[iRB]->mProperties.invertedMass != 0);
+			}
+
+			ParallelConstraintSolver::Input input;
+			input.numConstraints = mConstraints.size();
+			input.numRigidBodies = mRigidBodies.size();
+			input.constraintRBMap = mConstraintRBMap.data();
+			input.dynamicRBs = dynamicRBs.data();
+			input.jacobians = mJacobianMatrix.data();
+			input.invMassJacobians = invMassJacobianMatrix.data();
+			input.diagonal = diagonalJInvMJMatrix.data();
+			input.eta = etaMatrix.data();
+			input.lambdaMin = mLambdaMinMatrix.data();
+			input.lambdaMax = mLambdaMaxMatrix.data();
+			parallelSolver->solve(input, mLambdaMatrix.data(), mMaxConstraintIterations);
+			return;
+		}
+
 		std::vector<float> invMJLambdaMatrix = calculateInvMJLambdaMatrix(invMassJacobianMatrix, mLambdaMatrix);
 
 		// We use a fixed number of iterations for the Gauss-Seidel algorithm
@@ -459,43 +414,7 @@ namespace se::physics {
 					RigidBodyDynamics::integrateAngularVelocity(*mRigidBodies[i], deltaTime);
 				}
 			}
-
-			// Update the RigidBody internal state
-			mRigidBodies[i]->setStatus(RigidBody::Status::Sleeping, false);
-		}
-	}
-
-
-	bool ConstraintIsland::tryRemoveRigidBody(std::size_t iRB)
-	{
-		bool remove = true, first = true;
-		for (IndexPair& pair : mConstraintRBMap) {
-			if ((pair[0] == iRB) || (pair[1] == iRB)) {
-				if (!first) {
-					remove = false;
-					break;
-				}
-				first = false;
-			}
-		}
-
-		if (remove) {
-			// Remove the RigidBody
-			mRigidBodies.erase(mRigidBodies.begin() + iRB);
-			mInverseMassMatrix.erase(mInverseMassMatrix.begin() + 2*iRB, mInverseMassMatrix.begin() + 2*iRB + 1);
-			mVelocityMatrix.erase(mVelocityMatrix.begin() + 2*iRB, mVelocityMatrix.begin() + 2*iRB + 1);
-			mForceExtMatrix.erase(mForceExtMatrix.begin() + 2*iRB, mForceExtMatrix.begin() + 2*iRB + 1);
-
-			// Shift the mConstraintRBMap RigidBody indices left
-			for (IndexPair& pair : mConstraintRBMap) {
-				if (pair[0] > iRB) { --pair[0]; }
-				if (pair[1] > iRB) { --pair[1]; }
-			}
-
-			return true;
 		}
-
-		return false;
 	}
 
 }
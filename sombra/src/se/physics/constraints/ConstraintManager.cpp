@@ -1,82 +1,92 @@
+#include <numeric>
+#include <iterator>
 #include "se/physics/RigidBodyWorld.h"
 #include "se/physics/constraints/Constraint.h"
 #include "se/physics/constraints/ConstraintManager.h"
+#include "ParallelConstraintSolver.h"
 
 namespace se::physics {
 
+	ConstraintManager::ConstraintManager(RigidBodyWorld& parentWorld) :
+		mParentWorld(&parentWorld), mRebuildIslands(false),
+		mParallelSolver(std::make_unique<ParallelConstraintSolver>(
+			parentWorld.getThreadPool(), parentWorld.getProperties().numThreads
+		)) {}
+
+
+	ConstraintManager::~ConstraintManager() {}
+
+
 	void ConstraintManager::addConstraint(Constraint* constraint)
 	{
 		std::scoped_lock lck(mMutex);
 
-		bool rbHasIsland[2] = { false, false };
-		std::size_t iRBIsland[2] = { 0, 0 };
-
-		for (std::size_t i = 0; i < 2; ++i) {
-			RigidBody* rb = constraint->getRigidBody(i);
-			if (rb->getProperties().type != RigidBodyProperties::Type::Static) {
-				auto it = std::find_if(mIslands.begin(), mIslands.end(), [rb](const ConstraintIsland& island) {
-					return island.hasRigidBody(rb);
-				});
-				if (it != mIslands.end()) {
-					rbHasIsland[i] = true;
-					iRBIsland[i] = std::distance(mIslands.begin(), it);
-				}
-			}
+		auto it = std::lower_bound(mConstraints.begin(), mConstraints.end(), constraint);
+		if ((it == mConstraints.end()) || (*it != constraint)) {
+			mConstraints.insert(it, constraint);
+			mRebuildIslands = true;
 		}
+	}
 
-		std::size_t iConstraintIsland = 0;
-		if (rbHasIsland[0]) {
-			if (rbHasIsland[1]) {	// Merge islands
-				if (iRBIsland[0] < iRBIsland[1]) {
-					iConstraintIsland = iRBIsland[0];
-					mIslands[iRBIsland[0]].merge(mIslands[iRBIsland[1]]);
-					mIslands.erase(mIslands.begin() + iRBIsland[1]);
-				}
-				else if (iRBIsland[0] > iRBIsland[1]) {
-					iConstraintIsland = iRBIsland[1];
-					mIslands[iRBIsland[1]].merge(mIslands[iRBIsland[0]]);
-					mIslands.erase(mIslands.begin() + iRBIsland[0]);
-				}
-				else {
-					iConstraintIsland = iRBIsland[0];
-				}
-			}
-			else {					// 0
-				iConstraintIsland = iRBIsland[0];
-			}
-		}
-		else {
-			if (rbHasIsland[1]) {	// 1
-				iConstraintIsland = iRBIsland[1];
-			}
-			else {					// New island
-				mIslands.emplace_back(mParentWorld->getProperties().maxConstraintIterations);
-				iConstraintIsland = mIslands.size() - 1;
-			}
-		}
 
-		mIslands[iConstraintIsland].addConstraint(constraint);
+	void ConstraintManager::addConstraints(Constraint* const* constraints, std::size_t numConstraints)
+	{
+		std::scoped_lock lck(mMutex);
+
+		std::vector<Constraint*> newConstraints(constraints, constraints + numConstraints);
+		std::sort(newConstraints.begin(), newConstraints.end());
+
+		std::size_t oldSize = mConstraints.size();
+		std::vector<Constraint*> mergedConstraints;
+		mergedConstraints.reserve(oldSize + newConstraints.size());
+		std::merge(mConstraints.begin(), mConstraints.end(), newConstraints.begin(), newConstraints.end(), std::back_inserter(mergedConstraints));
+		mergedConstraints.erase(std::unique(mergedConstraints.begin(), mergedConstraints.end()), mergedConstraints.end());
+
+		if (mergedConstraints.size() != oldSize) {
+			mConstraints = std::move(mergedConstraints);
+			mRebuildIslands = true;
+		}
 	}
 
 
 	bool ConstraintManager::hasConstraints() const
 	{
 		std::scoped_lock lck(mMutex);
-		return !mIslands.empty();
+		return !mConstraints.empty();
 	}
 
 
 	void ConstraintManager::removeConstraint(Constraint* constraint)
 	{
 		std::scoped_lock lck(mMutex);
-		for (ConstraintIsland& island : mIslands) {
-			if (island.removeConstraint(constraint)) {
-				if (!island.hasConstraints()) {
-					std::swap(island, mIslands.back());
-					mIslands.pop_back();
-				}
-				break;
+
+		auto it = std::lower_bound(mConstraints.begin(), mConstraints.end(), constraint);
+		if ((it != mConstraints.end()) && (*it == constraint)) {
+			wakeUpRigidBodies(*constraint);
+			mConstraints.erase(it);
+			mRebuildIslands = true;
+		}
+	}
+
+
+	void ConstraintManager::removeConstraints(Constraint* const* constraints, std::size_t numConstraints)
+	{
+		std::scoped_lock lck(mMutex);
+
+		std::vector<Constraint*> oldConstraints(constraints, constraints + numConstraints);
+		std::sort(oldConstraints.begin(), oldConstraints.end());
+
+		auto itRemove = std::remove_if(mConstraints.begin(), mConstraints.end(), [&](Constraint* constraint) {
+			if (std::binary_search(oldConstraints.begin(), oldConstraints.end(), constraint)) {
+				wakeUpRigidBodies(*constraint);
+				return true;
 			}
+			return false;
+		});
+
+		if (itRemove != mConstraints.end()) {
+			mConstraints.erase(itRemove, mConstraints.end());
+			mRebuildIslands = true;
 		}
 	}
 
@@ -84,65 +94,248 @@ namespace se::physics {
 	void ConstraintManager::removeRigidBody(RigidBody* rigidBody)
 	{
 		std::scoped_lock lck(mMutex);
-		for (auto it = mIslands.begin(); it != mIslands.end();) {
-			if (it->removeRigidBody(rigidBody) && !it->hasConstraints()) {
-				it = mIslands.erase(it);
-			}
-			else {
-				++it;
+
+		auto itRemove = std::remove_if(mConstraints.begin(), mConstraints.end(), [&](Constraint* constraint) {
+			if ((constraint->getRigidBody(0) == rigidBody) || (constraint->getRigidBody(1) == rigidBody)) {
+				wakeUpRigidBodies(*constraint);
+				return true;
 			}
+			return false;
+		});
+
+		if (itRemove != mConstraints.end()) {
+			mConstraints.erase(itRemove, mConstraints.end());
+			mRebuildIslands = true;
+		}
+	}
+
+
+	void ConstraintManager::updateSleepingStatus()
+	{
+		std::scoped_lock lck(mMutex);
+
+		if (mRebuildIslands) {
+			rebuildIslands();
+		}
+
+		for (ConstraintIsland& island : mIslands) {
+			island.updateSleepingStatus();
 		}
 	}
 
 
 	void ConstraintManager::update(float deltaTime)
 	{
-		std::vector<Constraint*> updatedConstraints;
+		std::scoped_lock lck(mMutex);
 
-		{ // Get the Constraints of the RigidBodies whose properties have changed
-			std::scoped_lock lck(mMutex);
-			for (ConstraintIsland& island : mIslands) {
-				island.processRigidBodies([&](RigidBody* rb) {
-					if (rb->getStatus(RigidBody::Status::PropertiesChanged)) {
-						island.processRigidBodyConstraints(rb, [&](Constraint* constraint) {
-							updatedConstraints.push_back(constraint);
-						});
-					}
-				});
+		// Rebuild the islands if the Constraints have changed or if the
+		// properties of any RigidBody have changed, because it could have
+		// changed from static to dynamic or vice versa
+		for (Constraint* constraint : mConstraints) {
+			if (constraint->getRigidBody(0)->getStatus(RigidBody::Status::PropertiesChanged)
+				|| constraint->getRigidBody(1)->getStatus(RigidBody::Status::PropertiesChanged)
+			) {
+				wakeUpRigidBodies(*constraint);
+				mRebuildIslands = true;
 			}
 		}
+		if (mRebuildIslands) {
+			rebuildIslands();
+		}
 
-		// Remove and add those Constraints so the RigidBodies whose properties
-		// have changed from static to dynamic are in the same island
-		for (Constraint* constraint : updatedConstraints) {
-			removeConstraint(constraint);
-			addConstraint(constraint);
+		mIslandStats = IslandStats();
+		mIslandStats.numIslands = mIslands.size();
+		mIslandStats.numConstraints = mConstraints.size();
+		mIslandStats.maxIslandConstraints = mIslands.empty()? 0 : mIslands.front().getNumConstraints();
+		for (const ConstraintIsland& island : mIslands) {
+			std::size_t iBucket = 0;
+			while ((iBucket + 1 < IslandStats::kNumSizeBuckets) && (island.getNumConstraints() >> (iBucket + 1))) {
+				++iBucket;
+			}
+			++mIslandStats.sizeHistogram[iBucket];
 		}
 
-		{ // Solve the islands constraints
-			std::scoped_lock lck(mMutex);
+		// The large islands are solved one by one, splitting each one of
+		// them between all the threads
+		std::size_t minParallelConstraints = mParentWorld->getProperties().minParallelSolverConstraints;
+		std::size_t iFirstSmall = 0;
+		while ((iFirstSmall < mIslands.size()) && (minParallelConstraints > 0)
+			&& (mIslands[iFirstSmall].getNumConstraints() >= minParallelConstraints)
+		) {
+			mIslands[iFirstSmall].update(deltaTime, mParallelSolver.get());
+			++iFirstSmall;
+		}
+		mIslandStats.numParallelIslands = iFirstSmall;
 
-			std::size_t nThreads = mParentWorld->getProperties().numThreads;
-			std::size_t islandsPerThread = mIslands.size() / nThreads;
-			std::vector<std::future<void>> threadFutures(nThreads);
+		// The rest of the islands are split in tasks with a similar number
+		// of Constraints. Because they are sorted by size the large ones are
+		// submitted first as individual tasks, and the small ones are batched
+		// together
+		std::size_t numConstraints = std::accumulate(mIslands.begin() + iFirstSmall, mIslands.end(), std::size_t(0), [](std::size_t sum, const ConstraintIsland& island) {
+			return sum + island.getNumConstraints();
+		});
+		std::size_t nThreads = mParentWorld->getProperties().numThreads;
+		std::size_t constraintsPerTask = std::max(numConstraints / (kTasksPerThread * nThreads), std::size_t(1));
 
-			for (std::size_t iThread = 0; iThread < nThreads; ++iThread) {
-				threadFutures[iThread] = mParentWorld->getThreadPool().async([=]() {
-					std::size_t iStart = iThread * islandsPerThread;
-					std::size_t iEnd = (iThread < nThreads - 1)?
-						(iThread + 1) * islandsPerThread :
-						mIslands.size();
+		std::vector<std::pair<std::size_t, std::size_t>> taskRanges;
+		for (std::size_t iStart = iFirstSmall, taskConstraints = 0, i = iFirstSmall; i < mIslands.size(); ++i) {
+			taskConstraints += mIslands[i].getNumConstraints();
+			if ((taskConstraints >= constraintsPerTask) || (i + 1 == mIslands.size())) {
+				taskRanges.emplace_back(iStart, i + 1);
+				iStart = i + 1;
+				taskConstraints = 0;
+			}
+		}
+		mIslandStats.numTasks = taskRanges.size();
 
-					for (std::size_t i = iStart; i < iEnd; ++i) {
-						mIslands[i].update(deltaTime);
-					}
-				});
+		auto solveIslands = [this, deltaTime](std::size_t iStart, std::size_t iEnd) {
+			for (std::size_t i = iStart; i < iEnd; ++i) {
+				mIslands[i].update(deltaTime);
 			}
+		};
 
-			for (auto& future : threadFutures) {
+		if (taskRanges.size() == 1) {
+			solveIslands(taskRanges.front().first, taskRanges.front().second);
+		}
+		else if (taskRanges.size() > 1) {
+			std::vector<std::future<void>> taskFutures;
+			taskFutures.reserve(taskRanges.size());
+			for (auto [iStart, iEnd] : taskRanges) {
+				taskFutures.push_back(mParentWorld->getThreadPool().async([=]() { solveIslands(iStart, iEnd); }));
+			}
+
+			for (auto& future : taskFutures) {
 				future.get();
 			}
 		}
 	}
 
+
+	IslandStats ConstraintManager::getIslandStats() const
+	{
+		std::scoped_lock lck(mMutex);
+		return mIslandStats;
+	}
+
+// Private functions
+	void ConstraintManager::rebuildIslands()
+	{
+		mRebuildIslands = false;
+
+		// Get the non static RigidBodies, the static ones don't connect the
+		// islands
+		auto isStatic = [](const RigidBody* rb) {
+			return rb->getProperties().type == RigidBodyProperties::Type::Static;
+		};
+
+		std::vector<RigidBody*> rigidBodies;
+		for (Constraint* constraint : mConstraints) {
+			for (std::size_t i = 0; i < 2; ++i) {
+				if (!isStatic(constraint->getRigidBody(i))) {
+					rigidBodies.push_back(constraint->getRigidBody(i));
+				}
+			}
+		}
+		std::sort(rigidBodies.begin(), rigidBodies.end());
+		rigidBodies.erase(std::unique(rigidBodies.begin(), rigidBodies.end()), rigidBodies.end());
+
+		// Join the RigidBodies of each Constraint with an union-find
+		std::vector<std::size_t> parents(rigidBodies.size());
+		std::iota(parents.begin(), parents.end(), std::size_t(0));
+		auto find = [&](std::size_t iRB) {
+			while (parents[iRB] != iRB) {
+				parents[iRB] = parents[parents[iRB]];
+				iRB = parents[iRB];
+			}
+			return iRB;
+		};
+		auto indexOf = [&](RigidBody* rb) {
+			return static_cast<std::size_t>(std::distance(
+				rigidBodies.begin(), std::lower_bound(rigidBodies.begin(), rigidBodies.end(), rb)
+			));
+		};
+
+		std::vector<std::size_t> constraintRBs(mConstraints.size());
+		for (std::size_t iConstraint = 0; iConstraint < mConstraints.size(); ++iConstraint) {
+			RigidBody* rb1 = mConstraints[iConstraint]->getRigidBody(0);
+			RigidBody* rb2 = mConstraints[iConstraint]->getRigidBody(1);
+			if (!isStatic(rb1) && !isStatic(rb2)) {
+				std::size_t iRoot1 = find(indexOf(rb1)), iRoot2 = find(indexOf(rb2));
+				parents[std::max(iRoot1, iRoot2)] = std::min(iRoot1, iRoot2);
+				constraintRBs[iConstraint] = iRoot1;
+			}
+			else if (!isStatic(rb1)) {
+				constraintRBs[iConstraint] = indexOf(rb1);
+			}
+			else if (!isStatic(rb2)) {
+				constraintRBs[iConstraint] = indexOf(rb2);
+			}
+			else {
+				// The Constraints between static RigidBodies have their own
+				// islands
+				constraintRBs[iConstraint] = rigidBodies.size() + iConstraint;
+			}
+		}
+
+		// Assign an island to each root in the order of the Constraints
+		std::vector<std::size_t> rootIslands(rigidBodies.size(), mConstraints.size());
+		std::vector<std::size_t> constraintIslands(mConstraints.size());
+		std::vector<std::size_t> islandSizes;
+		for (std::size_t iConstraint = 0; iConstraint < mConstraints.size(); ++iConstraint) {
+			std::size_t iIsland = islandSizes.size();
+			if (constraintRBs[iConstraint] < rigidBodies.size()) {
+				std::size_t iRoot = find(constraintRBs[iConstraint]);
+				if (rootIslands[iRoot] == mConstraints.size()) {
+					rootIslands[iRoot] = iIsland;
+				}
+				iIsland = rootIslands[iRoot];
+			}
+
+			if (iIsland == islandSizes.size()) {
+				islandSizes.push_back(0);
+			}
+			constraintIslands[iConstraint] = iIsland;
+			++islandSizes[iIsland];
+		}
+
+		// Sort the islands descendently by their number of Constraints
+		std::vector<std::size_t> islandOrder(islandSizes.size());
+		std::iota(islandOrder.begin(), islandOrder.end(), std::size_t(0));
+		std::stable_sort(islandOrder.begin(), islandOrder.end(), [&](std::size_t i1, std::size_t i2) {
+			return islandSizes[i1] > islandSizes[i2];
+		});
+
+		std::vector<std::size_t> sortedOffsets(islandSizes.size() + 1, 0);
+		std::vector<std::size_t> islandOffsets(islandSizes.size());
+		for (std::size_t i = 0; i < islandOrder.size(); ++i) {
+			sortedOffsets[i + 1] = sortedOffsets[i] + islandSizes[islandOrder[i]];
+			islandOffsets[islandOrder[i]] = sortedOffsets[i];
+		}
+
+		// Group the Constraints by island, preserving their order
+		std::vector<Constraint*> sortedConstraints(mConstraints.size());
+		for (std::size_t iConstraint = 0; iConstraint < mConstraints.size(); ++iConstraint) {
+			sortedConstraints[islandOffsets[constraintIslands[iConstraint]]++] = mConstraints[iConstraint];
+		}
+
+		// Reuse the old islands so their memory isn't allocated again
+		mIslands.resize(islandSizes.size(), ConstraintIsland(mParentWorld->getProperties().maxConstraintIterations));
+		for (std::size_t i = 0; i < islandOrder.size(); ++i) {
+			mIslands[i].setConstraints(sortedConstraints.data() + sortedOffsets[i], sortedOffsets[i + 1] - sortedOffsets[i]);
+		}
+	}
+
+
+	void ConstraintManager::wakeUpRigidBodies(const Constraint& constraint)
+	{
+		for (std::size_t i = 0; i < 2; ++i) {
+			RigidBody* rb = constraint.getRigidBody(i);
+			if ((rb->getProperties().type == RigidBodyProperties::Type::Dynamic)
+				&& rb->getStatus(RigidBody::Status::Sleeping)
+			) {
+				rb->setStatus(RigidBody::Status::Sleeping, false);
+			}
+		}
+	}
+
 }
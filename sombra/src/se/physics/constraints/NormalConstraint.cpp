@@ -62,8 +62,13 @@ namespace se::physics {
 
 	void NormalConstraint::setDeltaTime(float deltaTime)
 	{
-		mDeltaTime = deltaTime;
-		mUpdated = true;
+		// The same delta time is set in every substep, so it only updates
+		// the NormalConstraint when it changes. Otherwise the sleeping
+		// ConstraintIslands would be woken up
+		if (mDeltaTime != deltaTime) {
+			mDeltaTime = deltaTime;
+			mUpdated = true;
+		}
 	}
 
 }
@@ -0,0 +1,312 @@
+#include <future>
+#include <algorithm>
+#include "se/utils/ThreadPool.h"
+#include "ParallelConstraintSolver.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+	#include <emmintrin.h>
+	#define SOMBRA_PARALLEL_SOLVER_SSE
+#endif
+
+namespace se::physics {
+
+	void ParallelConstraintSolver::solve(const Input& input, float* lambdas, std::size_t numIterations)
+	{
+		prepare(input, lambdas);
+
+		std::vector<std::future<void>> taskFutures;
+		for (std::size_t iteration = 0; iteration < numIterations; ++iteration) {
+			// The Constraints of each color batch don't share any dynamic
+			// RigidBody, so they can be solved in any order without changing
+			// the result
+			for (std::size_t iColor = 0; iColor + 1 < mColorOffsets.size(); ++iColor) {
+				std::size_t iFirst = mColorOffsets[iColor], iLast = mColorOffsets[iColor + 1];
+				std::size_t numGroups = (iLast - iFirst) / kNumLanes;
+				std::size_t numTasks = std::clamp((iLast - iFirst) / kMinConstraintsPerTask, std::size_t(1), std::max(std::size_t(1), mNumThreads));
+
+				if (numTasks == 1) {
+					solveSlots(iFirst, iLast);
+				}
+				else {
+					std::size_t groupsPerTask = numGroups / numTasks;
+					taskFutures.resize(numTasks);
+					for (std::size_t iTask = 0; iTask < numTasks; ++iTask) {
+						std::size_t iTaskFirst = iFirst + iTask * groupsPerTask * kNumLanes;
+						std::size_t iTaskLast = (iTask < numTasks - 1)? iTaskFirst + groupsPerTask * kNumLanes : iLast;
+						taskFutures[iTask] = mThreadPool.async([=]() { solveSlots(iTaskFirst, iTaskLast); });
+					}
+
+					for (auto& future : taskFutures) {
+						future.get();
+					}
+				}
+			}
+
+			solveOverflow(input, lambdas);
+		}
+
+		// Store the solved lambdas of the colored Constraints
+		for (std::size_t iSlot = 0; iSlot < mConstraintIndices.size(); ++iSlot) {
+			if (mConstraintIndices[iSlot] < input.numConstraints) {
+				lambdas[mConstraintIndices[iSlot]] = mLambdas[iSlot];
+			}
+		}
+	}
+
+// Private functions
+	void ParallelConstraintSolver::prepare(const Input& input, const float* lambdas)
+	{
+		// Color the Constraints greedily in their order, so the colors are
+		// always the same for the same Constraints
+		std::array<std::size_t, kMaxColors> colorSizes = {};
+		std::size_t numColors = 0;
+
+		mConstraintColors.resize(input.numConstraints);
+		mRigidBodyColors.assign(input.numRigidBodies, 0);
+		mOverflowConstraints.clear();
+		for (std::size_t i = 0; i < input.numConstraints; ++i) {
+			std::uint64_t usedColors = 0;
+			for (std::size_t iRB : input.constraintRBMap[i]) {
+				if (input.dynamicRBs[iRB]) {
+					usedColors |= mRigidBodyColors[iRB];
+				}
+			}
+
+			std::size_t iColor = 0;
+			while ((iColor < kMaxColors) && (usedColors & (std::uint64_t(1) << iColor))) {
+				++iColor;
+			}
+
+			mConstraintColors[i] = iColor;
+			if (iColor < kMaxColors) {
+				for (std::size_t iRB : input.constraintRBMap[i]) {
+					if (input.dynamicRBs[iRB]) {
+						mRigidBodyColors[iRB] |= std::uint64_t(1) << iColor;
+					}
+				}
+				++colorSizes[iColor];
+				numColors = std::max(numColors, iColor + 1);
+			}
+			else {
+				mOverflowConstraints.push_back(i);
+			}
+		}
+
+		// Calculate the slots of each color batch padded to the number of
+		// SIMD lanes
+		mColorOffsets.resize(numColors + 1);
+		mColorOffsets[0] = 0;
+		for (std::size_t iColor = 0; iColor < numColors; ++iColor) {
+			std::size_t paddedSize = (colorSizes[iColor] + kNumLanes - 1) / kNumLanes * kNumLanes;
+			mColorOffsets[iColor + 1] = mColorOffsets[iColor] + paddedSize;
+		}
+
+		// Store the Constraints in their slots, the padding slots have
+		// zero lambda bounds so they are never changed
+		const std::uint32_t iNoRB = static_cast<std::uint32_t>(input.numRigidBodies);
+		const std::size_t numSlots = mColorOffsets.back();
+		mConstraintIndices.resize(numSlots);
+		mRigidBodyIndices.resize(2 * numSlots);
+		mJacobians.resize(12 * numSlots);
+		mInvMassJacobians.resize(numSlots);
+		mInvEffectiveMasses.resize(numSlots);
+		mEtas.resize(numSlots);
+		mLambdaMins.resize(numSlots);
+		mLambdaMaxs.resize(numSlots);
+		mLambdas.resize(numSlots);
+
+		std::array<std::size_t, kMaxColors> nextSlots;
+		std::copy(mColorOffsets.begin(), mColorOffsets.end() - 1, nextSlots.begin());
+		for (std::size_t i = 0; i < input.numConstraints; ++i) {
+			if (mConstraintColors[i] >= kMaxColors) {
+				continue;
+			}
+
+			std::size_t iSlot = nextSlots[mConstraintColors[i]]++;
+			mConstraintIndices[iSlot] = i;
+			for (std::size_t j = 0; j < 2; ++j) {
+				std::size_t iRB = input.constraintRBMap[i][j];
+				mRigidBodyIndices[j * numSlots + iSlot] = input.dynamicRBs[iRB]? static_cast<std::uint32_t>(iRB) : iNoRB;
+			}
+			for (std::size_t k = 0; k < 12; ++k) {
+				mJacobians[k * numSlots + iSlot] = input.jacobians[i][k];
+			}
+			mInvMassJacobians[iSlot] = input.invMassJacobians[i];
+			mInvEffectiveMasses[iSlot] = (input.diagonal[i] > 0.0f)? 1.0f / input.diagonal[i] : 0.0f;
+			mEtas[iSlot] = input.eta[i];
+			mLambdaMins[iSlot] = input.lambdaMin[i];
+			mLambdaMaxs[iSlot] = input.lambdaMax[i];
+			mLambdas[iSlot] = lambdas[i];
+		}
+
+		for (std::size_t iColor = 0; iColor < numColors; ++iColor) {
+			for (std::size_t iSlot = nextSlots[iColor]; iSlot < mColorOffsets[iColor + 1]; ++iSlot) {
+				mConstraintIndices[iSlot] = input.numConstraints;
+				mRigidBodyIndices[iSlot] = mRigidBodyIndices[numSlots + iSlot] = iNoRB;
+				for (std::size_t k = 0; k < 12; ++k) {
+					mJacobians[k * numSlots + iSlot] = 0.0f;
+				}
+				mInvMassJacobians[iSlot] = {};
+				mInvEffectiveMasses[iSlot] = mEtas[iSlot] = 0.0f;
+				mLambdaMins[iSlot] = mLambdaMaxs[iSlot] = mLambdas[iSlot] = 0.0f;
+			}
+		}
+
+		// Apply the initial lambdas to the RigidBodies
+		mInvMJLambdas.assign(6 * (input.numRigidBodies + 1), 0.0f);
+		for (std::size_t i = 0; i < input.numConstraints; ++i) {
+			for (std::size_t j = 0; j < 2; ++j) {
+				std::size_t iRB = input.constraintRBMap[i][j];
+				if (input.dynamicRBs[iRB]) {
+					for (std::size_t k = 0; k < 6; ++k) {
+						mInvMJLambdas[6*iRB + k] += input.invMassJacobians[i][6*j + k] * lambdas[i];
+					}
+				}
+			}
+		}
+	}
+
+
+	void ParallelConstraintSolver::solveSlots(std::size_t iFirst, std::size_t iLast)
+	{
+		const std::size_t numSlots = mColorOffsets.back();
+		const std::uint32_t iNoRB = static_cast<std::uint32_t>(mInvMJLambdas.size() / 6 - 1);
+
+		for (std::size_t i = iFirst; i < iLast; i += kNumLanes) {
+#ifdef SOMBRA_PARALLEL_SOLVER_SSE
+			// Gather the current change of velocity of the RigidBodies of
+			// each lane, transposing them so each register holds the same
+			// component of every lane
+			__m128 invMJLambdas[12];
+			for (std::size_t j = 0; j < 2; ++j) {
+				const float* rbInvMJLambdas[kNumLanes];
+				for (std::size_t iLane = 0; iLane < kNumLanes; ++iLane) {
+					rbInvMJLambdas[iLane] = &mInvMJLambdas[6 * mRigidBodyIndices[j * numSlots + i + iLane]];
+				}
+
+				__m128 r0 = _mm_loadu_ps(rbInvMJLambdas[0]), r1 = _mm_loadu_ps(rbInvMJLambdas[1]),
+					r2 = _mm_loadu_ps(rbInvMJLambdas[2]), r3 = _mm_loadu_ps(rbInvMJLambdas[3]);
+				_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+				invMJLambdas[6*j] = r0; invMJLambdas[6*j + 1] = r1; invMJLambdas[6*j + 2] = r2; invMJLambdas[6*j + 3] = r3;
+
+				r0 = _mm_loadu_ps(rbInvMJLambdas[0] + 2); r1 = _mm_loadu_ps(rbInvMJLambdas[1] + 2);
+				r2 = _mm_loadu_ps(rbInvMJLambdas[2] + 2); r3 = _mm_loadu_ps(rbInvMJLambdas[3] + 2);
+				_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+				invMJLambdas[6*j + 4] = r2; invMJLambdas[6*j + 5] = r3;
+			}
+
+			// Calculate the change of the lambdas clamped to their bounds
+			__m128 jInvMJLambda = _mm_setzero_ps();
+			for (std::size_t k = 0; k < 12; ++k) {
+				jInvMJLambda = _mm_add_ps(jInvMJLambda, _mm_mul_ps(_mm_loadu_ps(&mJacobians[k * numSlots + i]), invMJLambdas[k]));
+			}
+
+			__m128 deltaLambda = _mm_mul_ps(
+				_mm_sub_ps(_mm_loadu_ps(&mEtas[i]), jInvMJLambda),
+				_mm_loadu_ps(&mInvEffectiveMasses[i])
+			);
+			__m128 oldLambda = _mm_loadu_ps(&mLambdas[i]);
+			__m128 newLambda = _mm_min_ps(
+				_mm_max_ps(_mm_add_ps(oldLambda, deltaLambda), _mm_loadu_ps(&mLambdaMins[i])),
+				_mm_loadu_ps(&mLambdaMaxs[i])
+			);
+			_mm_storeu_ps(&mLambdas[i], newLambda);
+
+			float deltaLambdas[kNumLanes];
+			_mm_storeu_ps(deltaLambdas, _mm_sub_ps(newLambda, oldLambda));
+
+			// Scatter the changes to the dynamic RigidBodies
+			for (std::size_t iLane = 0; iLane < kNumLanes; ++iLane) {
+				const float* invMassJacobian = mInvMassJacobians[i + iLane].data();
+				__m128 laneDeltaLambda = _mm_set1_ps(deltaLambdas[iLane]);
+				for (std::size_t j = 0; j < 2; ++j) {
+					std::uint32_t iRB = mRigidBodyIndices[j * numSlots + i + iLane];
+					if (iRB != iNoRB) {
+						float* rbInvMJLambda = &mInvMJLambdas[6*iRB];
+						_mm_storeu_ps(rbInvMJLambda, _mm_add_ps(
+							_mm_loadu_ps(rbInvMJLambda),
+							_mm_mul_ps(laneDeltaLambda, _mm_loadu_ps(invMassJacobian + 6*j))
+						));
+
+						__m128 rbLast = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(rbInvMJLambda + 4));
+						__m128 jacobianLast = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(invMassJacobian + 6*j + 4));
+						_mm_storel_pi(reinterpret_cast<__m64*>(rbInvMJLambda + 4), _mm_add_ps(rbLast, _mm_mul_ps(laneDeltaLambda, jacobianLast)));
+					}
+				}
+			}
+#else
+			// Gather the current change of velocity of the RigidBodies of
+			// each lane
+			float invMJLambdas[12][kNumLanes];
+			for (std::size_t j = 0; j < 2; ++j) {
+				for (std::size_t iLane = 0; iLane < kNumLanes; ++iLane) {
+					const float* invMJLambda = &mInvMJLambdas[6 * mRigidBodyIndices[j * numSlots + i + iLane]];
+					for (std::size_t k = 0; k < 6; ++k) {
+						invMJLambdas[6*j + k][iLane] = invMJLambda[k];
+					}
+				}
+			}
+
+			// Calculate the change of the lambdas clamped to their bounds
+			float deltaLambdas[kNumLanes];
+			for (std::size_t iLane = 0; iLane < kNumLanes; ++iLane) {
+				float jInvMJLambda = 0.0f;
+				for (std::size_t k = 0; k < 12; ++k) {
+					jInvMJLambda += mJacobians[k * numSlots + i + iLane] * invMJLambdas[k][iLane];
+				}
+
+				float deltaLambda = (mEtas[i + iLane] - jInvMJLambda) * mInvEffectiveMasses[i + iLane];
+				float oldLambda = mLambdas[i + iLane];
+				float newLambda = std::min(std::max(oldLambda + deltaLambda, mLambdaMins[i + iLane]), mLambdaMaxs[i + iLane]);
+				mLambdas[i + iLane] = newLambda;
+				deltaLambdas[iLane] = newLambda - oldLambda;
+			}
+
+			// Scatter the changes to the dynamic RigidBodies
+			for (std::size_t iLane = 0; iLane < kNumLanes; ++iLane) {
+				const vec12& invMassJacobian = mInvMassJacobians[i + iLane];
+				for (std::size_t j = 0; j < 2; ++j) {
+					std::uint32_t iRB = mRigidBodyIndices[j * numSlots + i + iLane];
+					if (iRB != iNoRB) {
+						for (std::size_t k = 0; k < 6; ++k) {
+							mInvMJLambdas[6*iRB + k] += deltaLambdas[iLane] * invMassJacobian[6*j + k];
+						}
+					}
+				}
+			}
+#endif
+		}
+	}
+
+
+	void ParallelConstraintSolver::solveOverflow(const Input& input, float* lambdas)
+	{
+		for (std::size_t i : mOverflowConstraints) {
+			float jInvMJLambda = 0.0f;
+			for (std::size_t j = 0; j < 2; ++j) {
+				std::size_t iRB = input.constraintRBMap[i][j];
+				if (input.dynamicRBs[iRB]) {
+					for (std::size_t k = 0; k < 6; ++k) {
+						jInvMJLambda += input.jacobians[i][6*j + k] * mInvMJLambdas[6*iRB + k];
+					}
+				}
+			}
+
+			float invEffectiveMass = (input.diagonal[i] > 0.0f)? 1.0f / input.diagonal[i] : 0.0f;
+			float deltaLambda = (input.eta[i] - jInvMJLambda) * invEffectiveMass;
+			float oldLambda = lambdas[i];
+			lambdas[i] = std::clamp(oldLambda + deltaLambda, input.lambdaMin[i], input.lambdaMax[i]);
+
+			deltaLambda = lambdas[i] - oldLambda;
+			for (std::size_t j = 0; j < 2; ++j) {
+				std::size_t iRB = input.constraintRBMap[i][j];
+				if (input.dynamicRBs[iRB]) {
+					for (std::size_t k = 0; k < 6; ++k) {
+						mInvMJLambdas[6*iRB + k] += deltaLambda * input.invMassJacobians[i][6*j + k];
+					}
+				}
+			}
+		}
+	}
+
+}
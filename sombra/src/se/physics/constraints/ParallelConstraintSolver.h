@@ -0,0 +1,189 @@
+#ifndef PARALLEL_CONSTRAINT_SOLVER_H
+#define PARALLEL_CONSTRAINT_SOLVER_H
+
+#include <array>
+#include <vector>
+#include <cstdint>
+
+namespace se::utils { class ThreadPool; }
+
+namespace se::physics {
+
+	/**
+	 * Class ParallelConstraintSolver, it's a PGS solver for the large
+	 * ConstraintIslands that can use multiple threads. The Constraints are
+	 * colored so the ones with the same color don't share any dynamic
+	 * RigidBody, so each color batch can be solved in parallel and with SIMD
+	 * instructions. The Constraints that can't be colored are solved
+	 * serially after the color batches.
+	 *
+	 * The data of the Constraints is stored in Structure of Arrays layout
+	 * sorted by color, and each color batch is padded to the number of SIMD
+	 * lanes. The result is independent of the number of threads.
+	 */
+	class ParallelConstraintSolver
+	{
+	public:		// Nested types
+		using vec12 = std::array<float, 12>;
+		using IndexPair = std::array<std::size_t, 2>;
+
+		/** Holds the data of the Constraints to solve, it's stored by the
+		 * ConstraintIsland in Array of Structures layout */
+		struct Input
+		{
+			/** The number of Constraints */
+			std::size_t numConstraints;
+
+			/** The number of RigidBodies */
+			std::size_t numRigidBodies;
+
+			/** The indices of the RigidBodies of each Constraint */
+			const IndexPair* constraintRBMap;
+
+			/** If each RigidBody is dynamic (1) or not (0) */
+			const std::uint8_t* dynamicRBs;
+
+			/** The Jacobian of each Constraint */
+			const vec12* jacobians;
+
+			/** The inverse mass matrix multiplied by the transposed Jacobian
+			 * of each Constraint */
+			const vec12* invMassJacobians;
+
+			/** The diagonal of J * M^-1 * J^T for each Constraint */
+			const float* diagonal;
+
+			/** The Eta value of each Constraint */
+			const float* eta;
+
+			/** The lower bound of the lambda of each Constraint */
+			const float* lambdaMin;
+
+			/** The upper bound of the lambda of each Constraint */
+			const float* lambdaMax;
+		};
+
+	private:
+		/** The maximum number of colors, the remaining Constraints are
+		 * solved serially */
+		static constexpr std::size_t kMaxColors = 64;
+
+		/** The number of Constraints solved together with SIMD
+		 * instructions, every color batch is padded to it */
+		static constexpr std::size_t kNumLanes = 4;
+
+		/** The minimum number of Constraints of a color batch that each
+		 * thread must solve */
+		static constexpr std::size_t kMinConstraintsPerTask = 64;
+
+	private:	// Attributes
+		/** The ThreadPool used for solving the color batches in parallel */
+		utils::ThreadPool& mThreadPool;
+
+		/** The maximum number of tasks to submit to @see mThreadPool */
+		std::size_t mNumThreads;
+
+		/** The color of each Constraint, @see kMaxColors if it couldn't be
+		 * colored */
+		std::vector<std::size_t> mConstraintColors;
+
+		/** The first slot of each color batch, the last one is the number
+		 * of slots */
+		std::vector<std::size_t> mColorOffsets;
+
+		/** The index of the Constraint stored in each slot,
+		 * numConstraints for the padding */
+		std::vector<std::size_t> mConstraintIndices;
+
+		/** The indices of the Constraints that couldn't be colored */
+		std::vector<std::size_t> mOverflowConstraints;
+
+		/** The indices of the RigidBodies of the Constraint of each slot,
+		 * stored as [rigidBody][slot]. The non dynamic ones and the padding
+		 * use the number of RigidBodies, which points to the zeroed entry
+		 * at the end of @see mInvMJLambdas, so they can be gathered without
+		 * branches */
+		std::vector<std::uint32_t> mRigidBodyIndices;
+
+		/** The Jacobian of the Constraint of each slot, stored as
+		 * [component][slot] */
+		std::vector<float> mJacobians;
+
+		/** The inverse mass matrix multiplied by the transposed Jacobian of
+		 * the Constraint of each slot, stored as [slot][component] because
+		 * it's only used for scattering the changes to each RigidBody */
+		std::vector<vec12> mInvMassJacobians;
+
+		/** The inverse of the effective mass of the Constraint of each
+		 * slot */
+		std::vector<float> mInvEffectiveMasses;
+
+		/** The Eta value of the Constraint of each slot */
+		std::vector<float> mEtas;
+
+		/** The lower bound of the lambda of the Constraint of each slot */
+		std::vector<float> mLambdaMins;
+
+		/** The upper bound of the lambda of the Constraint of each slot */
+		std::vector<float> mLambdaMaxs;
+
+		/** The lambda of the Constraint of each slot */
+		std::vector<float> mLambdas;
+
+		/** The inverse mass matrix multiplied by the transposed Jacobian and
+		 * the lambdas (the change of velocity) of each RigidBody, 6 floats
+		 * per RigidBody plus a zeroed entry for the non dynamic ones */
+		std::vector<float> mInvMJLambdas;
+
+		/** The colors used by each RigidBody while coloring */
+		std::vector<std::uint64_t> mRigidBodyColors;
+
+	public:		// Functions
+		/** Creates a new ParallelConstraintSolver
+		 *
+		 * @param	threadPool the ThreadPool used for solving the color
+		 *			batches in parallel
+		 * @param	numThreads the maximum number of tasks to submit to the
+		 *			ThreadPool */
+		ParallelConstraintSolver(
+			utils::ThreadPool& threadPool, std::size_t numThreads
+		) : mThreadPool(threadPool), mNumThreads(numThreads) {};
+
+		/** Solves the lambda values of the given Constraints
+		 *
+		 * @param	input the data of the Constraints
+		 * @param	lambdas the initial lambda value of each Constraint, the
+		 *			solved values will be stored in it
+		 * @param	numIterations the number of iterations of the PGS
+		 *			algorithm
+		 * @note	it can't be called from any of the threads of the
+		 *			ThreadPool */
+		void solve(
+			const Input& input, float* lambdas, std::size_t numIterations
+		);
+	private:
+		/** Colors the Constraints and stores them in Structure of Arrays
+		 * layout
+		 *
+		 * @param	input the data of the Constraints
+		 * @param	lambdas the initial lambda value of each Constraint */
+		void prepare(const Input& input, const float* lambdas);
+
+		/** Solves a range of slots of a color batch
+		 *
+		 * @param	iFirst the first slot to solve, it must be a multiple
+		 *			of @see kNumLanes
+		 * @param	iLast the slot after the last one to solve, it must be a
+		 *			multiple of @see kNumLanes */
+		void solveSlots(std::size_t iFirst, std::size_t iLast);
+
+		/** Solves the Constraints that couldn't be colored
+		 *
+		 * @param	input the data of the Constraints
+		 * @param	lambdas the lambda value of each Constraint */
+		void solveOverflow(const Input& input, float* lambdas);
+	};
+
+}
+
+#endif		// PARALLEL_CONSTRAINT_SOLVER_H
@@ -0,0 +1,128 @@
+#include "se/utils/Log.h"
+#include "se/utils/MemoryTracker.h"
+
+namespace se::utils {
+
+	MemoryTracker& MemoryTracker::getInstance()
+	{
+		static MemoryTracker instance;
+		return instance;
+	}
+
+
+	const char* MemoryTracker::getTagName(MemoryTag tag)
+	{
+		switch (tag) {
+			case MemoryTag::Default:	return "Default";
+			case MemoryTag::ECS:		return "ECS";
+			case MemoryTag::Repository:	return "Repository";
+			case MemoryTag::Physics:	return "Physics";
+			case MemoryTag::Animation:	return "Animation";
+			case MemoryTag::Graphics:	return "Graphics";
+			case MemoryTag::Mesh:		return "Mesh";
+			case MemoryTag::Texture:	return "Texture";
+			default:					return "Unknown";
+		}
+	}
+
+
+	void MemoryTracker::onAllocate(MemoryTag tag, std::size_t bytes)
+	{
+		TagCounters& counters = mCounters[static_cast<std::size_t>(tag)];
+
+		std::size_t oldBytes = counters.currentBytes.fetch_add(bytes);
+		std::size_t newBytes = oldBytes + bytes;
+		++counters.liveAllocations;
+		++counters.totalAllocations;
+		++counters.currentFrameAllocations;
+
+		std::size_t highWaterMark = counters.highWaterMark.load();
+		while ((newBytes > highWaterMark) && !counters.highWaterMark.compare_exchange_weak(highWaterMark, newBytes));
+
+		// The warning is logged later, because the logger could also
+		// allocate memory
+		std::size_t budget = counters.budget.load();
+		if ((oldBytes <= budget) && (newBytes > budget)) {
+			counters.budgetExceeded = true;
+		}
+	}
+
+
+	void MemoryTracker::onDeallocate(MemoryTag tag, std::size_t bytes)
+	{
+		TagCounters& counters = mCounters[static_cast<std::size_t>(tag)];
+		counters.currentBytes -= bytes;
+		--counters.liveAllocations;
+	}
+
+
+	void MemoryTracker::setBudget(MemoryTag tag, std::size_t bytes)
+	{
+		mCounters[static_cast<std::size_t>(tag)].budget = bytes;
+	}
+
+
+	bool MemoryTracker::isOverBudget(MemoryTag tag) const
+	{
+		const TagCounters& counters = mCounters[static_cast<std::size_t>(tag)];
+		return counters.currentBytes.load() > counters.budget.load();
+	}
+
+
+	void MemoryTracker::endFrame()
+	{
+		for (std::size_t i = 0; i < kNumTags; ++i) {
+			TagCounters& counters = mCounters[i];
+			counters.lastFrameAllocations = counters.currentFrameAllocations.exchange(0);
+
+			if (counters.budgetExceeded.exchange(false)) {
+				SOMBRA_WARN_LOG << "Memory budget of " << getTagName(static_cast<MemoryTag>(i)) << " exceeded: "
+					<< "high water mark of " << counters.highWaterMark.load() << " bytes, budget " << counters.budget.load() << " bytes";
+			}
+		}
+		++mFrameCount;
+	}
+
+
+	MemoryStats MemoryTracker::getStats(MemoryTag tag) const
+	{
+		const TagCounters& counters = mCounters[static_cast<std::size_t>(tag)];
+
+		MemoryStats ret;
+		ret.currentBytes = counters.currentBytes.load();
+		ret.highWaterMark = counters.highWaterMark.load();
+		ret.liveAllocations = counters.liveAllocations.load();
+		ret.totalAllocations = counters.totalAllocations.load();
+		ret.frameAllocations = counters.lastFrameAllocations.load();
+		ret.budget = counters.budget.load();
+		return ret;
+	}
+
+
+	MemoryStats MemoryTracker::getTotalStats() const
+	{
+		MemoryStats ret;
+		ret.budget = 0;
+		for (std::size_t i = 0; i < kNumTags; ++i) {
+			MemoryStats stats = getStats(static_cast<MemoryTag>(i));
+			ret.currentBytes += stats.currentBytes;
+			ret.highWaterMark += stats.highWaterMark;
+			ret.liveAllocations += stats.liveAllocations;
+			ret.totalAllocations += stats.totalAllocations;
+			ret.frameAllocations += stats.frameAllocations;
+			ret.budget = (stats.budget > std::numeric_limits<std::size_t>::max() - ret.budget)?
+				std::numeric_limits<std::size_t>::max() :
+				ret.budget + stats.budget;
+		}
+		return ret;
+	}
+
+
+	void MemoryTracker::resetHighWaterMarks()
+	{
+		for (TagCounters& counters : mCounters) {
+			counters.highWaterMark = counters.currentBytes.load();
+		}
+	}
+
+}
@@ -0,0 +1,112 @@
+#include <mutex>
+#include "se/utils/Log.h"
+#include "se/utils/StringInterner.h"
+
+namespace se::utils {
+
+	StringInterner& StringInterner::getInstance()
+	{
+		static StringInterner instance;
+		return instance;
+	}
+
+
+	StringInterner::ValueType StringInterner::intern(std::string_view str)
+	{
+		if (str.empty()) {
+			return kEmpty;
+		}
+
+		const ValueType hash = hashString64(str);
+		const ValueType firstId = (hash == kEmpty)? hash + 1 : hash;
+
+		ValueType id = hash;
+		{
+			std::shared_lock lock(mMutex);
+			if (probe(str, id)) {
+				return id;
+			}
+		}
+
+		std::unique_lock lock(mMutex);
+
+		// Probe again in case other thread added the string
+		id = hash;
+		if (!probe(str, id)) {
+			if (id != firstId) {
+				++mNumCollisions;
+				SOMBRA_WARN_LOG << "Hash collision found while interning \"" << str << "\", using id " << id;
+			}
+
+			mStrings.emplace(id, str);
+		}
+
+		return id;
+	}
+
+
+	bool StringInterner::find(std::string_view str, ValueType& ret) const
+	{
+		if (str.empty()) {
+			ret = kEmpty;
+			return true;
+		}
+
+		std::shared_lock lock(mMutex);
+		ValueType id = hashString64(str);
+		if (probe(str, id)) {
+			ret = id;
+			return true;
+		}
+
+		return false;
+	}
+
+
+	const char* StringInterner::getString(ValueType id) const
+	{
+		if (id == kEmpty) {
+			return "";
+		}
+
+		std::shared_lock lock(mMutex);
+		auto it = mStrings.find(id);
+		return (it != mStrings.end())? it->second.c_str() : "";
+	}
+
+
+	std::size_t StringInterner::size() const
+	{
+		std::shared_lock lock(mMutex);
+		return mStrings.size();
+	}
+
+
+	std::size_t StringInterner::getNumCollisions() const
+	{
+		std::shared_lock lock(mMutex);
+		return mNumCollisions;
+	}
+
+// Private functions
+	bool StringInterner::probe(std::string_view str, ValueType& id) const
+	{
+		if (id == kEmpty) {
+			++id;
+		}
+
+		for (auto it = mStrings.find(id); it != mStrings.end(); it = mStrings.find(id)) {
+			if (it->second == str) {
+				return true;
+			}
+
+			// Collision, try with the next id
+			if (++id == kEmpty) {
+				++id;
+			}
+		}
+
+		return false;
+	}
+
+}
@@ -34,10 +34,7 @@ TEST(SkeletonAnimator, loopTime1)
 TEST(SkeletonAnimator, animate1)
 {
 	std::string n1Str = "n1", n2Str = "n2", n3Str = "n3";
-	std::array<char, NodeData::kMaxLength> n1{}, n2{}, n3{};
-	std::copy(n1Str.begin(), n1Str.end(), n1.begin());
-	std::copy(n2Str.begin(), n2Str.end(), n2.begin());
-	std::copy(n3Str.begin(), n3Str.end(), n3.begin());
+	se::utils::NameId n1(n1Str), n2(n2Str), n3(n3Str);
 
 	std::vector<AnimationNode> expectedNodes(3);
 	expectedNodes[0].getData().name = n1;
@@ -125,11 +122,7 @@ TEST(SkeletonAnimator, animate1)
 TEST(SkeletonAnimator, resetNodesAnimatedState1)
 {
 	std::string n1Str = "n1", n2Str = "n2", n3Str = "n3", n4Str = "n4";
-	std::array<char, NodeData::kMaxLength> n1, n2, n3, n4;
-	std::copy(n1Str.begin(), n1Str.end(), n1.begin());
-	std::copy(n2Str.begin(), n2Str.end(), n2.begin());
-	std::copy(n3Str.begin(), n3Str.end(), n3.begin());
-	std::copy(n4Str.begin(), n4Str.end(), n4.begin());
+	se::utils::NameId n1(n1Str), n2(n2Str), n3(n3Str), n4(n4Str);
 
 	std::vector<AnimationNode> originalNodes(3);
 	originalNodes[0].getData().name = n1;
@@ -173,8 +166,7 @@ TEST(SkeletonAnimator, resetNodesAnimatedState1)
 TEST(SkeletonAnimator, updateNodesHierarchy1)
 {
 	std::string nameStr = "NODE";
-	std::array<char, NodeData::kMaxLength> name{};
-	std::copy(nameStr.begin(), nameStr.end(), name.begin());
+	se::utils::NameId name(nameStr);
 
 	std::vector<AnimationNode> expectedNodes(1);
 	expectedNodes[0].getData().name = name;
@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+#include <se/app/Application.h>
+
+using namespace se::app;
+
+class CountingApplication : public Application
+{
+public:
+	std::size_t numUpdates = 0;
+
+	CountingApplication(const HeadlessConfig& headlessConfig) :
+		Application(se::physics::WorldProperties(), 0.016f, headlessConfig) {};
+protected:
+	virtual void onUpdate(float deltaTime, float timeSinceStart) override
+	{
+		++numUpdates;
+		Application::onUpdate(deltaTime, timeSinceStart);
+	};
+};
+
+
+TEST(Application, headlessMaxUpdates)
+{
+	HeadlessConfig headlessConfig;
+	headlessConfig.runAsFastAsPossible = true;
+	headlessConfig.maxUpdates = 10;
+
+	CountingApplication application(headlessConfig);
+	EXPECT_TRUE(application.isHeadless());
+	EXPECT_EQ(application.getExternalTools().graphicsEngine, nullptr);
+	EXPECT_EQ(application.getExternalTools().audioEngine, nullptr);
+
+	// The main loop stops by itself after the last update
+	application.start();
+	EXPECT_EQ(application.numUpdates, 10u);
+}
@@ -0,0 +1,59 @@
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <se/app/io/SceneGenerator.h>
+#include <se/app/io/SceneSerializer.h>
+
+using namespace se::app;
+
+static std::string readFile(const std::string& path)
+{
+	std::ifstream stream(path, std::ios::binary);
+	std::stringstream buffer;
+	buffer << stream.rdbuf();
+	return buffer.str();
+}
+
+
+static std::string generateScene(unsigned int seed)
+{
+	HeadlessConfig headlessConfig;
+	Application application(se::physics::WorldProperties(), 0.016f, headlessConfig);
+	Scene scene("generated", application);
+
+	SceneGenerator::Config config;
+	config.seed = seed;
+	config.numConvexBodies = 20;
+	config.numMeshBodies = 3;
+	config.numTerrains = 1;
+	config.terrainResolution = 8;
+	config.numCharacters = 2;
+	config.numBonesPerCharacter = 4;
+	config.numLights = 3;
+	Result result = SceneGenerator::generate(config, scene);
+	EXPECT_TRUE(result) << result.description();
+
+	// The Scene is compared with its serialized data, including the binary
+	// buffers of the meshes and terrains
+	std::string path = (std::filesystem::temp_directory_path() / ("SceneGeneratorTest" + std::to_string(seed) + ".json")).string();
+	result = SceneSerializer::serialize(path, scene);
+	EXPECT_TRUE(result) << result.description();
+
+	std::string data = readFile(path) + readFile(path + ".dat");
+	std::filesystem::remove(path);
+	std::filesystem::remove(path + ".dat");
+	return data;
+}
+
+
+TEST(SceneGenerator, sameSeed)
+{
+	const std::string scene1 = generateScene(42);
+	const std::string scene2 = generateScene(42);
+	const std::string scene3 = generateScene(43);
+
+	ASSERT_FALSE(scene1.empty());
+	EXPECT_EQ(scene1, scene2);
+	EXPECT_NE(scene1, scene3);
+}
@@ -0,0 +1,167 @@
+#include <vector>
+#include <fstream>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <se/app/RigidBodyComponent.h>
+#include <se/app/io/SceneSerializer.h>
+#include <se/physics/collision/TriangleMeshCollider.h>
+
+using namespace se::app;
+using namespace se::physics;
+
+static std::shared_ptr<TriangleMesh> createMesh(float offset)
+{
+	const glm::vec3 vertices[] = {
+		{ offset, 0.0f, 0.0f }, { offset + 1.0f, 0.0f, 0.0f },
+		{ offset + 1.0f, 0.0f, 1.0f }, { offset, 0.0f, 1.0f }
+	};
+	const std::uint32_t indices[] = { 0, 1, 2, 0, 2, 3 };
+	return std::make_shared<TriangleMesh>(vertices, 4, indices, 6);
+}
+
+
+static void addMeshEntities(const std::vector<std::shared_ptr<TriangleMesh>>& meshes, Scene& scene)
+{
+	scene.application.getEntityDatabase().executeQuery([&](EntityDatabase::Query& query) {
+		for (const auto& mesh : meshes) {
+			Entity entity = query.addEntity();
+
+			RigidBodyComponent rigidBody;
+			rigidBody.get().setCollider(std::make_unique<TriangleMeshCollider>(mesh));
+			query.addComponent(entity, std::move(rigidBody));
+
+			scene.entities.push_back(entity);
+		}
+	});
+}
+
+
+static std::vector<const TriangleMesh*> getMeshes(Scene& scene)
+{
+	std::vector<const TriangleMesh*> meshes;
+	scene.application.getEntityDatabase().executeQuery([&](EntityDatabase::Query& query) {
+		for (Entity entity : scene.entities) {
+			auto [rigidBody] = query.getComponents<RigidBodyComponent>(entity);
+			auto collider = rigidBody? dynamic_cast<TriangleMeshCollider*>(rigidBody->get().getCollider()) : nullptr;
+			meshes.push_back(collider? collider->getMesh().get() : nullptr);
+		}
+	});
+	return meshes;
+}
+
+
+static nlohmann::json& getColliderJson(nlohmann::json& json, std::size_t entityIndex)
+{
+	for (auto& rigidBodyJson : json["rigidBodies"]) {
+		if (rigidBodyJson["entity"] == entityIndex) {
+			return rigidBodyJson["collider"];
+		}
+	}
+	return json["rigidBodies"][entityIndex]["collider"];
+}
+
+
+static void expectEqualMeshes(const TriangleMesh& mesh1, const TriangleMesh& mesh2)
+{
+	ASSERT_EQ(mesh1.getNumVertices(), mesh2.getNumVertices());
+	for (std::size_t i = 0; i < mesh1.getNumVertices(); ++i) {
+		EXPECT_EQ(mesh1.getVertices()[i], mesh2.getVertices()[i]);
+	}
+
+	ASSERT_EQ(mesh1.getNumIndices(), mesh2.getNumIndices());
+	for (std::size_t i = 0; i < mesh1.getNumIndices(); ++i) {
+		EXPECT_EQ(mesh1.getIndices()[i], mesh2.getIndices()[i]);
+	}
+}
+
+
+TEST(SceneSerializer, sharedTriangleMeshes)
+{
+	HeadlessConfig headlessConfig;
+	Application application(WorldProperties(), 0.016f, headlessConfig);
+	std::string path = (std::filesystem::temp_directory_path() / "SceneSerializerTestShared.json").string();
+
+	auto mesh1 = createMesh(0.0f), mesh2 = createMesh(5.0f);
+	{
+		Scene scene("shared", application);
+		addMeshEntities({ mesh1, mesh1, mesh2 }, scene);
+
+		Result result = SceneSerializer::serialize(path, scene);
+		ASSERT_TRUE(result) << result.description();
+	}
+
+	// The shared TriangleMesh must be written only once
+	std::ifstream jsonStream(path);
+	nlohmann::json json = nlohmann::json::parse(jsonStream);
+	ASSERT_EQ(json["rigidBodies"].size(), 3u);
+	EXPECT_EQ(getColliderJson(json, 0)["vertices"], getColliderJson(json, 1)["vertices"]);
+	EXPECT_NE(getColliderJson(json, 0)["vertices"], getColliderJson(json, 2)["vertices"]);
+	EXPECT_EQ(getColliderJson(json, 0)["indexSize"], sizeof(std::uint32_t));
+
+	Scene scene("shared", application);
+	Result result = SceneSerializer::deserialize(path, scene);
+	std::filesystem::remove(path);
+	std::filesystem::remove(path + ".dat");
+	ASSERT_TRUE(result) << result.description();
+
+	auto meshes = getMeshes(scene);
+	ASSERT_EQ(meshes.size(), 3u);
+	ASSERT_TRUE(meshes[0] && meshes[1] && meshes[2]);
+	EXPECT_EQ(meshes[0], meshes[1]);
+	EXPECT_NE(meshes[0], meshes[2]);
+	expectEqualMeshes(*meshes[0], *mesh1);
+	expectEqualMeshes(*meshes[2], *mesh2);
+}
+
+
+TEST(SceneSerializer, triangleMesh16BitIndices)
+{
+	HeadlessConfig headlessConfig;
+	Application application(WorldProperties(), 0.016f, headlessConfig);
+	std::string path = (std::filesystem::temp_directory_path() / "SceneSerializerTest16Bit.json").string();
+
+	auto mesh = createMesh(0.0f);
+	{
+		Scene scene("16bit", application);
+		addMeshEntities({ mesh }, scene);
+
+		Result result = SceneSerializer::serialize(path, scene);
+		ASSERT_TRUE(result) << result.description();
+	}
+
+	// Scenes serialized before the indexSize property was added stored the
+	// indices with 16 bits
+	nlohmann::json json;
+	{
+		std::ifstream jsonStream(path);
+		json = nlohmann::json::parse(jsonStream);
+	}
+	auto& colliderJson = getColliderJson(json, 0);
+	colliderJson.erase("indexSize");
+	std::size_t indicesBuffer = colliderJson["indices"].get<std::size_t>();
+
+	std::vector<std::uint16_t> indices(mesh->getIndices(), mesh->getIndices() + mesh->getNumIndices());
+	std::size_t indicesOffset = std::filesystem::file_size(path + ".dat");
+	{
+		std::ofstream dataStream(path + ".dat", std::ios::binary | std::ios::app);
+		dataStream.write(reinterpret_cast<const char*>(indices.data()), indices.size() * sizeof(std::uint16_t));
+	}
+	json["buffers"][indicesBuffer]["offset"] = indicesOffset;
+	json["buffers"][indicesBuffer]["size"] = indices.size() * sizeof(std::uint16_t);
+	{
+		std::ofstream jsonStream(path);
+		jsonStream << json;
+	}
+
+	Scene scene("16bit", application);
+	Result result = SceneSerializer::deserialize(path, scene);
+	std::filesystem::remove(path);
+	std::filesystem::remove(path + ".dat");
+	ASSERT_TRUE(result) << result.description();
+
+	auto meshes = getMeshes(scene);
+	ASSERT_EQ(meshes.size(), 1u);
+	ASSERT_TRUE(meshes[0]);
+	expectEqualMeshes(*meshes[0], *mesh);
+}
@@ -91,3 +91,23 @@ TEST(Capsule, getFurthestPointInDirection)
 		EXPECT_NEAR(pointLocal[i], expectedPLocal[i], kTolerance);
 	}
 }
+
+
+TEST(Capsule, getFurthestPointInDirection2)
+{
+	const float radius = 0.5f, height = 2.0f;
+	const glm::vec3 direction(0.0f, -1.0f, 0.0f);
+	const glm::vec3 expectedPWorld(3.0f, -1.5f, 0.0f);
+	const glm::vec3 expectedPLocal(0.0f, -1.5f, 0.0f);
+
+	Capsule c1(radius, height);
+	c1.setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(3.0f, 0.0f, 0.0f)));
+
+	glm::vec3 pointWorld, pointLocal;
+	c1.getFurthestPointInDirection(direction, pointWorld, pointLocal);
+
+	for (int i = 0; i < 3; ++i) {
+		EXPECT_NEAR(pointWorld[i], expectedPWorld[i], kTolerance);
+		EXPECT_NEAR(pointLocal[i], expectedPLocal[i], kTolerance);
+	}
+}
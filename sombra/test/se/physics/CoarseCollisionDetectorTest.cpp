@@ -1,8 +1,10 @@
+#include <random>
 #include <gtest/gtest.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <se/physics/collision/ConvexPolyhedron.h>
 #include <se/physics/collision/BoundingSphere.h>
 #include <se/physics/collision/CoarseCollisionDetector.h>
+#include <se/utils/ThreadPool.h>
 #include "TestMeshes.h"
 
 using namespace se::physics;
@@ -48,3 +50,176 @@ TEST(CoarseCollisionDetector, collide)
 		EXPECT_TRUE(flag);
 	});
 }
+
+
+TEST(CoarseCollisionDetector, moveColliders)
+{
+	CoarseCollisionDetector ccd(kTolerance, 0.5f, 2.0f, 4);
+
+	std::vector<std::unique_ptr<BoundingSphere>> spheres;
+	for (int i = 0; i < 16; ++i) {
+		auto& sphere = spheres.emplace_back(std::make_unique<BoundingSphere>(0.5f));
+		sphere->setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(3.0f * i, 0.0f, 0.0f)));
+		ccd.add(sphere.get());
+	}
+
+	// Move the spheres towards the first one, each step some of them will
+	// stay inside their fat AABBs and others will be reinserted
+	for (int step = 1; step <= 10; ++step) {
+		for (int i = 1; i < 16; ++i) {
+			float x = 3.0f * i - 0.3f * i * step;
+			spheres[i]->setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(x, 0.0f, 0.0f)));
+		}
+		ccd.update();
+
+		// Compare with a brute force test of the real AABBs
+		std::set<std::pair<const Collider*, const Collider*>> expectedRes;
+		for (std::size_t i = 0; i < spheres.size(); ++i) {
+			for (std::size_t j = i + 1; j < spheres.size(); ++j) {
+				if (overlaps(spheres[i]->getAABB(), spheres[j]->getAABB(), kTolerance)) {
+					expectedRes.emplace(spheres[i].get(), spheres[j].get());
+				}
+			}
+		}
+
+		std::size_t numCollisions = 0;
+		ccd.calculateCollisions([&](const Collider* c1, const Collider* c2) {
+			bool found = (expectedRes.count({ c1, c2 }) > 0) || (expectedRes.count({ c2, c1 }) > 0);
+			EXPECT_TRUE(found);
+			++numCollisions;
+		});
+		EXPECT_EQ(numCollisions, expectedRes.size());
+
+		// The pair cache must have the same pairs
+		std::size_t numPairs = 0;
+		for (const auto& pair : ccd.getPairs()) {
+			if (pair.state != CoarseCollisionDetector::PairState::End) {
+				const Collider* c1 = pair.colliders[0], * c2 = pair.colliders[1];
+				bool found = (expectedRes.count({ c1, c2 }) > 0) || (expectedRes.count({ c2, c1 }) > 0);
+				EXPECT_TRUE(found);
+				++numPairs;
+			}
+		}
+		EXPECT_EQ(numPairs, expectedRes.size());
+
+		for (auto& sphere : spheres) {
+			sphere->resetUpdatedState();
+		}
+	}
+}
+
+
+TEST(CoarseCollisionDetector, pairStates)
+{
+	using PairState = CoarseCollisionDetector::PairState;
+	CoarseCollisionDetector ccd(kTolerance);
+
+	BoundingSphere bs1(1.0f), bs2(1.0f), bs3(1.0f);
+	bs1.setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, 0.0f)));
+	bs2.setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(5.0f, 0.0f, 0.0f)));
+	bs3.setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(1.5f, 0.0f, 0.0f)));
+	ccd.add(&bs1);
+	ccd.add(&bs2);
+	ccd.add(&bs3);
+
+	auto resetUpdatedState = [&]() {
+		bs1.resetUpdatedState();
+		bs2.resetUpdatedState();
+		bs3.resetUpdatedState();
+	};
+
+	ccd.update();
+	resetUpdatedState();
+	ASSERT_EQ(ccd.getPairs().size(), 1u);
+	EXPECT_EQ(ccd.getPairs()[0].colliders[0], &bs1);
+	EXPECT_EQ(ccd.getPairs()[0].colliders[1], &bs3);
+	EXPECT_EQ(ccd.getPairs()[0].state, PairState::Begin);
+	ccd.getPairs()[0].userData = 3;
+
+	// Nothing moves
+	ccd.update();
+	resetUpdatedState();
+	ASSERT_EQ(ccd.getPairs().size(), 1u);
+	EXPECT_EQ(ccd.getPairs()[0].state, PairState::Persist);
+	EXPECT_EQ(ccd.getPairs()[0].userData, 3u);
+
+	// bs3 moves from bs1 to bs2
+	bs3.setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(3.5f, 0.0f, 0.0f)));
+	ccd.update();
+	resetUpdatedState();
+	ASSERT_EQ(ccd.getPairs().size(), 2u);
+	EXPECT_EQ(ccd.getPairs()[0].colliders[0], &bs1);
+	EXPECT_EQ(ccd.getPairs()[0].colliders[1], &bs3);
+	EXPECT_EQ(ccd.getPairs()[0].state, PairState::End);
+	EXPECT_EQ(ccd.getPairs()[0].userData, 3u);
+	EXPECT_EQ(ccd.getPairs()[1].colliders[0], &bs2);
+	EXPECT_EQ(ccd.getPairs()[1].colliders[1], &bs3);
+	EXPECT_EQ(ccd.getPairs()[1].state, PairState::Begin);
+	EXPECT_EQ(ccd.getPairs()[1].userData, CoarseCollisionDetector::ColliderPair::kNoUserData);
+
+	// The ended pairs are removed in the next update
+	ccd.update();
+	resetUpdatedState();
+	ASSERT_EQ(ccd.getPairs().size(), 1u);
+	EXPECT_EQ(ccd.getPairs()[0].colliders[0], &bs2);
+	EXPECT_EQ(ccd.getPairs()[0].state, PairState::Persist);
+
+	ccd.remove(&bs2);
+	EXPECT_TRUE(ccd.getPairs().empty());
+}
+
+
+TEST(CoarseCollisionDetector, parallelPairs)
+{
+	using PairState = CoarseCollisionDetector::PairState;
+	se::utils::ThreadPool threadPool(4);
+	CoarseCollisionDetector ccdSerial(kTolerance, 0.1f, 2.0f, 0);
+	CoarseCollisionDetector ccdParallel(kTolerance, 0.1f, 2.0f, 0);
+
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> positionDist(-10.0f, 10.0f);
+	std::uniform_real_distribution<float> velocityDist(-1.0f, 1.0f);
+
+	std::vector<std::unique_ptr<BoundingSphere>> spheres;
+	std::vector<glm::vec3> positions, velocities;
+	for (int i = 0; i < 2000; ++i) {
+		positions.emplace_back(positionDist(generator), positionDist(generator), positionDist(generator));
+		velocities.emplace_back(velocityDist(generator), velocityDist(generator), velocityDist(generator));
+
+		auto& sphere = spheres.emplace_back(std::make_unique<BoundingSphere>(0.5f));
+		sphere->setTransforms(glm::translate(glm::mat4(1.0f), positions.back()));
+		ccdSerial.add(sphere.get());
+		ccdParallel.add(sphere.get());
+	}
+
+	for (int step = 0; step < 10; ++step) {
+		ccdSerial.update();
+		ccdParallel.update(&threadPool, 4);
+
+		// The pairs must be the same and in the same order
+		const auto& serialPairs = ccdSerial.getPairs();
+		const auto& parallelPairs = ccdParallel.getPairs();
+		ASSERT_EQ(serialPairs.size(), parallelPairs.size());
+		std::size_t numPairs = 0;
+		for (std::size_t i = 0; i < serialPairs.size(); ++i) {
+			EXPECT_EQ(serialPairs[i].colliderIndices[0], parallelPairs[i].colliderIndices[0]);
+			EXPECT_EQ(serialPairs[i].colliderIndices[1], parallelPairs[i].colliderIndices[1]);
+			EXPECT_EQ(serialPairs[i].colliders[0], parallelPairs[i].colliders[0]);
+			EXPECT_EQ(serialPairs[i].colliders[1], parallelPairs[i].colliders[1]);
+			EXPECT_EQ(serialPairs[i].state, parallelPairs[i].state);
+			if (serialPairs[i].state != PairState::End) {
+				++numPairs;
+			}
+		}
+		EXPECT_GT(numPairs, 0u);
+
+		// Only half of the spheres move in each step
+		for (auto& sphere : spheres) {
+			sphere->resetUpdatedState();
+		}
+		for (std::size_t i = step % 2; i < spheres.size(); i += 2) {
+			positions[i] += velocities[i];
+			spheres[i]->setTransforms(glm::translate(glm::mat4(1.0f), positions[i]));
+		}
+	}
+}
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <gtest/gtest.h>
 #include <se/physics/RigidBodyWorld.h>
 #include <se/physics/constraints/DistanceConstraint.h>
@@ -117,3 +118,96 @@ TEST(Constraint, frictionConstraint)
 		EXPECT_NEAR(rb2.getState().orientation[i], expectedOrientation2[i], kTolerance);
 	}
 }
+
+
+TEST(Constraint, constraintManagerIslands)
+{
+	RigidBodyWorld rigidBodyWorld;
+	ConstraintManager& constraintManager = rigidBodyWorld.getConstraintManager();
+
+	// A chain of RigidBodies attached to a static one and a pair of
+	// RigidBodies also attached to it. The static RigidBody doesn't join the
+	// islands
+	RigidBody staticRB;
+	std::vector<RigidBody> chain(6, RigidBody(RigidBodyProperties(1.0f, glm::mat3(1.0f))));
+	std::vector<RigidBody> pair(2, RigidBody(RigidBodyProperties(1.0f, glm::mat3(1.0f))));
+
+	std::vector<DistanceConstraint> constraints;
+	constraints.reserve(8);
+	constraints.emplace_back(std::array<RigidBody*, 2>{ &staticRB, &chain[0] });
+	for (std::size_t i = 0; i + 1 < chain.size(); ++i) {
+		constraints.emplace_back(std::array<RigidBody*, 2>{ &chain[i], &chain[i + 1] });
+	}
+	constraints.emplace_back(std::array<RigidBody*, 2>{ &pair[0], &pair[1] });
+	constraints.emplace_back(std::array<RigidBody*, 2>{ &pair[1], &staticRB });
+	for (DistanceConstraint& constraint : constraints) {
+		constraintManager.addConstraint(&constraint);
+	}
+
+	constraintManager.update(0.016f);
+	IslandStats stats = constraintManager.getIslandStats();
+	EXPECT_EQ(stats.numIslands, 2u);
+	EXPECT_EQ(stats.numConstraints, 8u);
+	EXPECT_EQ(stats.maxIslandConstraints, 6u);
+	EXPECT_EQ(stats.sizeHistogram[1], 1u);
+	EXPECT_EQ(stats.sizeHistogram[2], 1u);
+
+	// Removing a Constraint from the middle of the chain splits its island
+	constraintManager.removeConstraint(&constraints[3]);
+	constraintManager.update(0.016f);
+	stats = constraintManager.getIslandStats();
+	EXPECT_EQ(stats.numIslands, 3u);
+	EXPECT_EQ(stats.numConstraints, 7u);
+	EXPECT_EQ(stats.maxIslandConstraints, 3u);
+	EXPECT_EQ(stats.sizeHistogram[1], 3u);
+	EXPECT_EQ(stats.sizeHistogram[2], 0u);
+
+	std::size_t numConstraints = 0;
+	constraintManager.processConstraints([&](Constraint*) { ++numConstraints; });
+	EXPECT_EQ(numConstraints, 7u);
+}
+
+
+TEST(Constraint, constraintManagerBulkChanges)
+{
+	RigidBodyWorld rigidBodyWorld;
+	ConstraintManager& constraintManager = rigidBodyWorld.getConstraintManager();
+
+	std::vector<RigidBody> rigidBodies(6, RigidBody(RigidBodyProperties(1.0f, glm::mat3(1.0f))));
+	std::vector<DistanceConstraint> constraints;
+	constraints.reserve(5);
+	for (std::size_t i = 0; i + 1 < rigidBodies.size(); ++i) {
+		constraints.emplace_back(std::array<RigidBody*, 2>{ &rigidBodies[i], &rigidBodies[i + 1] });
+	}
+
+	// The Constraints already added are ignored
+	std::vector<Constraint*> constraintPtrs = { &constraints[4], &constraints[0], &constraints[2], &constraints[1], &constraints[3] };
+	constraintManager.addConstraint(&constraints[2]);
+	constraintManager.addConstraints(constraintPtrs.data(), constraintPtrs.size());
+	constraintManager.addConstraints(constraintPtrs.data(), 2);
+	constraintManager.update(0.016f);
+
+	IslandStats stats = constraintManager.getIslandStats();
+	EXPECT_EQ(stats.numIslands, 1u);
+	EXPECT_EQ(stats.numConstraints, 5u);
+
+	// Removing the second and fourth Constraints splits the chain in three
+	// islands. The Constraints that aren't in the ConstraintManager are
+	// ignored
+	constraintManager.removeConstraint(&constraints[1]);
+	std::vector<Constraint*> removedPtrs = { &constraints[3], &constraints[1] };
+	constraintManager.removeConstraints(removedPtrs.data(), removedPtrs.size());
+	constraintManager.update(0.016f);
+
+	stats = constraintManager.getIslandStats();
+	EXPECT_EQ(stats.numIslands, 3u);
+	EXPECT_EQ(stats.numConstraints, 3u);
+	EXPECT_EQ(stats.maxIslandConstraints, 1u);
+
+	std::vector<Constraint*> remaining;
+	constraintManager.processConstraints([&](Constraint* constraint) { remaining.push_back(constraint); });
+	std::sort(remaining.begin(), remaining.end());
+	std::vector<Constraint*> expected = { &constraints[0], &constraints[2], &constraints[4] };
+	std::sort(expected.begin(), expected.end());
+	EXPECT_EQ(remaining, expected);
+}
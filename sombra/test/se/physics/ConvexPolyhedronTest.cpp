@@ -1,6 +1,11 @@
+#include <limits>
+#include <random>
+#include <algorithm>
 #include <gtest/gtest.h>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <se/physics/collision/QuickHull.h>
+#include <se/physics/collision/HalfEdgeMeshExt.h>
 #include <se/physics/collision/ConvexPolyhedron.h>
 #include "TestMeshes.h"
 
@@ -79,3 +84,76 @@ TEST(ConvexPolyhedron, getFurthestPointInDirection)
 		EXPECT_NEAR(pointLocal[i], expectedPLocal[i], kTolerance);
 	}
 }
+
+
+TEST(ConvexPolyhedron, getFurthestPointInDirectionEmpty)
+{
+	const glm::vec3 translation(5.0f, -1.0f, -10.0f);
+	const glm::vec3 directions[2] = { glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(-0.6f, 0.0f, 0.8f) };
+
+	ConvexPolyhedron cp1(HalfEdgeMesh{});
+	cp1.setTransforms(glm::translate(glm::mat4(1.0f), translation));
+
+	glm::vec3 pointWorld, pointLocal;
+	cp1.getFurthestPointInDirection(directions[0], pointWorld, pointLocal);
+	EXPECT_EQ(pointWorld, translation);
+	EXPECT_EQ(pointLocal, glm::vec3(0.0f));
+
+	glm::vec3 pointsWorld[2], pointsLocal[2];
+	cp1.getFurthestPointsInDirections(directions, 2, pointsWorld, pointsLocal);
+	for (int i = 0; i < 2; ++i) {
+		EXPECT_EQ(pointsWorld[i], translation);
+		EXPECT_EQ(pointsLocal[i], glm::vec3(0.0f));
+	}
+}
+
+
+TEST(ConvexPolyhedron, getFurthestPointsInDirections)
+{
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+	auto randomDirection = [&]() {
+		return glm::normalize(glm::vec3(distribution(generator), distribution(generator), distribution(generator)));
+	};
+
+	// A hull with more vertices than the SIMD width and not multiple of it
+	HalfEdgeMesh points;
+	for (int i = 0; i < 203; ++i) {
+		addVertex(points, glm::vec3(2.0f, 1.0f, 0.5f) * randomDirection());
+	}
+	QuickHull qh(0.0001f);
+	qh.calculate(points);
+
+	ConvexPolyhedron cp1(qh.getMesh());
+	cp1.setTransforms(
+		glm::translate(glm::mat4(1.0f), glm::vec3(5.0f, -1.0f, -10.0f))
+		* glm::mat4_cast(glm::angleAxis(glm::pi<float>() / 3.0f, glm::vec3(2/3.0f, -2/3.0f, 1/3.0f)))
+	);
+
+	constexpr std::size_t kNumDirections = 11;
+	glm::vec3 directions[kNumDirections], pointsWorld[kNumDirections], pointsLocal[kNumDirections];
+	for (glm::vec3& direction : directions) {
+		direction = randomDirection();
+	}
+	cp1.getFurthestPointsInDirections(directions, kNumDirections, pointsWorld, pointsLocal);
+
+	HalfEdgeMesh localMesh = cp1.getLocalMesh();
+	for (std::size_t i = 0; i < kNumDirections; ++i) {
+		float expectedDistance = -std::numeric_limits<float>::max();
+		for (const HEVertex& vertex : localMesh.vertices) {
+			glm::vec3 location = cp1.getTransforms() * glm::vec4(vertex.location, 1.0f);
+			expectedDistance = std::max(expectedDistance, glm::dot(location, directions[i]));
+		}
+
+		glm::vec3 pointWorld, pointLocal;
+		cp1.getFurthestPointInDirection(directions[i], pointWorld, pointLocal);
+		EXPECT_NEAR(glm::dot(pointWorld, directions[i]), expectedDistance, kTolerance);
+
+		glm::vec3 transformedPointLocal = cp1.getTransforms() * glm::vec4(pointsLocal[i], 1.0f);
+		for (int j = 0; j < 3; ++j) {
+			EXPECT_EQ(pointsWorld[i][j], pointWorld[j]);
+			EXPECT_EQ(pointsLocal[i][j], pointLocal[j]);
+			EXPECT_NEAR(transformedPointLocal[j], pointWorld[j], 0.00001f);
+		}
+	}
+}
@@ -1,8 +1,12 @@
+#include <cmath>
+#include <random>
 #include <gtest/gtest.h>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <se/physics/collision/Manifold.h>
 #include <se/physics/collision/BoundingBox.h>
+#include <se/physics/collision/Capsule.h>
+#include <se/physics/collision/ConvexPolyhedron.h>
 #include <se/physics/collision/BoundingSphere.h>
 #include <se/physics/collision/TriangleCollider.h>
 #include <se/physics/collision/FineCollisionDetector.h>
@@ -46,15 +50,15 @@ TEST(FineCollisionDetector, SphereSphere1)
 TEST(FineCollisionDetector, SphereSphere2)
 {
 	const glm::vec3 expectedWorldPos[] = {
-		{ 12.345151365f, -4.478355257f, 5.021325737f },
-		{ 12.345151438f, -4.478355306f, 5.021325869f }
+		{ 12.345150929f, -4.478355157f, 5.021325456f },
+		{ 12.345151711f, -4.478355680f, 5.021326863f }
 	};
 	const glm::vec3 expectedLocalPos[] = {
-		{ -1.154848634f, 0.771644742f, -2.078674167f },
-		{ 4.095410456f, -3.183182967f, -0.384987776f }
+		{ -1.154849071f, 0.771644843f, -2.078674544f },
+		{ 4.095411762f, -3.183184322f, -0.384987689f }
 	};
-	const glm::vec3 expectedNormal(-0.459900856f, 0.313255608f, -0.830880344f);
-	const float expectedPenetration = 0.000000159f;
+	const glm::vec3 expectedNormal(-0.461939628f, 0.308657937f, -0.831469818f);
+	const float expectedPenetration = 0.000001692f;
 	const glm::vec3 v1(13.5f, -5.25f, 7.1f), v2(9.943065643f, -2.873334407f, 0.697683811f);
 	const glm::quat o1(1.0f, glm::vec3(0.0f)), o2(0.795f, -0.002f, -0.575f, 0.192f);
 
@@ -94,17 +98,17 @@ TEST(FineCollisionDetector, CPolyCPolyNonColliding)
 {
 	const glm::vec3 v1(-5.65946f, -2.8255f, -1.52118f), v2(-4.58841f, -2.39753f, -0.164247f);
 	const glm::quat o1(0.890843f, 0.349613f, 0.061734f, 0.283475f), o2(0.962876f, -0.158823f, 0.216784f, -0.025477f);
-	BoundingBox bb1({ 2.0f, 1.0f, 2.0f }), bb2({ 1.0f, 1.0f, 0.5f });
+	ConvexPolyhedron cp1(BoundingBox({ 2.0f, 1.0f, 2.0f }).getLocalMesh()), cp2(BoundingBox({ 1.0f, 1.0f, 0.5f }).getLocalMesh());
 
 	glm::mat4 r1 = glm::mat4_cast(o1);
 	glm::mat4 t1 = glm::translate(glm::mat4(1.0f), v1);
-	bb1.setTransforms(t1 * r1);
+	cp1.setTransforms(t1 * r1);
 
 	glm::mat4 r2 = glm::mat4_cast(o2);
 	glm::mat4 t2 = glm::translate(glm::mat4(1.0f), v2);
-	bb2.setTransforms(t2 * r2);
+	cp2.setTransforms(t2 * r2);
 
-	Manifold manifold(&bb1, &bb2);
+	Manifold manifold(&cp1, &cp2);
 	FineCollisionDetector fineCollisionDetector(
 		kCoarseEpsilon,
 		kMinFDifference, kMaxIterations,
@@ -129,17 +133,17 @@ TEST(FineCollisionDetector, CPolyCPolyVertexFace)
 	const float expectedPenetration = 0.000005355f;
 	const glm::vec3 v1(-2.787537574f, 5.180943965f, -3.084435224f), v2(-3.950720071f, 4.450982570f, -1.945194125f);
 	const glm::quat o1(0.770950198f, 0.507247209f, -0.107715316f, 0.369774848f), o2(0.550417125f, -0.692481637f, -0.259043514f, 0.387822926f);
-	BoundingBox bb1({ 1.0f, 2.0f, 2.0f }), bb2({ 1.0f, 0.25f, 0.5f });
+	ConvexPolyhedron cp1(BoundingBox({ 1.0f, 2.0f, 2.0f }).getLocalMesh()), cp2(BoundingBox({ 1.0f, 0.25f, 0.5f }).getLocalMesh());
 
 	glm::mat4 r1 = glm::mat4_cast(o1);
 	glm::mat4 t1 = glm::translate(glm::mat4(1.0f), v1);
-	bb1.setTransforms(t1 * r1);
+	cp1.setTransforms(t1 * r1);
 
 	glm::mat4 r2 = glm::mat4_cast(o2);
 	glm::mat4 t2 = glm::translate(glm::mat4(1.0f), v2);
-	bb2.setTransforms(t2 * r2);
+	cp2.setTransforms(t2 * r2);
 
-	Manifold manifold(&bb1, &bb2);
+	Manifold manifold(&cp1, &cp2);
 	FineCollisionDetector fineCollisionDetector(
 		kCoarseEpsilon,
 		kMinFDifference, kMaxIterations,
@@ -176,17 +180,17 @@ TEST(FineCollisionDetector, CPolyCPolyVertexVertex)
 	const float expectedPenetration = 0.0f;
 	const glm::vec3 v1(2.764820814f, 2.738384008f, 0.0f), v2(3.065070390f, 0.126421570f, 0.363925665f);
 	const glm::quat o1(0.900554239f, -0.349306106f, -0.093596287f, -0.241302788f), o2(0.637856543f, -0.079467326f, -0.094705462f, -0.760167777f);
-	BoundingBox bb1({ 1.0f, 2.2f, 2.0f }), bb2({ 2.0f, 1.2f, 0.05f });
+	ConvexPolyhedron cp1(BoundingBox({ 1.0f, 2.2f, 2.0f }).getLocalMesh()), cp2(BoundingBox({ 2.0f, 1.2f, 0.05f }).getLocalMesh());
 
 	glm::mat4 r1 = glm::mat4_cast(o1);
 	glm::mat4 t1 = glm::translate(glm::mat4(1.0f), v1);
-	bb1.setTransforms(t1 * r1);
+	cp1.setTransforms(t1 * r1);
 
 	glm::mat4 r2 = glm::mat4_cast(o2);
 	glm::mat4 t2 = glm::translate(glm::mat4(1.0f), v2);
-	bb2.setTransforms(t2 * r2);
+	cp2.setTransforms(t2 * r2);
 
-	Manifold manifold(&bb1, &bb2);
+	Manifold manifold(&cp1, &cp2);
 	FineCollisionDetector fineCollisionDetector(
 		kCoarseEpsilon,
 		kMinFDifference, kMaxIterations,
@@ -209,6 +213,32 @@ TEST(FineCollisionDetector, CPolyCPolyVertexVertex)
 }
 
 
+TEST(FineCollisionDetector, CPolyCPolyTriangleSimplex)
+{
+	// A box resting on other box, GJK ends with a triangle simplex, so EPA
+	// must build its initial tetrahedron from it
+	const float expectedPenetration = 0.01f;
+	ConvexPolyhedron cp1(BoundingBox(glm::vec3(1.0f)).getLocalMesh()), cp2(BoundingBox(glm::vec3(1.0f)).getLocalMesh());
+	cp1.setTransforms(glm::mat4(1.0f));
+	cp2.setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(-0.3f, 0.99f, -0.3f)));
+
+	Manifold manifold(&cp1, &cp2);
+	FineCollisionDetector fineCollisionDetector(
+		kCoarseEpsilon,
+		kMinFDifference, kMaxIterations,
+		kContactPrecision, kContactSeparation,
+		kRaycastPrecision
+	);
+
+	ASSERT_TRUE(fineCollisionDetector.collide(manifold));
+	ASSERT_FALSE(manifold.contacts.empty());
+
+	const Contact& res = manifold.contacts.front();
+	EXPECT_NEAR(res.penetration, expectedPenetration, kTolerance);
+	EXPECT_NEAR(std::abs(res.normal.y), 1.0f, kTolerance);
+}
+
+
 TEST(FineCollisionDetector, SphereCPoly1)
 {
 	const glm::vec3 expectedWorldPos[] = {
@@ -329,6 +359,332 @@ TEST(FineCollisionDetector, TriangleTriangle1)
 }
 
 
+TEST(FineCollisionDetector, SphereCapsule)
+{
+	BoundingSphere bs1(1.0f);
+	bs1.setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(1.2f, 0.5f, 0.0f)));
+	Capsule c1(0.5f, 2.0f);
+
+	FineCollisionDetector fineCollisionDetector(
+		kCoarseEpsilon,
+		kMinFDifference, kMaxIterations,
+		kContactPrecision, kContactSeparation,
+		kRaycastPrecision
+	);
+
+	Manifold manifold1(&bs1, &c1);
+	ASSERT_TRUE(fineCollisionDetector.collide(manifold1));
+	ASSERT_EQ(static_cast<int>(manifold1.contacts.size()), 1);
+	EXPECT_NEAR(manifold1.contacts[0].penetration, 0.3f, kTolerance);
+	for (int i = 0; i < 3; ++i) {
+		EXPECT_NEAR(manifold1.contacts[0].normal[i], glm::vec3(-1.0f, 0.0f, 0.0f)[i], kTolerance);
+		EXPECT_NEAR(manifold1.contacts[0].worldPosition[0][i], glm::vec3(0.2f, 0.5f, 0.0f)[i], kTolerance);
+		EXPECT_NEAR(manifold1.contacts[0].worldPosition[1][i], glm::vec3(0.5f, 0.5f, 0.0f)[i], kTolerance);
+		EXPECT_NEAR(manifold1.contacts[0].localPosition[0][i], glm::vec3(-1.0f, 0.0f, 0.0f)[i], kTolerance);
+		EXPECT_NEAR(manifold1.contacts[0].localPosition[1][i], glm::vec3(0.5f, 0.5f, 0.0f)[i], kTolerance);
+	}
+
+	// The Contacts must follow the order of the Manifold Colliders
+	Manifold manifold2(&c1, &bs1);
+	ASSERT_TRUE(fineCollisionDetector.collide(manifold2));
+	ASSERT_EQ(static_cast<int>(manifold2.contacts.size()), 1);
+	EXPECT_NEAR(manifold2.contacts[0].penetration, 0.3f, kTolerance);
+	for (int i = 0; i < 3; ++i) {
+		EXPECT_NEAR(manifold2.contacts[0].normal[i], glm::vec3(1.0f, 0.0f, 0.0f)[i], kTolerance);
+		EXPECT_NEAR(manifold2.contacts[0].worldPosition[0][i], glm::vec3(0.5f, 0.5f, 0.0f)[i], kTolerance);
+		EXPECT_NEAR(manifold2.contacts[0].worldPosition[1][i], glm::vec3(0.2f, 0.5f, 0.0f)[i], kTolerance);
+	}
+
+	bs1.setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(1.6f, 0.5f, 0.0f)));
+	EXPECT_FALSE(fineCollisionDetector.collide(manifold1));
+	EXPECT_TRUE(manifold1.contacts.empty());
+}
+
+
+TEST(FineCollisionDetector, CapsuleCapsuleParallel)
+{
+	const glm::mat4 r1 = glm::rotate(glm::mat4(1.0f), glm::pi<float>() / 2.0f, glm::vec3(0.0f, 0.0f, 1.0f));
+	Capsule c1(0.5f, 2.0f), c2(0.5f, 2.0f);
+	c1.setTransforms(r1);
+	c2.setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(0.5f, 0.9f, 0.0f)) * r1);
+
+	Manifold manifold(&c1, &c2);
+	FineCollisionDetector fineCollisionDetector(
+		kCoarseEpsilon,
+		kMinFDifference, kMaxIterations,
+		kContactPrecision, kContactSeparation,
+		kRaycastPrecision
+	);
+
+	// A Contact at each end of the overlapping part of the capsules
+	ASSERT_TRUE(fineCollisionDetector.collide(manifold));
+	ASSERT_EQ(static_cast<int>(manifold.contacts.size()), 2);
+	float minX = std::min(manifold.contacts[0].worldPosition[0].x, manifold.contacts[1].worldPosition[0].x);
+	float maxX = std::max(manifold.contacts[0].worldPosition[0].x, manifold.contacts[1].worldPosition[0].x);
+	EXPECT_NEAR(minX, -0.5f, kTolerance);
+	EXPECT_NEAR(maxX, 1.0f, kTolerance);
+	for (const Contact& contact : manifold.contacts) {
+		EXPECT_NEAR(contact.penetration, 0.1f, kTolerance);
+		EXPECT_NEAR(contact.worldPosition[0].y, 0.5f, kTolerance);
+		EXPECT_NEAR(contact.worldPosition[1].y, 0.4f, kTolerance);
+		for (int i = 0; i < 3; ++i) {
+			EXPECT_NEAR(contact.normal[i], glm::vec3(0.0f, 1.0f, 0.0f)[i], kTolerance);
+		}
+	}
+}
+
+
+TEST(FineCollisionDetector, SphereBox)
+{
+	BoundingSphere bs1(0.5f);
+	BoundingBox bb1({ 2.0f, 2.0f, 2.0f });
+
+	Manifold manifold(&bs1, &bb1);
+	FineCollisionDetector fineCollisionDetector(
+		kCoarseEpsilon,
+		kMinFDifference, kMaxIterations,
+		kContactPrecision, kContactSeparation,
+		kRaycastPrecision
+	);
+
+	// Center outside the box
+	bs1.setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(0.2f, 1.3f, -0.1f)));
+	ASSERT_TRUE(fineCollisionDetector.collide(manifold));
+	ASSERT_EQ(static_cast<int>(manifold.contacts.size()), 1);
+	EXPECT_NEAR(manifold.contacts[0].penetration, 0.2f, kTolerance);
+	for (int i = 0; i < 3; ++i) {
+		EXPECT_NEAR(manifold.contacts[0].normal[i], glm::vec3(0.0f, -1.0f, 0.0f)[i], kTolerance);
+		EXPECT_NEAR(manifold.contacts[0].worldPosition[0][i], glm::vec3(0.2f, 0.8f, -0.1f)[i], kTolerance);
+		EXPECT_NEAR(manifold.contacts[0].worldPosition[1][i], glm::vec3(0.2f, 1.0f, -0.1f)[i], kTolerance);
+	}
+
+	// Center inside the box
+	bs1.setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(0.2f, 0.8f, -0.1f)));
+	ASSERT_TRUE(fineCollisionDetector.collide(manifold));
+	ASSERT_EQ(static_cast<int>(manifold.contacts.size()), 1);
+	EXPECT_NEAR(manifold.contacts[0].penetration, 0.7f, kTolerance);
+	for (int i = 0; i < 3; ++i) {
+		EXPECT_NEAR(manifold.contacts[0].normal[i], glm::vec3(0.0f, -1.0f, 0.0f)[i], kTolerance);
+		EXPECT_NEAR(manifold.contacts[0].worldPosition[0][i], glm::vec3(0.2f, 0.3f, -0.1f)[i], kTolerance);
+		EXPECT_NEAR(manifold.contacts[0].worldPosition[1][i], glm::vec3(0.2f, 1.0f, -0.1f)[i], kTolerance);
+	}
+
+	bs1.setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(1.4f, 1.4f, 0.0f)));
+	EXPECT_FALSE(fineCollisionDetector.collide(manifold));
+}
+
+
+TEST(FineCollisionDetector, CapsuleBoxLying)
+{
+	const glm::mat4 r1 = glm::rotate(glm::mat4(1.0f), glm::pi<float>() / 2.0f, glm::vec3(0.0f, 0.0f, 1.0f));
+	Capsule c1(0.5f, 2.0f);
+	c1.setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.9f, 0.0f)) * r1);
+	BoundingBox bb1({ 4.0f, 1.0f, 4.0f });
+
+	Manifold manifold(&bb1, &c1);
+	FineCollisionDetector fineCollisionDetector(
+		kCoarseEpsilon,
+		kMinFDifference, kMaxIterations,
+		kContactPrecision, kContactSeparation,
+		kRaycastPrecision
+	);
+
+	// A Contact at each end of the capsule
+	ASSERT_TRUE(fineCollisionDetector.collide(manifold));
+	ASSERT_EQ(static_cast<int>(manifold.contacts.size()), 2);
+	EXPECT_NEAR(std::abs(manifold.contacts[0].worldPosition[1].x), 1.0f, kTolerance);
+	EXPECT_NEAR(manifold.contacts[0].worldPosition[1].x, -manifold.contacts[1].worldPosition[1].x, kTolerance);
+	for (const Contact& contact : manifold.contacts) {
+		EXPECT_NEAR(contact.penetration, 0.1f, kTolerance);
+		EXPECT_NEAR(contact.worldPosition[0].y, 0.5f, kTolerance);
+		EXPECT_NEAR(contact.worldPosition[1].y, 0.4f, kTolerance);
+		for (int i = 0; i < 3; ++i) {
+			EXPECT_NEAR(contact.normal[i], glm::vec3(0.0f, 1.0f, 0.0f)[i], kTolerance);
+		}
+	}
+}
+
+
+TEST(FineCollisionDetector, BoxBoxFace)
+{
+	BoundingBox bb1({ 1.0f, 1.0f, 1.0f }), bb2({ 1.0f, 1.0f, 1.0f });
+
+	Manifold manifold(&bb1, &bb2);
+	FineCollisionDetector fineCollisionDetector(
+		kCoarseEpsilon,
+		kMinFDifference, kMaxIterations,
+		kContactPrecision, kContactSeparation,
+		kRaycastPrecision
+	);
+
+	// The second box rests on top of the first one, so the four corners of
+	// the overlapping square are the Contacts
+	bb2.setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(0.2f, 0.95f, 0.1f)));
+	ASSERT_TRUE(fineCollisionDetector.collide(manifold));
+	ASSERT_EQ(static_cast<int>(manifold.contacts.size()), 4);
+	for (const Contact& contact : manifold.contacts) {
+		EXPECT_NEAR(contact.penetration, 0.05f, kTolerance);
+		EXPECT_NEAR(contact.worldPosition[0].y, 0.5f, kTolerance);
+		EXPECT_NEAR(contact.worldPosition[1].y, 0.45f, kTolerance);
+		EXPECT_GE(contact.worldPosition[0].x, -0.3f - kTolerance);
+		EXPECT_LE(contact.worldPosition[0].x, 0.5f + kTolerance);
+		EXPECT_GE(contact.worldPosition[0].z, -0.4f - kTolerance);
+		EXPECT_LE(contact.worldPosition[0].z, 0.5f + kTolerance);
+		for (int i = 0; i < 3; ++i) {
+			EXPECT_NEAR(contact.normal[i], glm::vec3(0.0f, 1.0f, 0.0f)[i], kTolerance);
+		}
+	}
+
+	// Rotated, the clipped face has eight points that are reduced to four
+	bb2.setTransforms(
+		glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.95f, 0.0f))
+		* glm::rotate(glm::mat4(1.0f), glm::pi<float>() / 4.0f, glm::vec3(0.0f, 1.0f, 0.0f))
+	);
+	ASSERT_TRUE(fineCollisionDetector.collide(manifold));
+	ASSERT_EQ(static_cast<int>(manifold.contacts.size()), 4);
+	for (const Contact& contact : manifold.contacts) {
+		EXPECT_NEAR(contact.penetration, 0.05f, kTolerance);
+		EXPECT_NEAR(contact.worldPosition[0].y, 0.5f, kTolerance);
+	}
+
+	bb2.setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(0.2f, 1.05f, 0.1f)));
+	EXPECT_FALSE(fineCollisionDetector.collide(manifold));
+	EXPECT_TRUE(manifold.contacts.empty());
+}
+
+
+TEST(FineCollisionDetector, AnalyticEPAComparison)
+{
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> positionDist(-0.6f, 0.6f);
+	std::uniform_real_distribution<float> angleDist(-glm::pi<float>(), glm::pi<float>());
+	auto randomTransforms = [&]() {
+		glm::vec3 position(positionDist(generator), positionDist(generator), positionDist(generator));
+		glm::vec3 axis = glm::normalize(glm::vec3(positionDist(generator), positionDist(generator), positionDist(generator)));
+		return glm::translate(glm::mat4(1.0f), position) * glm::rotate(glm::mat4(1.0f), angleDist(generator), axis);
+	};
+
+	FineCollisionDetector fineCollisionDetector(
+		kCoarseEpsilon,
+		kMinFDifference, kMaxIterations,
+		kContactPrecision, kContactSeparation,
+		kRaycastPrecision
+	);
+
+	// The deepest analytic Contact must be close to the EPA one, and moving
+	// the second box along its normal must separate the boxes
+	BoundingBox bb1({ 1.0f, 0.5f, 0.8f }), bb2({ 0.6f, 1.0f, 0.4f });
+	ConvexPolyhedron cp1(bb1.getLocalMesh()), cp2(bb2.getLocalMesh());
+	for (int i = 0; i < 32; ++i) {
+		glm::mat4 transforms1 = randomTransforms(), transforms2 = randomTransforms();
+		bb1.setTransforms(transforms1);
+		bb2.setTransforms(transforms2);
+		cp1.setTransforms(transforms1);
+		cp2.setTransforms(transforms2);
+
+		Manifold manifold1(&bb1, &bb2), manifold2(&cp1, &cp2);
+		bool collides1 = fineCollisionDetector.collide(manifold1);
+		bool collides2 = fineCollisionDetector.collide(manifold2);
+		ASSERT_EQ(collides1, collides2);
+		if (collides1) {
+			const Contact& contact1 = *std::max_element(
+				manifold1.contacts.begin(), manifold1.contacts.end(),
+				[](const Contact& c1, const Contact& c2) { return c1.penetration < c2.penetration; }
+			);
+			const Contact& contact2 = manifold2.contacts[0];
+			EXPECT_GE(contact1.penetration, contact2.penetration - 0.001f);
+			EXPECT_LE(contact1.penetration, contact2.penetration / 0.95f + 0.001f);
+
+			glm::vec3 separation = (contact1.penetration + 0.001f) * contact1.normal;
+			cp2.setTransforms(glm::translate(glm::mat4(1.0f), separation) * transforms2);
+			Manifold manifold3(&cp1, &cp2);
+			EXPECT_FALSE(fineCollisionDetector.collide(manifold3));
+		}
+	}
+}
+
+
+TEST(FineCollisionDetector, WarmStartedGJK)
+{
+	FineCollisionDetector fineCollisionDetector(
+		kCoarseEpsilon,
+		kMinFDifference, kMaxIterations,
+		kContactPrecision, kContactSeparation,
+		kRaycastPrecision
+	);
+
+	// Move the second box through the first one, the persistent Manifold must
+	// give the same results than a new one in every step
+	ConvexPolyhedron cp1(BoundingBox({ 1.0f, 0.5f, 0.8f }).getLocalMesh()), cp2(BoundingBox({ 0.6f, 1.0f, 0.4f }).getLocalMesh());
+	cp1.setTransforms(glm::rotate(glm::mat4(1.0f), 0.3f, glm::normalize(glm::vec3(1.0f, 2.0f, -0.5f))));
+
+	Manifold manifold1(&cp1, &cp2);
+	for (int i = 0; i < 64; ++i) {
+		glm::vec3 position = glm::vec3(-2.0f, 0.3f, 0.1f) + static_cast<float>(i) * glm::vec3(0.0625f, 0.0f, 0.0f);
+		glm::mat4 rotation = glm::rotate(glm::mat4(1.0f), 0.05f * static_cast<float>(i), glm::vec3(0.0f, 1.0f, 0.0f));
+		cp2.setTransforms(glm::translate(glm::mat4(1.0f), position) * rotation);
+
+		Manifold manifold2(&cp1, &cp2);
+		bool collides1 = fineCollisionDetector.collide(manifold1);
+		bool collides2 = fineCollisionDetector.collide(manifold2);
+		ASSERT_EQ(collides1, collides2);
+		if (collides1) {
+			EXPECT_EQ(manifold1.gjkCache.simplexPoints.size(), 4u);
+			for (int j = 0; j < 3; ++j) {
+				EXPECT_NEAR(manifold1.gjkCache.direction[j], manifold2.contacts[0].normal[j], kTolerance);
+			}
+		}
+		else {
+			EXPECT_TRUE(manifold1.gjkCache.simplexPoints.empty());
+			EXPECT_TRUE(manifold1.contacts.empty());
+		}
+	}
+}
+
+
+TEST(FineCollisionDetector, EPAIterationBudget)
+{
+	const glm::vec3 expectedNormal = glm::normalize(glm::vec3(1.0f));
+	const float expectedPenetration = 1.0f - glm::length(glm::vec3(0.5f));
+
+	// The closest feature of the CSO to the origin is the rounded corner of
+	// the box, so the EPA needs many iterations to converge
+	BoundingSphere bs1(1.0f);
+	ConvexPolyhedron cp1(BoundingBox({ 2.0f, 2.0f, 2.0f }).getLocalMesh());
+	cp1.setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(1.5f)));
+
+	FineCollisionDetector fineCollisionDetector1(
+		kCoarseEpsilon,
+		kMinFDifference, kMaxIterations,
+		kContactPrecision, kContactSeparation,
+		kRaycastPrecision
+	);
+	Manifold manifold1(&bs1, &cp1);
+	ASSERT_TRUE(fineCollisionDetector1.collide(manifold1));
+	ASSERT_EQ(static_cast<int>(manifold1.contacts.size()), 1);
+	EXPECT_NEAR(manifold1.contacts[0].penetration, expectedPenetration, 0.001f);
+	for (int i = 0; i < 3; ++i) {
+		EXPECT_NEAR(manifold1.contacts[0].normal[i], expectedNormal[i], 0.02f);
+	}
+
+	// If the iterations are exhausted the closest face found until then is
+	// used
+	FineCollisionDetector fineCollisionDetector2(
+		kCoarseEpsilon,
+		kMinFDifference, 8,
+		kContactPrecision, kContactSeparation,
+		kRaycastPrecision
+	);
+	Manifold manifold2(&bs1, &cp1);
+	ASSERT_TRUE(fineCollisionDetector2.collide(manifold2));
+	ASSERT_EQ(static_cast<int>(manifold2.contacts.size()), 1);
+	EXPECT_GT(manifold2.contacts[0].penetration, 0.0f);
+	EXPECT_LE(manifold2.contacts[0].penetration, expectedPenetration + kTolerance);
+	EXPECT_NEAR(glm::length(manifold2.contacts[0].normal), 1.0f, kTolerance);
+	EXPECT_GT(glm::dot(manifold2.contacts[0].normal, expectedNormal), 0.0f);
+}
+
+
 // TODO: concave
 
 
@@ -357,4 +713,122 @@ TEST(Raycast, Cube1)
 	ASSERT_TRUE(res);
 }
 
+
+TEST(Raycast, CubeEdge)
+{
+	const Ray ray1(glm::vec3(3.0f, 3.0f, 0.25f), glm::normalize(glm::vec3(-1.0f, -1.0f, 0.0f)));
+
+	BoundingBox bb1(glm::vec3(2.0f));
+	bb1.setTransforms(glm::mat4(1.0f));
+
+	FineCollisionDetector fineCollisionDetector(
+		kCoarseEpsilon,
+		kMinFDifference, kMaxIterations,
+		kContactPrecision, kContactSeparation,
+		kRaycastPrecision
+	);
+
+	auto [res, rayHit] = fineCollisionDetector.intersects(ray1, bb1);
+	ASSERT_TRUE(res);
+	EXPECT_NEAR(rayHit.distance, 2.0f * std::sqrt(2.0f), kTolerance);
+	for (int i = 0; i < 3; ++i) {
+		EXPECT_NEAR(rayHit.contactPointWorld[i], glm::vec3(1.0f, 1.0f, 0.25f)[i], kTolerance);
+	}
+}
+
+
+TEST(Raycast, CubeFace)
+{
+	const Ray ray1(glm::vec3(0.2f, 5.0f, -0.3f), glm::vec3(0.0f, -1.0f, 0.0f));
+
+	glm::vec3 p1(0.0f, 0.5f, 0.0f);
+	BoundingBox bb1(glm::vec3(2.0f));
+	bb1.setTransforms(glm::translate(glm::mat4(1.0f), p1));
+
+	FineCollisionDetector fineCollisionDetector(
+		kCoarseEpsilon,
+		kMinFDifference, kMaxIterations,
+		kContactPrecision, kContactSeparation,
+		kRaycastPrecision
+	);
+
+	auto [res, rayHit] = fineCollisionDetector.intersects(ray1, bb1);
+	ASSERT_TRUE(res);
+	EXPECT_NEAR(rayHit.distance, 3.5f, kTolerance);
+	for (int i = 0; i < 3; ++i) {
+		EXPECT_NEAR(rayHit.contactPointWorld[i], glm::vec3(0.2f, 1.5f, -0.3f)[i], kTolerance);
+		EXPECT_NEAR(rayHit.contactPointLocal[i], glm::vec3(0.2f, 1.0f, -0.3f)[i], kTolerance);
+		EXPECT_NEAR(rayHit.contactNormal[i], glm::vec3(0.0f, 1.0f, 0.0f)[i], kTolerance);
+	}
+}
+
+
+TEST(Raycast, CubeInside)
+{
+	// The origin of the ray is inside the cube, so the final simplex is a
+	// tetrahedron that contains it
+	const Ray ray1(glm::vec3(0.1f, 0.2f, -0.3f), glm::normalize(glm::vec3(1.0f, 2.0f, -0.5f)));
+
+	BoundingBox bb1(glm::vec3(2.0f));
+	bb1.setTransforms(glm::mat4(1.0f));
+
+	FineCollisionDetector fineCollisionDetector(
+		kCoarseEpsilon,
+		kMinFDifference, kMaxIterations,
+		kContactPrecision, kContactSeparation,
+		kRaycastPrecision
+	);
+
+	auto [res, rayHit] = fineCollisionDetector.intersects(ray1, bb1);
+	ASSERT_TRUE(res);
+	EXPECT_NEAR(rayHit.distance, 0.0f, kTolerance);
+	for (int i = 0; i < 3; ++i) {
+		EXPECT_NEAR(rayHit.contactPointWorld[i], ray1.origin[i], kTolerance);
+	}
+}
+
 // TODO: other colliders
+
+
+TEST(FineCollisionDetector, BoxBoxContactIds)
+{
+	BoundingBox bb1(glm::vec3(1.0f)), bb2(glm::vec3(10.0f, 1.0f, 10.0f));
+	bb1.setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.499f, 0.0f)));
+	bb2.setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -0.5f, 0.0f)));
+
+	Manifold manifold(&bb1, &bb2);
+	FineCollisionDetector fineCollisionDetector(
+		kCoarseEpsilon,
+		kMinFDifference, kMaxIterations,
+		kContactPrecision, kContactSeparation,
+		kRaycastPrecision
+	);
+
+	ASSERT_TRUE(fineCollisionDetector.collide(manifold));
+	ASSERT_EQ(static_cast<int>(manifold.contacts.size()), 4);
+
+	std::vector<std::uint32_t> ids;
+	for (const Contact& contact : manifold.contacts) {
+		EXPECT_TRUE(std::find(ids.begin(), ids.end(), contact.id) == ids.end());
+		ids.push_back(contact.id);
+	}
+
+	// The Contacts keep their ids if the Colliders move slightly
+	bb1.setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(0.001f, 0.498f, 0.0f)));
+	ASSERT_TRUE(fineCollisionDetector.collide(manifold));
+	ASSERT_EQ(static_cast<int>(manifold.contacts.size()), 4);
+	for (const Contact& contact : manifold.contacts) {
+		EXPECT_TRUE(std::find(ids.begin(), ids.end(), contact.id) != ids.end());
+	}
+
+	// Otherwise new ids are used
+	bb1.setTransforms(
+		glm::translate(glm::mat4(1.0f), glm::vec3(2.0f, 0.498f, 0.0f))
+		* glm::mat4_cast(glm::angleAxis(0.5f, glm::vec3(0.0f, 1.0f, 0.0f)))
+	);
+	ASSERT_TRUE(fineCollisionDetector.collide(manifold));
+	ASSERT_FALSE(manifold.contacts.empty());
+	for (const Contact& contact : manifold.contacts) {
+		EXPECT_TRUE(std::find(ids.begin(), ids.end(), contact.id) == ids.end());
+	}
+}
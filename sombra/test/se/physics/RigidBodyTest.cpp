@@ -0,0 +1,21 @@
+#include <gtest/gtest.h>
+#include <se/physics/RigidBody.h>
+#include <se/physics/collision/BoundingBox.h>
+
+using namespace se::physics;
+
+TEST(RigidBody, colliderParent)
+{
+	RigidBody rb1(RigidBodyProperties(), RigidBodyState(), std::make_unique<BoundingBox>(glm::vec3(1.0f)));
+	ASSERT_NE(rb1.getCollider(), nullptr);
+	EXPECT_EQ(rb1.getCollider()->getParent(), &rb1);
+
+	RigidBody rb2(rb1);
+	ASSERT_NE(rb2.getCollider(), nullptr);
+	EXPECT_EQ(rb2.getCollider()->getParent(), &rb2);
+	EXPECT_EQ(rb1.getCollider()->getParent(), &rb1);
+
+	RigidBody rb3(std::move(rb2));
+	ASSERT_NE(rb3.getCollider(), nullptr);
+	EXPECT_EQ(rb3.getCollider()->getParent(), &rb3);
+}
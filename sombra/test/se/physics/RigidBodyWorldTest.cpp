@@ -1,9 +1,16 @@
+#include <algorithm>
 #include <gtest/gtest.h>
 #include <se/physics/RigidBody.h>
 #include <se/physics/RigidBodyWorld.h>
 #include <se/physics/forces/PunctualForce.h>
 #include <se/physics/forces/DirectionalForce.h>
+#include <se/physics/forces/Gravity.h>
 #include <se/physics/constraints/DistanceConstraint.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <se/physics/collision/BoundingBox.h>
+#include <se/physics/collision/BoundingSphere.h>
+#include <se/physics/collision/Capsule.h>
+#include <se/physics/collision/TriangleMeshCollider.h>
 
 using namespace se::physics;
 static constexpr float kTolerance = 0.000001f;
@@ -209,7 +216,8 @@ TEST(RigidBodyWorld, rigidBodyStatus)
 
 	rbw.update(0.016f);
 
-	EXPECT_TRUE(rb1.getStatus(RigidBody::Status::Sleeping));
+	// rb1 is kept awake by rb2 through the DistanceConstraint
+	EXPECT_FALSE(rb1.getStatus(RigidBody::Status::Sleeping));
 	EXPECT_FALSE(rb1.getStatus(RigidBody::Status::StateChanged));
 	EXPECT_FALSE(rb2.getStatus(RigidBody::Status::Sleeping));
 	EXPECT_FALSE(rb2.getStatus(RigidBody::Status::StateChanged));
@@ -228,3 +236,724 @@ TEST(RigidBodyWorld, rigidBodyStatus)
 	EXPECT_TRUE(rb2.getStatus(RigidBody::Status::Sleeping));
 	EXPECT_FALSE(rb2.getStatus(RigidBody::Status::StateChanged));
 }
+
+
+TEST(RigidBodyWorld, rayCastBatch)
+{
+	const std::size_t numRows = 8, numColumns = 8;
+
+	WorldProperties worldProperties;
+	worldProperties.numThreads = 3;
+	RigidBodyWorld rbw(worldProperties);
+
+	// A grid of spheres in the XY plane, the even rows in the layer 1 and
+	// the odd ones in the layer 2, with a second sphere behind each one
+	std::vector<std::unique_ptr<RigidBody>> rigidBodies;
+	for (std::size_t i = 0; i < numRows; ++i) {
+		for (std::size_t j = 0; j < numColumns; ++j) {
+			for (float z : { 0.0f, -5.0f }) {
+				RigidBodyState state;
+				state.position = glm::vec3(3.0f * j, 3.0f * i, z);
+
+				auto collider = std::make_unique<BoundingSphere>(1.0f);
+				collider->setLayers(std::bitset<Collider::kMaxLayers>().set(1 + i % 2));
+
+				rigidBodies.push_back(std::make_unique<RigidBody>(RigidBodyProperties(), state, std::move(collider)));
+				rbw.addRigidBody(rigidBodies.back().get());
+			}
+		}
+	}
+
+	std::vector<Ray> rays;
+	for (std::size_t i = 0; i < numRows; ++i) {
+		for (std::size_t j = 0; j < numColumns; ++j) {
+			rays.emplace_back(glm::vec3(3.0f * j, 3.0f * i, 10.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+		}
+	}
+	rays.emplace_back(glm::vec3(-10.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+
+	// Without an update the Colliders aren't in the snapshot yet
+	std::vector<CollisionDetector::RayCastResult> results(rays.size());
+	rbw.getCollisionDetector().rayCastBatch(rays.data(), rays.size(), results.data());
+	for (const auto& result : results) {
+		EXPECT_EQ(result.first, nullptr);
+	}
+
+	rbw.update(0.016f);
+
+	// The closest hits must be the same than the rayCastFirst ones
+	rbw.getCollisionDetector().rayCastBatch(rays.data(), rays.size(), results.data());
+	for (std::size_t i = 0; i < rays.size(); ++i) {
+		Collider* collider = rbw.getCollisionDetector().rayCastFirst(rays[i]).first;
+		EXPECT_EQ(results[i].first, collider);
+		if (i < numRows * numColumns) {
+			ASSERT_EQ(results[i].first, rigidBodies[2 * i]->getCollider());
+			EXPECT_NEAR(results[i].second.distance, 9.0f, 0.05f);
+		}
+	}
+
+	// Max distance
+	rbw.getCollisionDetector().rayCastBatch(rays.data(), rays.size(), results.data(), 8.5f);
+	for (const auto& result : results) {
+		EXPECT_EQ(result.first, nullptr);
+	}
+
+	// Layers
+	rbw.getCollisionDetector().rayCastBatch(
+		rays.data(), rays.size(), results.data(),
+		std::numeric_limits<float>::max(), std::bitset<Collider::kMaxLayers>().set(2)
+	);
+	for (std::size_t i = 0; i < numRows * numColumns; ++i) {
+		bool oddRow = ((i / numColumns) % 2 == 1);
+		EXPECT_EQ(results[i].first, oddRow? rigidBodies[2 * i]->getCollider() : nullptr);
+	}
+
+	// The queries use the Colliders at the moment of the snapshot, so the
+	// changes made since then aren't seen until the next update
+	Collider* movedCollider = rigidBodies[0]->getCollider();
+	movedCollider->setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(100.0f)));
+	rbw.getCollisionDetector().rayCastBatch(rays.data(), 1, results.data());
+	EXPECT_EQ(results[0].first, movedCollider);
+	EXPECT_NEAR(results[0].second.distance, 9.0f, 0.05f);
+
+	rbw.update(0.016f);
+	rbw.getCollisionDetector().rayCastBatch(rays.data(), 1, results.data());
+	EXPECT_EQ(results[0].first, rigidBodies[1]->getCollider());
+
+	// The removed Colliders are skipped until the next update
+	rbw.removeRigidBody(rigidBodies[0].get());
+	rbw.getCollisionDetector().rayCastBatch(rays.data(), 1, results.data());
+	EXPECT_EQ(results[0].first, rigidBodies[1]->getCollider());
+}
+
+
+TEST(RigidBodyWorld, shapeCast)
+{
+	WorldProperties worldProperties;
+	worldProperties.numThreads = 2;
+	RigidBodyWorld rbw(worldProperties);
+
+	// Two spheres and a ground plane made of 2 triangles at y = -4
+	std::vector<std::unique_ptr<RigidBody>> rigidBodies;
+	for (float x : { 0.0f, 3.0f }) {
+		RigidBodyState state;
+		state.position = glm::vec3(x, 0.0f, 0.0f);
+		rigidBodies.push_back(std::make_unique<RigidBody>(RigidBodyProperties(), state, std::make_unique<BoundingSphere>(1.0f)));
+		rbw.addRigidBody(rigidBodies.back().get());
+	}
+
+	const std::vector<glm::vec3> vertices = {
+		{ -10.0f, -4.0f, -10.0f }, { 10.0f, -4.0f, -10.0f }, { 10.0f, -4.0f, 10.0f }, { -10.0f, -4.0f, 10.0f }
+	};
+	const std::vector<std::uint32_t> indices = { 0, 2, 1, 0, 3, 2 };
+	auto ground = std::make_unique<TriangleMeshCollider>(
+		std::make_shared<TriangleMesh>(vertices.data(), vertices.size(), indices.data(), indices.size())
+	);
+	rigidBodies.push_back(std::make_unique<RigidBody>(RigidBodyProperties(), RigidBodyState(), std::move(ground)));
+	rbw.addRigidBody(rigidBodies.back().get());
+
+	rbw.update(0.016f);
+
+	BoundingSphere sphere(0.5f);
+	sphere.setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, 10.0f)));
+	BoundingBox box(glm::vec3(1.0f));
+	box.setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(3.0f, 0.0f, 10.0f)));
+	Capsule capsule(0.25f, 1.0f);
+	capsule.setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(1.5f, 0.0f, 10.0f)));
+	BoundingBox fallingBox(glm::vec3(2.0f));
+	fallingBox.setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(7.0f, 5.0f, 0.0f)));
+
+	const std::vector<CollisionDetector::ShapeCast> shapeCasts = {
+		{ &sphere, glm::vec3(0.0f, 0.0f, -1.0f) },
+		{ &box, glm::vec3(0.0f, 0.0f, -1.0f) },
+		{ &capsule, glm::vec3(0.0f, 0.0f, -1.0f) },
+		{ &fallingBox, glm::vec3(0.0f, -1.0f, 0.0f) },
+		{ &sphere, glm::vec3(0.0f, 0.0f, 1.0f) }
+	};
+	const Collider* expectedColliders[] = {
+		rigidBodies[0]->getCollider(), rigidBodies[1]->getCollider(), nullptr, rigidBodies[2]->getCollider(), nullptr
+	};
+	const float expectedDistances[] = { 8.5f, 8.5f, 0.0f, 8.0f, 0.0f };
+	const glm::vec3 expectedNormals[] = {
+		glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f)
+	};
+
+	std::vector<CollisionDetector::RayCastResult> results(shapeCasts.size());
+	rbw.getCollisionDetector().shapeCastBatch(shapeCasts.data(), shapeCasts.size(), results.data());
+	for (std::size_t i = 0; i < shapeCasts.size(); ++i) {
+		ASSERT_EQ(results[i].first, expectedColliders[i]);
+		if (expectedColliders[i]) {
+			EXPECT_NEAR(results[i].second.distance, expectedDistances[i], 0.05f);
+			for (int j = 0; j < 3; ++j) {
+				EXPECT_NEAR(results[i].second.contactNormal[j], expectedNormals[i][j], 0.05f);
+			}
+		}
+	}
+
+	// Max distance and layers
+	EXPECT_EQ(rbw.getCollisionDetector().shapeCastFirst(sphere, glm::vec3(0.0f, 0.0f, -1.0f), 8.0f).first, nullptr);
+	EXPECT_EQ(rbw.getCollisionDetector().shapeCastFirst(
+		sphere, glm::vec3(0.0f, 0.0f, -1.0f), std::numeric_limits<float>::max(), std::bitset<Collider::kMaxLayers>().set(5)
+	).first, nullptr);
+}
+
+
+TEST(RigidBodyWorld, overlapQueries)
+{
+	WorldProperties worldProperties;
+	RigidBodyWorld rbw(worldProperties);
+
+	// Three spheres along the X axis, the last one in the layer 1
+	std::vector<std::unique_ptr<RigidBody>> rigidBodies;
+	for (float x : { 0.0f, 3.0f, 6.0f }) {
+		RigidBodyState state;
+		state.position = glm::vec3(x, 0.0f, 0.0f);
+
+		auto collider = std::make_unique<BoundingSphere>(1.0f);
+		if (x == 6.0f) {
+			collider->setLayers(std::bitset<Collider::kMaxLayers>().set(1));
+		}
+
+		rigidBodies.push_back(std::make_unique<RigidBody>(RigidBodyProperties(), state, std::move(collider)));
+		rbw.addRigidBody(rigidBodies.back().get());
+	}
+
+	const CollisionDetector& collisionDetector = rbw.getCollisionDetector();
+	Collider* results[4] = {};
+	EXPECT_EQ(collisionDetector.overlapSphere(glm::vec3(0.0f), 10.0f, results, 4), 0u);
+
+	rbw.update(0.016f);
+
+	// Sphere between the first two spheres
+	std::size_t numResults = collisionDetector.overlapSphere(glm::vec3(1.5f, 0.0f, 0.0f), 0.6f, results, 4);
+	ASSERT_EQ(numResults, 2u);
+	if (results[0]->getTransforms()[3].x > results[1]->getTransforms()[3].x) {
+		std::swap(results[0], results[1]);
+	}
+	EXPECT_EQ(results[0], rigidBodies[0]->getCollider());
+	EXPECT_EQ(results[1], rigidBodies[1]->getCollider());
+
+	// Buffer size
+	EXPECT_EQ(collisionDetector.overlapSphere(glm::vec3(1.5f, 0.0f, 0.0f), 0.6f, results, 1), 1u);
+	EXPECT_EQ(collisionDetector.overlapSphere(glm::vec3(1.5f, 0.0f, 0.0f), 0.4f, results, 4), 0u);
+
+	// The AABB overlaps with the AABB of the first sphere but not with it
+	EXPECT_EQ(collisionDetector.overlapAABB({ glm::vec3(0.8f, 0.8f, -0.1f), glm::vec3(1.0f, 1.0f, 0.1f) }, results, 4), 0u);
+	ASSERT_EQ(collisionDetector.overlapAABB({ glm::vec3(-0.2f, 0.9f, -0.2f), glm::vec3(0.2f, 1.5f, 0.2f) }, results, 4), 1u);
+	EXPECT_EQ(results[0], rigidBodies[0]->getCollider());
+
+	// Convex shape and layers
+	Capsule capsule(0.25f, 6.0f);
+	capsule.setTransforms(glm::rotate(
+		glm::translate(glm::mat4(1.0f), glm::vec3(4.5f, 0.0f, 0.0f)),
+		glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f)
+	));
+	EXPECT_EQ(collisionDetector.overlapShape(capsule, results, 4), 2u);
+	ASSERT_EQ(collisionDetector.overlapShape(capsule, results, 4, std::bitset<Collider::kMaxLayers>().set(1)), 1u);
+	EXPECT_EQ(results[0], rigidBodies[2]->getCollider());
+}
+
+
+TEST(RigidBodyWorld, continuousCollisionDetection)
+{
+	WorldProperties worldProperties;
+	worldProperties.numThreads = 1;
+	RigidBodyWorld rbw(worldProperties);
+
+	// A thin box wall at x = 5 and a wall made of 2 triangles at x = -5
+	RigidBodyState wallState;
+	wallState.position = glm::vec3(5.0f, 0.0f, 0.0f);
+	RigidBody boxWall(RigidBodyProperties(), wallState, std::make_unique<BoundingBox>(glm::vec3(0.05f, 10.0f, 10.0f)));
+	rbw.addRigidBody(&boxWall);
+
+	const std::vector<glm::vec3> vertices = {
+		{ -5.0f, -5.0f, -5.0f }, { -5.0f, 5.0f, -5.0f }, { -5.0f, 5.0f, 5.0f }, { -5.0f, -5.0f, 5.0f }
+	};
+	const std::vector<std::uint32_t> indices = { 0, 1, 2, 0, 2, 3 };
+	RigidBody meshWall(RigidBodyProperties(), RigidBodyState(), std::make_unique<TriangleMeshCollider>(
+		std::make_shared<TriangleMesh>(vertices.data(), vertices.size(), indices.data(), indices.size())
+	));
+	rbw.addRigidBody(&meshWall);
+
+	// Fast spheres shot towards the walls, only the ones with continuous
+	// collision detection must stop before them
+	std::vector<std::unique_ptr<RigidBody>> spheres;
+	for (float direction : { 1.0f, -1.0f }) {
+		for (bool ccd : { false, true }) {
+			RigidBodyProperties properties(1.0f, glm::mat3(2.0f / 5.0f * 0.1f * 0.1f));
+			properties.continuousCollisionDetection = ccd;
+
+			RigidBodyState state;
+			state.position = glm::vec3(0.0f, ccd? 2.0f : -2.0f, 0.0f);
+			state.linearVelocity = glm::vec3(direction * 300.0f, 0.0f, 0.0f);
+
+			spheres.push_back(std::make_unique<RigidBody>(properties, state, std::make_unique<BoundingSphere>(0.1f)));
+			rbw.addRigidBody(spheres.back().get());
+		}
+	}
+
+	for (int i = 0; i < 10; ++i) {
+		rbw.update(0.016f);
+	}
+
+	EXPECT_GT(spheres[0]->getState().position.x, 5.0f);
+	EXPECT_LT(spheres[1]->getState().position.x, 5.0f);
+	EXPECT_LT(spheres[2]->getState().position.x, -5.0f);
+	EXPECT_GT(spheres[3]->getState().position.x, -5.0f);
+}
+
+
+TEST(RigidBodyWorld, islandSleeping)
+{
+	WorldProperties worldProperties;
+	worldProperties.numThreads = 1;
+	RigidBodyWorld rbw(worldProperties);
+
+	RigidBodyState groundState;
+	groundState.position = glm::vec3(0.0f, -0.5f, 0.0f);
+	RigidBody ground(RigidBodyProperties(), groundState, std::make_unique<BoundingBox>(glm::vec3(20.0f, 1.0f, 20.0f)));
+	rbw.addRigidBody(&ground);
+
+	// A stack of boxes resting on the ground
+	auto gravity = std::make_shared<Gravity>(-9.8f);
+	std::vector<std::unique_ptr<RigidBody>> boxes;
+	for (int i = 0; i < 2; ++i) {
+		RigidBodyProperties properties(1.0f, glm::mat3(1.0f / 6.0f));
+		properties.frictionCoefficient = 0.5f;
+
+		RigidBodyState state;
+		state.position = glm::vec3(0.0f, 0.499f + 0.999f * i, 0.0f);
+
+		boxes.push_back(std::make_unique<RigidBody>(properties, state, std::make_unique<BoundingBox>(glm::vec3(1.0f))));
+		boxes.back()->addForce(gravity);
+		rbw.addRigidBody(boxes.back().get());
+	}
+
+	// The boxes must always sleep and wake up together
+	auto isSleeping = [](const std::unique_ptr<RigidBody>& box) { return box->getStatus(RigidBody::Status::Sleeping); };
+	bool sleeping = false;
+	for (int i = 0; (i < 1000) && !sleeping; ++i) {
+		rbw.update(0.016f);
+
+		sleeping = isSleeping(boxes[0]);
+		EXPECT_TRUE(std::all_of(boxes.begin(), boxes.end(), [&](const auto& box) { return isSleeping(box) == sleeping; }));
+	}
+	ASSERT_TRUE(sleeping);
+
+	// The Contacts are kept while the boxes are sleeping
+	std::vector<RigidBodyState> states;
+	for (const auto& box : boxes) {
+		states.push_back(box->getState());
+	}
+	for (int i = 0; i < 10; ++i) {
+		rbw.update(0.016f);
+	}
+	EXPECT_TRUE(rbw.getConstraintManager().hasConstraints());
+	for (std::size_t i = 0; i < boxes.size(); ++i) {
+		EXPECT_TRUE(isSleeping(boxes[i]));
+		EXPECT_EQ(boxes[i]->getState().position, states[i].position);
+	}
+
+	// Waking up the top box wakes up the whole stack
+	RigidBodyState topState = boxes.back()->getState();
+	topState.linearVelocity = glm::vec3(1.0f, 0.0f, 0.0f);
+	boxes.back()->setState(topState);
+	rbw.update(0.016f);
+	EXPECT_TRUE(std::none_of(boxes.begin(), boxes.end(), isSleeping));
+}
+
+
+static std::vector<glm::vec3> simulateDistanceGrid(std::size_t minParallelSolverConstraints, std::size_t numThreads)
+{
+	static constexpr std::size_t kGridSize = 24;
+
+	WorldProperties worldProperties;
+	worldProperties.maxConstraintIterations = 10;
+	worldProperties.minParallelSolverConstraints = minParallelSolverConstraints;
+	worldProperties.numThreads = numThreads;
+	RigidBodyWorld rbw(worldProperties);
+
+	// A grid of RigidBodies linked by DistanceConstraints hanging from a
+	// row of static anchors. They are stored contiguously so the islands
+	// sort them in the same order in every simulation
+	auto gravity = std::make_shared<Gravity>(-9.8f);
+	std::vector<RigidBody> nodes;
+	std::vector<DistanceConstraint> constraints;
+	nodes.reserve(kGridSize * (kGridSize + 1));
+	constraints.reserve(2 * kGridSize * kGridSize);
+	for (std::size_t y = 0; y <= kGridSize; ++y) {
+		for (std::size_t x = 0; x < kGridSize; ++x) {
+			RigidBodyProperties properties = (y == 0)? RigidBodyProperties() : RigidBodyProperties(1.0f, glm::mat3(1.0f / 6.0f));
+			properties.sleepMotion = 0.0f;
+
+			RigidBodyState state;
+			state.position = glm::vec3(0.5f * x, -0.5f * y, 0.1f * (x % 3));
+
+			auto& node = nodes.emplace_back(properties, state);
+			if (y == 0) {
+				continue;
+			}
+
+			node.addForce(gravity);
+			constraints.emplace_back(std::array<RigidBody*, 2>{ &nodes[nodes.size() - 1 - kGridSize], &node });
+			if (x > 0) {
+				constraints.emplace_back(std::array<RigidBody*, 2>{ &nodes[nodes.size() - 2], &node });
+			}
+		}
+	}
+	for (RigidBody& node : nodes) {
+		rbw.addRigidBody(&node);
+	}
+	for (DistanceConstraint& constraint : constraints) {
+		rbw.getConstraintManager().addConstraint(&constraint);
+	}
+
+	for (int i = 0; i < 30; ++i) {
+		rbw.update(0.016f);
+	}
+
+	std::vector<glm::vec3> positions;
+	for (const RigidBody& node : nodes) {
+		positions.push_back(node.getState().position);
+	}
+	return positions;
+}
+
+
+TEST(RigidBodyWorld, parallelConstraintSolver)
+{
+	const std::vector<glm::vec3> serialPositions = simulateDistanceGrid(0, 1);
+	const std::vector<glm::vec3> parallelPositions1 = simulateDistanceGrid(1, 1);
+	const std::vector<glm::vec3> parallelPositions4 = simulateDistanceGrid(1, 4);
+
+	// The result of the parallel solver doesn't depend on the number of
+	// threads
+	ASSERT_EQ(parallelPositions1.size(), parallelPositions4.size());
+	for (std::size_t i = 0; i < parallelPositions1.size(); ++i) {
+		EXPECT_EQ(parallelPositions1[i], parallelPositions4[i]);
+	}
+
+	// The Constraints are solved in a different order, so the result is
+	// only similar to the serial one
+	ASSERT_EQ(serialPositions.size(), parallelPositions1.size());
+	for (std::size_t i = 0; i < serialPositions.size(); ++i) {
+		EXPECT_LE(glm::length(serialPositions[i] - parallelPositions1[i]), 0.01f);
+	}
+}
+
+
+static std::vector<RigidBodyState> simulateFreeBodies(std::size_t iFirst, std::size_t numRigidBodies, std::size_t numThreads)
+{
+	WorldProperties worldProperties;
+	worldProperties.numThreads = numThreads;
+	RigidBodyWorld rbw(worldProperties);
+
+	std::vector<RigidBody> rigidBodies;
+	rigidBodies.reserve(numRigidBodies);
+	for (std::size_t i = iFirst; i < iFirst + numRigidBodies; ++i) {
+		float mass = 1.0f + 0.1f * i;
+		RigidBodyProperties properties(mass, glm::mat3(2.0f / 5.0f * mass * 0.25f));
+		properties.linearDrag = (i % 2)? 0.1f : 0.0f;
+		properties.angularDrag = (i % 3)? 0.05f : 0.0f;
+
+		RigidBodyState state;
+		state.position = glm::vec3(i % 17 - 8.0f, i % 5, -(i % 11) * 1.0f);
+		state.linearVelocity = glm::vec3(0.1f * (i % 7), -0.2f * (i % 3), 0.3f);
+		state.angularVelocity = glm::vec3(0.5f, -0.1f * (i % 9), 0.2f * (i % 4));
+		state.orientation = glm::normalize(glm::quat(1.0f, 0.1f * (i % 5), 0.2f, -0.1f * (i % 3)));
+
+		auto& rb = rigidBodies.emplace_back(properties, state);
+		rb.addForce(std::make_shared<DirectionalForce>(glm::vec3(1.0f, -2.0f, 0.5f * (i % 4))));
+		rb.addForce(std::make_shared<PunctualForce>(glm::vec3(0.3f, 0.1f * (i % 6), -1.0f), state.position + glm::vec3(0.5f, 0.0f, 0.25f)));
+	}
+	for (RigidBody& rb : rigidBodies) {
+		rbw.addRigidBody(&rb);
+	}
+
+	for (int i = 0; i < 5; ++i) {
+		rbw.update(0.016f);
+	}
+
+	std::vector<RigidBodyState> states;
+	for (const RigidBody& rb : rigidBodies) {
+		states.push_back(rb.getState());
+	}
+	return states;
+}
+
+
+TEST(RigidBodyWorld, parallelIntegration)
+{
+	const std::size_t kNumRigidBodies = 4 * RigidBodyWorld::kMinRigidBodiesPerThread + 3;
+	const std::vector<RigidBodyState> states1 = simulateFreeBodies(0, kNumRigidBodies, 1);
+	const std::vector<RigidBodyState> states4 = simulateFreeBodies(0, kNumRigidBodies, 4);
+
+	// The result doesn't depend on the number of threads
+	ASSERT_EQ(states1.size(), states4.size());
+	for (std::size_t i = 0; i < states1.size(); ++i) {
+		EXPECT_EQ(states1[i].position, states4[i].position);
+		EXPECT_EQ(states1[i].orientation, states4[i].orientation);
+		EXPECT_EQ(states1[i].linearVelocity, states4[i].linearVelocity);
+		EXPECT_EQ(states1[i].angularVelocity, states4[i].angularVelocity);
+	}
+
+	// Nor on the number of RigidBodies integrated together
+	for (std::size_t i : { std::size_t(0), kNumRigidBodies / 2, kNumRigidBodies - 1 }) {
+		const RigidBodyState state = simulateFreeBodies(i, 1, 1).front();
+		for (int j = 0; j < 3; ++j) {
+			EXPECT_NEAR(state.position[j], states4[i].position[j], kTolerance);
+			EXPECT_NEAR(state.linearVelocity[j], states4[i].linearVelocity[j], kTolerance);
+			EXPECT_NEAR(state.angularVelocity[j], states4[i].angularVelocity[j], kTolerance);
+		}
+		for (int j = 0; j < 4; ++j) {
+			EXPECT_NEAR(state.orientation[j], states4[i].orientation[j], kTolerance);
+		}
+	}
+}
+
+
+TEST(RigidBodyWorld, collisionSolverPooling)
+{
+	WorldProperties worldProperties;
+	worldProperties.numThreads = 1;
+	RigidBodyWorld rbw(worldProperties);
+
+	RigidBodyState groundState;
+	groundState.position = glm::vec3(0.0f, -0.5f, 0.0f);
+	RigidBody ground(RigidBodyProperties(), groundState, std::make_unique<BoundingBox>(glm::vec3(20.0f, 1.0f, 20.0f)));
+	rbw.addRigidBody(&ground);
+
+	RigidBodyProperties properties(1.0f, glm::mat3(1.0f / 6.0f));
+	properties.frictionCoefficient = 0.5f;
+	properties.sleepMotion = 0.0f;
+	RigidBodyState state;
+	state.position = glm::vec3(0.0f, 0.499f, 0.0f);
+	RigidBody box(properties, state, std::make_unique<BoundingBox>(glm::vec3(1.0f)));
+	box.addForce(std::make_shared<Gravity>(-9.8f));
+	rbw.addRigidBody(&box);
+
+	auto getConstraints = [&]() {
+		std::vector<Constraint*> constraints;
+		rbw.getConstraintManager().processRigidBodyConstraints(&box, [&](Constraint* constraint) {
+			constraints.push_back(constraint);
+		});
+		std::sort(constraints.begin(), constraints.end());
+		return constraints;
+	};
+
+	for (int i = 0; i < 10; ++i) {
+		rbw.update(0.016f);
+	}
+
+	// The Constraints of the resting box are updated in place, so they keep
+	// the lambda values of the previous updates
+	const std::vector<Constraint*> constraints = getConstraints();
+	ASSERT_FALSE(constraints.empty());
+	for (int i = 0; i < 10; ++i) {
+		rbw.update(0.016f);
+
+		EXPECT_EQ(getConstraints(), constraints);
+		EXPECT_TRUE(std::any_of(constraints.begin(), constraints.end(), [](const Constraint* constraint) {
+			return constraint->getLambda() != 0.0f;
+		}));
+	}
+
+	// Replacing the Collider removes the Constraints of its old Contacts,
+	// the new one is too small to touch the ground
+	box.setCollider(std::make_unique<BoundingBox>(glm::vec3(0.5f)));
+	rbw.update(0.016f);
+	EXPECT_TRUE(getConstraints().empty());
+
+	// The box falls and the slots are reused for the new Contacts
+	for (int i = 0; (i < 100) && getConstraints().empty(); ++i) {
+		rbw.update(0.016f);
+	}
+	EXPECT_FALSE(getConstraints().empty());
+
+	// The Constraints are removed with the RigidBody
+	rbw.removeRigidBody(&box);
+	EXPECT_FALSE(rbw.getConstraintManager().hasConstraints());
+	rbw.update(0.016f);
+	EXPECT_FALSE(rbw.getConstraintManager().hasConstraints());
+}
+
+
+TEST(RigidBodyWorld, contactWarmStarting)
+{
+	WorldProperties worldProperties;
+	worldProperties.numThreads = 1;
+	worldProperties.warmStartingFactor = 1.0f;
+	RigidBodyWorld rbw(worldProperties);
+
+	RigidBody ground(RigidBodyProperties(), RigidBodyState(), std::make_unique<BoundingBox>(glm::vec3(20.0f, 1.0f, 20.0f)));
+	RigidBodyState state;
+	state.position = glm::vec3(0.0f, 1.0f, 0.0f);
+	RigidBody box(RigidBodyProperties(1.0f, glm::mat3(1.0f / 6.0f)), state, std::make_unique<BoundingBox>(glm::vec3(1.0f)));
+
+	CollisionSolver collisionSolver(rbw);
+	Manifold manifold(box.getCollider(), ground.getCollider());
+	manifold.state.set(Manifold::State::Intersecting);
+	for (std::uint32_t i = 0; i < 3; ++i) {
+		Contact contact;
+		contact.id = i;
+		contact.normal = glm::vec3(0.0f, -1.0f, 0.0f);
+		contact.worldPosition[0] = contact.worldPosition[1] = glm::vec3(0.5f * i - 0.5f, 0.5f, 0.5f - 0.5f * i);
+		manifold.contacts.push_back(contact);
+	}
+
+	// The Jacobian of a NormalConstraint identifies its Contact
+	using ConstraintData = std::pair<std::array<float, 12>, float>;
+	auto getConstraintsData = [&]() {
+		std::vector<std::pair<Constraint*, ConstraintData>> constraintsData;
+		rbw.getConstraintManager().processRigidBodyConstraints(&box, [&](Constraint* constraint) {
+			if (dynamic_cast<NormalConstraint*>(constraint)) {
+				constraintsData.emplace_back(constraint, ConstraintData(constraint->getJacobianMatrix(), constraint->getLambda()));
+			}
+		});
+		std::sort(constraintsData.begin(), constraintsData.end());
+		return constraintsData;
+	};
+
+	collisionSolver.onCollision(manifold, 0);
+	collisionSolver.update(0.016f);
+	auto constraintsData = getConstraintsData();
+	ASSERT_EQ(constraintsData.size(), 3u);
+	for (std::size_t i = 0; i < constraintsData.size(); ++i) {
+		constraintsData[i].first->setLambda(i + 1.0f);
+		constraintsData[i].second.second = i + 1.0f;
+	}
+
+	// The Constraints follow their Contacts when they are reordered
+	std::swap(manifold.contacts[0], manifold.contacts[2]);
+	collisionSolver.onCollision(manifold, 0);
+	collisionSolver.update(0.016f);
+	EXPECT_EQ(getConstraintsData(), constraintsData);
+
+	// The Constraints of the other Contacts are kept when one is removed
+	manifold.contacts.erase(manifold.contacts.begin());
+	collisionSolver.onCollision(manifold, 0);
+	collisionSolver.update(0.016f);
+	auto constraintsData2 = getConstraintsData();
+	EXPECT_EQ(constraintsData2.size(), 2u);
+	for (const auto& constraintData : constraintsData2) {
+		EXPECT_NE(std::find(constraintsData.begin(), constraintsData.end(), constraintData), constraintsData.end());
+	}
+}
+
+
+/** A stack of unit boxes resting on the ground of its own RigidBodyWorld */
+struct BoxStack
+{
+	RigidBodyWorld world;
+	RigidBody ground;
+	std::vector<std::unique_ptr<RigidBody>> boxes;
+
+	BoxStack(const WorldProperties& worldProperties, std::size_t numBoxes) :
+		world(worldProperties),
+		ground(RigidBodyProperties(), RigidBodyState(), std::make_unique<BoundingBox>(glm::vec3(20.0f, 1.0f, 20.0f)))
+	{
+		RigidBodyState groundState;
+		groundState.position = glm::vec3(0.0f, -0.5f, 0.0f);
+		ground.setState(groundState);
+		world.addRigidBody(&ground);
+
+		RigidBodyProperties properties(1.0f, glm::mat3(1.0f / 6.0f));
+		properties.frictionCoefficient = 0.5f;
+		properties.sleepMotion = 0.0f;
+		for (std::size_t i = 0; i < numBoxes; ++i) {
+			RigidBodyState state;
+			state.position = glm::vec3(0.0f, 0.5f + i, 0.0f);
+			boxes.push_back(std::make_unique<RigidBody>(properties, state, std::make_unique<BoundingBox>(glm::vec3(1.0f))));
+			boxes.back()->addForce(std::make_shared<Gravity>(-9.8f));
+			world.addRigidBody(boxes.back().get());
+		}
+	}
+};
+
+
+TEST(RigidBodyWorld, warmStartingIslandRebuild)
+{
+	WorldProperties worldProperties;
+	worldProperties.numThreads = 1;
+	BoxStack stack(worldProperties, 3);
+	for (int i = 0; i < 100; ++i) {
+		stack.world.update(0.016f);
+	}
+
+	// The Constraints are solved in the order of their addresses, so the
+	// updates are compared in the same RigidBodyWorld restoring its state
+	std::vector<RigidBodyState> states;
+	for (const auto& box : stack.boxes) {
+		states.push_back(box->getState());
+	}
+
+	std::vector<std::pair<Constraint*, float>> lambdas;
+	stack.world.getConstraintManager().processConstraints([&](Constraint* constraint) {
+		lambdas.emplace_back(constraint, constraint->getLambda());
+	});
+
+	auto updateFrom = [&](float lambdaFactor) {
+		for (std::size_t i = 0; i < stack.boxes.size(); ++i) {
+			stack.boxes[i]->setState(states[i]);
+		}
+		for (auto [constraint, lambda] : lambdas) {
+			constraint->setLambda(lambdaFactor * lambda);
+		}
+
+		stack.world.update(0.016f);
+
+		std::vector<RigidBodyState> result;
+		for (const auto& box : stack.boxes) {
+			result.push_back(box->getState());
+		}
+		return result;
+	};
+
+	auto states1 = updateFrom(1.0f);
+
+	// Adding and removing a Constraint forces the islands to be rebuilt
+	DistanceConstraint distanceConstraint({ &stack.ground, stack.boxes.back().get() });
+	stack.world.getConstraintManager().addConstraint(&distanceConstraint);
+	stack.world.getConstraintManager().removeConstraint(&distanceConstraint);
+	auto states2 = updateFrom(1.0f);
+
+	// Solving the Constraints from zero gives different results
+	auto states3 = updateFrom(0.0f);
+
+	bool coldDifferent = false;
+	for (std::size_t i = 0; i < stack.boxes.size(); ++i) {
+		for (int j = 0; j < 3; ++j) {
+			EXPECT_NEAR(states1[i].position[j], states2[i].position[j], kTolerance);
+			EXPECT_NEAR(states1[i].linearVelocity[j], states2[i].linearVelocity[j], kTolerance);
+			coldDifferent |= std::abs(states1[i].linearVelocity[j] - states3[i].linearVelocity[j]) > kTolerance;
+		}
+	}
+	EXPECT_TRUE(coldDifferent);
+}
+
+
+TEST(RigidBodyWorld, warmStartingStack)
+{
+	WorldProperties warmProperties;
+	warmProperties.numThreads = 1;
+	warmProperties.maxConstraintIterations = 1;
+	WorldProperties coldProperties = warmProperties;
+	coldProperties.maxConstraintIterations = 2;
+	coldProperties.warmStartingFactor = 0.0f;
+
+	BoxStack warmStack(warmProperties, 5), coldStack(coldProperties, 5);
+	for (int i = 0; i < 300; ++i) {
+		warmStack.world.update(0.016f);
+		coldStack.world.update(0.016f);
+	}
+
+	// With warm starting the stack sinks less with a single iteration than
+	// without it with two iterations
+	for (std::size_t i = 0; i < warmStack.boxes.size(); ++i) {
+		const glm::vec3& position = warmStack.boxes[i]->getState().position;
+		EXPECT_NEAR(position.x, 0.0f, 0.1f);
+		EXPECT_NEAR(position.y, 0.5f + i, 0.05f);
+		EXPECT_NEAR(position.z, 0.0f, 0.1f);
+	}
+	EXPECT_GT(warmStack.boxes.back()->getState().position.y, coldStack.boxes.back()->getState().position.y);
+}
@@ -14,7 +14,7 @@ TEST(TriangleMeshCollider, getAABB1)
 	const glm::vec3 expectedMaximum(1.209428787f, 1.568309783f, 1.263301849f);
 
 	auto [vertices, indices] = createTestTriangleMesh();
-	TriangleMeshCollider tm1(vertices.data(), vertices.size(), indices.data(), indices.size());
+	TriangleMeshCollider tm1(std::make_shared<TriangleMesh>(vertices.data(), vertices.size(), indices.data(), indices.size()));
 
 	AABB aabb1 = tm1.getAABB();
 	for (int i = 0; i < 3; ++i) {
@@ -26,8 +26,12 @@ TEST(TriangleMeshCollider, getAABB1)
 
 TEST(TriangleMeshCollider, getAABBTransforms1)
 {
-	const glm::vec3 expectedMinimum(1.686079740f, -3.096512794f, -3.178431987f);
-	const glm::vec3 expectedMaximum(3.719449758f, -1.429600834f, -1.414804577f);
+	// The AABB is the transformed local AABB, so it must contain the tight
+	// AABB of the transformed triangles
+	const glm::vec3 expectedMinimum(1.267042756f, -3.911709070f, -3.662684917f);
+	const glm::vec3 expectedMaximum(4.257503509f, -0.638594746f, -0.955025672f);
+	const glm::vec3 trianglesMinimum(1.686079740f, -3.096512794f, -3.178431987f);
+	const glm::vec3 trianglesMaximum(3.719449758f, -1.429600834f, -1.414804577f);
 
 	const glm::vec3 translation(2.865250587f, -2.368927478f, -2.282903194f);
 	const glm::quat rotation = { 0.928554952f, -0.294283181f, 0.006446061f, -0.226145476f };
@@ -38,13 +42,15 @@ TEST(TriangleMeshCollider, getAABBTransforms1)
 	glm::mat4 transforms = t * r * s;
 
 	auto [vertices, indices] = createTestTriangleMesh();
-	TriangleMeshCollider tm1(vertices.data(), vertices.size(), indices.data(), indices.size());
+	TriangleMeshCollider tm1(std::make_shared<TriangleMesh>(vertices.data(), vertices.size(), indices.data(), indices.size()));
 	tm1.setTransforms(transforms);
 
 	AABB aabb1 = tm1.getAABB();
 	for (int i = 0; i < 3; ++i) {
 		EXPECT_NEAR(aabb1.minimum[i], expectedMinimum[i], kTolerance);
 		EXPECT_NEAR(aabb1.maximum[i], expectedMaximum[i], kTolerance);
+		EXPECT_LE(aabb1.minimum[i], trianglesMinimum[i]);
+		EXPECT_GE(aabb1.maximum[i], trianglesMaximum[i]);
 	}
 }
 
@@ -52,7 +58,7 @@ TEST(TriangleMeshCollider, getAABBTransforms1)
 TEST(TriangleMeshCollider, updated)
 {
 	auto [vertices, indices] = createTestTriangleMesh();
-	TriangleMeshCollider tm1(vertices.data(), vertices.size(), indices.data(), indices.size());
+	TriangleMeshCollider tm1(std::make_shared<TriangleMesh>(vertices.data(), vertices.size(), indices.data(), indices.size()));
 
 	EXPECT_TRUE(tm1.updated());
 	tm1.resetUpdatedState();
@@ -82,7 +88,7 @@ TEST(TriangleMeshCollider, getOverlapingParts1)
 	glm::mat4 transforms = t * r * s;
 
 	auto [vertices, indices] = createTestTriangleMesh();
-	TriangleMeshCollider tm1(vertices.data(), vertices.size(), indices.data(), indices.size());
+	TriangleMeshCollider tm1(std::make_shared<TriangleMesh>(vertices.data(), vertices.size(), indices.data(), indices.size()));
 	tm1.setTransforms(transforms);
 
 	std::vector<TriangleCollider> expectedRes = {
@@ -165,15 +171,10 @@ TEST(TriangleMeshCollider, processIntersectingParts)
 	glm::mat4 transforms = t * r * s;
 
 	auto [vertices, indices] = createTestTriangleMesh();
-	TriangleMeshCollider tm1(vertices.data(), vertices.size(), indices.data(), indices.size());
+	TriangleMeshCollider tm1(std::make_shared<TriangleMesh>(vertices.data(), vertices.size(), indices.data(), indices.size()));
 	tm1.setTransforms(transforms);
 
 	std::vector<TriangleCollider> expectedRes = {
-		TriangleCollider({
-			glm::vec3(-0.222157642f, 1.022119164f, 0.925747632f),
-			glm::vec3(0.171862334f, -0.085280865f, 0.626737713f),
-			glm::vec3(0.053215581f, 0.763675630f, 0.238783344f)
-		}),
 		TriangleCollider({
 			glm::vec3(0.171862334f, -0.085280865f, 0.626737713f),
 			glm::vec3(1.209428787f, 0.122468627f, -0.003602489f),
@@ -193,11 +194,6 @@ TEST(TriangleMeshCollider, processIntersectingParts)
 			glm::vec3(-1.175907135f, 0.038690738f, -0.654182493f),
 			glm::vec3(0.017661752f, -0.138503223f, -1.216818571f),
 			glm::vec3(-0.108820162f, -0.884682297f, -0.771282374f)
-		}),
-		TriangleCollider({
-			glm::vec3(0.147921025f, 0.426297962f, -1.191849231f),
-			glm::vec3(0.017661752f, -0.138503223f, -1.216818571f),
-			glm::vec3(-1.175907135f, 0.038690738f, -0.654182493f)
 		})
 	};
 	for (TriangleCollider& cp : expectedRes) {
@@ -218,3 +214,125 @@ TEST(TriangleMeshCollider, processIntersectingParts)
 	});
 	EXPECT_EQ(expectedRes.size(), numTris);
 }
+
+
+TEST(TriangleMeshCollider, sharedMesh)
+{
+	auto [vertices, indices] = createTestTriangleMesh();
+	auto mesh = std::make_shared<TriangleMesh>(vertices.data(), vertices.size(), indices.data(), indices.size());
+
+	TriangleMeshCollider tm1(mesh);
+	tm1.setTransforms(glm::translate(glm::mat4(1.0f), glm::vec3(10.0f, 0.0f, 0.0f)));
+	auto tm2 = tm1.clone();
+	auto tm3 = dynamic_cast<TriangleMeshCollider*>(tm2.get());
+	ASSERT_TRUE(tm3);
+	tm3->setTransforms(glm::mat4(1.0f));
+
+	EXPECT_EQ(tm1.getMesh().get(), mesh.get());
+	EXPECT_EQ(tm3->getMesh().get(), mesh.get());
+	EXPECT_EQ(mesh.use_count(), 3);
+	for (int i = 0; i < 3; ++i) {
+		EXPECT_NEAR(tm1.getAABB().minimum[i], tm3->getAABB().minimum[i] + ((i == 0)? 10.0f : 0.0f), kTolerance);
+		EXPECT_NEAR(tm1.getAABB().maximum[i], tm3->getAABB().maximum[i] + ((i == 0)? 10.0f : 0.0f), kTolerance);
+	}
+}
+
+
+TEST(TriangleMeshCollider, largeIndices)
+{
+	// A strip of triangles whose vertices can't be indexed with 16 bits
+	const std::size_t numVertices = 70000;
+	std::vector<glm::vec3> vertices;
+	for (std::size_t i = 0; i < numVertices; ++i) {
+		vertices.emplace_back(static_cast<float>(i / 2), 0.0f, static_cast<float>(i % 2));
+	}
+
+	std::vector<std::uint32_t> indices;
+	for (std::uint32_t i = 0; i + 2 < numVertices; i += 2) {
+		indices.insert(indices.end(), { i, i + 1, i + 2 });
+	}
+
+	TriangleMeshCollider tm1(std::make_shared<TriangleMesh>(vertices.data(), vertices.size(), indices.data(), indices.size()));
+	const AABB aabb1 = { glm::vec3(34998.5f, -1.0f, 0.0f), glm::vec3(34998.6f, 1.0f, 0.1f) };
+
+	std::size_t numTris = 0;
+	tm1.processOverlapingParts(aabb1, kTolerance, [&](const ConvexCollider& part) {
+		auto tri1 = dynamic_cast<const TriangleCollider*>(&part);
+		ASSERT_TRUE(tri1);
+		EXPECT_NEAR(tri1->getLocalVertices()[0].x, 34998.0f, kTolerance);
+		numTris++;
+	});
+	EXPECT_EQ(numTris, 1u);
+}
+
+
+TEST(TriangleMeshCollider, queriesLargeMesh)
+{
+	// A wavy grid with enough triangles to have multiple levels in the AABB
+	// Tree, the queries must return the same triangles than a linear search
+	const std::size_t gridSize = 40;
+	std::vector<glm::vec3> vertices;
+	for (std::size_t z = 0; z < gridSize; ++z) {
+		for (std::size_t x = 0; x < gridSize; ++x) {
+			float y = 0.5f * std::sin(0.3f * x) * std::cos(0.2f * z);
+			vertices.emplace_back(static_cast<float>(x), y, static_cast<float>(z));
+		}
+	}
+
+	std::vector<std::uint32_t> indices;
+	for (std::uint32_t z = 0; z + 1 < gridSize; ++z) {
+		for (std::uint32_t x = 0; x + 1 < gridSize; ++x) {
+			std::uint32_t i0 = z * gridSize + x, i1 = i0 + 1, i2 = i0 + gridSize, i3 = i2 + 1;
+			indices.insert(indices.end(), { i0, i2, i1, i1, i2, i3 });
+		}
+	}
+
+	auto mesh = std::make_shared<TriangleMesh>(vertices.data(), vertices.size(), indices.data(), indices.size());
+	TriangleMeshCollider tm1(mesh);
+
+	auto getTriangleIndex = [&](const ConvexCollider& part) {
+		auto tri1 = dynamic_cast<const TriangleCollider*>(&part);
+		for (std::size_t i = 0; i < mesh->getNumTriangles(); ++i) {
+			if (tri1 && se::utils::compareTriangles(tri1->getLocalVertices(), mesh->getTriangle(i), kTolerance)) {
+				return i;
+			}
+		}
+		return mesh->getNumTriangles();
+	};
+
+	const AABB aabbs[] = {
+		{ glm::vec3(3.5f, -1.0f, 7.2f), glm::vec3(5.1f, 1.0f, 9.9f) },
+		{ glm::vec3(20.0f, 0.1f, 0.0f), glm::vec3(39.0f, 0.2f, 39.0f) },
+		{ glm::vec3(-5.0f, -1.0f, -5.0f), glm::vec3(-1.0f, 1.0f, -1.0f) }
+	};
+	for (const AABB& aabb : aabbs) {
+		std::vector<std::size_t> expectedRes, res;
+		for (std::size_t i = 0; i < mesh->getNumTriangles(); ++i) {
+			if (overlaps(mesh->getTriangleAABB(i), aabb, kTolerance)) {
+				expectedRes.push_back(i);
+			}
+		}
+
+		tm1.processOverlapingParts(aabb, kTolerance, [&](const ConvexCollider& part) { res.push_back(getTriangleIndex(part)); });
+		std::sort(res.begin(), res.end());
+		EXPECT_EQ(res, expectedRes);
+	}
+
+	const Ray rays[] = {
+		Ray(glm::vec3(-1.0f, 2.0f, -1.0f), glm::normalize(glm::vec3(1.0f, -0.1f, 1.0f))),
+		Ray(glm::vec3(12.3f, 5.0f, 17.7f), glm::vec3(0.0f, -1.0f, 0.0f))
+	};
+	for (const Ray& ray : rays) {
+		std::vector<std::size_t> expectedRes, res;
+		for (std::size_t i = 0; i < mesh->getNumTriangles(); ++i) {
+			if (intersects(mesh->getTriangleAABB(i), ray, kTolerance)) {
+				expectedRes.push_back(i);
+			}
+		}
+
+		tm1.processIntersectingParts(ray, kTolerance, [&](const ConvexCollider& part) { res.push_back(getTriangleIndex(part)); });
+		std::sort(res.begin(), res.end());
+		EXPECT_FALSE(res.empty());
+		EXPECT_EQ(res, expectedRes);
+	}
+}
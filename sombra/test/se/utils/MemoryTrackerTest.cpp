@@ -0,0 +1,142 @@
+#include <limits>
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <se/utils/PackedVector.h>
+#include <se/utils/MemoryTracker.h>
+#include <se/app/Repository.h>
+#include <se/app/graphics/Image.h>
+
+using namespace se::utils;
+
+struct TestTexture
+{
+	float pixels[16];
+};
+
+namespace se::app {
+
+	template <>
+	struct RepositoryMemoryTag<TestTexture>
+	{
+		static constexpr MemoryTag value = MemoryTag::Texture;
+	};
+
+}
+
+TEST(MemoryTracker, trackedAllocator)
+{
+	MemoryTracker& tracker = MemoryTracker::getInstance();
+	MemoryStats stats0 = tracker.getStats(MemoryTag::Default);
+
+	{
+		PackedVector<int, TrackedAllocator<int, MemoryTag::Default>> vector;
+		vector.reserve(16);
+
+		MemoryStats stats1 = tracker.getStats(MemoryTag::Default);
+		EXPECT_EQ(stats1.currentBytes, stats0.currentBytes + 16 * sizeof(int));
+		EXPECT_EQ(stats1.liveAllocations, stats0.liveAllocations + 1);
+		EXPECT_EQ(stats1.totalAllocations, stats0.totalAllocations + 1);
+		EXPECT_GE(stats1.highWaterMark, stats1.currentBytes);
+
+		vector.reserve(32);
+
+		MemoryStats stats2 = tracker.getStats(MemoryTag::Default);
+		EXPECT_EQ(stats2.currentBytes, stats0.currentBytes + 32 * sizeof(int));
+		EXPECT_EQ(stats2.liveAllocations, stats0.liveAllocations + 1);
+		EXPECT_EQ(stats2.totalAllocations, stats0.totalAllocations + 2);
+		EXPECT_GE(stats2.highWaterMark, stats0.currentBytes + 48 * sizeof(int));
+	}
+
+	MemoryStats stats3 = tracker.getStats(MemoryTag::Default);
+	EXPECT_EQ(stats3.currentBytes, stats0.currentBytes);
+	EXPECT_EQ(stats3.liveAllocations, stats0.liveAllocations);
+}
+
+
+TEST(MemoryTracker, frameAllocations)
+{
+	MemoryTracker& tracker = MemoryTracker::getInstance();
+	tracker.endFrame();
+	std::size_t frameCount = tracker.getFrameCount();
+
+	TrackedAllocator<float, MemoryTag::Default> allocator;
+	float* p1 = allocator.allocate(4);
+	float* p2 = allocator.allocate(8);
+	tracker.endFrame();
+
+	EXPECT_EQ(tracker.getFrameCount(), frameCount + 1);
+	EXPECT_EQ(tracker.getStats(MemoryTag::Default).frameAllocations, 2u);
+
+	allocator.deallocate(p1, 4);
+	allocator.deallocate(p2, 8);
+	tracker.endFrame();
+	EXPECT_EQ(tracker.getStats(MemoryTag::Default).frameAllocations, 0u);
+}
+
+
+TEST(MemoryTracker, budget)
+{
+	MemoryTracker& tracker = MemoryTracker::getInstance();
+	std::size_t currentBytes = tracker.getStats(MemoryTag::Default).currentBytes;
+	tracker.setBudget(MemoryTag::Default, currentBytes + 64);
+	EXPECT_FALSE(tracker.isOverBudget(MemoryTag::Default));
+
+	TrackedAllocator<char, MemoryTag::Default> allocator;
+	char* p = allocator.allocate(128);
+	EXPECT_TRUE(tracker.isOverBudget(MemoryTag::Default));
+
+	allocator.deallocate(p, 128);
+	EXPECT_FALSE(tracker.isOverBudget(MemoryTag::Default));
+	tracker.setBudget(MemoryTag::Default, std::numeric_limits<std::size_t>::max());
+}
+
+
+TEST(MemoryTracker, repositoryMemoryTags)
+{
+	MemoryTracker& tracker = MemoryTracker::getInstance();
+	MemoryStats repositoryStats0 = tracker.getStats(MemoryTag::Repository);
+	MemoryStats textureStats0 = tracker.getStats(MemoryTag::Texture);
+
+	{
+		auto value = se::app::Repository::makeShared<int>(3);
+		auto texture = se::app::Repository::makeShared<TestTexture>();
+		EXPECT_EQ(*value, 3);
+
+		MemoryStats repositoryStats1 = tracker.getStats(MemoryTag::Repository);
+		EXPECT_GE(repositoryStats1.currentBytes, repositoryStats0.currentBytes + sizeof(int));
+		EXPECT_EQ(repositoryStats1.liveAllocations, repositoryStats0.liveAllocations + 1);
+
+		MemoryStats textureStats1 = tracker.getStats(MemoryTag::Texture);
+		EXPECT_GE(textureStats1.currentBytes, textureStats0.currentBytes + sizeof(TestTexture));
+		EXPECT_EQ(textureStats1.liveAllocations, textureStats0.liveAllocations + 1);
+	}
+
+	EXPECT_EQ(tracker.getStats(MemoryTag::Repository).currentBytes, repositoryStats0.currentBytes);
+	EXPECT_EQ(tracker.getStats(MemoryTag::Texture).currentBytes, textureStats0.currentBytes);
+}
+
+
+TEST(MemoryTracker, imagePixels)
+{
+	MemoryTracker& tracker = MemoryTracker::getInstance();
+	MemoryStats stats0 = tracker.getStats(MemoryTag::Texture);
+
+	{
+		se::app::Image<float> image;
+		image.width = 4;
+		image.height = 2;
+		image.channels = 3;
+		image.pixels = se::app::allocatePixels<float>(24);
+		std::fill(image.pixels.get(), image.pixels.get() + 24, 1.0f);
+
+		se::app::Image<float> image2 = se::app::copy(image);
+
+		MemoryStats stats1 = tracker.getStats(MemoryTag::Texture);
+		EXPECT_EQ(stats1.currentBytes, stats0.currentBytes + 48 * sizeof(float));
+		EXPECT_EQ(stats1.liveAllocations, stats0.liveAllocations + 2);
+	}
+
+	MemoryStats stats2 = tracker.getStats(MemoryTag::Texture);
+	EXPECT_EQ(stats2.currentBytes, stats0.currentBytes);
+	EXPECT_EQ(stats2.liveAllocations, stats0.liveAllocations);
+}
@@ -0,0 +1,71 @@
+#include <thread>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <se/utils/StringInterner.h>
+
+using namespace se::utils;
+
+TEST(StringInterner, intern)
+{
+	NameId id1("Armature"), id2(std::string("Armature")), id3("Armature.001"), id4;
+
+	EXPECT_EQ(id1, id2);
+	EXPECT_NE(id1, id3);
+	EXPECT_TRUE(id4.empty());
+	EXPECT_EQ(id4, NameId(""));
+	EXPECT_STREQ(id1.c_str(), "Armature");
+	EXPECT_STREQ(id3.c_str(), "Armature.001");
+	EXPECT_STREQ(id4.c_str(), "");
+	EXPECT_EQ(id3.str(), "Armature.001");
+	EXPECT_EQ(id1.getValue(), hashString64("Armature"));
+}
+
+
+TEST(StringInterner, find)
+{
+	StringInterner& interner = StringInterner::getInstance();
+
+	StringInterner::ValueType id;
+	EXPECT_FALSE(interner.find("StringInterner::find::notInterned", id));
+
+	NameId nameId("StringInterner::find::interned");
+	EXPECT_TRUE(interner.find("StringInterner::find::interned", id));
+	EXPECT_EQ(id, nameId.getValue());
+}
+
+
+TEST(StringInterner, hash32)
+{
+	EXPECT_EQ(hashString32(""), 2166136261u);
+	EXPECT_EQ(hashString32("a"), 0xe40c292cu);
+	EXPECT_EQ(hashString64("a"), 0xaf63dc4c8601ec8cull);
+}
+
+
+TEST(StringInterner, multithread)
+{
+	const std::size_t kNumThreads = 4, kNumStrings = 256;
+	std::vector<std::vector<NameId>> threadIds(kNumThreads);
+
+	std::vector<std::thread> threads;
+	for (std::size_t i = 0; i < kNumThreads; ++i) {
+		threads.emplace_back([&, i]() {
+			for (std::size_t j = 0; j < kNumStrings; ++j) {
+				threadIds[i].emplace_back("joint" + std::to_string(j));
+			}
+		});
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	for (std::size_t j = 0; j < kNumStrings; ++j) {
+		std::string expected = "joint" + std::to_string(j);
+		for (std::size_t i = 0; i < kNumThreads; ++i) {
+			EXPECT_EQ(threadIds[i][j], threadIds[0][j]);
+			EXPECT_STREQ(threadIds[i][j].c_str(), expected.c_str());
+		}
+	}
+}